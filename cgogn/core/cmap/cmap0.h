@@ -79,6 +79,7 @@ public:
 	using QuickTraversor = typename cgogn::QuickTraversor<Self>;
 	using CellCache = typename cgogn::CellCache<Self>;
 	using BoundaryCache = typename cgogn::BoundaryCache<Self>;
+	using ChangeTracker = typename cgogn::ChangeTracker<Self>;
 
 public:
 
@@ -83,6 +83,7 @@ public:
 	using QuickTraversor = typename cgogn::QuickTraversor<Self>;
 	using CellCache = typename cgogn::CellCache<Self>;
 	using BoundaryCache = typename cgogn::BoundaryCache<Self>;
+	using ChangeTracker = typename cgogn::ChangeTracker<Self>;
 
 protected:
 
@@ -185,6 +186,10 @@ protected:
 		(*phi1_)[e.index] = f;
 		(*phi_1_)[g.index] = d;
 		(*phi_1_)[f.index] = e;
+		this->notify_dart_changed(d);
+		this->notify_dart_changed(e);
+		this->notify_dart_changed(f);
+		this->notify_dart_changed(g);
 	}
 
 	/*!
@@ -201,6 +206,9 @@ protected:
 		(*phi1_)[e.index] = e;
 		(*phi_1_)[f.index] = d;
 		(*phi_1_)[e.index] = e;
+		this->notify_dart_changed(d);
+		this->notify_dart_changed(e);
+		this->notify_dart_changed(f);
 	}
 
 	/*******************************************************************************
@@ -90,6 +90,7 @@ public:
 	using QuickTraversor = typename cgogn::QuickTraversor<Self>;
 	using CellCache = typename cgogn::CellCache<Self>;
 	using BoundaryCache = typename cgogn::BoundaryCache<Self>;
+	using ChangeTracker = typename cgogn::ChangeTracker<Self>;
 
 protected:
 
@@ -193,6 +194,8 @@ protected:
 		cgogn_assert(phi2(e) == e);
 		(*phi2_)[d.index] = e;
 		(*phi2_)[e.index] = d;
+		this->notify_dart_changed(d);
+		this->notify_dart_changed(e);
 	}
 
 	/**
@@ -206,6 +209,8 @@ protected:
 		Dart e = phi2(d);
 		(*phi2_)[d.index] = d;
 		(*phi2_)[e.index] = e;
+		this->notify_dart_changed(d);
+		this->notify_dart_changed(e);
 	}
 
 	/*******************************************************************************
@@ -567,6 +572,90 @@ public:
 		CGOGN_CHECK_CONCRETE_TYPE;
 
 		const Dart v = cut_edge_topo(e.dart);
+		cut_edge_embedding(e, v);
+		return Vertex(v);
+	}
+
+	/**
+	 * \brief Cut a set of edges.
+	 * \param edges : the edges to cut (each edge should appear only once)
+	 * \return The inserted vertices, in the order of the given edges
+	 * The result is the same as cutting the edges one by one with cut_edge.
+	 * The new darts are allocated at once and the edges are rewired in parallel,
+	 * then the boundary markers and the embeddings are updated sequentially.
+	 */
+	std::vector<Vertex> cut_edges(const std::vector<Edge>& edges)
+	{
+		CGOGN_CHECK_CONCRETE_TYPE;
+
+		const uint32 nb = uint32(edges.size());
+		std::vector<Vertex> vertices;
+		vertices.reserve(nb);
+		if (nb == 0u)
+			return vertices;
+
+		const uint32 first = this->add_topology_elements(2u * nb).index;
+
+		parallel_foreach_index(0u, nb, [&] (uint32 i)
+		{
+			cut_edge_topo_raw(edges[i].dart, Dart(first + 2u * i), Dart(first + 2u * i + 1u));
+		});
+
+		for (uint32 i = 0u; i < nb; ++i)
+		{
+			const Dart d = edges[i].dart;
+			const Dart nd(first + 2u * i);
+			const Dart ne(first + 2u * i + 1u);
+			const Dart e = phi2(nd);
+			this->set_boundary(nd, this->is_boundary(d));
+			this->set_boundary(ne, this->is_boundary(e));
+			for (Dart m : { d, e, nd, ne, this->phi1(nd), this->phi1(ne) })
+				this->notify_dart_changed(m);
+			cut_edge_embedding(edges[i], nd);
+			vertices.push_back(Vertex(nd));
+		}
+
+		return vertices;
+	}
+
+protected:
+
+	/**
+	 * \brief Cut the edge of d with the given new darts nd (inserted after d) and ne (inserted after phi2(d))
+	 * No notification is sent and the boundary markers of nd and ne are not set :
+	 * cuts of distinct edges can be done concurrently.
+	 */
+	inline void cut_edge_topo_raw(Dart d, Dart nd, Dart ne)
+	{
+		ChunkArray<Dart>& phi1 = *(this->phi1_);
+		ChunkArray<Dart>& phi_1 = *(this->phi_1_);
+		ChunkArray<Dart>& phi2 = *phi2_;
+
+		const Dart e = phi2[d.index];
+
+		const Dart f = phi1[d.index];				// insert nd between d and phi1(d)
+		phi1[d.index] = nd;
+		phi1[nd.index] = f;
+		phi_1[f.index] = nd;
+		phi_1[nd.index] = d;
+
+		const Dart g = phi1[e.index];				// insert ne between e and phi1(e)
+		phi1[e.index] = ne;
+		phi1[ne.index] = g;
+		phi_1[g.index] = ne;
+		phi_1[ne.index] = e;
+
+		phi2[d.index] = ne;							// build the new 2D-edges
+		phi2[ne.index] = d;
+		phi2[e.index] = nd;
+		phi2[nd.index] = e;
+	}
+
+	/**
+	 * \brief Embed the cells created by the cut of the edge e, v being the dart of the inserted vertex
+	 */
+	inline void cut_edge_embedding(Edge e, Dart v)
+	{
 		const Dart nf = phi2(e.dart);
 		const Dart f = phi2(v);
 
@@ -598,12 +687,8 @@ public:
 			this->template copy_embedding<Volume>(v, e.dart);
 			this->template copy_embedding<Volume>(nf, e.dart);
 		}
-
-		return Vertex(v);
 	}
 
-protected:
-
 	/**
 	 * @brief Flip an edge
 	 * @param d : a dart of the edge to flip
@@ -804,7 +889,10 @@ public:
 		{
 			auto vn1it = std::find(vn1->begin(), vn1->end(), this->embedding(Vertex(this->phi1(it))));
 			if (vn1it != vn1->end())
+			{
+				uint_buffers()->release_buffer(vn1);
 				return false;
+			}
 			it = next_edge(it);
 		} while(it != end);
 		uint_buffers()->release_buffer(vn1);
@@ -1063,6 +1151,89 @@ public:
 		cgogn_message_assert(!is_boundary_cell(Face(d)), "cut_face: should not cut a boundary face");
 
 		Dart nd = cut_face_topo(d, e);
+		cut_face_embedding(d, e, nd);
+		return Edge(nd);
+	}
+
+	/**
+	 * \brief Cut a set of faces
+	 * \param cuts : pairs (d,e) of darts given to cut_face (at most one pair per face)
+	 * \return The inserted edges, in the order of the given pairs
+	 * The result is the same as calling cut_face for each pair.
+	 * The new darts are allocated at once and the faces are rewired in parallel,
+	 * then the boundary markers and the embeddings are updated sequentially.
+	 */
+	std::vector<Edge> cut_faces(const std::vector<std::pair<Dart, Dart>>& cuts)
+	{
+		CGOGN_CHECK_CONCRETE_TYPE;
+
+		const uint32 nb = uint32(cuts.size());
+		std::vector<Edge> edges;
+		edges.reserve(nb);
+		if (nb == 0u)
+			return edges;
+
+		const uint32 first = this->add_topology_elements(2u * nb).index;
+
+		parallel_foreach_index(0u, nb, [&] (uint32 i)
+		{
+			cgogn_message_assert(!is_boundary_cell(Face(cuts[i].first)), "cut_faces: should not cut a boundary face");
+			cut_face_topo_raw(cuts[i].first, cuts[i].second, Dart(first + 2u * i), Dart(first + 2u * i + 1u));
+		});
+
+		for (uint32 i = 0u; i < nb; ++i)
+		{
+			const Dart d = cuts[i].first;
+			const Dart e = cuts[i].second;
+			const Dart nd(first + 2u * i);
+			const Dart ne(first + 2u * i + 1u);
+			this->set_boundary(nd, this->is_boundary(d));
+			this->set_boundary(ne, this->is_boundary(e));
+			for (Dart m : { d, e, nd, ne, this->phi_1(nd), this->phi_1(ne) })
+				this->notify_dart_changed(m);
+			cut_face_embedding(d, e, nd);
+			edges.push_back(Edge(nd));
+		}
+
+		return edges;
+	}
+
+protected:
+
+	/**
+	 * \brief Cut the face of d and e with the given new darts nd (inserted before d) and ne (inserted before e)
+	 * No notification is sent and the boundary markers of nd and ne are not set :
+	 * cuts of distinct faces can be done concurrently.
+	 */
+	inline void cut_face_topo_raw(Dart d, Dart e, Dart nd, Dart ne)
+	{
+		cgogn_message_assert(d != e, "cut_face_topo: d and e should be distinct");
+
+		ChunkArray<Dart>& phi1 = *(this->phi1_);
+		ChunkArray<Dart>& phi_1 = *(this->phi_1_);
+
+		const Dart dd = phi_1[d.index];
+		const Dart ee = phi_1[e.index];
+
+		phi1[dd.index] = ne;						// dd -> ne -> e
+		phi1[ne.index] = e;
+		phi_1[e.index] = ne;
+		phi_1[ne.index] = dd;
+
+		phi1[ee.index] = nd;						// ee -> nd -> d
+		phi1[nd.index] = d;
+		phi_1[d.index] = nd;
+		phi_1[nd.index] = ee;
+
+		(*phi2_)[nd.index] = ne;					// build the new 2D-edge
+		(*phi2_)[ne.index] = nd;
+	}
+
+	/**
+	 * \brief Embed the cells created by the cut of the face of d and e, nd being the dart of the inserted edge
+	 */
+	inline void cut_face_embedding(Dart d, Dart e, Dart nd)
+	{
 		Dart ne = this->phi_1(e);
 
 		if (this->template is_embedded<CDart>())
@@ -1091,8 +1262,6 @@ public:
 			this->template copy_embedding<Volume>(nd, d);
 			this->template copy_embedding<Volume>(ne, d);
 		}
-
-		return Edge(nd);
 	}
 
 protected:
@@ -1449,6 +1618,22 @@ protected:
 		return f;
 	}
 
+	/*!
+	 * \brief Close the hole that contains Dart d with a boundary face and update the embedding of incident cells.
+	 * \param d : a dart of the hole (a fixed point of phi2)
+	 * The other holes of the map are left open (close_map closes all of them).
+	 */
+	// The template parameter is a hack needed to compile the class CMap2_T<DefaultMapTraits, CMap3Type<DefaultMapTraits>> with MSVC (see close_map).
+	template <typename = std::enable_if<std::is_same<typename MapType::TYPE, Self>::value>>
+	inline Face close_boundary(Dart d)
+	{
+		CGOGN_CHECK_CONCRETE_TYPE;
+
+		const Face f = close_hole(d);
+		this->boundary_mark(f);
+		return f;
+	}
+
 	/*!
 	 * \brief Close the map by inserting faces in its holes and update the embedding of incident cells.
 	 * This method is used to close a CMap2 that has been build through the 2-sewing of 1-faces.
@@ -1477,8 +1662,7 @@ protected:
 		{
 			if (phi2(d) == d)
 			{
-				Face f = close_hole(d);
-				this->boundary_mark(f);
+				close_boundary(d);
 				++nb_holes;
 			}
 		}
@@ -24,6 +24,9 @@
 #ifndef CGOGN_CORE_CMAP_CMAP2_BUILDER_H_
 #define CGOGN_CORE_CMAP_CMAP2_BUILDER_H_
 
+#include <atomic>
+#include <vector>
+
 #include <cgogn/core/cmap/map_base.h>
 
 namespace cgogn
@@ -133,6 +136,14 @@ public:
 		return map_.close_hole(d);
 	}
 
+	/**
+	 * @brief close the hole that contains d, mark it as boundary and copy the embeddings of the incident cells on it
+	 */
+	inline Face close_boundary(Dart d)
+	{
+		return map_.close_boundary(d);
+	}
+
 	inline uint32 close_map()
 	{
 		return map_.close_map();
@@ -143,6 +154,53 @@ public:
 		return map_.add_topology_element();
 	}
 
+	/**
+	 * @brief add nb contiguous topological elements (darts for a CMap2), all phi relations are fixed points
+	 * @return the first dart of the added elements
+	 */
+	inline Dart add_topology_elements(uint32 nb)
+	{
+		return map_.add_topology_elements(nb);
+	}
+
+	/**
+	 * @brief add nb_faces faces of nb_edges edges (phi2 fixed points) on contiguous darts
+	 * @return the first dart, the darts of face i are [first + i*nb_edges, first + (i+1)*nb_edges[ in the phi1 order
+	 */
+	template <bool B=true>
+	inline auto add_faces_topo_fp(uint32 nb_faces, uint32 nb_edges) -> typename std::enable_if<B && MAP2::PRIM_SIZE==1, Dart>::type
+	{
+		const Dart first = map_.add_topology_elements(nb_faces * nb_edges);
+		ChunkArray<Dart>& phi1 = ca_phi1();
+		ChunkArray<Dart>& phi_1 = ca_phi_1();
+		parallel_foreach_index(0u, nb_faces * nb_edges, [&] (uint32 i)
+		{
+			const uint32 face = first.index + i - i % nb_edges;
+			const uint32 k = i % nb_edges;
+			phi1[first.index + i] = Dart(face + (k + 1u) % nb_edges);
+			phi_1[first.index + i] = Dart(face + (k + nb_edges - 1u) % nb_edges);
+		});
+		return first;
+	}
+
+	template <bool B=true>
+	inline auto add_faces_topo_fp(uint32 nb_faces, uint32 nb_edges) -> typename std::enable_if<B && (MAP2::PRIM_SIZE > 1), Dart>::type
+	{
+		cgogn_message_assert(nb_edges == MAP2::PRIM_SIZE, "add_faces_topo_fp: the faces must have PRIM_SIZE edges");
+		unused_parameters(nb_edges);
+		return map_.add_topology_elements(nb_faces);
+	}
+
+	/**
+	 * @brief embed darts of [first, first + nb_darts[ on nb_cells new lines of the ORBIT attribute container, in parallel
+	 * (see MapBase::new_embeddings)
+	 */
+	template <Orbit ORBIT, typename FUNC1, typename FUNC2>
+	inline uint32 new_embeddings(Dart first, uint32 nb_darts, uint32 nb_cells, const FUNC1& cell_of, const FUNC2& nb_darts_of)
+	{
+		return map_.template new_embeddings<ORBIT>(first, nb_darts, nb_cells, cell_of, nb_darts_of);
+	}
+
 
 	template <bool B=true>
 	inline auto ca_phi1() -> typename std::enable_if<B && MAP2::PRIM_SIZE==1,ChunkArray<Dart>&>::type
@@ -166,6 +224,107 @@ public:
 		return map_.topology_;
 	}
 
+	/**
+	 * @brief create the faces of a map with fixed size faces (CMap2Tri, CMap2Quad) from a flat array of vertex indices
+	 * @param faces_vertex_indices PRIM_SIZE vertex indices per face, in the phi1 order of the face
+	 * @param nb_vertices number of vertices (all indices are in [0,nb_vertices[)
+	 * @return the line of the vertex attribute container of vertex 0 (vertex i is the returned line + i)
+	 * All darts and vertex lines are allocated at once, phi2 and the vertex embedding are computed in parallel.
+	 * Edges shared by more than two faces are left unsewed, remaining holes are closed with close_map.
+	 */
+	template <bool B=true>
+	auto create_faces_from_indices(const std::vector<uint32>& faces_vertex_indices, uint32 nb_vertices)
+		-> typename std::enable_if<B && (MAP2::PRIM_SIZE > 1), uint32>::type
+	{
+		const uint32 N = MAP2::PRIM_SIZE;
+		const uint32 nb_faces = uint32(faces_vertex_indices.size()) / N;
+		const uint32 nb_darts = nb_faces * N;
+		if (nb_faces == 0u)
+			return INVALID_INDEX;
+
+		if (!map_.template is_embedded<Vertex>())
+			map_.template create_embedding<Vertex::ORBIT>();
+
+		ChunkArrayContainer<uint32>& vertex_container = attribute_container<Vertex::ORBIT>();
+		const uint32 first_vertex = vertex_container.template insert_lines<1>(nb_vertices);
+		for (uint32 i = first_vertex; i < first_vertex + nb_vertices; ++i)
+			vertex_container.init_markers_of_line(i);
+
+		const uint32 first_dart = map_.add_topology_elements(nb_faces).index;
+
+		// darts of each vertex (compressed rows)
+		std::vector<uint32> offsets(nb_vertices + 1u, 0u);
+		for (uint32 v : faces_vertex_indices)
+			++offsets[v + 1u];
+		for (uint32 v = 1u; v <= nb_vertices; ++v)
+			offsets[v] += offsets[v - 1u];
+		std::vector<uint32> vertex_darts(nb_darts);
+		{
+			std::vector<uint32> pos(offsets.begin(), offsets.end() - 1);
+			for (uint32 i = 0u; i < nb_darts; ++i)
+				vertex_darts[pos[faces_vertex_indices[i]]++] = i;
+		}
+
+		const auto next = [N] (uint32 i) -> uint32 { return (i % N == N - 1u) ? i + 1u - N : i + 1u; };
+
+		// dart i (a -> b) is matched with the unique dart b -> a
+		std::vector<uint32> phi2_candidate(nb_darts);
+		std::atomic<bool> non_manifold(false);
+		parallel_foreach_index(0u, nb_darts, [&] (uint32 i)
+		{
+			const uint32 a = faces_vertex_indices[i];
+			const uint32 b = faces_vertex_indices[next(i)];
+			uint32 candidate = i;
+			uint32 nb_candidates = 0u;
+			for (uint32 k = offsets[b]; k < offsets[b + 1u]; ++k)
+			{
+				const uint32 j = vertex_darts[k];
+				if (faces_vertex_indices[next(j)] == a)
+				{
+					candidate = j;
+					++nb_candidates;
+				}
+			}
+			if (nb_candidates > 1u)
+			{
+				non_manifold = true;
+				candidate = i;
+			}
+			phi2_candidate[i] = candidate;
+		});
+
+		ChunkArray<Dart>& phi2 = ca_phi2();
+		ChunkArray<uint32>& vertex_embedding = *(map_.embeddings_[Vertex::ORBIT]);
+		std::atomic<bool> has_boundary(false);
+		parallel_foreach_index(0u, nb_darts, [&] (uint32 i)
+		{
+			uint32 j = phi2_candidate[i];
+			if (phi2_candidate[j] != i)
+				j = i;
+			if (j == i)
+				has_boundary = true;
+			phi2[first_dart + i] = Dart(first_dart + j);
+			vertex_embedding[first_dart + i] = first_vertex + faces_vertex_indices[i];
+		});
+		parallel_foreach_index(0u, nb_vertices, [&] (uint32 v)
+		{
+			vertex_container.ref_line(first_vertex + v, offsets[v + 1u] - offsets[v]);
+		});
+
+		map_.merge_finish_embedding(first_dart);
+
+		if (has_boundary)
+			map_.close_map();
+
+		if (non_manifold)
+		{
+			map_.template enforce_unique_orbit_embedding<Vertex::ORBIT>();
+			cgogn_log_warning("create_faces_from_indices") << "non manifold vertices detected and corrected";
+		}
+
+		return first_vertex;
+	}
+
 private:
 
 	Map2& map_;
@@ -85,6 +85,7 @@ public:
 	using QuickTraversor = typename cgogn::QuickTraversor<Self>;
 	using CellCache = typename cgogn::CellCache<Self>;
 	using BoundaryCache = typename cgogn::BoundaryCache<Self>;
+	using ChangeTracker = typename cgogn::ChangeTracker<Self>;
 
 protected:
 
@@ -181,6 +182,8 @@ protected:
 		cgogn_assert(phi2(e) == e);
 		(*phi2_)[d.index] = e;
 		(*phi2_)[e.index] = d;
+		this->notify_dart_changed(d);
+		this->notify_dart_changed(e);
 	}
 
 	/**
@@ -194,6 +197,8 @@ protected:
 		Dart e = phi2(d);
 		(*phi2_)[d.index] = d;
 		(*phi2_)[e.index] = e;
+		this->notify_dart_changed(d);
+		this->notify_dart_changed(e);
 	}
 
 	/*******************************************************************************
@@ -685,6 +690,22 @@ protected:
 		return Face(dh);
 	}
 
+	/**
+	 * @brief close the hole that contains d (a fixed point of phi2) with boundary quads, the other holes are left open
+	 * @return a face of the fan
+	 */
+	inline Face close_boundary(Dart d)
+	{
+		const Face f = close_hole(d);
+		Dart df = f.dart;
+		do
+		{
+			this->boundary_mark(Face(df));
+			df = phi<121>(df);
+		} while (df != f.dart);
+		return f;
+	}
+
 	/**
 	 * @brief close_map
 	 * @return the number of holes (filled)
@@ -704,13 +725,7 @@ protected:
 		{
 			if (phi2(d) == d)
 			{
-				Face f = close_hole(d);
-				Dart df = f.dart;
-				do
-				{
-					this->boundary_mark(Face(df));
-					df = phi<121>(df);
-				} while (df != f.dart);
+				close_boundary(d);
 				++nb_holes;
 			}
 		}
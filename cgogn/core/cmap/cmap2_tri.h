@@ -85,6 +85,7 @@ public:
 	using QuickTraversor = typename cgogn::QuickTraversor<Self>;
 	using CellCache = typename cgogn::CellCache<Self>;
 	using BoundaryCache = typename cgogn::BoundaryCache<Self>;
+	using ChangeTracker = typename cgogn::ChangeTracker<Self>;
 
 protected:
 
@@ -182,6 +183,8 @@ protected:
 		cgogn_assert(phi2(e) == e);
 		(*phi2_)[d.index] = e;
 		(*phi2_)[e.index] = d;
+		this->notify_dart_changed(d);
+		this->notify_dart_changed(e);
 	}
 
 	/**
@@ -195,6 +198,8 @@ protected:
 		Dart e = phi2(d);
 		(*phi2_)[d.index] = d;
 		(*phi2_)[e.index] = e;
+		this->notify_dart_changed(d);
+		this->notify_dart_changed(e);
 	}
 
 	/*******************************************************************************
@@ -983,6 +988,21 @@ protected:
 		return Face(dh);
 	}
 
+	/**
+	 * \brief close the hole that contains d (a fixed point of phi2) with boundary triangles, the other holes are left open
+	 * \return a face of the fan
+	 */
+	inline Face close_boundary(Dart d)
+	{
+		const Face f = close_hole(d);
+		Vertex fan_center(phi_1(f.dart));
+		foreach_incident_face(fan_center, [&] (Face ff)
+		{
+			this->boundary_mark(ff);
+		});
+		return f;
+	}
+
 	/**
 	 * \brief close_map
 	 * \return the number of holes (filled)
@@ -1002,12 +1022,7 @@ protected:
 		{
 			if (phi2(d) == d)
 			{
-				Face f = close_hole(d);
-				Vertex fan_center(phi_1(f.dart));
-				foreach_incident_face(fan_center, [&] (Face ff)
-				{
-					this->boundary_mark(ff);
-				});
+				close_boundary(d);
 				++nb_holes;
 			}
 		}
@@ -26,6 +26,7 @@
 
 #include <cgogn/core/cmap/cmap2.h>
 #include <cgogn/core/cmap/cmap3_builder.h>
+#include <cgogn/core/cmap/tetra_link.h>
 
 namespace cgogn
 {
@@ -92,6 +93,7 @@ public:
 	using QuickTraversor = typename cgogn::QuickTraversor<Self>;
 	using CellCache = typename cgogn::CellCache<Self>;
 	using BoundaryCache = typename cgogn::BoundaryCache<Self>;
+	using ChangeTracker = typename cgogn::ChangeTracker<Self>;
 
 protected:
 
@@ -206,6 +208,8 @@ protected:
 		cgogn_assert(phi3(e) == e);
 		(*phi3_)[d.index] = e;
 		(*phi3_)[e.index] = d;
+		this->notify_dart_changed(d);
+		this->notify_dart_changed(e);
 	}
 
 	/**
@@ -219,6 +223,8 @@ protected:
 		Dart e = phi3(d);
 		(*phi3_)[d.index] = d;
 		(*phi3_)[e.index] = e;
+		this->notify_dart_changed(d);
+		this->notify_dart_changed(e);
 	}
 
 	/*******************************************************************************
@@ -385,7 +391,122 @@ public:
 		CGOGN_CHECK_CONCRETE_TYPE;
 
 		const Dart v = cut_edge_topo(e.dart);
+		cut_edge_embedding(e, v);
+		return Vertex(v);
+	}
+
+	/**
+	 * \brief Cut a set of edges.
+	 * \param edges : the edges to cut (each edge should appear only once)
+	 * \return The inserted vertices, in the order of the given edges
+	 * The result is the same as cutting the edges one by one with cut_edge.
+	 * The new darts are allocated at once and the edges are rewired in parallel,
+	 * then the boundary markers and the embeddings are updated sequentially.
+	 */
+	std::vector<Vertex> cut_edges(const std::vector<Edge>& edges)
+	{
+		CGOGN_CHECK_CONCRETE_TYPE;
+
+		const uint32 nb = uint32(edges.size());
+		std::vector<Vertex> vertices;
+		vertices.reserve(nb);
+		if (nb == 0u)
+			return vertices;
+
+		// each edge uses 2 new darts per dart of its PHI23 orbit
+		std::vector<uint32> offsets(nb + 1u, 0u);
+		parallel_foreach_index(0u, nb, [&] (uint32 i)
+		{
+			uint32 count = 0u;
+			Dart it = edges[i].dart;
+			do
+			{
+				count += 2u;
+				it = phi3(this->phi2(it));
+			} while (it != edges[i].dart);
+			offsets[i + 1u] = count;
+		});
+		for (uint32 i = 1u; i <= nb; ++i)
+			offsets[i] += offsets[i - 1u];
+
+		const uint32 first = this->add_topology_elements(offsets[nb]).index;
+
+		// cut_darts[k] is the dart after which the new dart first + k is inserted
+		std::vector<Dart> cut_darts(offsets[nb]);
+		parallel_foreach_index(0u, nb, [&] (uint32 i)
+		{
+			cut_edge_topo_raw(edges[i].dart, first + offsets[i], &cut_darts[offsets[i]]);
+		});
+
+		for (uint32 i = 0u; i < nb; ++i)
+		{
+			for (uint32 k = offsets[i]; k < offsets[i + 1u]; ++k)
+			{
+				const Dart nd(first + k);
+				this->set_boundary(nd, this->is_boundary(cut_darts[k]));
+				for (Dart m : { cut_darts[k], nd, this->phi1(nd) })
+					this->notify_dart_changed(m);
+			}
+			const Dart v(first + offsets[i]);
+			cut_edge_embedding(edges[i], v);
+			vertices.push_back(Vertex(v));
+		}
+
+		return vertices;
+	}
+
+protected:
+
+	/**
+	 * \brief Cut the edge of d using the new darts first, first + 1, ... (2 per dart of the PHI23 orbit of d)
+	 * @param cut_darts [out] cut_darts[k] is the dart after which the dart first + k is inserted
+	 * No notification is sent and the boundary markers of the new darts are not set :
+	 * cuts of distinct edges can be done concurrently.
+	 */
+	inline void cut_edge_topo_raw(Dart d, uint32 first, Dart* cut_darts)
+	{
+		ChunkArray<Dart>& phi3 = *phi3_;
+		uint32 k = 0u;
+
+		auto cut = [&] (Dart x)
+		{
+			cut_darts[k] = x;
+			cut_darts[k + 1u] = this->phi2(x);
+			Inherit::cut_edge_topo_raw(x, Dart(first + k), Dart(first + k + 1u));
+			k += 2u;
+		};
+		auto resew = [&] (Dart x)
+		{
+			const Dart x3 = phi3[x.index];
+			const Dart x31 = this->phi1(x3);
+			const Dart x1 = this->phi1(x);
+			phi3[x.index] = x31;
+			phi3[x31.index] = x;
+			phi3[x3.index] = x1;
+			phi3[x1.index] = x3;
+		};
+
+		Dart prev = d;
+		Dart d23 = phi3[this->phi2(d).index];
+
+		cut(d);
+
+		while (d23 != d)
+		{
+			prev = d23;
+			d23 = phi3[this->phi2(d23).index];
+			cut(prev);
+			resew(prev);
+		}
+
+		resew(d);
+	}
 
+	/**
+	 * \brief Embed the cells created by the cut of the edge e, v being the dart of the inserted vertex
+	 */
+	inline void cut_edge_embedding(Edge e, Dart v)
+	{
 		if (this->template is_embedded<CDart>())
 		{
 			foreach_dart_of_PHI23(e.dart, [this] (Dart d)
@@ -462,8 +583,6 @@ public:
 				}
 			});
 		}
-
-		return Vertex(v);
 	}
 
 protected:
@@ -616,6 +735,162 @@ public:
 		return true;
 	}
 
+protected:
+
+	/**
+	 * @brief check if the volume of d is a tetrahedron
+	 */
+	inline bool is_tetra(Dart d) const
+	{
+		const Dart e1 = this->phi2(d);
+		const Dart e2 = this->phi2(this->phi1(d));
+		const Dart e3 = this->phi2(this->phi_1(d));
+		for (Dart f : { d, e1, e2, e3 })
+		{
+			if (this->phi1(this->phi1(this->phi1(f))) != f)
+				return false;
+		}
+		return this->phi2(this->phi1(e1)) == this->phi_1(e3) &&
+			this->phi2(this->phi_1(e1)) == this->phi1(e2) &&
+			this->phi2(this->phi_1(e2)) == this->phi1(e3);
+	}
+
+	/**
+	 * @brief check if the volumes incident to a vertex are all tetrahedra
+	 */
+	bool incident_volumes_are_tetra(Vertex v) const
+	{
+		bool result = true;
+		foreach_dart_of_orbit(v, [&] (Dart d) -> bool
+		{
+			if (!this->is_boundary(d) && !is_tetra(d))
+				result = false;
+			return result;
+		});
+		return result;
+	}
+
+public:
+
+	/**
+	 * @brief check if an edge of a tetrahedral mesh can be collapsed without changing the topology
+	 * @param e the edge to check
+	 * The edge cannot be collapsed if both its vertices are incident to the boundary
+	 * (so the boundary is never modified), if a volume incident to one of its vertices is not a tetrahedron
+	 * or if the link condition is not satisfied. The vertices have to be embedded.
+	 */
+	bool edge_can_collapse(Edge e) const
+	{
+		cgogn_message_assert(this->template is_embedded<Vertex>(), "edge_can_collapse: the vertices must be embedded");
+
+		const std::pair<Vertex, Vertex> v = vertices(e);
+		if (this->is_incident_to_boundary(v.first) && this->is_incident_to_boundary(v.second))
+			return false;
+
+		if (!incident_volumes_are_tetra(v.first) || !incident_volumes_are_tetra(v.second))
+			return false;
+
+		return cgogn::tetra_link_condition(*this, e.dart);
+	}
+
+protected:
+
+	/**
+	 * @brief Collapse an edge of a tetrahedral mesh
+	 * @param d : a dart of the edge to collapse (not incident to the boundary)
+	 * @param merged : filled with a dart of each pair of merged edges (2 per removed tetrahedron), the first one of each pair is also a dart of the merged face
+	 * @return a dart of the resulting vertex
+	 * The tetrahedra around the edge are removed, the two other faces of each tetrahedron are sewn together.
+	 */
+	Dart collapse_edge_topo(Dart d, std::vector<Dart>& merged)
+	{
+		std::vector<Dart>* shell = cgogn::dart_buffers()->buffer();
+		Dart it = d;
+		do
+		{
+			shell->push_back(it);
+			it = phi3(this->phi2(it));
+		} while (it != d);
+
+		Dart res;
+		for (Dart s : *shell)
+		{
+			// the face (a,c,x) of u is merged with the face (c,b,x) of w
+			const Dart u = this->phi2(this->phi_1(s));
+			const Dart w = this->phi2(this->phi1(s));
+			const Dart p[3] = { u, this->phi1(u), this->phi_1(u) };
+			const Dart q[3] = { w, this->phi_1(w), this->phi1(w) };
+			for (uint32 i = 0u; i < 3u; ++i)
+			{
+				const Dart x = phi3(p[i]);
+				const Dart y = phi3(q[i]);
+				phi3_unsew(p[i]);
+				phi3_unsew(q[i]);
+				phi3_sew(x, y);
+				if (i == 0u)
+				{
+					merged.push_back(x);
+					res = this->is_boundary(x) ? y : this->phi1(x);
+				}
+				else if (i == 2u)
+					merged.push_back(x);
+			}
+		}
+
+		std::vector<Dart>* darts_to_be_deleted = cgogn::dart_buffers()->buffer();
+		for (Dart s : *shell)
+			this->foreach_dart_of_orbit(Volume(s), [&] (Dart vd) { darts_to_be_deleted->push_back(vd); });
+		for (Dart vd : *darts_to_be_deleted)
+			this->remove_topology_element(vd);
+
+		cgogn::dart_buffers()->release_buffer(darts_to_be_deleted);
+		cgogn::dart_buffers()->release_buffer(shell);
+
+		return res;
+	}
+
+public:
+
+	/**
+	 * @brief Collapse an edge of a tetrahedral mesh
+	 * @param e : the edge to collapse (edge_can_collapse(e) must be true)
+	 * @return the resulting vertex, it keeps the embedding of the vertex of e.dart
+	 * or of the other vertex if this one is incident to the boundary
+	 */
+	Vertex collapse_edge(Edge e)
+	{
+		CGOGN_CHECK_CONCRETE_TYPE;
+
+		uint32 emb = INVALID_INDEX;
+		if (this->template is_embedded<Vertex>())
+		{
+			const Vertex v2(this->phi1(e.dart));
+			emb = this->is_incident_to_boundary(v2) ? this->embedding(v2) : this->embedding(Vertex(e.dart));
+		}
+
+		std::vector<Dart>* merged = cgogn::dart_buffers()->buffer();
+		const Vertex v(collapse_edge_topo(e.dart, *merged));
+
+		if (this->template is_embedded<Vertex>())
+			this->template set_orbit_embedding<Vertex>(v, emb);
+
+		if (this->template is_embedded<Edge>())
+		{
+			for (Dart d : *merged)
+				this->template set_orbit_embedding<Edge>(Edge(d), this->embedding(Edge(d)));
+		}
+
+		if (this->template is_embedded<Face>())
+		{
+			for (uint32 i = 0u; i < merged->size(); i += 2u)
+				this->template set_orbit_embedding<Face>(Face((*merged)[i]), this->embedding(Face((*merged)[i])));
+		}
+
+		cgogn::dart_buffers()->release_buffer(merged);
+
+		return v;
+	}
+
 protected:
 
 	// TODO: write test in cmap3_topo_test
@@ -764,6 +1039,75 @@ public:
 		CGOGN_CHECK_CONCRETE_TYPE;
 
 		Dart nd = cut_face_topo(d, e);
+		cut_face_embedding(d, e, nd);
+		return Edge(nd);
+	}
+
+	/**
+	 * \brief Cut a set of faces
+	 * \param cuts : pairs (d,e) of darts given to cut_face (at most one pair per face)
+	 * \return The inserted edges, in the order of the given pairs
+	 * The result is the same as calling cut_face for each pair.
+	 * The new darts are allocated at once and the faces are rewired in parallel,
+	 * then the boundary markers and the embeddings are updated sequentially.
+	 */
+	std::vector<Edge> cut_faces(const std::vector<std::pair<Dart, Dart>>& cuts)
+	{
+		CGOGN_CHECK_CONCRETE_TYPE;
+
+		const uint32 nb = uint32(cuts.size());
+		std::vector<Edge> edges;
+		edges.reserve(nb);
+		if (nb == 0u)
+			return edges;
+
+		const uint32 first = this->add_topology_elements(4u * nb).index;
+
+		parallel_foreach_index(0u, nb, [&] (uint32 i)
+		{
+			const Dart d = cuts[i].first;
+			const Dart e = cuts[i].second;
+			cgogn_message_assert(this->same_cell(Face2(d), Face2(e)), "cut_face_topo: d and e should belong to the same Face2");
+			const Dart dd = this->phi1(phi3(d));
+			const Dart ee = this->phi1(phi3(e));
+			const Dart nd(first + 4u * i);
+			const Dart ndd(first + 4u * i + 2u);
+			Inherit::cut_face_topo_raw(d, e, nd, Dart(first + 4u * i + 1u));
+			Inherit::cut_face_topo_raw(dd, ee, ndd, Dart(first + 4u * i + 3u));
+			ChunkArray<Dart>& phi3 = *phi3_;
+			const Dart ee1 = this->phi_1(ee);
+			const Dart e1 = this->phi_1(e);
+			phi3[nd.index] = ee1;
+			phi3[ee1.index] = nd;
+			phi3[ndd.index] = e1;
+			phi3[e1.index] = ndd;
+		});
+
+		for (uint32 i = 0u; i < nb; ++i)
+		{
+			const Dart d = cuts[i].first;
+			const Dart nd(first + 4u * i);
+			for (uint32 k = 0u; k < 4u; ++k)
+			{
+				const Dart n(first + 4u * i + k);
+				this->set_boundary(n, this->is_boundary(k < 2u ? d : phi3(d)));
+				for (Dart m : { n, this->phi1(n), this->phi_1(n) })
+					this->notify_dart_changed(m);
+			}
+			cut_face_embedding(d, cuts[i].second, nd);
+			edges.push_back(Edge(nd));
+		}
+
+		return edges;
+	}
+
+protected:
+
+	/**
+	 * \brief Embed the cells created by the cut of the face of d and e, nd being the dart of the inserted edge
+	 */
+	inline void cut_face_embedding(Dart d, Dart e, Dart nd)
+	{
 		Dart ne = this->phi_1(e);
 		Dart nd3 = phi3(nd);
 		Dart ne3 = phi3(ne);
@@ -844,12 +1188,8 @@ public:
 				this->template copy_embedding<Volume>(ne3, d3);
 			}
 		}
-
-		return Edge(nd);
 	}
 
-protected:
-
 	bool merge_incident_faces_topo(Dart d)
 	{
 		if (this->degree(Edge(d)) != 2u)
@@ -1486,6 +1826,19 @@ protected:
 		return v;
 	}
 
+	/**
+	 * @brief close the hole that contains d (a fixed point of phi3) with a boundary volume, the other holes are left open
+	 * @return a dart of the volume that closes the hole
+	 */
+	inline Dart close_boundary(Dart d)
+	{
+		CGOGN_CHECK_CONCRETE_TYPE;
+
+		const Volume v = close_hole(d);
+		this->boundary_mark(v);
+		return v.dart;
+	}
+
 	/**
 	 * @brief close_map closes the map removing topological holes (only for import/creation)
 	 * Add volumes to the map that close every existing hole.
@@ -1509,8 +1862,7 @@ protected:
 		{
 			if (phi3(d) == d)
 			{
-				Volume v = close_hole(d);
-				this->boundary_mark(v);
+				close_boundary(d);
 				++nb_holes;
 			}
 		}
@@ -2562,6 +2914,7 @@ public:
 
 			// set copied Darts in fix point for phi3
 			(*phi3_)[i] = Dart(i);
+			this->notify_dart_changed(Dart(i));
 		}
 
 		// the boundary marker of the merged Map2 is ignored
@@ -24,6 +24,10 @@
 #ifndef CGOGN_CORE_CMAP_CMAP3_BUILDER_H_
 #define CGOGN_CORE_CMAP_CMAP3_BUILDER_H_
 
+#include <array>
+#include <atomic>
+#include <vector>
+
 #include <cgogn/core/cmap/map_base.h>
 
 namespace cgogn
@@ -50,6 +54,8 @@ public:
 	using DartMarkerStore = typename Map3::DartMarkerStore;
 	template <typename T>
 	using ChunkArrayContainer = typename Map3::template ChunkArrayContainer<T>;
+	template <typename T>
+	using ChunkArray = typename Map3::template ChunkArray<T>;
 
 	inline CMap3Builder_T(Map3& map) : map_(map) {}
 	CGOGN_NOT_COPYABLE_NOR_MOVABLE(CMap3Builder_T);
@@ -134,11 +140,214 @@ public:
 		map_.boundary_unmark(c);
 	}
 
+	/**
+	 * @brief close the hole that contains d, mark it as boundary and copy the embeddings of the incident cells on it
+	 */
+	inline Dart close_boundary(Dart d)
+	{
+		return map_.close_boundary(d);
+	}
+
 	inline uint32 close_map()
 	{
 		return map_.close_map();
 	}
 
+	/**
+	 * @brief add nb volumes of a map with fixed type volumes (CMap3Tetra, CMap3Hexa) on contiguous darts (phi3 fixed points)
+	 * @return the first dart, the darts of volume i are [first + i*PRIM_SIZE, first + (i+1)*PRIM_SIZE[
+	 */
+	template <bool B=true>
+	inline auto add_volumes_topo_fp(uint32 nb) -> typename std::enable_if<B && (MAP3::PRIM_SIZE > 1), Dart>::type
+	{
+		return map_.add_topology_elements(nb);
+	}
+
+	/**
+	 * @brief add nb contiguous topological elements (darts for a CMap3), all phi relations are fixed points
+	 * @return the first dart of the added elements
+	 */
+	inline Dart add_topology_elements(uint32 nb)
+	{
+		return map_.add_topology_elements(nb);
+	}
+
+	template <bool B=true>
+	inline auto ca_phi1() -> typename std::enable_if<B && MAP3::PRIM_SIZE==1, ChunkArray<Dart>&>::type
+	{
+		return *(map_.phi1_);
+	}
+
+	template <bool B=true>
+	inline auto ca_phi_1() -> typename std::enable_if<B && MAP3::PRIM_SIZE==1, ChunkArray<Dart>&>::type
+	{
+		return *(map_.phi_1_);
+	}
+
+	template <bool B=true>
+	inline auto ca_phi2() -> typename std::enable_if<B && MAP3::PRIM_SIZE==1, ChunkArray<Dart>&>::type
+	{
+		return *(map_.phi2_);
+	}
+
+	inline ChunkArray<Dart>& ca_phi3()
+	{
+		return *(map_.phi3_);
+	}
+
+	/**
+	 * @brief embed darts of [first, first + nb_darts[ on nb_cells new lines of the ORBIT attribute container, in parallel
+	 * (see MapBase::new_embeddings)
+	 */
+	template <Orbit ORBIT, typename FUNC1, typename FUNC2>
+	inline uint32 new_embeddings(Dart first, uint32 nb_darts, uint32 nb_cells, const FUNC1& cell_of, const FUNC2& nb_darts_of)
+	{
+		return map_.template new_embeddings<ORBIT>(first, nb_darts, nb_cells, cell_of, nb_darts_of);
+	}
+
+	/**
+	 * @brief create the volumes of a map with fixed type volumes (CMap3Tetra, CMap3Hexa) from a flat array of vertex indices
+	 * @param volumes_vertex_indices 4 (tetra) or 8 (hexa) vertex indices per volume, in the VolumeImport order
+	 * @param nb_vertices number of vertices (all indices are in [0,nb_vertices[)
+	 * @return the line of the vertex attribute container of vertex 0 (vertex i is the returned line + i)
+	 * All darts and vertex lines are allocated at once, phi3 and the vertex embedding are computed in parallel.
+	 * Faces shared by more than two volumes are left unsewed, remaining holes are closed with close_map.
+	 */
+	template <bool B=true>
+	auto create_volumes_from_indices(const std::vector<uint32>& volumes_vertex_indices, uint32 nb_vertices)
+		-> typename std::enable_if<B && (MAP3::PRIM_SIZE > 1), uint32>::type
+	{
+		const uint32 P = MAP3::PRIM_SIZE;
+		const uint32 NV = (P == 12u) ? 4u : 8u;
+		const uint32 nb_volumes = uint32(volumes_vertex_indices.size()) / NV;
+		const uint32 nb_darts = nb_volumes * P;
+		if (nb_volumes == 0u)
+			return INVALID_INDEX;
+
+		if (!map_.template is_embedded<Vertex>())
+			map_.template create_embedding<Vertex::ORBIT>();
+
+		ChunkArrayContainer<uint32>& vertex_container = attribute_container<Vertex::ORBIT>();
+		const uint32 first_vertex = vertex_container.template insert_lines<1>(nb_vertices);
+		for (uint32 i = first_vertex; i < first_vertex + nb_vertices; ++i)
+			vertex_container.init_markers_of_line(i);
+
+		const Dart first_dart = map_.add_topology_elements(nb_volumes);
+
+		// phi1 and local vertex of each dart of a volume (identical for all volumes)
+		std::array<uint32, MAP3::PRIM_SIZE> local_phi1;
+		std::array<uint32, MAP3::PRIM_SIZE> local_vertex;
+		{
+			const Dart d = first_dart;
+			std::vector<Dart> vertices;
+			if (NV == 4u)
+				vertices = { d, map_.phi1(d), map_.phi_1(d), map_.phi_1(map_.phi2(map_.phi_1(d))) };
+			else
+			{
+				const Dart d0 = map_.phi2(map_.phi1(map_.phi1(map_.phi2(map_.phi_1(d)))));
+				const Dart d1 = map_.phi2(map_.phi1(map_.phi1(map_.phi2(d))));
+				const Dart d2 = map_.phi2(map_.phi1(map_.phi1(map_.phi2(map_.phi1(d)))));
+				const Dart d3 = map_.phi2(map_.phi1(map_.phi1(map_.phi2(map_.phi1(map_.phi1(d))))));
+				vertices = { d, map_.phi1(d), map_.phi1(map_.phi1(d)), map_.phi_1(d), d0, d1, d2, d3 };
+			}
+			for (uint32 v = 0u; v < NV; ++v)
+			{
+				Dart dd = vertices[v];
+				do
+				{
+					local_vertex[dd.index - d.index] = v;
+					dd = map_.phi1(map_.phi2(dd));
+				} while (dd != vertices[v]);
+			}
+			for (uint32 i = 0u; i < P; ++i)
+				local_phi1[i] = map_.phi1(Dart(d.index + i)).index - d.index;
+		}
+
+		const auto phi1 = [&] (uint32 i) -> uint32 { return i - i % P + local_phi1[i % P]; };
+		const auto vertex_of = [&] (uint32 i) -> uint32 { return volumes_vertex_indices[(i / P) * NV + local_vertex[i % P]]; };
+
+		// darts of each vertex (compressed rows)
+		std::vector<uint32> offsets(nb_vertices + 1u, 0u);
+		for (uint32 i = 0u; i < nb_darts; ++i)
+			++offsets[vertex_of(i) + 1u];
+		for (uint32 v = 1u; v <= nb_vertices; ++v)
+			offsets[v] += offsets[v - 1u];
+		std::vector<uint32> vertex_darts(nb_darts);
+		{
+			std::vector<uint32> pos(offsets.begin(), offsets.end() - 1);
+			for (uint32 i = 0u; i < nb_darts; ++i)
+				vertex_darts[pos[vertex_of(i)]++] = i;
+		}
+
+		// vertices of phi1 and phi_1 of each dart, so that the candidates are tested without walking their faces
+		std::vector<uint32> next_vertex(nb_darts);
+		std::vector<uint32> prev_vertex(nb_darts);
+		parallel_foreach_index(0u, nb_darts, [&] (uint32 i)
+		{
+			const uint32 j = phi1(i);
+			next_vertex[i] = vertex_of(j);
+			prev_vertex[j] = vertex_of(i);
+		});
+
+		// dart i (a -> b, face a b c ...) is matched with the unique dart b -> a of face b a ... c
+		std::vector<uint32> phi3_candidate(nb_darts);
+		std::atomic<bool> non_manifold(false);
+		parallel_foreach_index(0u, nb_darts, [&] (uint32 i)
+		{
+			const uint32 a = vertex_of(i);
+			const uint32 b = next_vertex[i];
+			const uint32 c = next_vertex[phi1(i)];
+			uint32 candidate = i;
+			uint32 nb_candidates = 0u;
+			for (uint32 k = offsets[b]; k < offsets[b + 1u]; ++k)
+			{
+				const uint32 j = vertex_darts[k];
+				if (next_vertex[j] == a && prev_vertex[j] == c)
+				{
+					candidate = j;
+					++nb_candidates;
+				}
+			}
+			if (nb_candidates > 1u)
+			{
+				non_manifold = true;
+				candidate = i;
+			}
+			phi3_candidate[i] = candidate;
+		});
+
+		ChunkArray<Dart>& phi3 = *(map_.phi3_);
+		ChunkArray<uint32>& vertex_embedding = *(map_.embeddings_[Vertex::ORBIT]);
+		std::atomic<bool> has_boundary(false);
+		parallel_foreach_index(0u, nb_darts, [&] (uint32 i)
+		{
+			uint32 j = phi3_candidate[i];
+			if (phi3_candidate[j] != i)
+				j = i;
+			if (j == i)
+				has_boundary = true;
+			phi3[first_dart.index + i] = Dart(first_dart.index + j);
+			vertex_embedding[first_dart.index + i] = first_vertex + vertex_of(i);
+		});
+		parallel_foreach_index(0u, nb_vertices, [&] (uint32 v)
+		{
+			vertex_container.ref_line(first_vertex + v, offsets[v + 1u] - offsets[v]);
+		});
+
+		map_.merge_finish_embedding(first_dart.index);
+
+		if (has_boundary)
+			map_.close_map();
+
+		if (non_manifold)
+		{
+			map_.template enforce_unique_orbit_embedding<Vertex::ORBIT>();
+			cgogn_log_warning("create_volumes_from_indices") << "non manifold vertices detected and corrected";
+		}
+
+		return first_vertex;
+	}
+
 private:
 
 	Map3& map_;
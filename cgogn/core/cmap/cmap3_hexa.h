@@ -88,6 +88,7 @@ public:
 	using QuickTraversor = typename cgogn::QuickTraversor<Self>;
 	using CellCache = typename cgogn::CellCache<Self>;
 	using BoundaryCache = typename cgogn::BoundaryCache<Self>;
+	using ChangeTracker = typename cgogn::ChangeTracker<Self>;
 
 protected:
 
@@ -199,6 +200,8 @@ protected:
 		cgogn_assert(phi3(e) == e);
 		(*phi3_)[d.index] = e;
 		(*phi3_)[e.index] = d;
+		this->notify_dart_changed(d);
+		this->notify_dart_changed(e);
 	}
 
 	/**
@@ -212,6 +215,8 @@ protected:
 		Dart e = phi3(d);
 		(*phi3_)[d.index] = d;
 		(*phi3_)[e.index] = e;
+		this->notify_dart_changed(d);
+		this->notify_dart_changed(e);
 	}
 
 	/*******************************************************************************
@@ -513,9 +518,11 @@ protected:
 	/**
 	 * @brief close_hole_topo closes the topological hole that contains Dart d (a fixed point of phi3 relation)
 	 * @param d a dart incident to the hole
+	 * @param mark_boundary mark the closing volumes as boundary
+	 * @param hole_darts if not null, receives the darts of the hole
 	 * @return a dart of the volume that closes the hole
 	 */
-	Dart close_hole_topo(Dart d, bool mark_boundary=false)
+	Dart close_hole_topo(Dart d, bool mark_boundary=false, std::vector<Dart>* hole_darts = nullptr)
 	{
 		cgogn_message_assert(phi3(d) == d, "CMap3Hexa: close hole called on a dart that is not a phi3 fix point");
 
@@ -560,6 +567,8 @@ protected:
 		for(uint32 i = 0u; i < visited_faces.size(); ++i)
 		{
 			Dart f = visited_faces[i];
+			if (hole_darts)
+				this->foreach_dart_of_orbit(Face2(f), [&] (Dart fd) { hole_darts->push_back(fd); });
 
 			const Dart tb = add_hexa_topo_fp();
 			boundary_marker.mark_orbit(Volume(tb));
@@ -583,6 +592,49 @@ protected:
 		return phi3(d);
 	}
 
+	/**
+	 * @brief close the hole that contains d (a fixed point of phi3) with boundary volumes
+	 * and copy the embeddings of the incident cells on them, the other holes are left open
+	 * @return a dart of the volume that closes the hole
+	 */
+	inline Dart close_boundary(Dart d)
+	{
+		std::vector<Dart>* hole_darts = dart_buffers()->buffer();
+		const Dart b = close_hole_topo(d, true, hole_darts);
+
+		if (this->template is_embedded<Vertex>())
+		{
+			for (Dart hd : (*hole_darts))
+			{
+				Dart e = phi3(hd);
+				this->template copy_embedding<Vertex>(this->phi2(e), hd);
+				e = this->phi1(e);
+				this->template copy_embedding<Vertex>(e, hd);
+				this->template copy_embedding<Vertex>(phi<21>(e), hd);
+			}
+		}
+
+		if (this->template is_embedded<Edge>())
+		{
+			for (Dart hd : (*hole_darts))
+			{
+				Dart e = phi3(hd);
+				this->template copy_embedding<Edge>(e, hd);
+				this->template copy_embedding<Edge>(this->phi2(e), hd);
+			}
+		}
+
+		if (this->template is_embedded<Face>())
+		{
+			for (Dart hd : (*hole_darts))
+				this->template copy_embedding<Face>(phi3(hd), hd);
+		}
+
+		dart_buffers()->release_buffer(hole_darts);
+
+		return b;
+	}
+
 	/**
 	 * @brief close_map closes the map removing topological holes (only for import/creation)
 	 * Add volumes to the map that close every existing hole.
@@ -604,39 +656,11 @@ protected:
 		{
 			if (phi3(d) == d)
 			{
-				close_hole_topo(d, true);
+				close_boundary(d);
 				++nb_holes;
 			}
 		}
 
-		if (this->template is_embedded<Vertex>())
-		{
-			for (Dart d : (*fix_point_darts))
-			{
-				Dart e = phi3(d);
-				this->template copy_embedding<Vertex>(this->phi2(e), d);
-				e = this->phi1(e);
-				this->template copy_embedding<Vertex>(e, d);
-				this->template copy_embedding<Vertex>(phi<21>(e), d);
-			}
-		}
-
-		if (this->template is_embedded<Edge>())
-		{
-			for (Dart d : (*fix_point_darts))
-			{
-				Dart e = phi3(d);
-				this->template copy_embedding<Edge>(e, d);
-				this->template copy_embedding<Edge>(this->phi2(e), d);
-			}
-		}
-
-		if (this->template is_embedded<Face>())
-		{
-			for (Dart d : (*fix_point_darts))
-				this->template copy_embedding<Face>(phi3(d), d);
-		}
-
 		dart_buffers()->release_buffer(fix_point_darts);
 
 		return nb_holes;
@@ -26,6 +26,7 @@
 
 #include <cgogn/core/cmap/map_base.h>
 #include <cgogn/core/cmap/cmap3_builder.h>
+#include <cgogn/core/cmap/tetra_link.h>
 
 namespace cgogn
 {
@@ -88,6 +89,7 @@ public:
 	using QuickTraversor = typename cgogn::QuickTraversor<Self>;
 	using CellCache = typename cgogn::CellCache<Self>;
 	using BoundaryCache = typename cgogn::BoundaryCache<Self>;
+	using ChangeTracker = typename cgogn::ChangeTracker<Self>;
 
 protected:
 
@@ -199,6 +201,8 @@ protected:
 		cgogn_assert(phi3(e) == e);
 		(*phi3_)[d.index] = e;
 		(*phi3_)[e.index] = d;
+		this->notify_dart_changed(d);
+		this->notify_dart_changed(e);
 	}
 
 	/**
@@ -212,6 +216,8 @@ protected:
 		Dart e = phi3(d);
 		(*phi3_)[d.index] = d;
 		(*phi3_)[e.index] = e;
+		this->notify_dart_changed(d);
+		this->notify_dart_changed(e);
 	}
 
 	/*******************************************************************************
@@ -469,9 +475,11 @@ protected:
 	/**
 	 * @brief close_hole_topo closes the topological hole that contains Dart d (a fixed point of phi3 relation)
 	 * @param d a dart incident to the hole
+	 * @param mark_boundary mark the closing volumes as boundary
+	 * @param hole_darts if not null, receives the darts of the hole
 	 * @return a dart of the volume that closes the hole
 	 */
-	inline Dart close_hole_topo(Dart d, bool mark_boundary = false)
+	inline Dart close_hole_topo(Dart d, bool mark_boundary = false, std::vector<Dart>* hole_darts = nullptr)
 	{
 		cgogn_message_assert(phi3(d) == d, "CMap3Tetra: close hole called on a dart that is not a phi3 fix point");
 
@@ -516,6 +524,8 @@ protected:
 		for(uint32 i = 0u; i < visited_faces.size(); ++i)
 		{
 			Dart f = visited_faces[i];
+			if (hole_darts)
+				this->foreach_dart_of_orbit(Face2(f), [&] (Dart fd) { hole_darts->push_back(fd); });
 
 			const Dart tb = add_tetra_topo_fp();
 			boundary_marker.mark_orbit(Volume(tb));
@@ -537,6 +547,49 @@ protected:
 		return phi3(d);
 	}
 
+	/**
+	 * @brief close the hole that contains d (a fixed point of phi3) with boundary volumes
+	 * and copy the embeddings of the incident cells on them, the other holes are left open
+	 * @return a dart of the volume that closes the hole
+	 */
+	inline Dart close_boundary(Dart d)
+	{
+		std::vector<Dart>* hole_darts = dart_buffers()->buffer();
+		const Dart b = close_hole_topo(d, true, hole_darts);
+
+		if (this->template is_embedded<Vertex>())
+		{
+			for (Dart hd : (*hole_darts))
+			{
+				Dart e = phi3(hd);
+				this->template copy_embedding<Vertex>(this->phi2(e), hd);
+				e = this->phi1(e);
+				this->template copy_embedding<Vertex>(e, hd);
+				this->template copy_embedding<Vertex>(phi<21>(e), hd);
+			}
+		}
+
+		if (this->template is_embedded<Edge>())
+		{
+			for (Dart hd : (*hole_darts))
+			{
+				Dart e = phi3(hd);
+				this->template copy_embedding<Edge>(e, hd);
+				this->template copy_embedding<Edge>(this->phi2(e), hd);
+			}
+		}
+
+		if (this->template is_embedded<Face>())
+		{
+			for (Dart hd : (*hole_darts))
+				this->template copy_embedding<Face>(phi3(hd), hd);
+		}
+
+		dart_buffers()->release_buffer(hole_darts);
+
+		return b;
+	}
+
 	/**
 	 * @brief close_map closes the map removing topological holes (only for import/creation)
 	 * Add volumes to the map that close every existing hole.
@@ -558,42 +611,127 @@ protected:
 		{
 			if (phi3(d) == d)
 			{
-				close_hole_topo(d, true);
+				close_boundary(d);
 				++nb_holes;
 			}
 		}
 
-		if (this->template is_embedded<Vertex>())
+		dart_buffers()->release_buffer(fix_point_darts);
+
+		return nb_holes;
+	}
+
+public:
+
+	/**
+	 * @brief check if an edge can be collapsed without changing the topology
+	 * @param e the edge to check
+	 * The edge cannot be collapsed if both its vertices are incident to the boundary
+	 * (so the boundary is never modified) or if the link condition is not satisfied.
+	 * The vertices have to be embedded.
+	 */
+	bool edge_can_collapse(Edge e) const
+	{
+		cgogn_message_assert(this->template is_embedded<Vertex>(), "edge_can_collapse: the vertices must be embedded");
+
+		if (this->is_incident_to_boundary(Vertex(e.dart)) && this->is_incident_to_boundary(Vertex(this->phi1(e.dart))))
+			return false;
+
+		return cgogn::tetra_link_condition(*this, e.dart);
+	}
+
+protected:
+
+	/**
+	 * @brief Collapse an edge
+	 * @param d : a dart of the edge to collapse (not incident to the boundary)
+	 * @param merged : filled with a dart of each pair of merged edges (2 per removed tetrahedron), the first one of each pair is also a dart of the merged face
+	 * @return a dart of the resulting vertex
+	 * The tetrahedra around the edge are removed, the two other faces of each tetrahedron are sewn together.
+	 */
+	Dart collapse_edge_topo(Dart d, std::vector<Dart>& merged)
+	{
+		std::vector<Dart>* shell = cgogn::dart_buffers()->buffer();
+		Dart it = d;
+		do
 		{
-			for (Dart d : (*fix_point_darts))
+			shell->push_back(it);
+			it = phi3(this->phi2(it));
+		} while (it != d);
+
+		Dart res;
+		for (Dart s : *shell)
+		{
+			// the face (a,c,x) of u is merged with the face (c,b,x) of w
+			const Dart u = this->phi2(this->phi_1(s));
+			const Dart w = this->phi2(this->phi1(s));
+			const Dart p[3] = { u, this->phi1(u), this->phi_1(u) };
+			const Dart q[3] = { w, this->phi_1(w), this->phi1(w) };
+			for (uint32 i = 0u; i < 3u; ++i)
 			{
-				Dart e = phi3(d);
-				this->template copy_embedding<Vertex>(this->phi2(e), d);
-				e = this->phi1(e);
-				this->template copy_embedding<Vertex>(e, d);
-				this->template copy_embedding<Vertex>(phi<21>(e), d);
+				const Dart x = phi3(p[i]);
+				const Dart y = phi3(q[i]);
+				phi3_unsew(p[i]);
+				phi3_unsew(q[i]);
+				phi3_sew(x, y);
+				if (i == 0u)
+				{
+					merged.push_back(x);
+					res = this->is_boundary(x) ? y : this->phi1(x);
+				}
+				else if (i == 2u)
+					merged.push_back(x);
 			}
 		}
 
+		for (Dart s : *shell)
+			remove_tetra_topo_fp(Dart(s.index - s.index % PRIM_SIZE));
+
+		cgogn::dart_buffers()->release_buffer(shell);
+
+		return res;
+	}
+
+public:
+
+	/**
+	 * @brief Collapse an edge
+	 * @param e : the edge to collapse (edge_can_collapse(e) must be true)
+	 * @return the resulting vertex, it keeps the embedding of the vertex of e.dart
+	 * or of the other vertex if this one is incident to the boundary
+	 */
+	Vertex collapse_edge(Edge e)
+	{
+		CGOGN_CHECK_CONCRETE_TYPE;
+
+		uint32 emb = INVALID_INDEX;
+		if (this->template is_embedded<Vertex>())
+		{
+			const Vertex v2(this->phi1(e.dart));
+			emb = this->is_incident_to_boundary(v2) ? this->embedding(v2) : this->embedding(Vertex(e.dart));
+		}
+
+		std::vector<Dart>* merged = cgogn::dart_buffers()->buffer();
+		const Vertex v(collapse_edge_topo(e.dart, *merged));
+
+		if (this->template is_embedded<Vertex>())
+			this->template set_orbit_embedding<Vertex>(v, emb);
+
 		if (this->template is_embedded<Edge>())
 		{
-			for (Dart d : (*fix_point_darts))
-			{
-				Dart e = phi3(d);
-				this->template copy_embedding<Edge>(e, d);
-				this->template copy_embedding<Edge>(this->phi2(e), d);
-			}
+			for (Dart d : *merged)
+				this->template set_orbit_embedding<Edge>(Edge(d), this->embedding(Edge(d)));
 		}
 
 		if (this->template is_embedded<Face>())
 		{
-			for (Dart d : (*fix_point_darts))
-				this->template copy_embedding<Face>(phi3(d), d);
+			for (uint32 i = 0u; i < merged->size(); i += 2u)
+				this->template set_orbit_embedding<Face>(Face((*merged)[i]), this->embedding(Face((*merged)[i])));
 		}
 
-		dart_buffers()->release_buffer(fix_point_darts);
+		cgogn::dart_buffers()->release_buffer(merged);
 
-		return nb_holes;
+		return v;
 	}
 
 	/*******************************************************************************
@@ -0,0 +1,235 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef CGOGN_CORE_CMAP_INDEXED_ARRAYS_H_
+#define CGOGN_CORE_CMAP_INDEXED_ARRAYS_H_
+
+#include <array>
+#include <vector>
+
+#include <cgogn/core/utils/numerics.h>
+#include <cgogn/core/utils/definitions.h>
+#include <cgogn/core/utils/assert.h>
+#include <cgogn/core/utils/parallel_foreach_element.h>
+#include <cgogn/core/basic/dart.h>
+
+namespace cgogn
+{
+
+/**
+ * \brief export the vertex indices of the faces of a map in compressed rows
+ * @param map the map (2D or 3D, vertices must be embedded)
+ * @param offsets [out] face i uses indices[offsets[i]] .. indices[offsets[i+1]-1]
+ * @param indices [out] vertex embedding of the vertices of the faces, in phi1 order
+ * @return the number of exported faces
+ * The indices are lines of the vertex attribute container, they can directly address vertex attributes.
+ * The sizes are counted in parallel, then the indices are filled in parallel after a prefix sum.
+ */
+template <typename MAP>
+uint32 export_face_indices(const MAP& map, std::vector<uint32>& offsets, std::vector<uint32>& indices)
+{
+	using Vertex = typename MAP::Vertex;
+	using Face = typename MAP::Face;
+
+	std::vector<Dart> faces;
+	faces.reserve(map.template nb_cells<Face::ORBIT>());
+	map.foreach_cell([&] (Face f) { faces.push_back(f.dart); });
+	const uint32 nb_faces = uint32(faces.size());
+
+	offsets.assign(nb_faces + 1u, 0u);
+	parallel_foreach_index(0u, nb_faces, [&] (uint32 i)
+	{
+		uint32 nb = 0u;
+		Dart it = faces[i];
+		do
+		{
+			++nb;
+			it = map.phi1(it);
+		} while (it != faces[i]);
+		offsets[i + 1u] = nb;
+	});
+	for (uint32 i = 1u; i <= nb_faces; ++i)
+		offsets[i] += offsets[i - 1u];
+
+	indices.resize(offsets[nb_faces]);
+	parallel_foreach_index(0u, nb_faces, [&] (uint32 i)
+	{
+		uint32 k = offsets[i];
+		Dart it = faces[i];
+		do
+		{
+			indices[k++] = map.embedding(Vertex(it));
+			it = map.phi1(it);
+		} while (it != faces[i]);
+	});
+
+	return nb_faces;
+}
+
+/**
+ * \brief export the vertex indices of the volumes of a 3D map in compressed rows
+ * @param map the map (vertices must be embedded)
+ * @param offsets [out] volume i uses indices[offsets[i]] .. indices[offsets[i+1]-1]
+ * @param indices [out] vertex embedding of the vertices of the volumes
+ * @return the number of exported volumes
+ * Tetrahedra are exported in the VolumeImport order, other volumes in the order of foreach_incident_vertex.
+ */
+template <typename MAP>
+uint32 export_volume_indices(const MAP& map, std::vector<uint32>& offsets, std::vector<uint32>& indices)
+{
+	static_assert(MAP::DIMENSION == 3, "export_volume_indices works only with 3D Maps.");
+
+	using Vertex = typename MAP::Vertex;
+	using Volume = typename MAP::Volume;
+
+	std::vector<Dart> volumes;
+	volumes.reserve(map.template nb_cells<Volume::ORBIT>());
+	map.foreach_cell([&] (Volume v) { volumes.push_back(v.dart); });
+	const uint32 nb_volumes = uint32(volumes.size());
+
+	offsets.assign(nb_volumes + 1u, 0u);
+	parallel_foreach_index(0u, nb_volumes, [&] (uint32 i)
+	{
+		uint32 nb = 0u;
+		map.foreach_incident_vertex(Volume(volumes[i]), [&nb] (Vertex) { ++nb; });
+		offsets[i + 1u] = nb;
+	});
+	for (uint32 i = 1u; i <= nb_volumes; ++i)
+		offsets[i] += offsets[i - 1u];
+
+	indices.resize(offsets[nb_volumes]);
+	parallel_foreach_index(0u, nb_volumes, [&] (uint32 i)
+	{
+		uint32 k = offsets[i];
+		const Dart d = volumes[i];
+		if (offsets[i + 1u] - k == 4u)
+		{
+			indices[k] = map.embedding(Vertex(d));
+			indices[k + 1u] = map.embedding(Vertex(map.phi1(d)));
+			indices[k + 2u] = map.embedding(Vertex(map.phi_1(d)));
+			indices[k + 3u] = map.embedding(Vertex(map.phi_1(map.phi2(map.phi_1(d)))));
+		}
+		else
+			map.foreach_incident_vertex(Volume(d), [&] (Vertex v) { indices[k++] = map.embedding(v); });
+	});
+
+	return nb_volumes;
+}
+
+/**
+ * \brief The PrimitiveIndicesView class gives a direct access (without copy) to the vertex indices
+ * of the primitives of a map made of a single type of primitive (CMap2Tri, CMap2Quad, CMap3Tetra, CMap3Hexa).
+ * The darts of a primitive are contiguous in the topology container, so the vertex indices are read
+ * in place in the vertex embedding of the darts. Primitive p is valid if its darts are used and
+ * are not boundary darts. When the view is dense (no hole in the topology container and no
+ * boundary), all the primitives in [0,nb_primitives()[ are valid.
+ * Vertices of the volumes are given in the VolumeImport order.
+ */
+template <typename MAP>
+class PrimitiveIndicesView
+{
+public:
+
+	static_assert(MAP::PRIM_SIZE > 1, "PrimitiveIndicesView works only with maps of fixed size primitives.");
+
+	using Self = PrimitiveIndicesView<MAP>;
+	using Vertex = typename MAP::Vertex;
+
+	static const uint32 PRIM_SIZE = MAP::PRIM_SIZE;
+	static const uint32 NB_VERTICES = (MAP::DIMENSION == 2u) ? PRIM_SIZE : ((PRIM_SIZE == 12u) ? 4u : 8u);
+
+	inline PrimitiveIndicesView(const MAP& map) :
+		map_(map),
+		dense_(true)
+	{
+		const Dart d(0u);
+		std::vector<Dart> vertices;
+		if (MAP::DIMENSION == 2u)
+		{
+			Dart it = d;
+			for (uint32 k = 0u; k < NB_VERTICES; ++k, it = map_.phi1(it))
+				vertices.push_back(it);
+		}
+		else if (NB_VERTICES == 4u)
+			vertices = { d, map_.phi1(d), map_.phi_1(d), map_.phi_1(map_.phi2(map_.phi_1(d))) };
+		else
+			vertices = {
+				d, map_.phi1(d), map_.phi1(map_.phi1(d)), map_.phi_1(d),
+				map_.phi2(map_.phi1(map_.phi1(map_.phi2(map_.phi_1(d))))),
+				map_.phi2(map_.phi1(map_.phi1(map_.phi2(d)))),
+				map_.phi2(map_.phi1(map_.phi1(map_.phi2(map_.phi1(d))))),
+				map_.phi2(map_.phi1(map_.phi1(map_.phi2(map_.phi1(map_.phi1(d))))))
+			};
+		for (uint32 k = 0u; k < NB_VERTICES; ++k)
+			local_darts_[k] = vertices[k].index;
+
+		const auto& topo = map_.topology_container();
+		if (topo.size() != topo.end())
+			dense_ = false;
+		else
+		{
+			for (uint32 p = 0u, end = nb_primitives(); p < end && dense_; ++p)
+				dense_ = !map_.is_boundary(Dart(p * PRIM_SIZE));
+		}
+	}
+
+	CGOGN_NOT_COPYABLE_NOR_MOVABLE(PrimitiveIndicesView);
+
+	/**
+	 * @brief number of primitive slots (valid or not) of the map
+	 */
+	inline uint32 nb_primitives() const
+	{
+		return map_.topology_container().end() / PRIM_SIZE;
+	}
+
+	inline bool is_dense() const
+	{
+		return dense_;
+	}
+
+	inline bool is_valid(uint32 p) const
+	{
+		const Dart d(p * PRIM_SIZE);
+		return map_.topology_container().used(d.index) && !map_.is_boundary(d);
+	}
+
+	/**
+	 * @brief the index of the k-th vertex of the primitive p
+	 */
+	inline uint32 operator()(uint32 p, uint32 k) const
+	{
+		cgogn_message_assert(k < NB_VERTICES, "PrimitiveIndicesView: vertex out of the primitive");
+		return map_.embedding(Vertex(Dart(p * PRIM_SIZE + local_darts_[k])));
+	}
+
+private:
+
+	const MAP& map_;
+	std::array<uint32, NB_VERTICES> local_darts_;
+	bool dense_;
+};
+
+} // namespace cgogn
+
+#endif // CGOGN_CORE_CMAP_INDEXED_ARRAYS_H_
@@ -26,11 +26,17 @@
 
 #include <vector>
 #include <memory>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <sstream>
+#include <algorithm>
 
 #include <cgogn/core/utils/masks.h>
 #include <cgogn/core/utils/logger.h>
 #include <cgogn/core/utils/unique_ptr.h>
 #include <cgogn/core/utils/type_traits.h>
+#include <cgogn/core/utils/parallel_foreach_element.h>
 
 #include <cgogn/core/basic/cell.h>
 #include <cgogn/core/basic/dart_marker.h>
@@ -97,6 +103,8 @@ public:
 
 		for (uint32 i = 0u; i < NB_ORBITS; ++i)
 			this->attributes_[i].clear_chunk_arrays();
+
+		this->notify_topology_reset();
 	}
 
 	/**
@@ -106,6 +114,7 @@ public:
 	{
 		// 1st step : some cleaning
 		this->topology_.clear_chunk_arrays();
+		this->notify_topology_reset();
 
 		for (auto& att : this->attributes_)
 			att.remove_chunk_arrays();
@@ -166,10 +175,42 @@ protected:
 					(*this->embeddings_[orbit])[jdx] = INVALID_INDEX;
 			}
 			to_concrete()->init_dart(Dart(jdx));
+			this->notify_dart_changed(Dart(jdx));
 		}
 		return Dart(idx);
 	}
 
+	/**
+	 * \brief Adds nb topological elements of PRIM_SIZE to the topology container in one batch
+	 * \return the first dart of the added elements
+	 * The added elements are contiguous : the darts of the i-th element start at index
+	 * first + i * PRIM_SIZE. Their darts are initialized in parallel.
+	 */
+	inline Dart add_topology_elements(uint32 nb)
+	{
+		const uint32 idx = this->topology_.template insert_lines<ConcreteMap::PRIM_SIZE>(nb);
+		const uint32 end = idx + nb * ConcreteMap::PRIM_SIZE;
+
+		// markers are bit fields : not initialized concurrently
+		for (uint32 jdx = idx; jdx < end; ++jdx)
+		{
+			this->topology_.init_markers_of_line(jdx);
+			this->notify_dart_changed(Dart(jdx));
+		}
+
+		parallel_foreach_index(idx, end, [this] (uint32 jdx)
+		{
+			for (uint32 orbit = 0u; orbit < NB_ORBITS; ++orbit)
+			{
+				if (this->embeddings_[orbit])
+					(*this->embeddings_[orbit])[jdx] = INVALID_INDEX;
+			}
+			to_concrete()->init_dart(Dart(jdx));
+		});
+
+		return Dart(idx);
+	}
+
 	/**
 	 * \brief Removes a topological element of PRIM_SIZE from the topology container
 	 * \param d the element to remove ( or one them if PRIM_SIZE >1)
@@ -180,6 +221,8 @@ protected:
 	{
 		uint32 index = d.index;
 		this->topology_.template remove_lines<ConcreteMap::PRIM_SIZE>(index);
+		for (uint32 jdx = index; jdx < index + ConcreteMap::PRIM_SIZE; ++jdx)
+			this->notify_dart_changed(Dart(jdx));
 
 		for (uint32 orbit = 0; orbit < NB_ORBITS; ++orbit)
 		{
@@ -462,6 +505,41 @@ protected:
 		return emb;
 	}
 
+	/**
+	 * \brief embed darts of [first, first + nb_darts[ on nb_cells new lines of the ORBIT attribute container, in parallel
+	 * @param cell_of index in [0,nb_cells[ of the cell of dart first + i, or INVALID_INDEX to leave the dart unembedded
+	 * @param nb_darts_of number of darts given to cell c by cell_of
+	 * @return the first new line (cell c is embedded on the returned line + c)
+	 * Used by the map builders, the darts that are not given (e.g. boundary darts) are embedded afterwards (close_map).
+	 */
+	template <Orbit ORBIT, typename FUNC1, typename FUNC2>
+	uint32 new_embeddings(Dart first, uint32 nb_darts, uint32 nb_cells, const FUNC1& cell_of, const FUNC2& nb_darts_of)
+	{
+		static_assert(ORBIT < NB_ORBITS, "Unknown orbit parameter");
+
+		if (!this->template is_embedded<ORBIT>())
+			create_embedding<ORBIT>();
+
+		ChunkArrayContainer<uint32>& container = this->attributes_[ORBIT];
+		const uint32 first_line = container.template insert_lines<1>(nb_cells);
+		for (uint32 i = first_line; i < first_line + nb_cells; ++i)
+			container.init_markers_of_line(i);
+
+		ChunkArray<uint32>& embedding = *(this->embeddings_[ORBIT]);
+		parallel_foreach_index(0u, nb_darts, [&] (uint32 i)
+		{
+			const uint32 c = cell_of(i);
+			if (c != INVALID_INDEX)
+				embedding[first.index + i] = first_line + c;
+		});
+		parallel_foreach_index(0u, nb_cells, [&] (uint32 c)
+		{
+			container.ref_line(first_line + c, nb_darts_of(c));
+		});
+
+		return first_line;
+	}
+
 public:
 
 	/**
@@ -495,7 +573,10 @@ public:
 	/**
 	 * \brief Tests if all \p ORBIT orbits are well embedded
 	 * \details An orbit is well embedded if all its darts
-	 * have the same embedding (index)
+	 * have the same embedding (index), and the reference counter of each index
+	 * is the number of darts that use it.
+	 * The cells and the lines of the attribute container are checked in parallel,
+	 * the diagnostics are gathered and logged at the end of the check.
 	 *
 	 * \tparam ORBIT [description]
 	 * \return [description]
@@ -509,83 +590,121 @@ public:
 		cgogn_message_assert(this->template is_embedded<ORBIT>(), "Invalid parameter: orbit not embedded");
 
 		const ConcreteMap* cmap = to_concrete();
-		Attribute<std::vector<CellType>, ORBIT> counter = add_attribute<std::vector<CellType>, ORBIT>("__tmp_dart_per_emb");
-		bool result = true;
-
 		const ChunkArrayContainer<uint32>& container = this->attributes_[ORBIT];
 
+		// number of cells and of darts using each index
+		// (some darts may not be traversed by the orbits, e.g. boundary darts of the maps with fixed size cells,
+		// but they still hold a reference on their index)
+		const uint32 nb_lines = container.end();
+		std::unique_ptr<std::atomic<uint32>[]> nb_cells(new std::atomic<uint32>[nb_lines]);
+		std::unique_ptr<std::atomic<uint32>[]> nb_darts(new std::atomic<uint32>[nb_lines]);
+		parallel_foreach_index(0u, nb_lines, [&] (uint32 i) { nb_cells[i] = 0u; nb_darts[i] = 0u; });
+		const ChunkArray<uint32>& embedding = *(this->embeddings_[ORBIT]);
+		parallel_foreach_dart([&] (Dart d)
+		{
+			const uint32 idx = embedding[d.index];
+			if (idx < nb_lines)
+				++nb_darts[idx];
+		});
+
+		std::atomic<bool> result(true);
+		std::mutex diagnostics_mutex;
+		std::vector<std::string> diagnostics;
+		auto report = [&] (const std::string& msg)
+		{
+			result = false;
+			std::lock_guard<std::mutex> lock(diagnostics_mutex);
+			diagnostics.push_back(msg);
+		};
+
 		// Check that the indexation of cells is correct
-		foreach_cell<FORCE_DART_MARKING>([&] (CellType c)
+		parallel_foreach_cell<FORCE_DART_MARKING>([&] (CellType c)
 		{
 			const uint32 idx = this->embedding(c);
 			// check used indices are valid
 			if (idx == INVALID_INDEX)
 			{
-				result = false;
-				cgogn_log_error("is_well_embedded") << "INVALID_INDEX found for dart " << c << " in orbit " << orbit_name(ORBIT);
+				std::stringstream ss;
+				ss << "INVALID_INDEX found for dart " << c << " in orbit " << orbit_name(ORBIT);
+				report(ss.str());
 				return;
 			}
-			counter[idx].push_back(c);
-			uint32 refs = 1;
+			if (idx < nb_lines)
+				++nb_cells[idx];
 			// check all darts of the cell use the same index (distinct to INVALID_INDEX)
 			cmap->foreach_dart_of_orbit(c, [&] (Dart d)
 			{
 				const uint32 emb_d = this->embedding(CellType(d));
 				if (emb_d != idx)
 				{
-					cgogn_log_error("is_well_embedded") << "Different indices (" << idx << " and " << emb_d << ") in orbit " << orbit_name(ORBIT);
-					result = false;
+					std::stringstream ss;
+					ss << "Different indices (" << idx << " and " << emb_d << ") in orbit " << orbit_name(ORBIT);
+					report(ss.str());
 				}
-				refs++;
 			});
-			if (refs != container.nb_refs(this->embedding(c)))
-			{
-				cgogn_log_error("is_well_embedded") << "Wrong reference number of embedding " << this->embedding(c) << " in orbit " << orbit_name(ORBIT);
-				result = false;
-			}
-
 		});
+
 		// check that all cells present in the attribute handler are used
-		for (uint32 i = container.begin(), end = container.end(); i != end; container.next(i))
+		parallel_foreach_index(container.begin(), nb_lines, [&] (uint32 i)
 		{
-			if (counter[i].empty())
+			if (!container.used(i))
+				return;
+			if (nb_darts[i] + 1u != container.nb_refs(i))
 			{
-				result =false;
-				cgogn_log_error("is_well_embedded") << "Cell #" << i << " is not used in orbit " << orbit_name(ORBIT);
-			} else
+				std::stringstream ss;
+				ss << "Wrong reference number of embedding " << i << " in orbit " << orbit_name(ORBIT);
+				report(ss.str());
+			}
+			const uint32 size = nb_cells[i];
+			if (size == 0u)
 			{
-				const std::size_t size = counter[i].size();
-				if (size >= 2ul)
-				{
-					result =false;
-					cgogn_log_error("is_well_embedded") << size << " cells with same index \"" << i << "\" in orbit " << orbit_name(ORBIT);
-				}
+				std::stringstream ss;
+				ss << "Cell #" << i << " is not used in orbit " << orbit_name(ORBIT);
+				report(ss.str());
 			}
-		}
+			else if (size >= 2u)
+			{
+				std::stringstream ss;
+				ss << size << " cells with same index \"" << i << "\" in orbit " << orbit_name(ORBIT);
+				report(ss.str());
+			}
+		});
+
+		std::sort(diagnostics.begin(), diagnostics.end());
+		for (const std::string& msg : diagnostics)
+			cgogn_log_error("is_well_embedded") << msg;
 
-		remove_attribute(counter);
 		return result;
 	}
 
+	/**
+	 * \brief check the topological relations of all the darts and the embeddings of all the embedded orbits
+	 * The darts are checked in parallel, the number of broken darts and the first of them are reported.
+	 */
 	bool check_map_integrity()
 	{
 		ConcreteMap* cmap = to_concrete();
-		bool result = true;
 
 		// check the integrity of topological relations or the correct sewing of darts
-		foreach_dart([&cmap, &result] (Dart d) -> bool
+		std::atomic<uint32> nb_broken(0u);
+		std::atomic<uint32> first_broken(INVALID_INDEX);
+		parallel_foreach_dart([&] (Dart d)
 		{
-			result = cmap->check_integrity(d);
-			return result;
+			if (!cmap->check_integrity(d))
+			{
+				++nb_broken;
+				uint32 prev = first_broken;
+				while (d.index < prev && !first_broken.compare_exchange_weak(prev, d.index)) {}
+			}
 		});
-		if (!result)
+		if (nb_broken > 0u)
 		{
-			cgogn_log_error("check_map_integrity") << "Integrity of the topology is broken";
+			cgogn_log_error("check_map_integrity") << "Integrity of the topology is broken (" << nb_broken << " darts, first one: " << first_broken << ")";
 			return false;
 		}
 
 		// check the embedding indexation for the concrete map
-		result = cmap->check_embedding_integrity();
+		const bool result = cmap->check_embedding_integrity();
 		if (!result)
 		{
 			cgogn_log_error("check_map_integrity") << "Integrity of the embeddings is broken";
@@ -733,6 +852,7 @@ public:
 	inline void set_boundary(Dart d, bool b)
 	{
 		this->boundary_marker_->set_value(d.index, b);
+		this->notify_dart_changed(d);
 	}
 
 #pragma warning(push)
@@ -1457,13 +1577,15 @@ public:
 			std::vector<uint32> old_new = this->attributes_[orbit].template compact<1>();
 			if (!old_new.empty())
 			{
-				for (uint32 i=this->topology_.begin(); i!= this->topology_.end(); this->topology_.next(i))
+				parallel_foreach_index(this->topology_.begin(), this->topology_.end(), [&] (uint32 i)
 				{
+					if (!this->topology_.used(i))
+						return;
 					uint32& emb = (*embedding)[i];
 					if ((emb != std::numeric_limits<uint32>::max())
 						&& (old_new[emb] != std::numeric_limits<uint32>::max()))
 						emb = old_new[emb];
-				}
+				});
 			}
 		}
 	}
@@ -1475,18 +1597,22 @@ public:
 		if (old_new.empty())
 			return;			// already compact nothing to do with relationss
 
+		this->notify_topology_reset();
+
 		for (ChunkArrayGen* ptr: this->topology_.chunk_arrays())
 		{
 			ChunkArray<Dart>* ca = dynamic_cast<ChunkArray<Dart>*>(ptr);
 			if (ca)
 			{
-				for (uint32 i=this->topology_.begin(); i!= this->topology_.end(); this->topology_.next(i))
+				parallel_foreach_index(this->topology_.begin(), this->topology_.end(), [&] (uint32 i)
 				{
+					if (!this->topology_.used(i))
+						return;
 					Dart& d = (*ca)[i];
 					uint32 idx = d.index;
-					if (old_new[idx] != std::numeric_limits<uint32>::max())
+					if (idx < old_new.size() && old_new[idx] != std::numeric_limits<uint32>::max())
 						d = Dart(old_new[idx]);
-				}
+				});
 			}
 		}
 	}
@@ -1540,13 +1666,15 @@ public:
 			ChunkArray<Dart>* cad = dynamic_cast<ChunkArray<Dart>*>(ptr);
 			if (cad)
 			{
-				for (uint32 i = first; i != this->topology_.end(); this->topology_.next(i))
+				parallel_foreach_index(first, this->topology_.end(), [&] (uint32 i)
 				{
+					if (!this->topology_.used(i))
+						return;
 					Dart& d = (*cad)[i];
 					uint32 idx = d.index;
 					if (old_new_topo[idx] != INVALID_INDEX)
 						d = Dart(old_new_topo[idx]);
-				}
+				});
 			}
 		}
 
@@ -1565,25 +1693,30 @@ public:
 			{
 				if (map.embeddings_[i] == nullptr) // set embedding to INVALID for further easy detection
 				{
-					for (uint32 j = first; j != this->topology_.end(); this->topology_.next(j))
+					parallel_foreach_index(first, this->topology_.end(), [&] (uint32 j)
+					{
 						(*emb)[j] = INVALID_INDEX;
+					});
 				}
 				else
 				{
 					std::vector<uint32> old_new = this->attributes_[i].template merge<1>(map.attributes_[i]);
-					for (uint32 j = first; j != this->topology_.end(); this->topology_.next(j))
+					parallel_foreach_index(first, this->topology_.end(), [&] (uint32 j)
 					{
 						uint32& e = (*emb)[j];
-						if (e != INVALID_INDEX)
+						if (e != INVALID_INDEX && e < old_new.size())
 						{
 							if (old_new[e] != INVALID_INDEX)
 								e = old_new[e];
 						}
-					}
+					});
 				}
 			}
 		}
 
+		for (uint32 j = first; j != this->topology_.end(); this->topology_.next(j))
+			this->notify_dart_changed(Dart(j));
+
 		// embed remaining cells
 		concrete->merge_finish_embedding(first);
 
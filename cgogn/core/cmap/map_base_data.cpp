@@ -34,7 +34,11 @@ const std::array<uint32, 12> MapBaseData::tetra_phi2 = {3,5,7,uint32(-3),7,2,uin
 // hexa_phi2 = {4,7,10,13, -4,14,17,2, -7,-2,12,2, -10,-2,7,2, -13,-2,2,-14, -2,-7,-12,-17}
 const std::array<uint32, 24> MapBaseData::hexa_phi2 = {4,7,10,13, uint32(-4),14,17,2, uint32(-7),uint32(-2),12,2, uint32(-10),uint32(-2),7,2, uint32(-13),uint32(-2),2,uint32(-14), uint32(-2),uint32(-7),uint32(-12),uint32(-17)};
 
-MapBaseData::MapBaseData()
+MapObserver::~MapObserver()
+{}
+
+MapBaseData::MapBaseData() :
+	topology_version_(0u)
 {
 	if (instances_ == nullptr)
 	{
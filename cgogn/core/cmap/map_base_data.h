@@ -56,6 +56,31 @@ class AttributeGen;
 template <typename T> class Attribute_T;
 template <typename T, Orbit ORBIT> class Attribute;
 
+/**
+ * @brief The MapObserver class
+ * A MapObserver registered on a map (add_observer) is notified of each modification of the topology.
+ * Notifications are sent during the topological operations : the map may be in a transitory state
+ * so observers should only record the given darts and process them afterwards.
+ */
+class CGOGN_CORE_API MapObserver
+{
+public:
+
+	inline MapObserver() {}
+	CGOGN_NOT_COPYABLE_NOR_MOVABLE(MapObserver);
+	virtual ~MapObserver();
+
+	/**
+	 * @brief the dart d has been added, removed or one of its phi relations has changed
+	 */
+	virtual void dart_changed(Dart d) = 0;
+
+	/**
+	 * @brief the whole topology has changed (cleared, compacted or merged)
+	 */
+	virtual void topology_reset() = 0;
+};
+
 /**
  * @brief The MapBaseData class
  */
@@ -100,6 +125,12 @@ protected:
 	std::array<std::vector<std::vector<ChunkArrayBool*>>, NB_ORBITS> mark_attributes_;
 	std::array<std::mutex, NB_ORBITS> mark_attributes_mutex_;
 
+	// observers of the topological modifications
+	mutable std::vector<MapObserver*> observers_;
+
+	// incremented at each topological modification
+	uint64 topology_version_;
+
 	// vector of Map instances
 	static std::vector<const MapBaseData*>* instances_;
 
@@ -142,8 +173,54 @@ public:
 		return topology_;
 	}
 
+	/*******************************************************************************
+	 * Topology observers management
+	 *******************************************************************************/
+
+	/**
+	 * @brief register an observer of the topological modifications
+	 * (const : observing a map does not modify it)
+	 */
+	inline void add_observer(MapObserver* o) const
+	{
+		if (std::find(observers_.begin(), observers_.end(), o) == observers_.end())
+			observers_.push_back(o);
+	}
+
+	inline void remove_observer(MapObserver* o) const
+	{
+		auto it = std::find(observers_.begin(), observers_.end(), o);
+		if (it != observers_.end())
+		{
+			*it = observers_.back();
+			observers_.pop_back();
+		}
+	}
+
+	/**
+	 * @brief the version of the topology, incremented at each topological modification
+	 */
+	inline uint64 topology_version() const
+	{
+		return topology_version_;
+	}
+
 protected:
 
+	inline void notify_dart_changed(Dart d)
+	{
+		++topology_version_;
+		for (MapObserver* o : observers_)
+			o->dart_changed(d);
+	}
+
+	inline void notify_topology_reset()
+	{
+		++topology_version_;
+		for (MapObserver* o : observers_)
+			o->topology_reset();
+	}
+
 	template <Orbit ORBIT>
 	inline ChunkArrayContainer<uint32>& non_const_attribute_container()
 	{
@@ -0,0 +1,143 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef CGOGN_CORE_CMAP_TETRA_LINK_H_
+#define CGOGN_CORE_CMAP_TETRA_LINK_H_
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include <cgogn/core/utils/definitions.h>
+#include <cgogn/core/basic/dart.h>
+
+namespace cgogn
+{
+
+/**
+ * @brief compute the triangles of the link of a vertex of a 3-map whose incident volumes are tetrahedra
+ * @param map the map (its vertices have to be embedded)
+ * @param v the vertex
+ * @param triangles the sorted vertex embeddings of the faces opposite to v in its incident tetrahedra
+ */
+template <typename MAP>
+void tetra_link_triangles(const MAP& map, typename MAP::Vertex v, std::vector<std::array<uint32, 3>>& triangles)
+{
+	using Vertex = typename MAP::Vertex;
+
+	map.foreach_dart_of_orbit(v, [&] (Dart d)
+	{
+		if (map.is_boundary(d))
+			return;
+		std::array<uint32, 3> t = {{
+			map.embedding(Vertex(map.phi1(d))),
+			map.embedding(Vertex(map.phi_1(d))),
+			map.embedding(Vertex(map.phi_1(map.phi2(d))))
+		}};
+		std::sort(t.begin(), t.end());
+		triangles.push_back(t);
+	});
+	std::sort(triangles.begin(), triangles.end());
+	triangles.erase(std::unique(triangles.begin(), triangles.end()), triangles.end());
+}
+
+/**
+ * @brief check the link condition of the edge of d in a 3-map
+ * @param map the map (its vertices have to be embedded)
+ * @param d a dart of the edge, the volumes incident to both its vertices have to be tetrahedra
+ * The vertices, edges and triangles shared by the links of both vertices of the edge
+ * are exactly the vertices and edges of the link of the edge (the ring of the vertices opposite to the edge).
+ */
+template <typename MAP>
+bool tetra_link_condition(const MAP& map, Dart d)
+{
+	using Vertex = typename MAP::Vertex;
+	using Triangle = std::array<uint32, 3>;
+	using Segment = std::pair<uint32, uint32>;
+
+	std::vector<Triangle> ta;
+	std::vector<Triangle> tb;
+	tetra_link_triangles(map, Vertex(d), ta);
+	tetra_link_triangles(map, Vertex(map.phi1(d)), tb);
+
+	const uint32 a = map.embedding(Vertex(d));
+	const uint32 b = map.embedding(Vertex(map.phi1(d)));
+	auto contains = [&] (const Triangle& t) { return t[0] == a || t[1] == a || t[2] == a || t[0] == b || t[1] == b || t[2] == b; };
+
+	std::vector<Triangle> common_triangles;
+	std::set_intersection(ta.begin(), ta.end(), tb.begin(), tb.end(), std::back_inserter(common_triangles));
+	for (const Triangle& t : common_triangles)
+	{
+		if (!contains(t))
+			return false;
+	}
+
+	// vertices and edges of the links of a and b that are not incident to a or b
+	auto reduce = [&] (const std::vector<Triangle>& triangles, std::vector<uint32>& verts, std::vector<Segment>& segments)
+	{
+		for (const Triangle& t : triangles)
+		{
+			for (uint32 i = 0u; i < 3u; ++i)
+			{
+				const uint32 p = t[i];
+				const uint32 q = t[(i + 1u) % 3u];
+				if (p != a && p != b)
+					verts.push_back(p);
+				if (p != a && p != b && q != a && q != b)
+					segments.push_back(std::make_pair(std::min(p, q), std::max(p, q)));
+			}
+		}
+		std::sort(verts.begin(), verts.end());
+		verts.erase(std::unique(verts.begin(), verts.end()), verts.end());
+		std::sort(segments.begin(), segments.end());
+		segments.erase(std::unique(segments.begin(), segments.end()), segments.end());
+	};
+
+	std::vector<uint32> va, vb, common_vertices;
+	std::vector<Segment> sa, sb, common_segments;
+	reduce(ta, va, sa);
+	reduce(tb, vb, sb);
+	std::set_intersection(va.begin(), va.end(), vb.begin(), vb.end(), std::back_inserter(common_vertices));
+	std::set_intersection(sa.begin(), sa.end(), sb.begin(), sb.end(), std::back_inserter(common_segments));
+
+	// the link of the edge: one vertex and one edge per incident tetrahedron
+	std::vector<uint32> ring;
+	uint32 nb_tetra = 0u;
+	Dart it = d;
+	do
+	{
+		ring.push_back(map.embedding(Vertex(map.phi_1(it))));
+		++nb_tetra;
+		it = map.phi3(map.phi2(it));
+	} while (it != d);
+	std::sort(ring.begin(), ring.end());
+	ring.erase(std::unique(ring.begin(), ring.end()), ring.end());
+
+	return ring.size() == nb_tetra && common_vertices.size() == nb_tetra && common_segments.size() == nb_tetra;
+}
+
+} // namespace cgogn
+
+#endif // CGOGN_CORE_CMAP_TETRA_LINK_H_
@@ -40,6 +40,7 @@
 #include <cgogn/core/utils/unique_ptr.h>
 #include <cgogn/core/utils/thread_pool.h>
 #include <cgogn/core/utils/buffers.h>
+#include <cgogn/core/utils/parallel_foreach_element.h>
 
 #include <cgogn/core/container/chunk_array.h>
 #include <cgogn/core/container/chunk_stack.h>
@@ -633,6 +634,8 @@ public:
 		uint32 up = rbegin();
 		uint32 down = std::numeric_limits<uint32>::max();
 		std::vector<uint32> map_old_new(up+1, std::numeric_limits<uint32>::max());
+		// lines moved from the end of the container to the holes (the moves do not depend on each other)
+		std::vector<uint32> moved_lines;
 		do
 		{
 			down = holes_stack_.head();
@@ -641,12 +644,27 @@ public:
 				{
 					const uint32 rdown = down + PRIM_SIZE - 1u - i;
 					map_old_new[up] = rdown;
-					move_line(rdown, up,true,true);
+					moved_lines.push_back(up);
 					rnext(up);
 				}
 			holes_stack_.pop();
 		} while (!holes_stack_.empty());
 
+		cgogn::parallel_foreach_index(0u, uint32(moved_lines.size()), [&] (uint32 k)
+		{
+			const uint32 src = moved_lines[k];
+			const uint32 dst = map_old_new[src];
+			for (auto ptr : table_arrays_)
+				ptr->move_element(dst, src);
+			refs_[dst] = refs_[src];
+		});
+		// markers are bit fields: copied sequentially
+		for (uint32 src : moved_lines)
+		{
+			for (auto ptr : table_marker_arrays_)
+				ptr->copy_element(map_old_new[src], src);
+		}
+
 		// free unused memory blocks
 		const uint32 old_nb_blocks = this->nb_max_lines_/CHUNK_SIZE + 1u;
 		nb_max_lines_ = nb_used_lines_;
@@ -717,8 +735,10 @@ public:
 
 		// line mapping
 		std::vector<uint32> map_old_new(cac.rbegin() + 1u, std::numeric_limits<uint32>::max());
+		std::vector<uint32> copied_lines;
+		copied_lines.reserve(cac.size());
 
-		// copy data
+		// allocate lines (sequential: uses the holes stack)
 		for (uint32 it = cac.begin(); it != cac.end(); cac.next(it))
 		{
 			uint32 new_lines = this->insert_lines<PRIM_SIZE>();
@@ -727,15 +747,23 @@ public:
 				uint32 ol = it+j;
 				uint32 nl = new_lines+j;
 				init_markers_of_line(nl); // raz markers of new lines
-				refs_[nl]= cac.refs_[ol]; // copy nb refs counter
 				map_old_new[ol] = nl;
-				uint32 nb_att = uint32(cac.table_arrays_.size());
-				for (uint32 k=0; k<nb_att; ++k)
-					table_arrays_[map_attrib[k]]->copy_external_element(nl, cac.table_arrays_[k], ol);
+				copied_lines.push_back(ol);
 			}
 			it += PRIM_SIZE-1u;
 		}
 
+		// copy data
+		const uint32 nb_att = uint32(cac.table_arrays_.size());
+		cgogn::parallel_foreach_index(0u, uint32(copied_lines.size()), [&] (uint32 i)
+		{
+			const uint32 ol = copied_lines[i];
+			const uint32 nl = map_old_new[ol];
+			refs_[nl]= cac.refs_[ol]; // copy nb refs counter
+			for (uint32 k=0; k<nb_att; ++k)
+				table_arrays_[map_attrib[k]]->copy_external_element(nl, cac.table_arrays_[k], ol);
+		});
+
 		return map_old_new;
 	}
 
@@ -804,6 +832,43 @@ public:
 		return index;
 	}
 
+	/**
+	* @brief insert nb groups of PRIM_SIZE consecutive lines at the end of the container
+	* The holes are not reused so that all the inserted lines are contiguous
+	* and the chunks are allocated only once.
+	* @param nb number of groups to insert
+	* @return index of the first line of the first group
+	*/
+	template <uint32 PRIM_SIZE>
+	uint32 insert_lines(uint32 nb)
+	{
+		static_assert(PRIM_SIZE < CHUNK_SIZE, "Cannot insert lines in a container if PRIM_SIZE < CHUNK_SIZE");
+
+		const uint32 index = nb_max_lines_;
+		if (nb == 0u)
+			return index;
+
+		nb_max_lines_ += nb * PRIM_SIZE;
+
+		const uint32 nb_chunks = nb_max_lines_ / CHUNK_SIZE + 1u;
+		if (refs_.nb_chunks() < nb_chunks)
+		{
+			for (auto arr : table_arrays_)
+				arr->set_nb_chunks(nb_chunks);
+			for (auto arr : table_marker_arrays_)
+				arr->set_nb_chunks(nb_chunks);
+			refs_.set_nb_chunks(nb_chunks);
+		}
+
+		// mark lines as used
+		for (uint32 i = index; i < nb_max_lines_; ++i)
+			refs_.set_value(i, 1u); // do not use [] in case of refs_ is bool
+
+		nb_used_lines_ += nb * PRIM_SIZE;
+
+		return index;
+	}
+
 	/**
 	* @brief remove a group of PRIM_SIZE lines in the container
 	* @param index index of one line of group to remove
@@ -891,6 +956,16 @@ public:
 		refs_[index]++;
 	}
 
+	/**
+	* @brief increment the reference counter of the given line by nb (only for PRIM_SIZE==1)
+	* @param index index of the line
+	* @param nb number of references to add
+	*/
+	void ref_line(uint32 index, T_REF nb)
+	{
+		refs_[index] += nb;
+	}
+
 	/**
 	* @brief decrement the reference counter of the given line (only for PRIM_SIZE==1)
 	* @param index index of the line
@@ -0,0 +1,86 @@
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <cgogn/core/utils/logger.h>
+#include <cgogn/core/cmap/cmap2_tri.h>
+
+using namespace cgogn::numerics;
+
+using Map2 = cgogn::CMap2Tri;
+using Vertex = Map2::Vertex;
+
+using TimePoint = std::chrono::time_point<std::chrono::system_clock>;
+
+static float64 elapsed(const TimePoint& start)
+{
+	std::chrono::duration<float64> d = std::chrono::system_clock::now() - start;
+	return d.count();
+}
+
+// closed triangulated n x n torus
+static void build_torus(Map2& map, uint32 n)
+{
+	std::vector<uint32> triangles;
+	triangles.reserve(6u * n * n);
+	for (uint32 j = 0u; j < n; ++j)
+	{
+		for (uint32 i = 0u; i < n; ++i)
+		{
+			const uint32 v00 = j * n + i;
+			const uint32 v10 = j * n + (i + 1u) % n;
+			const uint32 v01 = ((j + 1u) % n) * n + i;
+			const uint32 v11 = ((j + 1u) % n) * n + (i + 1u) % n;
+			triangles.insert(triangles.end(), { v00, v10, v11, v00, v11, v01 });
+		}
+	}
+	Map2::Builder builder(map);
+	builder.create_faces_from_indices(triangles, n * n);
+}
+
+int main(int argc, char** argv)
+{
+	uint32 n = 1000u;
+	if (argc < 2)
+		cgogn_log_info("bench_map") << "USAGE: " << argv[0] << " [torus_size] (using " << n << ")";
+	else
+		n = std::max(2u, uint32(std::stoi(argv[1])));
+
+	// two tori in the same map, the first one is removed to make holes in the containers
+	Map2 map;
+	map.add_attribute<float32, Vertex>("value");
+	build_torus(map, n);
+	build_torus(map, n);
+	cgogn_log_info("bench_map") << map.nb_darts() << " darts";
+
+	TimePoint start = std::chrono::system_clock::now();
+	bool valid = map.check_map_integrity();
+	cgogn_log_info("bench_map") << "check_map_integrity (" << std::boolalpha << valid << "): " << elapsed(start) << "s";
+
+	// (the vertex lines are released with their last dart)
+	Map2::Builder builder(map);
+	for (uint32 f = 0u; f < 2u * n * n; ++f)
+		builder.remove_face_topo_fp(cgogn::Dart(3u * f));
+	cgogn_log_info("bench_map") << "fragmentation: " << map.topology_container().fragmentation();
+
+	start = std::chrono::system_clock::now();
+	map.compact();
+	cgogn_log_info("bench_map") << "compact: " << elapsed(start) << "s";
+
+	Map2 other;
+	other.add_attribute<float32, Vertex>("value");
+	build_torus(other, n);
+
+	start = std::chrono::system_clock::now();
+	Map2::DartMarker dm(map);
+	map.merge(other, dm);
+	cgogn_log_info("bench_map") << "merge: " << elapsed(start) << "s";
+
+	start = std::chrono::system_clock::now();
+	valid = map.check_map_integrity();
+	cgogn_log_info("bench_map") << "check_map_integrity (" << std::boolalpha << valid << "): " << elapsed(start) << "s";
+
+	return 0;
+}
@@ -83,6 +83,7 @@ public:
 	using CellCache = typename cgogn::CellCache<Self>;
 	using QuickTraversor = typename cgogn::QuickTraversor<Self>;
 	using BoundaryCache = typename cgogn::BoundaryCache<Self>;
+	using ChangeTracker = typename cgogn::ChangeTracker<Self>;
 
 protected:
 
@@ -146,6 +147,8 @@ protected:
 	{
 		(*alpha0_)[d.index] = e;
 		(*alpha0_)[e.index] = d;
+		this->notify_dart_changed(d);
+		this->notify_dart_changed(e);
 	}
 
 	inline void alpha0_unsew(Dart d)
@@ -153,6 +156,8 @@ protected:
 		Dart e = alpha0(d);
 		(*alpha0_)[d.index] = d;
 		(*alpha0_)[e.index] = e;
+		this->notify_dart_changed(d);
+		this->notify_dart_changed(e);
 	}
 
 	/* alpha1 is a permutation */
@@ -164,6 +169,10 @@ protected:
 		(*alpha1_)[e.index] = f;
 		(*alpha_1_)[g.index] = d;
 		(*alpha_1_)[f.index] = e;
+		this->notify_dart_changed(d);
+		this->notify_dart_changed(e);
+		this->notify_dart_changed(f);
+		this->notify_dart_changed(g);
 	}
 
 	inline void alpha1_unsew(Dart d)
@@ -174,6 +183,9 @@ protected:
 		(*alpha1_)[d.index] = d;
 		(*alpha_1_)[e.index] = f;
 		(*alpha_1_)[d.index] = d;
+		this->notify_dart_changed(d);
+		this->notify_dart_changed(e);
+		this->notify_dart_changed(f);
 	}
 
 public:
@@ -21,6 +21,8 @@
 *                                                                              *
 *******************************************************************************/
 
+#include <algorithm>
+
 #include <gtest/gtest.h>
 
 #include <cgogn/core/cmap/cmap2.h>
@@ -252,6 +254,57 @@ TEST_F(CMap2Test, cut_face)
 	EXPECT_TRUE(cmap_.check_map_integrity());
 }
 
+/**
+ * \brief Cutting a set of edges at once preserves the cell indexation
+ */
+TEST_F(CMap2Test, cut_edges)
+{
+	add_closed_surfaces();
+
+	std::vector<Edge> edges;
+	cmap_.foreach_cell([&] (Edge e) { edges.push_back(e); });
+	const uint32 nb_vertices = cmap_.nb_cells<Vertex::ORBIT>();
+	const uint32 nb_edges = cmap_.nb_cells<Edge::ORBIT>();
+
+	std::vector<Vertex> vertices = cmap_.cut_edges(edges);
+
+	EXPECT_EQ(uint32(vertices.size()), uint32(edges.size()));
+	EXPECT_EQ(cmap_.nb_cells<Vertex::ORBIT>(), nb_vertices + nb_edges);
+	EXPECT_EQ(cmap_.nb_cells<Edge::ORBIT>(), 2u * nb_edges);
+	for (Vertex v : vertices)
+		EXPECT_EQ(cmap_.degree(v), 2u);
+	EXPECT_TRUE(cmap_.check_map_integrity());
+}
+
+/**
+ * \brief Cutting a set of faces at once preserves the cell indexation
+ */
+TEST_F(CMap2Test, cut_faces)
+{
+	add_closed_surfaces();
+
+	std::vector<std::pair<Dart, Dart>> cuts;
+	for (Dart d : darts_)
+	{
+		if (cmap_.codegree(Face(d)) > 1u)
+		{
+			Dart e = d; // find a second dart in the face of d (distinct from d)
+			uint32 i = std::rand() % 10u;
+			while (i-- > 0u) e = cmap_.phi1(e);
+			if (e == d) e = cmap_.phi1(e);
+
+			cuts.push_back(std::make_pair(d, e));
+		}
+	}
+	const uint32 nb_faces = cmap_.nb_cells<Face::ORBIT>();
+
+	std::vector<Edge> edges = cmap_.cut_faces(cuts);
+
+	EXPECT_EQ(uint32(edges.size()), uint32(cuts.size()));
+	EXPECT_EQ(cmap_.nb_cells<Face::ORBIT>(), nb_faces + uint32(cuts.size()));
+	EXPECT_TRUE(cmap_.check_map_integrity());
+}
+
 /**
  * \brief Merging faces preserves the cell indexation
  */
@@ -425,6 +478,65 @@ TEST_F(CMap2Test, merge_map)
 	EXPECT_EQ(map1.nb_cells<Volume::ORBIT>(),10u);
 }
 
+/**
+ * \brief Tracked caches and traversors stay consistent with the map after topological operations
+ */
+TEST_F(CMap2Test, tracked_cell_cache)
+{
+	add_closed_surfaces();
+
+	CMap2::CellCache cache(cmap_);
+	cache.build<Vertex>();
+	cache.build<Face>();
+	cache.track_changes();
+	CMap2::QuickTraversor qt(cmap_);
+	qt.build<Vertex>();
+	qt.track_changes();
+	CMap2::ChangeTracker tracker(cmap_);
+	const uint64 version = tracker.version();
+
+	for (Dart d : darts_)
+		cmap_.cut_edge(Edge(d));
+	for (Dart d : darts_)
+	{
+		if (cmap_.codegree(Face(d)) > 3u)
+			cmap_.cut_face(d, cmap_.phi1(cmap_.phi1(d)));
+	}
+
+	cache.update();
+	qt.update();
+
+	auto check_cache = [&] (const CMap2::CellCache& c)
+	{
+		std::vector<uint32> cached;
+		std::vector<uint32> expected;
+		for (auto it = c.begin<Vertex>(); it != c.end<Vertex>(); ++it)
+			cached.push_back(cmap_.embedding(Vertex(*it)));
+		cmap_.foreach_cell([&] (Vertex v) { expected.push_back(cmap_.embedding(v)); });
+		std::sort(cached.begin(), cached.end());
+		std::sort(expected.begin(), expected.end());
+		EXPECT_EQ(cached, expected);
+		EXPECT_EQ(c.size<Face>(), std::size_t(cmap_.nb_cells<Face::ORBIT>()));
+	};
+	check_cache(cache);
+
+	cmap_.foreach_cell([&] (Vertex v)
+	{
+		EXPECT_EQ(cmap_.embedding(Vertex(qt.cell_from_index<Vertex>(cmap_.embedding(v)).dart)), cmap_.embedding(v));
+	});
+
+	std::vector<Vertex> changed;
+	tracker.changed_cells(version, changed);
+	EXPECT_GT(changed.size(), 0u);
+	EXPECT_LT(changed.size(), std::size_t(cmap_.nb_cells<Vertex::ORBIT>()));
+	tracker.changed_cells(tracker.version(), changed);
+	EXPECT_EQ(changed.size(), 0u);
+
+	cmap_.compact();
+	cache.update();
+	check_cache(cache);
+}
+
 #undef NB_MAX
 
 } // namespace cgogn
@@ -152,4 +152,25 @@ TEST_F(CMap2QuadTest, extrude_quad)
 
 
 
+TEST_F(CMap2QuadTest, create_faces_from_indices)
+{
+	MapBuilder builder(cmap_);
+
+	// closed cube
+	std::vector<uint32> cube = { 0,3,2,1, 4,5,6,7, 0,1,5,4, 1,2,6,5, 2,3,7,6, 3,0,4,7 };
+	uint32 first = builder.create_faces_from_indices(cube, 8u);
+
+	EXPECT_EQ(first, 0u);
+	EXPECT_TRUE(cmap_.check_map_integrity());
+	EXPECT_EQ(cmap_.nb_cells<Vertex::ORBIT>(), 8u);
+	EXPECT_EQ(cmap_.nb_cells<Edge::ORBIT>(), 12u);
+	EXPECT_EQ(cmap_.nb_cells<Face::ORBIT>(), 6u);
+	EXPECT_EQ(cmap_.nb_darts(), 24u);
+
+	cmap_.foreach_cell([&] (Vertex v)
+	{
+		EXPECT_EQ(cmap_.degree(v), 3u);
+	});
+}
+
 } // namespace cgogn
@@ -263,4 +263,34 @@ TEST_F(CMap2TriTest, add_tetra)
 	});
 }
 
+TEST_F(CMap2TriTest, create_faces_from_indices)
+{
+	MapBuilder builder(cmap_);
+
+	// closed tetrahedron
+	std::vector<uint32> tetra = { 0,2,1, 0,1,3, 1,2,3, 0,3,2 };
+	uint32 first = builder.create_faces_from_indices(tetra, 4u);
+
+	EXPECT_EQ(first, 0u);
+	EXPECT_TRUE(cmap_.check_map_integrity());
+	EXPECT_EQ(cmap_.nb_cells<Vertex::ORBIT>(), 4u);
+	EXPECT_EQ(cmap_.nb_cells<Edge::ORBIT>(), 6u);
+	EXPECT_EQ(cmap_.nb_cells<Face::ORBIT>(), 4u);
+	EXPECT_EQ(cmap_.nb_darts(), 12u);
+
+	cmap_.foreach_cell([&] (Vertex v)
+	{
+		EXPECT_EQ(cmap_.degree(v), 3u);
+	});
+
+	// open square (2 triangles) added to the same map
+	std::vector<uint32> square = { 0,1,2, 0,2,3 };
+	first = builder.create_faces_from_indices(square, 4u);
+
+	EXPECT_EQ(first, 4u);
+	EXPECT_EQ(cmap_.nb_cells<Vertex::ORBIT>(), 8u);
+	EXPECT_EQ(cmap_.nb_cells<Face::ORBIT>(), 6u);
+	EXPECT_EQ(cmap_.nb_darts(), 30u); // 12 + 6 + 4 boundary triangles
+}
+
 } // namespace cgogn
@@ -21,6 +21,9 @@
 *                                                                              *
 *******************************************************************************/
 
+#include <array>
+#include <map>
+
 #include <gtest/gtest.h>
 
 #include <cgogn/core/cmap/cmap3.h>
@@ -140,6 +143,54 @@ TEST_F(CMap3Test, cut_face)
 	EXPECT_TRUE(cmap_.check_map_integrity());
 }
 
+/**
+ * @brief Cutting a set of edges and faces at once preserves the cell indexation
+ */
+TEST_F(CMap3Test, cut_edges_and_faces)
+{
+	MapBuilder mbuild(cmap_);
+
+	Dart p1 = mbuild.add_prism_topo_fp(3u);
+	Dart p2 = mbuild.add_prism_topo_fp(3u);
+	mbuild.sew_volumes_fp(p1, p2);
+
+	Dart p3 = mbuild.add_pyramid_topo_fp(4u);
+	Dart p4 = mbuild.add_pyramid_topo_fp(4u);
+	mbuild.sew_volumes_fp(p3, p4);
+
+	mbuild.close_map();
+
+	cmap_.add_attribute<int32, CDart>("darts");
+	cmap_.add_attribute<int32, Vertex2>("vertices2");
+	cmap_.add_attribute<int32, Vertex>("vertices");
+	cmap_.add_attribute<int32, Edge2>("edges2");
+	cmap_.add_attribute<int32, Edge>("edges");
+	cmap_.add_attribute<int32, Face2>("faces2");
+	cmap_.add_attribute<int32, Face>("faces");
+	cmap_.add_attribute<int32, Volume>("volumes");
+
+	std::vector<Edge> edges;
+	cmap_.foreach_cell([&] (Edge e) { edges.push_back(e); });
+	const uint32 nb_vertices = cmap_.nb_cells<Vertex::ORBIT>();
+	const uint32 nb_edges = cmap_.nb_cells<Edge::ORBIT>();
+
+	cmap_.cut_edges(edges);
+
+	EXPECT_EQ(cmap_.nb_cells<Vertex::ORBIT>(), nb_vertices + nb_edges);
+	EXPECT_EQ(cmap_.nb_cells<Edge::ORBIT>(), 2u * nb_edges);
+	EXPECT_TRUE(cmap_.check_map_integrity());
+
+	const uint32 nb_faces = cmap_.nb_cells<Face::ORBIT>();
+
+	cmap_.cut_faces({
+		std::make_pair(cmap_.phi2(p1), cmap_.phi<1111>(cmap_.phi2(p1))),
+		std::make_pair(p3, cmap_.phi<1111>(p3))
+	});
+
+	EXPECT_EQ(cmap_.nb_cells<Face::ORBIT>(), nb_faces + 2u);
+	EXPECT_TRUE(cmap_.check_map_integrity());
+}
+
 /**
  * @brief Cutting volumes preserves the cell indexation
  */
@@ -348,6 +399,129 @@ TEST_F(CMap3Test, merge_map2)
 	EXPECT_EQ(cmap_.nb_cells<Face::ORBIT>(), 30u);
 }
 
+/**
+ * \brief build 3 x 3 x 3 cubes, each one cut into 6 tetrahedra around its diagonal
+ */
+static void tetra_grid(CMap3& map)
+{
+	const uint32 n = 3u;
+	auto id = [&] (uint32 i, uint32 j, uint32 k) { return (k * (n + 1u) + j) * (n + 1u) + i; };
+	const uint32 paths[6][3] = { {0u,1u,2u}, {1u,2u,0u}, {2u,0u,1u}, {0u,2u,1u}, {2u,1u,0u}, {1u,0u,2u} };
+
+	CMap3::Builder mbuild(map);
+	std::vector<uint32> dart_vertex;
+	for (uint32 k = 0u; k < n; ++k)
+		for (uint32 j = 0u; j < n; ++j)
+			for (uint32 i = 0u; i < n; ++i)
+				for (uint32 p = 0u; p < 6u; ++p)
+				{
+					uint32 c[3] = { i, j, k };
+					uint32 v[4];
+					v[0] = id(c[0], c[1], c[2]);
+					for (uint32 s = 0u; s < 3u; ++s)
+					{
+						++c[paths[p][s]];
+						v[s + 1u] = id(c[0], c[1], c[2]);
+					}
+					if (p >= 3u)
+						std::swap(v[1], v[2]);
+
+					const Dart d = mbuild.add_pyramid_topo_fp(3u);
+					const Dart vd[4] = { d, map.phi1(d), map.phi_1(d), map.phi_1(map.phi2(map.phi_1(d))) };
+					for (uint32 l = 0u; l < 4u; ++l)
+					{
+						Dart it = vd[l];
+						do
+						{
+							dart_vertex.resize(std::max(std::size_t(it.index + 1u), dart_vertex.size()));
+							dart_vertex[it.index] = v[l];
+							it = map.phi1(map.phi2(it));
+						} while (it != vd[l]);
+					}
+				}
+
+	// the dart a -> b of face (a,b,c) is sewn with the dart b -> a of face (b,a,c)
+	std::map<std::array<uint32, 3>, Dart> darts;
+	map.foreach_dart([&] (Dart d) { darts[{{ dart_vertex[d.index], dart_vertex[map.phi1(d).index], dart_vertex[map.phi_1(d).index] }}] = d; });
+	map.foreach_dart([&] (Dart d)
+	{
+		auto it = darts.find({{ dart_vertex[map.phi1(d).index], dart_vertex[d.index], dart_vertex[map.phi_1(d).index] }});
+		if (it != darts.end() && map.phi3(d) == d)
+			mbuild.phi3_sew(d, it->second);
+	});
+	mbuild.close_map();
+
+	mbuild.create_embedding<CMap3::Vertex::ORBIT>();
+	std::vector<bool> embedded((n + 1u) * (n + 1u) * (n + 1u), false);
+	map.foreach_dart([&] (Dart d)
+	{
+		if (!map.is_boundary(d) && !embedded[dart_vertex[d.index]])
+		{
+			mbuild.new_orbit_embedding(CMap3::Vertex(d));
+			embedded[dart_vertex[d.index]] = true;
+		}
+	});
+}
+
+/**
+ * @brief Collapsing edges preserves the topology and the cell indexation
+ */
+TEST_F(CMap3Test, collapse_edge)
+{
+	tetra_grid(cmap_);
+	cmap_.add_attribute<int32, Edge>("edges");
+	cmap_.add_attribute<int32, Face>("faces");
+	cmap_.add_attribute<int32, Volume>("volumes");
+	EXPECT_TRUE(cmap_.check_map_integrity());
+	EXPECT_EQ(cmap_.nb_cells<Vertex::ORBIT>(), 64u);
+
+	uint32 nb_boundary = 0u;
+	cmap_.foreach_cell([&] (Vertex v)
+	{
+		if (cmap_.is_incident_to_boundary(v))
+		{
+			++nb_boundary;
+			// the boundary edges are not collapsible
+			cmap_.foreach_incident_edge(v, [&] (Edge e)
+			{
+				if (cmap_.is_incident_to_boundary(e))
+				{
+					EXPECT_FALSE(cmap_.edge_can_collapse(e));
+				}
+			});
+		}
+	});
+	EXPECT_EQ(nb_boundary, 56u);
+
+	// collapse edges until none is collapsible
+	uint32 nb_collapses = 0u;
+	Edge e;
+	do
+	{
+		e = Edge();
+		cmap_.foreach_cell([&] (Edge ce) -> bool
+		{
+			if (cmap_.edge_can_collapse(ce))
+				e = ce;
+			return !e.is_valid();
+		});
+		if (e.is_valid())
+		{
+			cmap_.collapse_edge(e);
+			++nb_collapses;
+			EXPECT_TRUE(cmap_.check_map_integrity());
+		}
+	} while (e.is_valid());
+
+	// the 8 interior vertices are removed, the boundary is unchanged
+	EXPECT_EQ(nb_collapses, 8u);
+	EXPECT_EQ(cmap_.nb_cells<Vertex::ORBIT>(), 56u);
+	const int32 euler = int32(cmap_.nb_cells<Vertex::ORBIT>()) - int32(cmap_.nb_cells<Edge::ORBIT>())
+		+ int32(cmap_.nb_cells<Face::ORBIT>()) - int32(cmap_.nb_cells<Volume::ORBIT>());
+	EXPECT_EQ(euler, 1);
+	cmap_.foreach_cell([&] (Vertex v) { EXPECT_TRUE(cmap_.is_incident_to_boundary(v)); });
+}
+
 #undef NB_MAX
 
 } // namespace cgogn
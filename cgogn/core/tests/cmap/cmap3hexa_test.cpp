@@ -208,4 +208,26 @@ TEST_F(CMap3HexaTest, embedded)
 }
 
 
+TEST_F(CMap3HexaTest, create_volumes_from_indices)
+{
+	MapBuilder mbuild(cmap_);
+
+	// two hexahedra sharing the face (0,1,2,3)
+	std::vector<uint32> hexas = { 0,1,2,3,4,5,6,7, 1,0,3,2,8,9,10,11 };
+	uint32 first = mbuild.create_volumes_from_indices(hexas, 12u);
+
+	EXPECT_EQ(first, 0u);
+	uint32 nb_sewed = 0u;
+	for (uint32 i = 0u; i < 24u; ++i)
+	{
+		if (!cmap_.is_boundary(cmap_.phi3(Dart(i))))
+			++nb_sewed;
+	}
+	EXPECT_EQ(nb_sewed, 4u);
+	EXPECT_EQ(cmap_.nb_cells<Vertex::ORBIT>(), 12u);
+	EXPECT_EQ(cmap_.nb_cells<Edge::ORBIT>(), 20u);
+	EXPECT_EQ(cmap_.nb_cells<Face::ORBIT>(), 11u);
+	EXPECT_EQ(cmap_.nb_cells<Volume::ORBIT>(), 2u);
+}
+
 } // namespace cgogn
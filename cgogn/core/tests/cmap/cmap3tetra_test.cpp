@@ -201,4 +201,91 @@ TEST_F(CMap3TetraTest, embedded)
 	EXPECT_EQ(nb,4);
 }
 
+TEST_F(CMap3TetraTest, create_volumes_from_indices)
+{
+	MapBuilder mbuild(cmap_);
+
+	// two tetrahedra sharing the face (0,1,2)
+	std::vector<uint32> tetras = { 0,1,2,3, 1,0,2,4 };
+	uint32 first = mbuild.create_volumes_from_indices(tetras, 5u);
+
+	EXPECT_EQ(first, 0u);
+	uint32 nb_sewed = 0u;
+	for (uint32 i = 0u; i < 12u; ++i)
+	{
+		if (!cmap_.is_boundary(cmap_.phi3(Dart(i))))
+			++nb_sewed;
+	}
+	EXPECT_EQ(nb_sewed, 3u);
+	EXPECT_EQ(cmap_.nb_cells<Vertex::ORBIT>(), 5u);
+	EXPECT_EQ(cmap_.nb_cells<Edge::ORBIT>(), 9u);
+	EXPECT_EQ(cmap_.nb_cells<Face::ORBIT>(), 7u);
+	EXPECT_EQ(cmap_.nb_cells<Volume::ORBIT>(), 2u);
+}
+
+/**
+ * @brief Collapsing edges preserves the topology
+ */
+TEST_F(CMap3TetraTest, collapse_edge)
+{
+	// 3 x 3 x 3 cubes, each one cut into 6 tetrahedra around its diagonal
+	const uint32 n = 3u;
+	auto id = [&] (uint32 i, uint32 j, uint32 k) { return (k * (n + 1u) + j) * (n + 1u) + i; };
+	const uint32 paths[6][3] = { {0u,1u,2u}, {1u,2u,0u}, {2u,0u,1u}, {0u,2u,1u}, {2u,1u,0u}, {1u,0u,2u} };
+	std::vector<uint32> tetras;
+	for (uint32 k = 0u; k < n; ++k)
+		for (uint32 j = 0u; j < n; ++j)
+			for (uint32 i = 0u; i < n; ++i)
+				for (uint32 p = 0u; p < 6u; ++p)
+				{
+					uint32 c[3] = { i, j, k };
+					uint32 v[4];
+					v[0] = id(c[0], c[1], c[2]);
+					for (uint32 s = 0u; s < 3u; ++s)
+					{
+						++c[paths[p][s]];
+						v[s + 1u] = id(c[0], c[1], c[2]);
+					}
+					if (p >= 3u)
+						std::swap(v[1], v[2]);
+					tetras.insert(tetras.end(), v, v + 4);
+				}
+	MapBuilder mbuild(cmap_);
+	mbuild.create_volumes_from_indices(tetras, (n + 1u) * (n + 1u) * (n + 1u));
+	EXPECT_EQ(cmap_.nb_cells<Vertex::ORBIT>(), 64u);
+	EXPECT_EQ(cmap_.nb_cells<Volume::ORBIT>(), 162u);
+
+	uint32 nb_collapses = 0u;
+	Edge e;
+	do
+	{
+		e = Edge();
+		cmap_.foreach_cell([&] (Edge ce) -> bool
+		{
+			if (cmap_.edge_can_collapse(ce))
+				e = ce;
+			return !e.is_valid();
+		});
+		if (e.is_valid())
+		{
+			const Vertex v = cmap_.collapse_edge(e);
+			EXPECT_FALSE(cmap_.is_boundary(v.dart));
+			++nb_collapses;
+		}
+	} while (e.is_valid());
+
+	// the 8 interior vertices are removed, the boundary is unchanged
+	EXPECT_EQ(nb_collapses, 8u);
+	EXPECT_EQ(cmap_.nb_cells<Vertex::ORBIT>(), 56u);
+	const int32 euler = int32(cmap_.nb_cells<Vertex::ORBIT>()) - int32(cmap_.nb_cells<Edge::ORBIT>())
+		+ int32(cmap_.nb_cells<Face::ORBIT>()) - int32(cmap_.nb_cells<Volume::ORBIT>());
+	EXPECT_EQ(euler, 1);
+	cmap_.foreach_dart([&] (Dart d)
+	{
+		EXPECT_NE(cmap_.phi3(d), d);
+		EXPECT_EQ(cmap_.phi3(cmap_.phi3(d)), d);
+		EXPECT_TRUE(cmap_.is_boundary(d) || cmap_.is_incident_to_boundary(Vertex(d)));
+	});
+}
+
 } // namespace cgogn
@@ -0,0 +1,116 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <algorithm>
+
+#include <gtest/gtest.h>
+
+#include <cgogn/core/cmap/cmap2_tri.h>
+#include <cgogn/core/cmap/cmap3_tetra.h>
+#include <cgogn/core/cmap/indexed_arrays.h>
+
+namespace cgogn
+{
+
+TEST(IndexedArraysTest, tri_faces)
+{
+	CMap2Tri map;
+	CMap2Tri::Builder builder(map);
+	const std::vector<uint32> tetra = { 0,2,1, 0,1,3, 1,2,3, 0,3,2 };
+	builder.create_faces_from_indices(tetra, 4u);
+
+	std::vector<uint32> offsets;
+	std::vector<uint32> indices;
+	EXPECT_EQ(export_face_indices(map, offsets, indices), 4u);
+	EXPECT_EQ(offsets.size(), 5u);
+	EXPECT_EQ(indices.size(), 12u);
+	for (uint32 i = 0u; i < 4u; ++i)
+		EXPECT_EQ(offsets[i + 1u] - offsets[i], 3u);
+
+	PrimitiveIndicesView<CMap2Tri> view(map);
+	EXPECT_TRUE(view.is_dense());
+	EXPECT_EQ(view.nb_primitives(), 4u);
+	for (uint32 p = 0u; p < view.nb_primitives(); ++p)
+	{
+		EXPECT_TRUE(view.is_valid(p));
+		for (uint32 k = 0u; k < 3u; ++k)
+			EXPECT_EQ(view(p, k), tetra[3u * p + k]);
+	}
+}
+
+TEST(IndexedArraysTest, tri_faces_with_boundary)
+{
+	CMap2Tri map;
+	CMap2Tri::Builder builder(map);
+	const std::vector<uint32> square = { 0,1,2, 0,2,3 };
+	builder.create_faces_from_indices(square, 4u);
+
+	std::vector<uint32> offsets;
+	std::vector<uint32> indices;
+	EXPECT_EQ(export_face_indices(map, offsets, indices), 2u);
+	EXPECT_EQ(indices.size(), 6u);
+
+	PrimitiveIndicesView<CMap2Tri> view(map);
+	EXPECT_FALSE(view.is_dense());
+	uint32 nb_valid = 0u;
+	for (uint32 p = 0u; p < view.nb_primitives(); ++p)
+	{
+		if (view.is_valid(p))
+			++nb_valid;
+	}
+	EXPECT_EQ(nb_valid, 2u);
+}
+
+TEST(IndexedArraysTest, tetra_volumes)
+{
+	CMap3Tetra map;
+	CMap3Tetra::Builder builder(map);
+	const std::vector<uint32> tetras = { 0,1,2,3, 1,0,2,4 };
+	builder.create_volumes_from_indices(tetras, 5u);
+
+	std::vector<uint32> offsets;
+	std::vector<uint32> indices;
+	EXPECT_EQ(export_volume_indices(map, offsets, indices), 2u);
+	EXPECT_EQ(indices.size(), 8u);
+
+	PrimitiveIndicesView<CMap3Tetra> view(map);
+	EXPECT_FALSE(view.is_dense());
+	for (uint32 p = 0u; p < 2u; ++p)
+	{
+		EXPECT_TRUE(view.is_valid(p));
+		for (uint32 k = 0u; k < 4u; ++k)
+			EXPECT_EQ(view(p, k), tetras[4u * p + k]);
+	}
+
+	// same vertices as the view
+	std::vector<uint32> sorted_view;
+	std::vector<uint32> sorted_export(indices);
+	for (uint32 p = 0u; p < 2u; ++p)
+		for (uint32 k = 0u; k < 4u; ++k)
+			sorted_view.push_back(view(p, k));
+	std::sort(sorted_view.begin(), sorted_view.end());
+	std::sort(sorted_export.begin(), sorted_export.end());
+	EXPECT_EQ(sorted_view, sorted_export);
+}
+
+} // namespace cgogn
@@ -26,6 +26,8 @@
 
 #include <vector>
 #include <array>
+#include <algorithm>
+#include <functional>
 
 #include <cgogn/core/utils/numerics.h>
 #include <cgogn/core/basic/cell.h>
@@ -115,8 +117,14 @@ protected:
 	uint32 traversed_cells_;
 };
 
+/**
+ * @brief The QuickTraversor class
+ * A QuickTraversor stores a dart of each cell of the built orbits in an attribute of the cells.
+ * After a call to track_changes(), the cells modified by the topological operations
+ * of the map can be updated with update() (see CellCache).
+ */
 template <typename MAP>
-class QuickTraversor : public CellTraversor
+class QuickTraversor : public CellTraversor, public MapObserver
 {
 public:
 
@@ -128,11 +136,15 @@ public:
 	CGOGN_NOT_COPYABLE_NOR_MOVABLE(QuickTraversor);
 
 	inline QuickTraversor(MAP& map) : Inherit(),
-		map_(map)
+		map_(map),
+		tracking_(false),
+		reset_(false)
 	{}
 
 	virtual ~QuickTraversor() override
 	{
+		if (tracking_ && MapBaseData::is_alive(&map_))
+			map_.remove_observer(this);
 		for (auto& qta : qt_attributes_)
 		{
 			if (qta.is_valid())
@@ -170,6 +182,7 @@ public:
 		if (!qt_attributes_[ORBIT].is_valid())
 			qt_attributes_[ORBIT] = map_.template add_attribute<Dart, ORBIT>(std::string("qt_att_nb_") + std::to_string(qt_counter_++));
 		map_.foreach_cell([&] (CellType c) { qt_attributes_[ORBIT][c.dart] = dart_select(c); });
+		updaters_[ORBIT] = [this, dart_select] () { this->update_cells<CellType>(dart_select); };
 		traversed_cells_ |= orbit_mask<CellType>();
 	}
 
@@ -194,10 +207,80 @@ public:
 		update(c, [] (CellType c) -> Dart { return c.dart; });
 	}
 
+	/**
+	 * @brief start recording the topological modifications of the map
+	 */
+	inline void track_changes()
+	{
+		if (!tracking_)
+		{
+			map_.add_observer(this);
+			tracking_ = true;
+		}
+	}
+
+	/**
+	 * @brief update the cells modified since the last update (all the cells if the topology has been reset)
+	 */
+	inline void update()
+	{
+		for (uint32 orbit = 0u; orbit < NB_ORBITS; ++orbit)
+		{
+			if (updaters_[orbit])
+				updaters_[orbit]();
+		}
+		changed_darts_.clear();
+		reset_ = false;
+	}
+
+	virtual void dart_changed(Dart d) override
+	{
+		if (!reset_)
+			changed_darts_.push_back(d);
+	}
+
+	virtual void topology_reset() override
+	{
+		changed_darts_.clear();
+		reset_ = true;
+	}
+
 private:
 
+	template <typename CellType, typename DartSelectionFunction>
+	void update_cells(const DartSelectionFunction& dart_select)
+	{
+		static const Orbit ORBIT = CellType::ORBIT;
+		Attribute_T<Dart>& qta = qt_attributes_[ORBIT];
+		if (reset_)
+		{
+			map_.foreach_cell([&] (CellType c) { qta[c.dart] = dart_select(c); });
+			return;
+		}
+		const auto& topo = map_.topology_container();
+		typename MAP::DartMarkerStore dm(map_);
+		for (Dart d : changed_darts_)
+		{
+			if (!topo.used(d.index) || dm.is_marked(d))
+				continue;
+			Dart first;
+			map_.foreach_dart_of_orbit(CellType(d), [&] (Dart e)
+			{
+				dm.mark(e);
+				if (first.is_nil() && !map_.is_boundary(e))
+					first = e;
+			});
+			if (!first.is_nil())
+				qta[first] = dart_select(CellType(first));
+		}
+	}
+
 	MAP& map_;
 	std::array<Attribute_T<Dart>, NB_ORBITS> qt_attributes_;
+	std::array<std::function<void()>, NB_ORBITS> updaters_;
+	std::vector<Dart> changed_darts_;
+	bool tracking_;
+	bool reset_;
 	static uint32 qt_counter_;
 };
 
@@ -366,8 +449,16 @@ private:
 template <typename MAP>
 uint32 FilteredQuickTraversor<MAP>::fqt_counter_ = 0u;
 
+/**
+ * @brief The CellCache class
+ * A CellCache stores a dart of each cell of the built orbits.
+ * After a call to track_changes(), the topological modifications of the map are recorded
+ * and a call to update() brings the cache up to date by processing only the modified cells
+ * (orbits built with a filtering function (CellType -> bool) are updated, the others are left as is).
+ * The filtering and dart selection functions are kept for the updates and must remain valid.
+ */
 template <typename MAP>
-class CellCache : public CellTraversor
+class CellCache : public CellTraversor, public MapObserver
 {
 public:
 
@@ -379,9 +470,17 @@ public:
 	CGOGN_NOT_COPYABLE_NOR_MOVABLE(CellCache);
 
 	inline CellCache(const MAP& m) : Inherit(),
-		map_(m)
+		map_(m),
+		tracking_(false),
+		reset_(false)
 	{}
 
+	virtual ~CellCache() override
+	{
+		if (tracking_ && MapBaseData::is_alive(&map_))
+			map_.remove_observer(this);
+	}
+
 	template <typename CellType>
 	inline const_iterator begin() const
 	{
@@ -404,10 +503,8 @@ public:
 	inline void build(const MASK& mask, const DartSelectionFunction& dart_select)
 	{
 		static_assert(is_func_return_same<DartSelectionFunction, Dart>::value && is_func_parameter_same<DartSelectionFunction, CellType>::value, "Badly formed DartSelectionFunction");
-		static const Orbit ORBIT = CellType::ORBIT;
-		cells_[ORBIT].clear();
-		cells_[ORBIT].reserve(4096u);
-		map_.foreach_cell([&] (CellType c) { cells_[ORBIT].push_back(dart_select(c)); }, mask);
+		fill<CellType>(mask, dart_select);
+		set_updaters<CellType>(mask, dart_select);
 		traversed_cells_ |= orbit_mask<CellType>();
 	}
 
@@ -434,7 +531,11 @@ public:
 	{
 		static_assert(is_func_return_same<DartSelectionFunction, Dart>::value && is_func_parameter_same<DartSelectionFunction, CellType>::value, "Badly formed DartSelectionFunction");
 		static const Orbit ORBIT = CellType::ORBIT;
-		cells_[ORBIT].push_back(dart_select(c));
+		const Dart d = dart_select(c);
+		if (d.index >= positions_[ORBIT].size())
+			positions_[ORBIT].resize(d.index + 1u, INVALID_INDEX);
+		positions_[ORBIT][d.index] = uint32(cells_[ORBIT].size());
+		cells_[ORBIT].push_back(d);
 	}
 
 	template <typename CellType>
@@ -448,16 +549,157 @@ public:
 	{
 		static const Orbit ORBIT = CellType::ORBIT;
 		cells_[ORBIT].clear();
+		positions_[ORBIT].clear();
+		updaters_[ORBIT] = nullptr;
+		rebuilders_[ORBIT] = nullptr;
+	}
+
+	/**
+	 * @brief start recording the topological modifications of the map
+	 */
+	inline void track_changes()
+	{
+		if (!tracking_)
+		{
+			map_.add_observer(this);
+			tracking_ = true;
+		}
+	}
+
+	/**
+	 * @brief update the cached orbits according to the modifications recorded since the last update
+	 * Only the cells containing a modified dart are processed, unless the whole topology
+	 * has been reset (cleared, compacted or merged) in which case the orbits are rebuilt.
+	 */
+	inline void update()
+	{
+		for (uint32 orbit = 0u; orbit < NB_ORBITS; ++orbit)
+		{
+			if (reset_ && rebuilders_[orbit])
+				rebuilders_[orbit]();
+			else if (!reset_ && updaters_[orbit])
+				updaters_[orbit]();
+		}
+		changed_darts_.clear();
+		reset_ = false;
+	}
+
+	virtual void dart_changed(Dart d) override
+	{
+		if (!reset_)
+			changed_darts_.push_back(d);
+	}
+
+	virtual void topology_reset() override
+	{
+		changed_darts_.clear();
+		reset_ = true;
 	}
 
 private:
 
+	template <typename CellType, typename MASK, typename DartSelectionFunction>
+	inline void fill(const MASK& mask, const DartSelectionFunction& dart_select)
+	{
+		static const Orbit ORBIT = CellType::ORBIT;
+		std::vector<Dart>& cells = cells_[ORBIT];
+		std::vector<uint32>& positions = positions_[ORBIT];
+		cells.clear();
+		cells.reserve(4096u);
+		map_.foreach_cell([&] (CellType c) { cells.push_back(dart_select(c)); }, mask);
+		positions.assign(map_.topology_container().end(), INVALID_INDEX);
+		for (uint32 i = 0u, end = uint32(cells.size()); i < end; ++i)
+			positions[cells[i].index] = i;
+	}
+
+	template <typename CellType, typename MASK, typename DartSelectionFunction>
+	inline auto set_updaters(const MASK& mask, const DartSelectionFunction& dart_select)
+		-> typename std::enable_if<is_func_parameter_same<MASK, CellType>::value>::type
+	{
+		static const Orbit ORBIT = CellType::ORBIT;
+		updaters_[ORBIT] = [this, mask, dart_select] () { this->update_cells<CellType>(mask, dart_select); };
+		rebuilders_[ORBIT] = [this, mask, dart_select] () { this->fill<CellType>(mask, dart_select); };
+	}
+
+	template <typename CellType, typename MASK, typename DartSelectionFunction>
+	inline auto set_updaters(const MASK&, const DartSelectionFunction&)
+		-> typename std::enable_if<!is_func_parameter_same<MASK, CellType>::value>::type
+	{
+		static const Orbit ORBIT = CellType::ORBIT;
+		updaters_[ORBIT] = nullptr;
+		rebuilders_[ORBIT] = nullptr;
+	}
+
+	template <typename CellType, typename MASK, typename DartSelectionFunction>
+	void update_cells(const MASK& mask, const DartSelectionFunction& dart_select)
+	{
+		static const Orbit ORBIT = CellType::ORBIT;
+		std::vector<Dart>& cells = cells_[ORBIT];
+		std::vector<uint32>& positions = positions_[ORBIT];
+		const auto& topo = map_.topology_container();
+		if (positions.size() < topo.end())
+			positions.resize(topo.end(), INVALID_INDEX);
+
+		auto remove_cell = [&] (uint32 pos)
+		{
+			positions[cells[pos].index] = INVALID_INDEX;
+			if (pos != cells.size() - 1u)
+			{
+				cells[pos] = cells.back();
+				positions[cells[pos].index] = pos;
+			}
+			cells.pop_back();
+		};
+
+		// cells whose stored dart has been removed
+		for (Dart d : changed_darts_)
+		{
+			if (!topo.used(d.index) && positions[d.index] != INVALID_INDEX)
+				remove_cell(positions[d.index]);
+		}
+
+		// cells containing a modified dart are replaced by their current state
+		typename MAP::DartMarkerStore dm(map_);
+		for (Dart d : changed_darts_)
+		{
+			if (!topo.used(d.index) || dm.is_marked(d))
+				continue;
+			Dart first;
+			map_.foreach_dart_of_orbit(CellType(d), [&] (Dart e)
+			{
+				dm.mark(e);
+				if (positions[e.index] != INVALID_INDEX)
+					remove_cell(positions[e.index]);
+				if (first.is_nil() && !map_.is_boundary(e))
+					first = e;
+			});
+			if (!first.is_nil() && mask(CellType(first)))
+			{
+				const Dart s = dart_select(CellType(first));
+				positions[s.index] = uint32(cells.size());
+				cells.push_back(s);
+			}
+		}
+	}
+
 	const MAP& map_;
 	std::array<std::vector<Dart>, NB_ORBITS> cells_;
+	// position in cells_ of each stored dart (INVALID_INDEX if not stored)
+	std::array<std::vector<uint32>, NB_ORBITS> positions_;
+	std::array<std::function<void()>, NB_ORBITS> updaters_;
+	std::array<std::function<void()>, NB_ORBITS> rebuilders_;
+	std::vector<Dart> changed_darts_;
+	bool tracking_;
+	bool reset_;
 };
 
+/**
+ * @brief The BoundaryCache class
+ * A BoundaryCache stores the boundary cells of a map.
+ * After a call to track_changes(), it can be brought up to date with update() (see CellCache).
+ */
 template <typename MAP>
-class BoundaryCache : public CellTraversor
+class BoundaryCache : public CellTraversor, public MapObserver
 {
 public:
 
@@ -471,12 +713,20 @@ public:
 	CGOGN_NOT_COPYABLE_NOR_MOVABLE(BoundaryCache);
 
 	inline BoundaryCache(const MAP& m) : Inherit(),
-		map_(m)
+		map_(m),
+		tracking_(false),
+		reset_(false)
 	{
 		cells_.reserve(4096u);
 		build();
 	}
 
+	virtual ~BoundaryCache() override
+	{
+		if (tracking_ && MapBaseData::is_alive(&map_))
+			map_.remove_observer(this);
+	}
+
 	template <typename CellType = BoundaryCellType>
 	inline const_iterator begin() const
 	{
@@ -520,13 +770,203 @@ public:
 				cells_.push_back(c);
 			}
 		});
+		positions_.assign(map_.topology_container().end(), INVALID_INDEX);
+		for (uint32 i = 0u, end = uint32(cells_.size()); i < end; ++i)
+			positions_[cells_[i].dart.index] = i;
 		traversed_cells_ |= orbit_mask<CellType>();
 	}
 
+	/**
+	 * @brief start recording the topological modifications of the map
+	 */
+	inline void track_changes()
+	{
+		if (!tracking_)
+		{
+			map_.add_observer(this);
+			tracking_ = true;
+		}
+	}
+
+	/**
+	 * @brief update the boundary cells according to the modifications recorded since the last update
+	 */
+	template <typename CellType = BoundaryCellType>
+	void update()
+	{
+		static_assert(std::is_same<CellType, BoundaryCellType>::value, "BoundaryCache can only be used with BoundaryCellType");
+		if (reset_)
+		{
+			build();
+			reset_ = false;
+			return;
+		}
+
+		const auto& topo = map_.topology_container();
+		if (positions_.size() < topo.end())
+			positions_.resize(topo.end(), INVALID_INDEX);
+
+		auto remove_cell = [&] (uint32 pos)
+		{
+			positions_[cells_[pos].dart.index] = INVALID_INDEX;
+			if (pos != cells_.size() - 1u)
+			{
+				cells_[pos] = cells_.back();
+				positions_[cells_[pos].dart.index] = pos;
+			}
+			cells_.pop_back();
+		};
+
+		for (Dart d : changed_darts_)
+		{
+			if (!topo.used(d.index) && positions_[d.index] != INVALID_INDEX)
+				remove_cell(positions_[d.index]);
+		}
+
+		typename MAP::DartMarkerStore dm(map_);
+		for (Dart d : changed_darts_)
+		{
+			if (!topo.used(d.index) || dm.is_marked(d))
+				continue;
+			map_.foreach_dart_of_orbit(CellType(d), [&] (Dart e)
+			{
+				dm.mark(e);
+				if (positions_[e.index] != INVALID_INDEX)
+					remove_cell(positions_[e.index]);
+			});
+			if (map_.is_boundary(d))
+			{
+				positions_[d.index] = uint32(cells_.size());
+				cells_.push_back(CellType(d));
+			}
+		}
+		changed_darts_.clear();
+	}
+
+	virtual void dart_changed(Dart d) override
+	{
+		if (!reset_)
+			changed_darts_.push_back(d);
+	}
+
+	virtual void topology_reset() override
+	{
+		changed_darts_.clear();
+		reset_ = true;
+	}
+
 private:
 
 	const MAP& map_;
 	std::vector<BoundaryCellType> cells_;
+	// position in cells_ of each stored dart (INVALID_INDEX if not stored)
+	std::vector<uint32> positions_;
+	std::vector<Dart> changed_darts_;
+	bool tracking_;
+	bool reset_;
+};
+
+/**
+ * @brief The ChangeTracker class
+ * A ChangeTracker records the darts modified by the topological operations of a map.
+ * Clients read the current version(), and later ask for the cells modified since this version
+ * (e.g. to update only the attributes of the modified cells).
+ */
+template <typename MAP>
+class ChangeTracker : public MapObserver
+{
+public:
+
+	using Self = ChangeTracker<MAP>;
+
+	CGOGN_NOT_COPYABLE_NOR_MOVABLE(ChangeTracker);
+
+	inline ChangeTracker(const MAP& m) :
+		map_(m),
+		reset_version_(m.topology_version())
+	{
+		map_.add_observer(this);
+	}
+
+	virtual ~ChangeTracker() override
+	{
+		if (MapBaseData::is_alive(&map_))
+			map_.remove_observer(this);
+	}
+
+	/**
+	 * @brief the current version of the topology of the map
+	 */
+	inline uint64 version() const
+	{
+		return map_.topology_version();
+	}
+
+	/**
+	 * @brief get the cells (boundary cells excluded) modified after the version since
+	 * @param since a version previously returned by version()
+	 * @param cells [out] the modified cells, each cell appears once (all the cells of the map
+	 * if the topology has been reset or the records have been discarded after since)
+	 */
+	template <typename CellType>
+	void changed_cells(uint64 since, std::vector<CellType>& cells) const
+	{
+		cells.clear();
+		if (since < reset_version_)
+		{
+			map_.foreach_cell([&] (CellType c) { cells.push_back(c); });
+			return;
+		}
+
+		const auto& topo = map_.topology_container();
+		typename MAP::DartMarkerStore dm(map_);
+		auto it = std::upper_bound(changes_.begin(), changes_.end(), since,
+			[] (uint64 v, const std::pair<uint64, Dart>& c) { return v < c.first; });
+		for (; it != changes_.end(); ++it)
+		{
+			const Dart d = it->second;
+			if (!topo.used(d.index) || dm.is_marked(d))
+				continue;
+			Dart first;
+			map_.foreach_dart_of_orbit(CellType(d), [&] (Dart e)
+			{
+				dm.mark(e);
+				if (first.is_nil() && !map_.is_boundary(e))
+					first = e;
+			});
+			if (!first.is_nil())
+				cells.push_back(CellType(first));
+		}
+	}
+
+	/**
+	 * @brief forget the modifications made until the version until (included)
+	 */
+	inline void discard(uint64 until)
+	{
+		auto it = std::upper_bound(changes_.begin(), changes_.end(), until,
+			[] (uint64 v, const std::pair<uint64, Dart>& c) { return v < c.first; });
+		changes_.erase(changes_.begin(), it);
+		reset_version_ = std::max(reset_version_, until);
+	}
+
+	virtual void dart_changed(Dart d) override
+	{
+		changes_.push_back(std::make_pair(map_.topology_version(), d));
+	}
+
+	virtual void topology_reset() override
+	{
+		changes_.clear();
+		reset_version_ = map_.topology_version();
+	}
+
+private:
+
+	const MAP& map_;
+	// (version, dart) of each modification, sorted by version
+	std::vector<std::pair<uint64, Dart>> changes_;
+	uint64 reset_version_;
 };
 
 } // namespace cgogn
@@ -27,7 +27,9 @@
 #include <vector>
 #include <type_traits>
 #include <utility>
+#include <algorithm>
 
+#include <cgogn/core/utils/type_traits.h>
 
 #include <cgogn/core/utils/thread.h>
 #include <cgogn/core/utils/thread_pool.h>
@@ -126,6 +128,56 @@ void parallel_foreach_element(CONT& cont, const FUNC& f)
 
 
 
+/**
+ * @brief apply f function on each index of the range [first, last[ in parallel
+ * The range is split in contiguous blocks of indices, each block is processed by one task.
+ * @param first first index of the range
+ * @param last index after the last index of the range
+ * @param f function with 1 param (uint32 index)
+ */
+template <typename FUNC>
+void parallel_foreach_index(uint32 first, uint32 last, const FUNC& f)
+{
+	static_assert(is_func_parameter_same<FUNC, uint32>::value, "parallel_foreach_index: given function should take an uint32 as parameter");
+
+	if (last <= first)
+		return;
+
+	ThreadPool* thread_pool = cgogn::thread_pool();
+	const uint32 nb_workers = thread_pool->nb_workers();
+	const uint32 nb = last - first;
+
+	// mono-thread case
+	if (nb_workers == 0 || nb <= PARALLEL_BUFFER_SIZE)
+	{
+		for (uint32 i = first; i < last; ++i)
+			f(i);
+		return;
+	}
+
+	// a few blocks per worker for load balancing, but not smaller than PARALLEL_BUFFER_SIZE
+	const uint32 block_size = std::max(PARALLEL_BUFFER_SIZE, nb / (8u * nb_workers) + 1u);
+
+	std::vector<std::future<void>> futures;
+	futures.reserve(nb / block_size + 1u);
+
+	uint32 b = first;
+	while (b < last)
+	{
+		const uint32 e = b + std::min(block_size, last - b);
+		futures.push_back(thread_pool->enqueue([&f, b, e] ()
+		{
+			for (uint32 i = b; i < e; ++i)
+				f(i);
+		}));
+		b = e;
+	}
+
+	for (auto& fu : futures)
+		fu.wait();
+}
+
+
 namespace internal
 {
 	template <typename FUNC, int ITH, typename CONT, typename T_ELT >
@@ -61,6 +61,37 @@ inline ScalarOf<InsideTypeOf<VERTEX_ATTR>> angle(const MAP& map, const Cell<Orbi
 }
 
 
+/**
+ * @brief compute and return the signed angle formed by two face normals around their common edge
+ * @param n1 normal of the first face
+ * @param n2 normal of the second face
+ * @param edge vector of the edge, oriented from the first to the second vertex of the first face
+ * @return
+ */
+template <typename VEC3>
+inline ScalarOf<VEC3> angle_between_normals(const VEC3& n1, const VEC3& n2, VEC3 edge)
+{
+	using Scalar = ScalarOf<VEC3>;
+
+	edge.normalize();
+	Scalar s = edge.dot(n1.cross(n2));
+	Scalar c = n1.dot(n2);
+	Scalar a(0);
+
+	// the following trick is useful to avoid NaNs (due to floating point errors)
+	if (c > Scalar(0.5)) a = std::asin(s);
+	else
+	{
+		if(c < -1) c = -1;
+		if (s >= 0) a = std::acos(c);
+		else a = -std::acos(c);
+	}
+	if (a != a)
+		cgogn_log_warning("angle_between_face_normals") << "NaN computed";
+
+	return a;
+}
+
 /**
  * @brief compute and return the angle formed by the normals of the two faces incident to the given edge
  * @param map
@@ -87,27 +118,10 @@ inline ScalarOf<InsideTypeOf<VERTEX_ATTR>> angle_between_face_normals(
 	const Dart d = e.dart;
 	const Dart d2 = map.phi2(d);
 
-    const VEC3 n1 = normal(map, Face2(d), position);
-    const VEC3 n2 = normal(map, Face2(d2), position);
+	const VEC3 n1 = normal(map, Face2(d), position);
+	const VEC3 n2 = normal(map, Face2(d2), position);
 
-	VEC3 edge = position[Vertex2(d2)] - position[Vertex2(d)];
-	edge.normalize();
-	Scalar s = edge.dot(n1.cross(n2));
-	Scalar c = n1.dot(n2);
-	Scalar a(0);
-
-	// the following trick is useful to avoid NaNs (due to floating point errors)
-	if (c > Scalar(0.5)) a = std::asin(s);
-	else
-	{
-		if(c < -1) c = -1;
-		if (s >= 0) a = std::acos(c);
-		else a = -std::acos(c);
-	}
-	if (a != a)
-		cgogn_log_warning("angle_between_face_normals") << "NaN computed";
-
-	return a;
+	return angle_between_normals(n1, n2, VEC3(position[Vertex2(d2)] - position[Vertex2(d)]));
 }
 
 
@@ -24,7 +24,14 @@
 #ifndef CGOGN_GEOMETRY_ALGOS_CURVATURE_H_
 #define CGOGN_GEOMETRY_ALGOS_CURVATURE_H_
 
+#include <memory>
+#include <vector>
+
+#include <cgogn/core/utils/thread.h>
+#include <cgogn/core/utils/thread_pool.h>
+
 #include <cgogn/geometry/types/geometry_traits.h>
+#include <cgogn/geometry/algos/kdtree.h>
 #include <cgogn/geometry/algos/selection.h>
 #include <cgogn/geometry/algos/length.h>
 #include <cgogn/geometry/functions/intersection.h>
@@ -52,6 +59,10 @@ namespace geometry
 //	Attribute<VEC3, Orbit::PHI21>& Kmin,
 //	Attribute<VEC3, Orbit::PHI21>& Knormal
 //)
+/**
+ * \brief compute the curvature of v from the normal cycle tensor of the neighborhood collected by the given collector
+ * (which is reused, e.g. one per thread)
+ */
 template <typename MAP, typename VERTEX_ATTR>
 void curvature(
 	const MAP& map,
@@ -65,7 +76,8 @@ void curvature(
 	Attribute<ScalarOf<InsideTypeOf<VERTEX_ATTR>>, Orbit::PHI21>& kmin,
 	VERTEX_ATTR& Kmax,
 	VERTEX_ATTR& Kmin,
-	VERTEX_ATTR& Knormal
+	VERTEX_ATTR& Knormal,
+	Collector<InsideTypeOf<VERTEX_ATTR>, MAP>& neighborhood
 )
 {
 	static_assert(is_orbit_of<VERTEX_ATTR, Orbit::PHI21>::value,"position must be a vertex attribute");
@@ -78,7 +90,6 @@ void curvature(
 	unused_parameters(edge_area);
 
 	// collect the normal cycle tensor
-	geometry::Collector_WithinSphere<VEC3, MAP> neighborhood(map, radius, position);
 	neighborhood.collect(v);
 
 	Eigen::Matrix3d tensor;
@@ -158,7 +169,36 @@ void curvature(
 }
 
 
-template <typename MAP, typename MASK, typename VERTEX_ATTR>
+template <typename MAP, typename VERTEX_ATTR>
+void curvature(
+	const MAP& map,
+	const Cell<Orbit::PHI21> v,
+	ScalarOf<InsideTypeOf<VERTEX_ATTR>> radius,
+	const VERTEX_ATTR& position,
+	const Attribute<InsideTypeOf<VERTEX_ATTR>, Orbit::PHI21>& normal,
+	const Attribute<ScalarOf<InsideTypeOf<VERTEX_ATTR>>, Orbit::PHI2>& edge_angle,
+	const Attribute<ScalarOf<InsideTypeOf<VERTEX_ATTR>>, Orbit::PHI2>& edge_area,
+	Attribute<ScalarOf<InsideTypeOf<VERTEX_ATTR>>, Orbit::PHI21>& kmax,
+	Attribute<ScalarOf<InsideTypeOf<VERTEX_ATTR>>, Orbit::PHI21>& kmin,
+	VERTEX_ATTR& Kmax,
+	VERTEX_ATTR& Kmin,
+	VERTEX_ATTR& Knormal
+)
+{
+	static_assert(is_orbit_of<VERTEX_ATTR, Orbit::PHI21>::value,"position must be a vertex attribute");
+
+	geometry::Collector_WithinSphere<InsideTypeOf<VERTEX_ATTR>, MAP> neighborhood(map, radius, position);
+	curvature(map, v, radius, position, normal, edge_angle, edge_area, kmax, kmin, Kmax, Kmin, Knormal, neighborhood);
+}
+
+namespace internal
+{
+
+/**
+ * \brief compute the curvature of the vertices of mask in parallel, with one collector per thread
+ * (created by new_collector before the traversal, the collectors are cleared by each collect, not reallocated)
+ */
+template <typename MAP, typename MASK, typename VERTEX_ATTR, typename NEW_COLLECTOR>
 void compute_curvature(
 	const MAP& map,
 	const MASK& mask,
@@ -171,18 +211,53 @@ void compute_curvature(
 	Attribute<ScalarOf<InsideTypeOf<VERTEX_ATTR>>, Orbit::PHI21>& kmin,
 	VERTEX_ATTR& Kmax,
 	VERTEX_ATTR& Kmin,
-	VERTEX_ATTR& Knormal
+	VERTEX_ATTR& Knormal,
+	const NEW_COLLECTOR& new_collector
 )
 {
-	static_assert(is_orbit_of<VERTEX_ATTR, Orbit::PHI21>::value,"position must be a vertex attribute");
+	using CollectorType = Collector<InsideTypeOf<VERTEX_ATTR>, MAP>;
+
+	std::vector<std::unique_ptr<CollectorType>> neighborhoods(thread_pool()->nb_workers() + 1u);
+	for (auto& neighborhood : neighborhoods)
+		neighborhood = new_collector();
 
 	map.parallel_foreach_cell([&] (Cell<Orbit::PHI21> v)
 	{
-		curvature(map, v, radius, position, normal, edge_angle, edge_area, kmax, kmin, Kmax, Kmin, Knormal);
+		CollectorType& neighborhood = *neighborhoods[current_thread_index()];
+		curvature(map, v, radius, position, normal, edge_angle, edge_area, kmax, kmin, Kmax, Kmin, Knormal, neighborhood);
 	},
 	mask);
 }
 
+} // namespace internal
+
+template <typename MAP, typename MASK, typename VERTEX_ATTR>
+void compute_curvature(
+	const MAP& map,
+	const MASK& mask,
+	ScalarOf<InsideTypeOf<VERTEX_ATTR>> radius,
+	const VERTEX_ATTR& position,
+	const VERTEX_ATTR& normal,
+	const Attribute<ScalarOf<InsideTypeOf<VERTEX_ATTR>>, Orbit::PHI2>& edge_angle,
+	const Attribute<ScalarOf<InsideTypeOf<VERTEX_ATTR>>, Orbit::PHI2>& edge_area,
+	Attribute<ScalarOf<InsideTypeOf<VERTEX_ATTR>>, Orbit::PHI21>& kmax,
+	Attribute<ScalarOf<InsideTypeOf<VERTEX_ATTR>>, Orbit::PHI21>& kmin,
+	VERTEX_ATTR& Kmax,
+	VERTEX_ATTR& Kmin,
+	VERTEX_ATTR& Knormal
+)
+{
+	static_assert(is_orbit_of<VERTEX_ATTR, Orbit::PHI21>::value,"position must be a vertex attribute");
+
+	using VEC3 = InsideTypeOf<VERTEX_ATTR>;
+	using CollectorType = Collector<VEC3, MAP>;
+
+	internal::compute_curvature(map, mask, radius, position, normal, edge_angle, edge_area, kmax, kmin, Kmax, Kmin, Knormal, [&] ()
+	{
+		return std::unique_ptr<CollectorType>(new Collector_WithinSphere<VEC3, MAP>(map, radius, position));
+	});
+}
+
 template <typename MAP, typename VERTEX_ATTR>
 void compute_curvature(
 	const MAP& map,
@@ -203,6 +278,50 @@ void compute_curvature(
 	compute_curvature(map, AllCellsFilter(), radius, position, normal, edge_angle, edge_area, kmax, kmin, Kmax, Kmin, Knormal);
 }
 
+/**
+ * \brief compute the curvature of the vertices of the map of the given k-d tree, the neighborhoods
+ * are the vertices at a Euclidean distance lower than radius (see Collector_WithinRadius)
+ */
+template <typename MAP, typename VEC3, typename MASK>
+void compute_curvature(
+	const KDTree<MAP, VEC3>& kdtree,
+	const MASK& mask,
+	ScalarOf<VEC3> radius,
+	const typename MAP::template VertexAttribute<VEC3>& normal,
+	const typename MAP::template EdgeAttribute<ScalarOf<VEC3>>& edge_angle,
+	const typename MAP::template EdgeAttribute<ScalarOf<VEC3>>& edge_area,
+	typename MAP::template VertexAttribute<ScalarOf<VEC3>>& kmax,
+	typename MAP::template VertexAttribute<ScalarOf<VEC3>>& kmin,
+	typename MAP::template VertexAttribute<VEC3>& Kmax,
+	typename MAP::template VertexAttribute<VEC3>& Kmin,
+	typename MAP::template VertexAttribute<VEC3>& Knormal
+)
+{
+	using CollectorType = Collector<VEC3, MAP>;
+
+	internal::compute_curvature(kdtree.map(), mask, radius, kdtree.position(), normal, edge_angle, edge_area, kmax, kmin, Kmax, Kmin, Knormal, [&] ()
+	{
+		return std::unique_ptr<CollectorType>(new Collector_WithinRadius<VEC3, MAP>(kdtree, radius));
+	});
+}
+
+template <typename MAP, typename VEC3>
+void compute_curvature(
+	const KDTree<MAP, VEC3>& kdtree,
+	ScalarOf<VEC3> radius,
+	const typename MAP::template VertexAttribute<VEC3>& normal,
+	const typename MAP::template EdgeAttribute<ScalarOf<VEC3>>& edge_angle,
+	const typename MAP::template EdgeAttribute<ScalarOf<VEC3>>& edge_area,
+	typename MAP::template VertexAttribute<ScalarOf<VEC3>>& kmax,
+	typename MAP::template VertexAttribute<ScalarOf<VEC3>>& kmin,
+	typename MAP::template VertexAttribute<VEC3>& Kmax,
+	typename MAP::template VertexAttribute<VEC3>& Kmin,
+	typename MAP::template VertexAttribute<VEC3>& Knormal
+)
+{
+	compute_curvature(kdtree, AllCellsFilter(), radius, normal, edge_angle, edge_area, kmax, kmin, Kmax, Kmin, Knormal);
+}
+
 } // namespace geometry
 
 } // namespace cgogn
@@ -25,6 +25,9 @@
 #define CGOGN_GEOMETRY_ALGOS_EAR_TRIANGULATION_H_
 
 #include <set>
+#include <array>
+#include <vector>
+#include <algorithm>
 
 #include <cgogn/geometry/types/geometry_traits.h>
 #include <cgogn/geometry/algos/normal.h>
@@ -382,6 +385,425 @@ public:
 	}
 };
 
+namespace internal
+{
+
+/**
+ * @brief allocator taking the single objects from a free list of the thread (nodes of the multisets of ears)
+ */
+template <typename T>
+class ThreadPoolAllocator
+{
+	struct FreeList
+	{
+		std::vector<void*> blocks_;
+
+		~FreeList()
+		{
+			for (void* p : blocks_)
+				::operator delete(p);
+		}
+	};
+
+	static std::vector<void*>& free_blocks()
+	{
+		static thread_local FreeList free_list;
+		return free_list.blocks_;
+	}
+
+public:
+
+	using value_type = T;
+
+	ThreadPoolAllocator() {}
+
+	template <typename U>
+	ThreadPoolAllocator(const ThreadPoolAllocator<U>&) {}
+
+	T* allocate(std::size_t n)
+	{
+		std::vector<void*>& blocks = free_blocks();
+		if (n != 1u || blocks.empty())
+			return static_cast<T*>(::operator new(n * sizeof(T)));
+		void* p = blocks.back();
+		blocks.pop_back();
+		return static_cast<T*>(p);
+	}
+
+	void deallocate(T* p, std::size_t n)
+	{
+		if (n == 1u)
+			free_blocks().push_back(p);
+		else
+			::operator delete(p);
+	}
+};
+
+template <typename T, typename U>
+inline bool operator==(const ThreadPoolAllocator<T>&, const ThreadPoolAllocator<U>&) { return true; }
+
+template <typename T, typename U>
+inline bool operator!=(const ThreadPoolAllocator<T>&, const ThreadPoolAllocator<U>&) { return false; }
+
+} // namespace internal
+
+/**
+ * @brief ear triangulation that does not allocate per polygon vertex
+ * The polygon nodes are stored in a buffer reused by all the triangulations of a thread (in the object for quads and pentagons)
+ * and the nodes of the multiset of ears come from a free list of the thread.
+ * The ears are compared, inserted and erased as in EarTriangulation: near equal values are compared by length,
+ * which is not a strict weak order, so the best ear depends on the container and a multiset is kept to give the same triangles.
+ */
+template <typename VEC3, typename MAP>
+class PooledEarTriangulation
+{
+	using Vertex = typename MAP::Vertex;
+	using Face   = typename MAP::Face;
+	using Scalar = ScalarOf<VEC3>;
+
+	struct Node;
+
+	struct EarCompare
+	{
+		Node* const* nodes_;
+
+		bool operator()(uint32 lhs, uint32 rhs) const
+		{
+			return cmp_VP((*nodes_)[lhs], (*nodes_)[rhs]);
+		}
+	};
+
+	using EarSet = std::multiset<uint32, EarCompare, internal::ThreadPoolAllocator<uint32>>;
+
+	struct Node
+	{
+		Vertex vert_;
+		Scalar value_;
+		Scalar length_;
+		uint32 prev_;
+		uint32 next_;
+		typename EarSet::iterator ear_;
+	};
+
+	static const uint32 SMALL_SIZE = 5u;
+
+	static std::vector<Node>& thread_nodes()
+	{
+		static thread_local std::vector<Node> nodes;
+		return nodes;
+	}
+
+	// ref on map
+	MAP& map_;
+
+	// ref on position attribute
+	const typename MAP::template VertexAttribute<VEC3>& positions_;
+
+	// normal to polygon (for orientation of angles)
+	VEC3 normalPoly_;
+
+	// nodes of the polygon (small_nodes_ or the thread buffer)
+	std::array<Node, SMALL_SIZE> small_nodes_;
+	std::vector<Node> nodes_;
+	Node* node_;
+
+	// multiset of ears
+	EarSet ears_;
+
+	// is current polygon convex
+	bool convex_;
+
+	// number of vertices
+	uint32 nb_verts_;
+
+	// initial face
+	Face face_;
+
+	inline static bool cmp_VP(const Node& lhs, const Node& rhs)
+	{
+		if (std::abs(lhs.value_ - rhs.value_) < Scalar(0.2))
+			return lhs.length_ < rhs.length_;
+		return lhs.value_ < rhs.value_;
+	}
+
+	inline void insert_ear(uint32 i)
+	{
+		node_[i].ear_ = ears_.insert(i);
+	}
+
+	inline uint32 erase_node(uint32 i)
+	{
+		const uint32 p = node_[i].prev_;
+		const uint32 n = node_[i].next_;
+		node_[p].next_ = n;
+		node_[n].prev_ = p;
+		return p;
+	}
+
+	void recompute_2_ears(uint32 i)
+	{
+		Node& vp = node_[i];
+		Node& vp2 = node_[vp.next_];
+		const Node& vprev = node_[vp.prev_];
+		const Node& vnext = node_[vp2.next_];
+		const VEC3& Ta = positions_[vp.vert_];
+		const VEC3& Tb = positions_[vp2.vert_];
+		const VEC3& Tc = positions_[vprev.vert_];
+		const VEC3& Td = positions_[vnext.vert_];
+
+		// compute angle
+		VEC3 v1 = Tb - Ta;
+		VEC3 v2 = Tc - Ta;
+		VEC3 v3 = Td - Tb;
+
+		v1.normalize();
+		v2.normalize();
+		v3.normalize();
+
+		Scalar dotpr1 = std::acos(v1.dot(v2)) / Scalar(M_PI_2);
+		Scalar dotpr2 = std::acos(-(v1.dot(v3))) / Scalar(M_PI_2);
+
+		if (!convex_)	// if convex no need to test if vertex is an ear (yes)
+		{
+			VEC3 nv1 = v1.cross(v2);
+			VEC3 nv2 = v1.cross(v3);
+
+			if (nv1.dot(normalPoly_) < Scalar(0))
+				dotpr1 = Scalar(10) - dotpr1;// not an ear (concave)
+			if (nv2.dot(normalPoly_) < Scalar(0))
+				dotpr2 = Scalar(10) - dotpr2;// not an ear (concave)
+
+			bool finished = (dotpr1 >= Scalar(5)) && (dotpr2 >= Scalar(5));
+			for (auto it = ears_.rbegin(); (!finished) && (it != ears_.rend()) && (node_[*it].value_ > Scalar(5)); ++it)
+			{
+				Vertex id = node_[*it].vert_;
+				const VEC3& P = positions_[id];
+
+				if ((dotpr1 < Scalar(5)) && (id.dart != vprev.vert_.dart))
+					if (in_triangle(P, normalPoly_, Tb, Tc, Ta))
+						dotpr1 = Scalar(5); // not an ear !
+
+				if ((dotpr2 < Scalar(5)) && (id.dart != vnext.vert_.dart))
+					if (in_triangle(P, normalPoly_, Td, Ta, Tb))
+						dotpr2 = Scalar(5); // not an ear !
+
+				finished = (dotpr1 >= Scalar(5)) && (dotpr2 >= Scalar(5));
+			}
+		}
+
+		// lengths updated as in EarTriangulation (same triangles)
+		vp.value_ = dotpr1;
+		vp.length_ = Scalar((Tb-Tc).squaredNorm());
+		insert_ear(i);
+		vp2.value_ = dotpr2;
+		vp.length_ = Scalar((Td-Ta).squaredNorm());
+		insert_ear(vp.next_);
+
+		// polygon if convex only if all vertices have convex angle (last have ...)
+		convex_ = node_[*ears_.rbegin()].value_ < Scalar(5);
+	}
+
+	Scalar ear_angle(const VEC3& P1, const VEC3& P2, const VEC3& P3)
+	{
+		VEC3 v1 = P1 - P2;
+		VEC3 v2 = P3 - P2;
+		v1.normalize();
+		v2.normalize();
+
+		Scalar dotpr = std::acos(v1.dot(v2)) / Scalar(M_PI_2);
+
+		VEC3 vn = v1.cross(v2);
+		if (vn.dot(normalPoly_) > Scalar(0))
+			dotpr = Scalar(10) - dotpr; 	// not an ear (concave, store at the end for optimized use for intersections)
+
+		return dotpr;
+	}
+
+	void ear_intersection(uint32 i)
+	{
+		Node& vp = node_[i];
+		const uint32 end = vp.prev_;
+		uint32 curr = vp.next_;
+		const VEC3& Ta = positions_[vp.vert_];
+		const VEC3& Tb = positions_[node_[curr].vert_];
+		const VEC3& Tc = positions_[node_[end].vert_];
+		curr = node_[curr].next_;
+
+		while (curr != end)
+		{
+			if (in_triangle(positions_[node_[curr].vert_], normalPoly_, Tb, Tc, Ta))
+			{
+				vp.value_ = Scalar(5); // not an ear !
+				return;
+			}
+			curr = node_[curr].next_;
+		}
+	}
+
+	/**
+	 * @brief remove the best ear from the polygon
+	 * @return the removed ear (its neighbors in the polygon are still valid)
+	 */
+	uint32 cut_best_ear()
+	{
+		const typename EarSet::iterator be_it = ears_.begin(); // best ear
+		const uint32 be = *be_it;
+		--nb_verts_;
+		if (nb_verts_ > 3)	// do not recompute if only one triangle left
+		{
+			// remove ears and two sided ears
+			ears_.erase(be_it);
+			ears_.erase(node_[node_[be].next_].ear_);
+			ears_.erase(node_[node_[be].prev_].ear_);
+		}
+		return be;
+	}
+
+public:
+
+	CGOGN_NOT_COPYABLE_NOR_MOVABLE(PooledEarTriangulation);
+
+	/**
+	 * @brief PooledEarTriangulation constructor
+	 * @param map ref on map
+	 * @param f the face to triangulate
+	 * @param position attribute of position to use
+	 */
+	PooledEarTriangulation(MAP& map, const typename MAP::Face f, const typename MAP::template VertexAttribute<VEC3>& position) :
+		map_(map),
+		positions_(position),
+		node_(nullptr),
+		ears_(EarCompare{&node_}),
+		convex_(true),
+		nb_verts_(0u),
+		face_(f)
+	{
+		uint32 codegree = map_.codegree(f);
+
+		if (codegree <= 3)
+		{
+			nb_verts_ = codegree;
+			return;
+		}
+
+		if (codegree <= SMALL_SIZE)
+			node_ = small_nodes_.data();
+		else
+		{
+			nodes_.swap(thread_nodes());
+			nodes_.resize(codegree);
+			node_ = nodes_.data();
+		}
+
+		// compute normals for orientation
+		normalPoly_ = normal(map_, Cell<Orbit::PHI1>(f.dart), position);
+
+		// first pass create polygon in chained list with angle computation
+		Dart a = f.dart;
+		Dart b = map_.phi1(a);
+		Dart c = map_.phi1(b);
+		do
+		{
+			const VEC3& P1 = position[Vertex(a)];
+			const VEC3& P2 = position[Vertex(b)];
+			const VEC3& P3 = position[Vertex(c)];
+
+			Node& vp = node_[nb_verts_];
+			vp.vert_ = Vertex(b);
+			vp.value_ = ear_angle(P1, P2, P3);
+			vp.length_ = Scalar((P3-P1).squaredNorm());
+			vp.prev_ = (nb_verts_ + codegree - 1u) % codegree;
+			vp.next_ = (nb_verts_ + 1u) % codegree;
+
+			if (vp.value_ > Scalar(5))  // concav angle
+				convex_ = false;
+
+			a = b;
+			b = c;
+			c = map_.phi1(c);
+			nb_verts_++;
+		} while (a != f.dart);
+
+		// second pass (test intersections with polygon if not convex)
+		for (uint32 i = 0u; i < nb_verts_; ++i)
+		{
+			if (!convex_ && node_[i].value_ < Scalar(5))
+				ear_intersection(i);
+			insert_ear(i);
+		}
+	}
+
+	~PooledEarTriangulation()
+	{
+		// give the buffer back to the thread (keep the largest one)
+		std::vector<Node>& nodes = thread_nodes();
+		if (nodes_.capacity() > nodes.capacity())
+			nodes_.swap(nodes);
+	}
+
+	/**
+	 * @brief compute table of vertices indices (embeddings) of triangulation
+	 * @param table_indices
+	 */
+	void append_indices(std::vector<uint32>& table_indices)
+	{
+		if (nb_verts_ < 3)
+			return;
+
+		if (nb_verts_ == 3)
+		{
+			map_.foreach_incident_vertex(face_, [&] (Vertex v)
+			{
+				table_indices.push_back(map_.embedding(v));
+			});
+			return;
+		}
+
+		while (nb_verts_ > 3)
+		{
+			// take best (and valid!) ear
+			uint32 be = cut_best_ear();
+
+			table_indices.push_back(map_.embedding(node_[be].vert_));
+			table_indices.push_back(map_.embedding(node_[node_[be].next_].vert_));
+			table_indices.push_back(map_.embedding(node_[node_[be].prev_].vert_));
+
+			be = erase_node(be); 	// remove ear vertex from polygon
+			if (nb_verts_ > 3)
+				recompute_2_ears(be);
+			else
+			{
+				// last triangle
+				table_indices.push_back(map_.embedding(node_[be].vert_));
+				table_indices.push_back(map_.embedding(node_[node_[be].next_].vert_));
+				table_indices.push_back(map_.embedding(node_[node_[be].prev_].vert_));
+			}
+		}
+	}
+
+	/**
+	 * @brief apply the ear triangulation the face
+	 */
+	void apply()
+	{
+		while (nb_verts_ > 3)
+		{
+			// take best (and valid!) ear
+			const uint32 be = cut_best_ear();
+			Node& prev = node_[node_[be].prev_];
+
+			map_.cut_face(prev.vert_.dart, node_[node_[be].next_].vert_.dart);
+
+			if (nb_verts_ > 3)
+			{
+				// replace dart to be in remaining poly
+				prev.vert_ = Vertex(map_.phi2(map_.phi_1(prev.vert_.dart)));
+				recompute_2_ears(erase_node(be));
+			}
+		}
+	}
+};
+
 /**
  * @brief compute ear triangulation
  * @param map
@@ -400,7 +822,7 @@ static void append_ear_triangulation(
 	static_assert(is_orbit_of<VERTEX_ATTR, MAP::Vertex::ORBIT>::value,"attribute must be a vertex attribute");
 
 
-	EarTriangulation<InsideTypeOf<VERTEX_ATTR>, MAP> tri(map, f, position);
+	PooledEarTriangulation<InsideTypeOf<VERTEX_ATTR>, MAP> tri(map, f, position);
 	tri.append_indices(table_indices);
 }
 
@@ -419,7 +841,7 @@ static void apply_ear_triangulation(
 {
 	static_assert(is_orbit_of<VERTEX_ATTR, MAP::Vertex::ORBIT>::value,"attribute must be a vertex attribute");
 
-	EarTriangulation<InsideTypeOf<VERTEX_ATTR>, MAP> tri(map, f, position);
+	PooledEarTriangulation<InsideTypeOf<VERTEX_ATTR>, MAP> tri(map, f, position);
 	tri.apply();
 }
 
@@ -441,7 +863,7 @@ static void apply_ear_triangulation(
 	{
 		if (!map.has_codegree(f, 3))
 		{
-			EarTriangulation<InsideTypeOf<VERTEX_ATTR>, MAP> tri(map, f, position);
+			PooledEarTriangulation<InsideTypeOf<VERTEX_ATTR>, MAP> tri(map, f, position);
 			tri.apply();
 		}
 	});
@@ -0,0 +1,1047 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef CGOGN_GEOMETRY_ALGOS_FACE_BVH_H_
+#define CGOGN_GEOMETRY_ALGOS_FACE_BVH_H_
+
+#include <array>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <future>
+#include <cmath>
+
+#include <cgogn/core/utils/numerics.h>
+#include <cgogn/core/utils/thread.h>
+#include <cgogn/core/utils/thread_pool.h>
+#include <cgogn/core/utils/parallel_foreach_element.h>
+#include <cgogn/core/basic/cell.h>
+
+#include <cgogn/geometry/types/geometry_traits.h>
+#include <cgogn/geometry/functions/intersection.h>
+#include <cgogn/geometry/functions/distance.h>
+#include <cgogn/geometry/algos/ear_triangulation.h>
+
+namespace cgogn
+{
+
+namespace geometry
+{
+
+/**
+ * \brief The FaceBVH class is a bounding volume hierarchy of the faces of a map.
+ * Faces are ear-triangulated once, the hierarchy is built on the triangles with
+ * a binned surface area heuristic (SAH) along the largest axis of the centroids. The upper levels are built sequentially,
+ * the subtrees below them are built in parallel.
+ * Triangles keep the vertex embeddings, so after moving vertices, refit() updates
+ * the bounding boxes without changing the hierarchy. After a topological change,
+ * build() must be called again.
+ * Besides ray queries, the hierarchy answers closest point queries and, for closed
+ * outward-oriented surfaces, signed distance queries (the sign is given by the
+ * angle-weighted pseudo-normals or by the generalized winding number).
+ */
+template <typename MAP, typename VEC3>
+class FaceBVH
+{
+public:
+
+	using Self = FaceBVH<MAP, VEC3>;
+	using Scalar = ScalarOf<VEC3>;
+	using Vertex = typename MAP::Vertex;
+	using Face = typename MAP::Face;
+	using VertexAttribute = typename MAP::template VertexAttribute<VEC3>;
+
+	static const uint32 NB_BINS = 16u;
+	static const uint32 MAX_LEAF_SIZE = 8u;
+
+	enum SignMethod
+	{
+		PSEUDO_NORMAL = 0,
+		WINDING_NUMBER
+	};
+
+	/**
+	 * \brief closest point of the surface
+	 */
+	struct Projection
+	{
+		Face face;
+		VEC3 point;
+		std::array<uint32, 3> vertices; // vertex embeddings of the triangle of the face that contains the point
+		std::array<Scalar, 3> barycentric; // coordinates of the point w.r.t. these vertices
+		Scalar distance;
+	};
+
+	/**
+	 * \brief intersection of a ray with a face
+	 */
+	struct Hit
+	{
+		Face face;
+		VEC3 point;
+		Scalar distance; // distance from the origin of the ray
+	};
+
+	FaceBVH(const MAP& map, const VertexAttribute& position) :
+		map_(map),
+		position_(position),
+		has_sign_data_(false)
+	{
+		build();
+	}
+
+	CGOGN_NOT_COPYABLE_NOR_MOVABLE(FaceBVH);
+
+	inline const MAP& map() const { return map_; }
+	inline const VertexAttribute& position() const { return position_; }
+	inline uint32 nb_triangles() const { return uint32(triangles_.size()); }
+	inline uint32 nb_nodes() const { return uint32(nodes_.size()); }
+
+	/**
+	 * \brief (re)build the triangulation and the hierarchy
+	 */
+	void build()
+	{
+		nodes_.clear();
+		subtree_roots_.clear();
+		triangulate();
+
+		const uint32 nb = nb_triangles();
+		if (nb == 0u)
+			return;
+
+		centroids_.resize(nb);
+		prim_min_.resize(nb);
+		prim_max_.resize(nb);
+		prims_.resize(nb);
+		parallel_foreach_index(0u, nb, [&] (uint32 i)
+		{
+			triangle_bounds(i, prim_min_[i], prim_max_[i]);
+			centroids_[i] = (prim_min_[i] + prim_max_[i]) / Scalar(2);
+			prims_[i] = i;
+		});
+
+		// the upper levels are built here, subtrees smaller than task_size are deferred
+		const uint32 nb_workers = thread_pool()->nb_workers();
+		const uint32 task_size = nb_workers > 0u ? std::max(4096u, nb / (4u * nb_workers)) : nb;
+		std::vector<std::array<uint32, 3>> tasks; // node, first, count
+		nodes_.resize(1u);
+		build_node(nodes_, 0u, 0u, nb, &tasks, task_size);
+
+		std::vector<std::vector<Node>> subtrees(tasks.size());
+		const auto build_task = [&] (uint32 k)
+		{
+			subtrees[k].resize(1u);
+			build_node(subtrees[k], 0u, tasks[k][1], tasks[k][2], nullptr, 0u);
+		};
+		if (nb_workers == 0u || tasks.size() < 2u)
+		{
+			for (uint32 k = 0u; k < uint32(tasks.size()); ++k)
+				build_task(k);
+		}
+		else
+		{
+			std::vector<std::future<void>> futures;
+			futures.reserve(tasks.size());
+			for (uint32 k = 0u; k < uint32(tasks.size()); ++k)
+				futures.push_back(thread_pool()->enqueue([&build_task, k] () { build_task(k); }));
+			for (auto& fu : futures)
+				fu.wait();
+		}
+
+		// the root of a subtree takes the place of its deferred node, other nodes are appended
+		for (uint32 k = 0u; k < uint32(tasks.size()); ++k)
+		{
+			const uint32 base = uint32(nodes_.size()) - 1u;
+			std::vector<Node>& sub = subtrees[k];
+			for (Node& n : sub)
+			{
+				if (n.count == 0u)
+				{
+					n.left += base;
+					n.right += base;
+				}
+			}
+			nodes_[tasks[k][0]] = sub[0];
+			nodes_.insert(nodes_.end(), sub.begin() + 1, sub.end());
+			subtree_roots_.push_back(tasks[k][0]);
+		}
+
+		// leaves address contiguous ranges of triangles
+		std::vector<std::array<uint32, 3>> triangles(nb);
+		std::vector<Face> faces(nb);
+		parallel_foreach_index(0u, nb, [&] (uint32 i)
+		{
+			triangles[i] = triangles_[prims_[i]];
+			faces[i] = faces_[prims_[i]];
+		});
+		triangles_.swap(triangles);
+		faces_.swap(faces);
+
+		std::vector<VEC3>().swap(centroids_);
+		std::vector<VEC3>().swap(prim_min_);
+		std::vector<VEC3>().swap(prim_max_);
+		std::vector<uint32>().swap(prims_);
+
+		if (has_sign_data_)
+			update_sign_data();
+	}
+
+	/**
+	 * \brief update the bounding boxes after a move of the vertices (the hierarchy is kept)
+	 */
+	void refit()
+	{
+		foreach_subtree_post_order([this] (uint32 n, const std::vector<bool>* stop) { refit_node(n, stop); });
+
+		if (has_sign_data_)
+			update_sign_data();
+	}
+
+	/**
+	 * \brief compute the first intersection of a ray with the faces
+	 * \param[in] A origin of the ray
+	 * \param[in] dir direction of the ray (not necessarily normalized)
+	 * \param[out] hit the nearest hit
+	 * \return true if the ray intersects a face
+	 */
+	bool intersect_ray(const VEC3& A, const VEC3& dir, Hit& hit) const
+	{
+		VEC3 D = dir;
+		D.normalize();
+		return closest_hit(A, D, std::numeric_limits<Scalar>::max(), hit);
+	}
+
+	/**
+	 * \brief compute the intersection of the segment [A,B] with the faces that is the closest to A
+	 * \return true if the segment intersects a face
+	 */
+	bool intersect_segment(const VEC3& A, const VEC3& B, Hit& hit) const
+	{
+		VEC3 D = B - A;
+		const Scalar length = D.norm();
+		if (length == Scalar(0))
+			return false;
+		D /= length;
+		return closest_hit(A, D, length, hit);
+	}
+
+	/**
+	 * \brief compute all the intersections of a ray with the faces
+	 * \param[out] hits one hit per intersected face, sorted by increasing distance
+	 * \return the number of intersected faces
+	 */
+	uint32 intersect_ray_all(const VEC3& A, const VEC3& dir, std::vector<Hit>& hits) const
+	{
+		hits.clear();
+		if (nodes_.empty())
+			return 0u;
+
+		VEC3 D = dir;
+		D.normalize();
+		const VEC3 inv = inverse(D);
+		const Scalar t_max = std::numeric_limits<Scalar>::max();
+
+		std::vector<uint32> stack;
+		stack.reserve(64u);
+		stack.push_back(0u);
+		while (!stack.empty())
+		{
+			const Node& n = nodes_[stack.back()];
+			stack.pop_back();
+			Scalar t_entry;
+			if (!ray_box(n, A, inv, t_max, t_entry))
+				continue;
+			if (n.count > 0u)
+			{
+				for (uint32 i = n.first; i < n.first + n.count; ++i)
+				{
+					VEC3 I;
+					if (intersect_triangle(i, A, D, I))
+						hits.push_back(Hit{faces_[i], I, (I - A).dot(D)});
+				}
+			}
+			else
+			{
+				stack.push_back(n.left);
+				stack.push_back(n.right);
+			}
+		}
+
+		// keep the nearest hit of each face
+		std::sort(hits.begin(), hits.end(), [] (const Hit& h1, const Hit& h2)
+		{
+			return h1.face.dart.index < h2.face.dart.index || (h1.face.dart == h2.face.dart && h1.distance < h2.distance);
+		});
+		hits.erase(std::unique(hits.begin(), hits.end(), [] (const Hit& h1, const Hit& h2) { return h1.face.dart == h2.face.dart; }), hits.end());
+		std::sort(hits.begin(), hits.end(), [] (const Hit& h1, const Hit& h2) { return h1.distance < h2.distance; });
+
+		return uint32(hits.size());
+	}
+
+	/**
+	 * \brief compute the closest point of the faces to P
+	 * \param[out] proj the closest point
+	 * \param[in] max_distance only the points closer than max_distance are searched
+	 * \return true if a point has been found
+	 */
+	bool closest_point(const VEC3& P, Projection& proj, Scalar max_distance = std::numeric_limits<Scalar>::max()) const
+	{
+		return closest_triangle(P, proj, max_distance) != INVALID_INDEX;
+	}
+
+	/**
+	 * \brief compute in parallel the closest points of the faces to a set of points
+	 */
+	void closest_points(const std::vector<VEC3>& points, std::vector<Projection>& projections) const
+	{
+		projections.resize(points.size());
+		parallel_foreach_index(0u, uint32(points.size()), [&] (uint32 i)
+		{
+			closest_point(points[i], projections[i]);
+		});
+	}
+
+	/**
+	 * \brief compute the data needed by the signed distance queries
+	 * (pseudo-normals of the triangles, edges and vertices, and dipoles of the nodes).
+	 * Once computed, they are kept up to date by build() and refit().
+	 */
+	void update_sign_data()
+	{
+		has_sign_data_ = true;
+		compute_pseudo_normals();
+		dipoles_.resize(nodes_.size());
+		foreach_subtree_post_order([this] (uint32 n, const std::vector<bool>* stop) { dipole_node(n, stop); });
+	}
+
+	inline bool has_sign_data() const
+	{
+		return has_sign_data_;
+	}
+
+	/**
+	 * \brief generalized winding number of the surface at P (1 inside and 0 outside of a closed outward-oriented surface)
+	 * The solid angles of the far nodes are approximated by the ones of their dipoles (Barill et al. 2018).
+	 */
+	Scalar winding_number(const VEC3& P) const
+	{
+		cgogn_message_assert(has_sign_data_, "winding_number: update_sign_data should be called first");
+		if (nodes_.empty())
+			return Scalar(0);
+		return winding_number_node(0u, P) / Scalar(4.0 * M_PI);
+	}
+
+	/**
+	 * \brief signed distance from P to the surface (negative inside of a closed outward-oriented surface)
+	 * \param[out] proj if given, the closest point
+	 */
+	Scalar signed_distance(const VEC3& P, SignMethod method, Projection* proj = nullptr) const
+	{
+		cgogn_message_assert(has_sign_data_, "signed_distance: update_sign_data should be called first");
+
+		Projection pr;
+		const uint32 t = closest_triangle(P, pr, std::numeric_limits<Scalar>::max());
+		if (t == INVALID_INDEX)
+			return std::numeric_limits<Scalar>::max();
+		if (proj)
+			*proj = pr;
+
+		bool inside = false;
+		if (method == WINDING_NUMBER)
+			inside = winding_number(P) > Scalar(0.5);
+		else
+			inside = (P - pr.point).dot(pseudo_normal(t, pr.barycentric)) < Scalar(0);
+
+		return inside ? -pr.distance : pr.distance;
+	}
+
+	/**
+	 * \brief compute in parallel the signed distances from a set of points to the surface
+	 */
+	void signed_distances(const std::vector<VEC3>& points, std::vector<Scalar>& distances, SignMethod method)
+	{
+		if (!has_sign_data_)
+			update_sign_data();
+
+		distances.resize(points.size());
+		parallel_foreach_index(0u, uint32(points.size()), [&] (uint32 i)
+		{
+			distances[i] = signed_distance(points[i], method);
+		});
+	}
+
+private:
+
+	struct Node
+	{
+		VEC3 min;
+		VEC3 max;
+		uint32 left;
+		uint32 right;
+		uint32 first;
+		uint32 count; // 0 for internal nodes
+	};
+
+	struct Dipole
+	{
+		VEC3 center;
+		VEC3 normal; // sum of the area vectors of the triangles
+		Scalar area;
+		Scalar radius;
+	};
+
+	struct Bin
+	{
+		VEC3 min;
+		VEC3 max;
+		uint32 count;
+	};
+
+	void triangulate()
+	{
+		std::vector<Face> faces;
+		faces.reserve(map_.template nb_cells<Face::ORBIT>());
+		map_.foreach_cell([&] (Face f) { faces.push_back(f); });
+		const uint32 nb_faces = uint32(faces.size());
+
+		std::vector<uint32> offsets(nb_faces + 1u, 0u);
+		parallel_foreach_index(0u, nb_faces, [&] (uint32 i)
+		{
+			const uint32 codegree = map_.codegree(faces[i]);
+			offsets[i + 1u] = codegree < 3u ? 0u : codegree - 2u;
+		});
+		for (uint32 i = 1u; i <= nb_faces; ++i)
+			offsets[i] += offsets[i - 1u];
+
+		triangles_.resize(offsets[nb_faces]);
+		faces_.resize(offsets[nb_faces]);
+		std::vector<std::vector<uint32>> ear_indices_th(thread_pool()->nb_workers() + 1u);
+		parallel_foreach_index(0u, nb_faces, [&] (uint32 i)
+		{
+			const Face f = faces[i];
+			uint32 k = offsets[i];
+			if (offsets[i + 1u] - k == 1u)
+			{
+				const Dart d = f.dart;
+				triangles_[k] = {{ map_.embedding(Vertex(d)), map_.embedding(Vertex(map_.phi1(d))), map_.embedding(Vertex(map_.phi_1(d))) }};
+				faces_[k] = f;
+			}
+			else if (offsets[i + 1u] > k)
+			{
+				std::vector<uint32>& ear_indices = ear_indices_th[current_thread_index()];
+				ear_indices.clear();
+				append_ear_triangulation(map_, f, position_, ear_indices);
+				for (std::size_t j = 0u; j < ear_indices.size(); j += 3u, ++k)
+				{
+					triangles_[k] = {{ ear_indices[j], ear_indices[j + 1u], ear_indices[j + 2u] }};
+					faces_[k] = f;
+				}
+			}
+		});
+	}
+
+	inline void triangle_bounds(uint32 t, VEC3& min, VEC3& max) const
+	{
+		const VEC3& p0 = position_[triangles_[t][0]];
+		const VEC3& p1 = position_[triangles_[t][1]];
+		const VEC3& p2 = position_[triangles_[t][2]];
+		for (uint32 c = 0u; c < 3u; ++c)
+		{
+			min[c] = std::min(p0[c], std::min(p1[c], p2[c]));
+			max[c] = std::max(p0[c], std::max(p1[c], p2[c]));
+		}
+	}
+
+	static inline void grow(VEC3& min, VEC3& max, const VEC3& pmin, const VEC3& pmax)
+	{
+		for (uint32 c = 0u; c < 3u; ++c)
+		{
+			min[c] = std::min(min[c], pmin[c]);
+			max[c] = std::max(max[c], pmax[c]);
+		}
+	}
+
+	static inline Scalar half_area(const VEC3& min, const VEC3& max)
+	{
+		const VEC3 d = max - min;
+		return d[0] * d[1] + d[1] * d[2] + d[2] * d[0];
+	}
+
+	static inline void empty_bounds(VEC3& min, VEC3& max)
+	{
+		for (uint32 c = 0u; c < 3u; ++c)
+		{
+			min[c] = std::numeric_limits<Scalar>::max();
+			max[c] = std::numeric_limits<Scalar>::lowest();
+		}
+	}
+
+	static inline VEC3 inverse(const VEC3& D)
+	{
+		VEC3 inv;
+		for (uint32 c = 0u; c < 3u; ++c)
+			inv[c] = D[c] != Scalar(0) ? Scalar(1) / D[c] : std::numeric_limits<Scalar>::max();
+		return inv;
+	}
+
+	/**
+	 * \brief build the subtree of node n on the triangles prims_[first .. first+count[
+	 * When tasks is given, the subtrees of less than task_size triangles are deferred.
+	 */
+	void build_node(std::vector<Node>& nodes, uint32 n, uint32 first, uint32 count, std::vector<std::array<uint32, 3>>* tasks, uint32 task_size)
+	{
+		if (tasks && count <= task_size)
+		{
+			tasks->push_back({{ n, first, count }});
+			return;
+		}
+
+		VEC3 min, max, cmin, cmax;
+		empty_bounds(min, max);
+		empty_bounds(cmin, cmax);
+		for (uint32 i = first; i < first + count; ++i)
+		{
+			const uint32 p = prims_[i];
+			grow(min, max, prim_min_[p], prim_max_[p]);
+			grow(cmin, cmax, centroids_[p], centroids_[p]);
+		}
+		nodes[n].min = min;
+		nodes[n].max = max;
+
+		const auto make_leaf = [&] ()
+		{
+			nodes[n].first = first;
+			nodes[n].count = count;
+		};
+
+		if (count <= 2u)
+			return make_leaf();
+
+		// binned SAH along the axis of largest extent of the centroids
+		uint32 axis = 0u;
+		for (uint32 c = 1u; c < 3u; ++c)
+		{
+			if (cmax[c] - cmin[c] > cmax[axis] - cmin[axis])
+				axis = c;
+		}
+		uint32 best_split = 0u;
+		Scalar best_cost = std::numeric_limits<Scalar>::max();
+		if (cmax[axis] > cmin[axis])
+		{
+			const Scalar scale = Scalar(NB_BINS) / (cmax[axis] - cmin[axis]);
+
+			std::array<Bin, NB_BINS> bins;
+			for (Bin& b : bins)
+			{
+				empty_bounds(b.min, b.max);
+				b.count = 0u;
+			}
+			for (uint32 i = first; i < first + count; ++i)
+			{
+				const uint32 p = prims_[i];
+				const uint32 b = std::min(NB_BINS - 1u, uint32((centroids_[p][axis] - cmin[axis]) * scale));
+				grow(bins[b].min, bins[b].max, prim_min_[p], prim_max_[p]);
+				++bins[b].count;
+			}
+
+			// cost of the splits between bin s-1 and bin s
+			std::array<Scalar, NB_BINS> right_cost;
+			VEC3 rmin, rmax;
+			empty_bounds(rmin, rmax);
+			uint32 rcount = 0u;
+			for (uint32 s = NB_BINS - 1u; s > 0u; --s)
+			{
+				grow(rmin, rmax, bins[s].min, bins[s].max);
+				rcount += bins[s].count;
+				right_cost[s] = rcount > 0u ? half_area(rmin, rmax) * Scalar(rcount) : Scalar(0);
+			}
+			VEC3 lmin, lmax;
+			empty_bounds(lmin, lmax);
+			uint32 lcount = 0u;
+			for (uint32 s = 1u; s < NB_BINS; ++s)
+			{
+				grow(lmin, lmax, bins[s - 1u].min, bins[s - 1u].max);
+				lcount += bins[s - 1u].count;
+				if (lcount == 0u || lcount == count)
+					continue;
+				const Scalar cost = half_area(lmin, lmax) * Scalar(lcount) + right_cost[s];
+				if (cost < best_cost)
+				{
+					best_cost = cost;
+					best_split = s;
+				}
+			}
+		}
+
+		uint32 middle = first;
+		if (best_cost < std::numeric_limits<Scalar>::max())
+		{
+			// a leaf is kept when splitting does not pay (a traversal step costs about one triangle test)
+			if (count <= MAX_LEAF_SIZE && best_cost >= half_area(min, max) * (Scalar(count) - Scalar(1)))
+				return make_leaf();
+
+			const Scalar scale = Scalar(NB_BINS) / (cmax[axis] - cmin[axis]);
+			middle = uint32(std::partition(prims_.begin() + first, prims_.begin() + first + count, [&] (uint32 p)
+			{
+				return std::min(NB_BINS - 1u, uint32((centroids_[p][axis] - cmin[axis]) * scale)) < best_split;
+			}) - prims_.begin());
+		}
+		else
+		{
+			// all the centroids are at the same place
+			if (count <= MAX_LEAF_SIZE)
+				return make_leaf();
+			middle = first + count / 2u;
+		}
+
+		const uint32 left = uint32(nodes.size());
+		nodes.resize(left + 2u);
+		nodes[n].left = left;
+		nodes[n].right = left + 1u;
+		nodes[n].first = first;
+		nodes[n].count = 0u;
+		build_node(nodes, left, first, middle - first, tasks, task_size);
+		build_node(nodes, left + 1u, middle, first + count - middle, tasks, task_size);
+	}
+
+	/**
+	 * \brief recompute the bounds of the subtree of node n (stopping at the given already refitted nodes)
+	 */
+	void refit_node(uint32 n, const std::vector<bool>* stop)
+	{
+		if (stop && (*stop)[n])
+			return;
+
+		Node& node = nodes_[n];
+		empty_bounds(node.min, node.max);
+		if (node.count > 0u)
+		{
+			for (uint32 i = node.first; i < node.first + node.count; ++i)
+			{
+				VEC3 tmin, tmax;
+				triangle_bounds(i, tmin, tmax);
+				grow(node.min, node.max, tmin, tmax);
+			}
+		}
+		else
+		{
+			refit_node(node.left, stop);
+			refit_node(node.right, stop);
+			grow(node.min, node.max, nodes_[node.left].min, nodes_[node.left].max);
+			grow(node.min, node.max, nodes_[node.right].min, nodes_[node.right].max);
+		}
+	}
+
+	/**
+	 * \brief apply f(n, stop) on the subtrees built in parallel (in parallel), then on the upper levels
+	 * (stopping at the roots of these subtrees)
+	 */
+	template <typename FUNC>
+	void foreach_subtree_post_order(const FUNC& f)
+	{
+		if (nodes_.empty())
+			return;
+
+		std::vector<bool> is_subtree_root(nodes_.size(), false);
+		for (uint32 n : subtree_roots_)
+			is_subtree_root[n] = true;
+
+		const uint32 nb_workers = thread_pool()->nb_workers();
+		if (nb_workers == 0u || subtree_roots_.size() < 2u)
+		{
+			for (uint32 n : subtree_roots_)
+				f(n, nullptr);
+		}
+		else
+		{
+			std::vector<std::future<void>> futures;
+			futures.reserve(subtree_roots_.size());
+			for (uint32 n : subtree_roots_)
+				futures.push_back(thread_pool()->enqueue([&f, n] () { f(n, nullptr); }));
+			for (auto& fu : futures)
+				fu.wait();
+		}
+
+		f(0u, &is_subtree_root);
+	}
+
+	/**
+	 * \brief closest point query
+	 * \return the index of the closest triangle (INVALID_INDEX if none)
+	 */
+	uint32 closest_triangle(const VEC3& P, Projection& proj, Scalar max_distance) const
+	{
+		if (nodes_.empty())
+			return INVALID_INDEX;
+
+		Scalar best = max_distance < std::sqrt(std::numeric_limits<Scalar>::max()) ? max_distance * max_distance : std::numeric_limits<Scalar>::max();
+		uint32 best_t = INVALID_INDEX;
+		std::array<Scalar, 3> best_bc;
+
+		std::vector<std::pair<uint32, Scalar>> stack;
+		stack.reserve(64u);
+		stack.push_back(std::make_pair(0u, box_squared_distance(nodes_[0u], P)));
+		while (!stack.empty())
+		{
+			const std::pair<uint32, Scalar> top = stack.back();
+			stack.pop_back();
+			if (top.second >= best)
+				continue;
+			const Node& n = nodes_[top.first];
+			if (n.count > 0u)
+			{
+				for (uint32 i = n.first; i < n.first + n.count; ++i)
+				{
+					const std::array<uint32, 3>& tri = triangles_[i];
+					std::array<Scalar, 3> bc;
+					const Scalar d2 = squared_distance_triangle_point(position_[tri[0]], position_[tri[1]], position_[tri[2]], P, &bc);
+					if (d2 < best)
+					{
+						best = d2;
+						best_t = i;
+						best_bc = bc;
+					}
+				}
+			}
+			else
+			{
+				// the nearest child is visited first
+				const Scalar d_left = box_squared_distance(nodes_[n.left], P);
+				const Scalar d_right = box_squared_distance(nodes_[n.right], P);
+				if (d_left < d_right)
+				{
+					if (d_right < best)
+						stack.push_back(std::make_pair(n.right, d_right));
+					stack.push_back(std::make_pair(n.left, d_left));
+				}
+				else
+				{
+					if (d_left < best)
+						stack.push_back(std::make_pair(n.left, d_left));
+					stack.push_back(std::make_pair(n.right, d_right));
+				}
+			}
+		}
+
+		if (best_t == INVALID_INDEX)
+			return INVALID_INDEX;
+
+		const std::array<uint32, 3>& tri = triangles_[best_t];
+		proj.face = faces_[best_t];
+		proj.vertices = tri;
+		proj.barycentric = best_bc;
+		proj.point = position_[tri[0]] * best_bc[0] + position_[tri[1]] * best_bc[1] + position_[tri[2]] * best_bc[2];
+		proj.distance = std::sqrt(best);
+		return best_t;
+	}
+
+	static inline Scalar box_squared_distance(const Node& n, const VEC3& P)
+	{
+		Scalar d2 = Scalar(0);
+		for (uint32 c = 0u; c < 3u; ++c)
+		{
+			if (P[c] < n.min[c])
+				d2 += (n.min[c] - P[c]) * (n.min[c] - P[c]);
+			else if (P[c] > n.max[c])
+				d2 += (P[c] - n.max[c]) * (P[c] - n.max[c]);
+		}
+		return d2;
+	}
+
+	void compute_pseudo_normals()
+	{
+		const uint32 nb = nb_triangles();
+
+		uint32 nb_vertices = 0u;
+		for (const std::array<uint32, 3>& tri : triangles_)
+			nb_vertices = std::max(nb_vertices, std::max(tri[0], std::max(tri[1], tri[2])) + 1u);
+
+		triangle_normals_.resize(nb);
+		parallel_foreach_index(0u, nb, [&] (uint32 t)
+		{
+			const std::array<uint32, 3>& tri = triangles_[t];
+			VEC3 N = (position_[tri[1]] - position_[tri[0]]).cross(position_[tri[2]] - position_[tri[0]]);
+			const Scalar l = N.norm();
+			if (l > Scalar(0))
+				N /= l;
+			triangle_normals_[t] = N;
+		});
+
+		// angle weighted vertex normals
+		vertex_normals_.assign(nb_vertices, VEC3::Zero());
+		for (uint32 t = 0u; t < nb; ++t)
+		{
+			const std::array<uint32, 3>& tri = triangles_[t];
+			for (uint32 k = 0u; k < 3u; ++k)
+			{
+				VEC3 u = position_[tri[(k + 1u) % 3u]] - position_[tri[k]];
+				VEC3 v = position_[tri[(k + 2u) % 3u]] - position_[tri[k]];
+				const Scalar lu = u.norm();
+				const Scalar lv = v.norm();
+				if (lu > Scalar(0) && lv > Scalar(0))
+				{
+					const Scalar c = std::max(Scalar(-1), std::min(Scalar(1), u.dot(v) / (lu * lv)));
+					vertex_normals_[tri[k]] += triangle_normals_[t] * std::acos(c);
+				}
+			}
+		}
+
+		// edge (k, k+1) of triangle t is at 3t+k, its normal is the sum of the normals of its triangles
+		std::vector<std::pair<uint64, uint32>> edges(3u * nb);
+		parallel_foreach_index(0u, nb, [&] (uint32 t)
+		{
+			const std::array<uint32, 3>& tri = triangles_[t];
+			for (uint32 k = 0u; k < 3u; ++k)
+			{
+				const uint32 a = tri[k];
+				const uint32 b = tri[(k + 1u) % 3u];
+				edges[3u * t + k] = std::make_pair((uint64(std::min(a, b)) << 32u) | uint64(std::max(a, b)), 3u * t + k);
+			}
+		});
+		std::sort(edges.begin(), edges.end());
+		edge_normals_.resize(3u * nb);
+		for (std::size_t i = 0u; i < edges.size();)
+		{
+			std::size_t j = i;
+			VEC3 N = VEC3::Zero();
+			for (; j < edges.size() && edges[j].first == edges[i].first; ++j)
+				N += triangle_normals_[edges[j].second / 3u];
+			for (; i < j; ++i)
+				edge_normals_[edges[i].second] = N;
+		}
+	}
+
+	inline VEC3 pseudo_normal(uint32 t, const std::array<Scalar, 3>& bc) const
+	{
+		const uint32 nb_zeros = uint32(bc[0] == Scalar(0)) + uint32(bc[1] == Scalar(0)) + uint32(bc[2] == Scalar(0));
+		for (uint32 k = 0u; k < 3u; ++k)
+		{
+			if (nb_zeros == 2u && bc[k] != Scalar(0))
+				return vertex_normals_[triangles_[t][k]];
+			if (nb_zeros == 1u && bc[k] == Scalar(0))
+				return edge_normals_[3u * t + (k + 1u) % 3u]; // edge opposite to vertex k
+		}
+		return triangle_normals_[t];
+	}
+
+	/**
+	 * \brief compute the dipole of the subtree of node n (stopping at the given already computed nodes)
+	 */
+	void dipole_node(uint32 n, const std::vector<bool>* stop)
+	{
+		if (stop && (*stop)[n])
+			return;
+
+		const Node& node = nodes_[n];
+		Dipole& dp = dipoles_[n];
+		dp.normal = VEC3::Zero();
+		dp.center = VEC3::Zero();
+		dp.area = Scalar(0);
+		dp.radius = Scalar(0);
+		if (node.count > 0u)
+		{
+			for (uint32 i = node.first; i < node.first + node.count; ++i)
+			{
+				const std::array<uint32, 3>& tri = triangles_[i];
+				const VEC3 N = (position_[tri[1]] - position_[tri[0]]).cross(position_[tri[2]] - position_[tri[0]]) / Scalar(2);
+				const Scalar a = N.norm();
+				dp.normal += N;
+				dp.center += (position_[tri[0]] + position_[tri[1]] + position_[tri[2]]) * (a / Scalar(3));
+				dp.area += a;
+			}
+			dp.center = dp.area > Scalar(0) ? VEC3(dp.center / dp.area) : VEC3((node.min + node.max) / Scalar(2));
+			for (uint32 i = node.first; i < node.first + node.count; ++i)
+				for (uint32 k = 0u; k < 3u; ++k)
+					dp.radius = std::max(dp.radius, (position_[triangles_[i][k]] - dp.center).norm());
+		}
+		else
+		{
+			dipole_node(node.left, stop);
+			dipole_node(node.right, stop);
+			const Dipole& l = dipoles_[node.left];
+			const Dipole& r = dipoles_[node.right];
+			dp.normal = l.normal + r.normal;
+			dp.area = l.area + r.area;
+			dp.center = dp.area > Scalar(0) ? VEC3((l.center * l.area + r.center * r.area) / dp.area) : VEC3((node.min + node.max) / Scalar(2));
+			dp.radius = std::max((l.center - dp.center).norm() + l.radius, (r.center - dp.center).norm() + r.radius);
+		}
+	}
+
+	/**
+	 * \brief solid angle of the triangle t seen from P (Van Oosterom and Strackee)
+	 */
+	inline Scalar solid_angle(uint32 t, const VEC3& P) const
+	{
+		const std::array<uint32, 3>& tri = triangles_[t];
+		const VEC3 a = position_[tri[0]] - P;
+		const VEC3 b = position_[tri[1]] - P;
+		const VEC3 c = position_[tri[2]] - P;
+		const Scalar la = a.norm();
+		const Scalar lb = b.norm();
+		const Scalar lc = c.norm();
+		const Scalar num = a.dot(b.cross(c));
+		const Scalar den = la * lb * lc + a.dot(b) * lc + b.dot(c) * la + c.dot(a) * lb;
+		return Scalar(2) * std::atan2(num, den);
+	}
+
+	Scalar winding_number_node(uint32 n, const VEC3& P) const
+	{
+		const Node& node = nodes_[n];
+		const Dipole& dp = dipoles_[n];
+		const VEC3 d = dp.center - P;
+		const Scalar l = d.norm();
+		if (l > Scalar(2) * dp.radius)
+			return d.dot(dp.normal) / (l * l * l);
+
+		if (node.count > 0u)
+		{
+			Scalar w = Scalar(0);
+			for (uint32 i = node.first; i < node.first + node.count; ++i)
+				w += solid_angle(i, P);
+			return w;
+		}
+		return winding_number_node(node.left, P) + winding_number_node(node.right, P);
+	}
+
+	/**
+	 * \brief slab test of the ray (A, 1/inv) with the box of node n
+	 * \param[out] t_entry distance at which the ray enters the box
+	 */
+	static inline bool ray_box(const Node& n, const VEC3& A, const VEC3& inv, Scalar t_max, Scalar& t_entry)
+	{
+		Scalar t0 = Scalar(0);
+		Scalar t1 = t_max;
+		for (uint32 c = 0u; c < 3u; ++c)
+		{
+			Scalar tn = (n.min[c] - A[c]) * inv[c];
+			Scalar tf = (n.max[c] - A[c]) * inv[c];
+			if (tn > tf)
+				std::swap(tn, tf);
+			t0 = std::max(t0, tn);
+			t1 = std::min(t1, tf);
+			if (t0 > t1)
+				return false;
+		}
+		t_entry = t0;
+		return true;
+	}
+
+	inline bool intersect_triangle(uint32 t, const VEC3& A, const VEC3& D, VEC3& I) const
+	{
+		const std::array<uint32, 3>& tri = triangles_[t];
+		return intersection_ray_triangle(A, D, position_[tri[0]], position_[tri[1]], position_[tri[2]], &I);
+	}
+
+	bool closest_hit(const VEC3& A, const VEC3& D, Scalar t_max, Hit& hit) const
+	{
+		if (nodes_.empty())
+			return false;
+
+		const VEC3 inv = inverse(D);
+		Scalar t_best = t_max;
+		bool found = false;
+
+		std::vector<uint32> stack;
+		stack.reserve(64u);
+		stack.push_back(0u);
+		while (!stack.empty())
+		{
+			const Node& n = nodes_[stack.back()];
+			stack.pop_back();
+			Scalar t_entry;
+			if (!ray_box(n, A, inv, t_best, t_entry))
+				continue;
+			if (n.count > 0u)
+			{
+				for (uint32 i = n.first; i < n.first + n.count; ++i)
+				{
+					VEC3 I;
+					if (intersect_triangle(i, A, D, I))
+					{
+						const Scalar t = (I - A).dot(D);
+						if (t <= t_best)
+						{
+							t_best = t;
+							hit = Hit{faces_[i], I, t};
+							found = true;
+						}
+					}
+				}
+			}
+			else
+			{
+				// the nearest child is visited first
+				Scalar t_left, t_right;
+				const bool l = ray_box(nodes_[n.left], A, inv, t_best, t_left);
+				const bool r = ray_box(nodes_[n.right], A, inv, t_best, t_right);
+				if (l && r)
+				{
+					if (t_left < t_right)
+					{
+						stack.push_back(n.right);
+						stack.push_back(n.left);
+					}
+					else
+					{
+						stack.push_back(n.left);
+						stack.push_back(n.right);
+					}
+				}
+				else if (l)
+					stack.push_back(n.left);
+				else if (r)
+					stack.push_back(n.right);
+			}
+		}
+
+		return found;
+	}
+
+	const MAP& map_;
+	const VertexAttribute& position_;
+
+	std::vector<Node> nodes_;
+	std::vector<uint32> subtree_roots_;
+	std::vector<std::array<uint32, 3>> triangles_; // vertex embeddings
+	std::vector<Face> faces_;
+
+	// sign data
+	bool has_sign_data_;
+	std::vector<VEC3> triangle_normals_;
+	std::vector<VEC3> edge_normals_;
+	std::vector<VEC3> vertex_normals_;
+	std::vector<Dipole> dipoles_;
+
+	// build data (bounds and centroids of the boxes of the triangles)
+	std::vector<VEC3> prim_min_;
+	std::vector<VEC3> prim_max_;
+	std::vector<VEC3> centroids_;
+	std::vector<uint32> prims_;
+};
+
+} // namespace geometry
+
+} // namespace cgogn
+
+#endif // CGOGN_GEOMETRY_ALGOS_FACE_BVH_H_
@@ -0,0 +1,349 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef CGOGN_GEOMETRY_ALGOS_GEOMETRY_CACHE_H_
+#define CGOGN_GEOMETRY_ALGOS_GEOMETRY_CACHE_H_
+
+#include <vector>
+
+#include <cgogn/core/utils/numerics.h>
+#include <cgogn/core/utils/parallel_foreach_element.h>
+#include <cgogn/core/basic/cell.h>
+#include <cgogn/core/basic/cell_marker.h>
+
+#include <cgogn/geometry/types/geometry_traits.h>
+#include <cgogn/geometry/algos/angle.h>
+#include <cgogn/geometry/algos/area.h>
+#include <cgogn/geometry/algos/length.h>
+#include <cgogn/geometry/algos/normal.h>
+
+namespace cgogn
+{
+
+namespace geometry
+{
+
+/**
+ * \brief The GeometryCache class keeps the face normals and areas, the edge lengths and the angles
+ * between face normals (as computed by compute_normal, compute_area, compute_length and
+ * compute_angle_between_face_normals) of a surface map up to date with its position attribute.
+ * Moving vertices through position(v), or declaring them with touch(v), only marks them:
+ * their incident faces and the edges of these faces are recomputed when a value is asked
+ * (on the fly for a single cell, in parallel for all pending cells with update()).
+ * touch() and position(v) are not thread safe. After a change of the topology, refresh() must be called.
+ */
+template <typename MAP, typename VEC3>
+class GeometryCache
+{
+public:
+
+	using Self = GeometryCache<MAP, VEC3>;
+	using Scalar = ScalarOf<VEC3>;
+	using Vertex = typename MAP::Vertex;
+	using Edge = typename MAP::Edge;
+	using Face = typename MAP::Face;
+
+	template <typename T>
+	using VertexAttribute = typename MAP::template VertexAttribute<T>;
+	template <typename T>
+	using EdgeAttribute = typename MAP::template EdgeAttribute<T>;
+	template <typename T>
+	using FaceAttribute = typename MAP::template FaceAttribute<T>;
+
+	CGOGN_NOT_COPYABLE_NOR_MOVABLE(GeometryCache);
+
+	inline GeometryCache(MAP& map, VertexAttribute<VEC3>& position) :
+		map_(map),
+		position_(position),
+		face_normal_(map.template add_attribute<VEC3, Face>("GeometryCache_FaceNormal")),
+		face_area_(map.template add_attribute<Scalar, Face>("GeometryCache_FaceArea")),
+		edge_length_(map.template add_attribute<Scalar, Edge>("GeometryCache_EdgeLength")),
+		edge_angle_(map.template add_attribute<Scalar, Edge>("GeometryCache_EdgeAngle")),
+		touched_vertex_(map),
+		dirty_face_(map),
+		dirty_edge_(map),
+		listed_face_(map),
+		listed_edge_(map),
+		nb_dirty_faces_(0u),
+		nb_dirty_edges_(0u)
+	{
+		refresh();
+	}
+
+	~GeometryCache()
+	{
+		map_.remove_attribute(face_normal_);
+		map_.remove_attribute(face_area_);
+		map_.remove_attribute(edge_length_);
+		map_.remove_attribute(edge_angle_);
+	}
+
+	/**
+	 * \brief recompute all the cached values (after a change of the topology or of the whole position attribute)
+	 */
+	void refresh()
+	{
+		clear_dirty();
+		map_.parallel_foreach_cell([&] (Face f) { update_face(f); });
+		map_.parallel_foreach_cell([&] (Edge e) { update_edge(e); });
+	}
+
+	/**
+	 * \brief declare that the position of v has been (or will be) modified
+	 */
+	inline void touch(Vertex v)
+	{
+		if (!touched_vertex_.is_marked(v))
+		{
+			touched_vertex_.mark(v);
+			touched_vertices_.push_back(v);
+		}
+	}
+
+	/**
+	 * \brief write access to the position of v, v is touched
+	 */
+	inline VEC3& position(Vertex v)
+	{
+		touch(v);
+		return position_[v];
+	}
+
+	inline const VertexAttribute<VEC3>& position() const
+	{
+		return position_;
+	}
+
+	/**
+	 * \brief recompute (in parallel) all the values depending on the touched vertices
+	 */
+	void update()
+	{
+		propagate();
+
+		parallel_foreach_index(0u, uint32(dirty_faces_.size()), [&] (uint32 i)
+		{
+			const Face f = dirty_faces_[i];
+			if (dirty_face_.is_marked(f))
+				update_face(f);
+		});
+		for (Face f : dirty_faces_)
+		{
+			dirty_face_.unmark(f);
+			listed_face_.unmark(f);
+		}
+		dirty_faces_.clear();
+		nb_dirty_faces_ = 0u;
+
+		parallel_foreach_index(0u, uint32(dirty_edges_.size()), [&] (uint32 i)
+		{
+			const Edge e = dirty_edges_[i];
+			if (dirty_edge_.is_marked(e))
+				update_edge(e);
+		});
+		for (Edge e : dirty_edges_)
+		{
+			dirty_edge_.unmark(e);
+			listed_edge_.unmark(e);
+		}
+		dirty_edges_.clear();
+		nb_dirty_edges_ = 0u;
+	}
+
+	inline const VEC3& normal(Face f)
+	{
+		ensure_face(f);
+		return face_normal_[f];
+	}
+
+	inline Scalar area(Face f)
+	{
+		ensure_face(f);
+		return face_area_[f];
+	}
+
+	inline Scalar length(Edge e)
+	{
+		ensure_edge(e);
+		return edge_length_[e];
+	}
+
+	inline Scalar angle(Edge e)
+	{
+		ensure_edge(e);
+		return edge_angle_[e];
+	}
+
+	/**
+	 * \brief the cached attributes, all pending values are first updated
+	 */
+	inline const FaceAttribute<VEC3>& face_normal() { update(); return face_normal_; }
+	inline const FaceAttribute<Scalar>& face_area() { update(); return face_area_; }
+	inline const EdgeAttribute<Scalar>& edge_length() { update(); return edge_length_; }
+	inline const EdgeAttribute<Scalar>& edge_angle() { update(); return edge_angle_; }
+
+	/**
+	 * \brief number of faces (resp. edges) whose values are not up to date
+	 */
+	inline uint32 nb_dirty_faces() { propagate(); return nb_dirty_faces_; }
+	inline uint32 nb_dirty_edges() { propagate(); return nb_dirty_edges_; }
+
+private:
+
+	/**
+	 * \brief mark the faces incident to the touched vertices, and the edges of these faces, as dirty
+	 */
+	void propagate()
+	{
+		for (Vertex v : touched_vertices_)
+		{
+			touched_vertex_.unmark(v);
+			map_.foreach_incident_face(v, [&] (Face f)
+			{
+				if (dirty_face_.is_marked(f))
+					return;
+				dirty_face_.mark(f);
+				push_face(f);
+				++nb_dirty_faces_;
+				map_.foreach_incident_edge(f, [&] (Edge e)
+				{
+					if (dirty_edge_.is_marked(e))
+						return;
+					dirty_edge_.mark(e);
+					push_edge(e);
+					++nb_dirty_edges_;
+				});
+			});
+		}
+		touched_vertices_.clear();
+	}
+
+	void clear_dirty()
+	{
+		for (Vertex v : touched_vertices_)
+			touched_vertex_.unmark(v);
+		touched_vertices_.clear();
+		for (Face f : dirty_faces_)
+		{
+			dirty_face_.unmark(f);
+			listed_face_.unmark(f);
+		}
+		dirty_faces_.clear();
+		nb_dirty_faces_ = 0u;
+		for (Edge e : dirty_edges_)
+		{
+			dirty_edge_.unmark(e);
+			listed_edge_.unmark(e);
+		}
+		dirty_edges_.clear();
+		nb_dirty_edges_ = 0u;
+	}
+
+	/**
+	 * \brief a cell updated on the fly stays in the list until the next update(),
+	 * so a cell dirty again is not listed twice (it would be updated by two threads)
+	 */
+	inline void push_face(Face f)
+	{
+		if (!listed_face_.is_marked(f))
+		{
+			listed_face_.mark(f);
+			dirty_faces_.push_back(f);
+		}
+	}
+
+	inline void push_edge(Edge e)
+	{
+		if (!listed_edge_.is_marked(e))
+		{
+			listed_edge_.mark(e);
+			dirty_edges_.push_back(e);
+		}
+	}
+
+	inline void ensure_face(Face f)
+	{
+		propagate();
+		if (dirty_face_.is_marked(f))
+		{
+			update_face(f);
+			dirty_face_.unmark(f);
+			--nb_dirty_faces_;
+		}
+	}
+
+	inline void ensure_edge(Edge e)
+	{
+		propagate();
+		if (dirty_edge_.is_marked(e))
+		{
+			map_.foreach_incident_face(e, [&] (Face f) { ensure_face(f); });
+			update_edge(e);
+			dirty_edge_.unmark(e);
+			--nb_dirty_edges_;
+		}
+	}
+
+	inline void update_face(Face f)
+	{
+		face_normal_[f] = geometry::normal(map_, f, position_);
+		face_area_[f] = geometry::area(map_, f, position_);
+	}
+
+	// the normals of the incident faces must be up to date
+	inline void update_edge(Edge e)
+	{
+		const Dart d = e.dart;
+		const Dart d2 = map_.phi2(d);
+		edge_length_[e] = geometry::length(map_, e, position_);
+		if (map_.is_incident_to_boundary(e))
+			edge_angle_[e] = Scalar(0);
+		else
+			edge_angle_[e] = angle_between_normals(face_normal_[Face(d)], face_normal_[Face(d2)], VEC3(position_[Vertex(d2)] - position_[Vertex(d)]));
+	}
+
+	MAP& map_;
+	VertexAttribute<VEC3>& position_;
+
+	FaceAttribute<VEC3> face_normal_;
+	FaceAttribute<Scalar> face_area_;
+	EdgeAttribute<Scalar> edge_length_;
+	EdgeAttribute<Scalar> edge_angle_;
+
+	CellMarker<MAP, Vertex::ORBIT> touched_vertex_;
+	CellMarker<MAP, Face::ORBIT> dirty_face_;
+	CellMarker<MAP, Edge::ORBIT> dirty_edge_;
+	CellMarker<MAP, Face::ORBIT> listed_face_;
+	CellMarker<MAP, Edge::ORBIT> listed_edge_;
+	std::vector<Vertex> touched_vertices_;
+	std::vector<Face> dirty_faces_;
+	std::vector<Edge> dirty_edges_;
+	uint32 nb_dirty_faces_;
+	uint32 nb_dirty_edges_;
+};
+
+} // namespace geometry
+
+} // namespace cgogn
+
+#endif // CGOGN_GEOMETRY_ALGOS_GEOMETRY_CACHE_H_
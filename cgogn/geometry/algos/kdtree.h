@@ -0,0 +1,386 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef CGOGN_GEOMETRY_ALGOS_KDTREE_H_
+#define CGOGN_GEOMETRY_ALGOS_KDTREE_H_
+
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <future>
+
+#include <cgogn/core/utils/numerics.h>
+#include <cgogn/core/utils/thread.h>
+#include <cgogn/core/utils/thread_pool.h>
+#include <cgogn/core/utils/parallel_foreach_element.h>
+#include <cgogn/core/basic/cell.h>
+
+#include <cgogn/geometry/types/geometry_traits.h>
+
+namespace cgogn
+{
+
+namespace geometry
+{
+
+/**
+ * \brief The KDTree class is a k-d tree of the vertices of a map (of any dimension, including CMap0 point sets).
+ * The tree is implicit: the points are copied and reordered so that the median of each range
+ * (split along the largest extent of the range) is at its middle, ranges smaller than LEAF_SIZE are leaves.
+ * The upper levels are built sequentially, the ranges below them are built in parallel.
+ * After moving vertices or changing the topology, build() must be called again.
+ */
+template <typename MAP, typename VEC3>
+class KDTree
+{
+public:
+
+	using Self = KDTree<MAP, VEC3>;
+	using Scalar = ScalarOf<VEC3>;
+	using Vertex = typename MAP::Vertex;
+	using VertexAttribute = typename MAP::template VertexAttribute<VEC3>;
+
+	static const uint32 LEAF_SIZE = 8u;
+
+	inline KDTree(const MAP& map, const VertexAttribute& position) :
+		map_(map),
+		position_(position)
+	{
+		build();
+	}
+
+	CGOGN_NOT_COPYABLE_NOR_MOVABLE(KDTree);
+
+	inline const MAP& map() const { return map_; }
+
+	inline const VertexAttribute& position() const { return position_; }
+
+	inline uint32 nb_points() const { return uint32(points_.size()); }
+
+	/**
+	 * \brief (re)build the tree
+	 */
+	void build()
+	{
+		vertices_.clear();
+		vertices_.reserve(map_.template nb_cells<Vertex::ORBIT>());
+		map_.foreach_cell([&] (Vertex v) { vertices_.push_back(v); });
+
+		const uint32 nb = uint32(vertices_.size());
+		points_.resize(nb);
+		axes_.assign(nb, 0u);
+		order_.resize(nb);
+		parallel_foreach_index(0u, nb, [&] (uint32 i)
+		{
+			points_[i] = position_[vertices_[i]];
+			order_[i] = i;
+		});
+
+		// the upper levels are built here, ranges smaller than task_size are deferred
+		const uint32 nb_workers = thread_pool()->nb_workers();
+		const uint32 task_size = nb_workers > 0u ? std::max(4096u, nb / (4u * nb_workers)) : nb;
+		std::vector<std::pair<uint32, uint32>> tasks;
+		build_range(0u, nb, &tasks, task_size);
+
+		if (nb_workers == 0u || tasks.size() < 2u)
+		{
+			for (const auto& t : tasks)
+				build_range(t.first, t.second, nullptr, 0u);
+		}
+		else
+		{
+			std::vector<std::future<void>> futures;
+			futures.reserve(tasks.size());
+			for (const auto& t : tasks)
+				futures.push_back(thread_pool()->enqueue([this, t] () { build_range(t.first, t.second, nullptr, 0u); }));
+			for (auto& fu : futures)
+				fu.wait();
+		}
+
+		std::vector<VEC3> points(nb);
+		std::vector<Vertex> vertices(nb);
+		parallel_foreach_index(0u, nb, [&] (uint32 i)
+		{
+			points[i] = points_[order_[i]];
+			vertices[i] = vertices_[order_[i]];
+		});
+		points_.swap(points);
+		vertices_.swap(vertices);
+		std::vector<uint32>().swap(order_);
+	}
+
+	/**
+	 * \brief find the nearest vertex of P
+	 * \param[out] squared_distance if given, the squared distance to the vertex
+	 * \return false if the tree is empty
+	 */
+	bool find_nearest(const VEC3& P, Vertex& v, Scalar* squared_distance = nullptr) const
+	{
+		std::vector<std::pair<Scalar, uint32>> heap;
+		heap.reserve(2u);
+		knn(P, 1u, heap);
+		if (heap.empty())
+			return false;
+		v = vertices_[heap[0].second];
+		if (squared_distance)
+			*squared_distance = heap[0].first;
+		return true;
+	}
+
+	/**
+	 * \brief find the k nearest vertices of P, sorted by increasing distance
+	 * \param[out] squared_distances if given, the squared distances to the vertices
+	 * \return the number of vertices found
+	 */
+	uint32 find_knn(const VEC3& P, uint32 k, std::vector<Vertex>& neighbors, std::vector<Scalar>* squared_distances = nullptr) const
+	{
+		std::vector<std::pair<Scalar, uint32>> heap;
+		heap.reserve(k + 1u);
+		knn(P, k, heap);
+		std::sort_heap(heap.begin(), heap.end());
+		output(heap, neighbors, squared_distances);
+		return uint32(neighbors.size());
+	}
+
+	/**
+	 * \brief find the vertices at a distance lower than radius from P (in no particular order)
+	 * \param[out] squared_distances if given, the squared distances to the vertices
+	 * \return the number of vertices found
+	 */
+	uint32 find_within_radius(const VEC3& P, Scalar radius, std::vector<Vertex>& neighbors, std::vector<Scalar>* squared_distances = nullptr) const
+	{
+		std::vector<std::pair<Scalar, uint32>> found;
+		within_radius(P, radius * radius, found);
+		output(found, neighbors, squared_distances);
+		return uint32(neighbors.size());
+	}
+
+	/**
+	 * \brief apply f(v, neighbors) in parallel on the vertices v of the map,
+	 * with the k nearest vertices of v (v included) sorted by increasing distance
+	 */
+	template <typename FUNC>
+	void parallel_foreach_knn(uint32 k, const FUNC& f) const
+	{
+		static_assert(is_func_parameter_same<FUNC, Vertex>::value, "Wrong function cell parameter type");
+		parallel_foreach_neighborhood([&] (Vertex v, std::vector<std::pair<Scalar, uint32>>& heap)
+		{
+			knn(position_[v], k, heap);
+			std::sort_heap(heap.begin(), heap.end());
+		},
+		f);
+	}
+
+	/**
+	 * \brief apply f(v, neighbors) in parallel on the vertices v of the map,
+	 * with the vertices at a distance lower than radius from v (v included)
+	 */
+	template <typename FUNC>
+	void parallel_foreach_within_radius(Scalar radius, const FUNC& f) const
+	{
+		static_assert(is_func_parameter_same<FUNC, Vertex>::value, "Wrong function cell parameter type");
+		const Scalar radius2 = radius * radius;
+		parallel_foreach_neighborhood([&] (Vertex v, std::vector<std::pair<Scalar, uint32>>& found)
+		{
+			within_radius(position_[v], radius2, found);
+		},
+		f);
+	}
+
+private:
+
+	/**
+	 * \brief put the median of [first,last[ in the middle along the largest extent of the range and recurse
+	 * (ranges smaller than task_size are appended to tasks when it is given)
+	 */
+	void build_range(uint32 first, uint32 last, std::vector<std::pair<uint32, uint32>>* tasks, uint32 task_size)
+	{
+		if (last - first <= LEAF_SIZE)
+			return;
+
+		if (tasks && last - first <= task_size)
+		{
+			tasks->push_back(std::make_pair(first, last));
+			return;
+		}
+
+		VEC3 bb_min = points_[order_[first]];
+		VEC3 bb_max = bb_min;
+		for (uint32 i = first + 1u; i < last; ++i)
+		{
+			const VEC3& p = points_[order_[i]];
+			for (uint32 c = 0u; c < 3u; ++c)
+			{
+				bb_min[c] = std::min(bb_min[c], p[c]);
+				bb_max[c] = std::max(bb_max[c], p[c]);
+			}
+		}
+		uint8 axis = 0u;
+		for (uint8 c = 1u; c < 3u; ++c)
+			if (bb_max[c] - bb_min[c] > bb_max[axis] - bb_min[axis])
+				axis = c;
+
+		const uint32 mid = first + (last - first) / 2u;
+		std::nth_element(order_.begin() + first, order_.begin() + mid, order_.begin() + last, [&] (uint32 a, uint32 b)
+		{
+			return points_[a][axis] < points_[b][axis];
+		});
+		axes_[mid] = axis;
+
+		build_range(first, mid, tasks, task_size);
+		build_range(mid + 1u, last, tasks, task_size);
+	}
+
+	/**
+	 * \brief k nearest points of P in a max-heap of (squared distance, index)
+	 */
+	inline void knn(const VEC3& P, uint32 k, std::vector<std::pair<Scalar, uint32>>& heap) const
+	{
+		heap.clear();
+		if (k > 0u)
+			knn_range(P, k, 0u, nb_points(), heap);
+	}
+
+	void knn_range(const VEC3& P, uint32 k, uint32 first, uint32 last, std::vector<std::pair<Scalar, uint32>>& heap) const
+	{
+		const auto consider = [&] (uint32 i)
+		{
+			const Scalar d2 = (points_[i] - P).squaredNorm();
+			if (heap.size() < k)
+			{
+				heap.push_back(std::make_pair(d2, i));
+				std::push_heap(heap.begin(), heap.end());
+			}
+			else if (d2 < heap.front().first)
+			{
+				std::pop_heap(heap.begin(), heap.end());
+				heap.back() = std::make_pair(d2, i);
+				std::push_heap(heap.begin(), heap.end());
+			}
+		};
+
+		if (last - first <= LEAF_SIZE)
+		{
+			for (uint32 i = first; i < last; ++i)
+				consider(i);
+			return;
+		}
+
+		const uint32 mid = first + (last - first) / 2u;
+		const Scalar d = P[axes_[mid]] - points_[mid][axes_[mid]];
+		consider(mid);
+		if (d < Scalar(0))
+		{
+			knn_range(P, k, first, mid, heap);
+			if (heap.size() < k || d * d < heap.front().first)
+				knn_range(P, k, mid + 1u, last, heap);
+		}
+		else
+		{
+			knn_range(P, k, mid + 1u, last, heap);
+			if (heap.size() < k || d * d < heap.front().first)
+				knn_range(P, k, first, mid, heap);
+		}
+	}
+
+	inline void within_radius(const VEC3& P, Scalar radius2, std::vector<std::pair<Scalar, uint32>>& found) const
+	{
+		found.clear();
+		within_radius_range(P, radius2, 0u, nb_points(), found);
+	}
+
+	void within_radius_range(const VEC3& P, Scalar radius2, uint32 first, uint32 last, std::vector<std::pair<Scalar, uint32>>& found) const
+	{
+		const auto consider = [&] (uint32 i)
+		{
+			const Scalar d2 = (points_[i] - P).squaredNorm();
+			if (d2 < radius2)
+				found.push_back(std::make_pair(d2, i));
+		};
+
+		if (last - first <= LEAF_SIZE)
+		{
+			for (uint32 i = first; i < last; ++i)
+				consider(i);
+			return;
+		}
+
+		const uint32 mid = first + (last - first) / 2u;
+		const Scalar d = P[axes_[mid]] - points_[mid][axes_[mid]];
+		consider(mid);
+		if (d < Scalar(0) || d * d < radius2)
+			within_radius_range(P, radius2, first, mid, found);
+		if (d >= Scalar(0) || d * d < radius2)
+			within_radius_range(P, radius2, mid + 1u, last, found);
+	}
+
+	inline void output(const std::vector<std::pair<Scalar, uint32>>& found, std::vector<Vertex>& neighbors, std::vector<Scalar>* squared_distances) const
+	{
+		neighbors.resize(found.size());
+		for (std::size_t i = 0u; i < found.size(); ++i)
+			neighbors[i] = vertices_[found[i].second];
+		if (squared_distances)
+		{
+			squared_distances->resize(found.size());
+			for (std::size_t i = 0u; i < found.size(); ++i)
+				(*squared_distances)[i] = found[i].first;
+		}
+	}
+
+	/**
+	 * \brief run query(v, found) then f(v, neighbors) on the vertices of the map in parallel (with per thread buffers)
+	 */
+	template <typename QUERY, typename FUNC>
+	void parallel_foreach_neighborhood(const QUERY& query, const FUNC& f) const
+	{
+		const uint32 nb_threads = thread_pool()->nb_workers() + 1u;
+		std::vector<std::vector<std::pair<Scalar, uint32>>> found_th(nb_threads);
+		std::vector<std::vector<Vertex>> neighbors_th(nb_threads);
+
+		map_.parallel_foreach_cell([&] (Vertex v)
+		{
+			const uint32 th = current_thread_index();
+			std::vector<std::pair<Scalar, uint32>>& found = found_th[th];
+			std::vector<Vertex>& neighbors = neighbors_th[th];
+			query(v, found);
+			output(found, neighbors, nullptr);
+			f(v, neighbors);
+		});
+	}
+
+	const MAP& map_;
+	const VertexAttribute& position_;
+
+	std::vector<VEC3> points_;
+	std::vector<Vertex> vertices_;
+	std::vector<uint8> axes_; // split axis of the range whose middle is at this index
+
+	// build data
+	std::vector<uint32> order_;
+};
+
+} // namespace geometry
+
+} // namespace cgogn
+
+#endif // CGOGN_GEOMETRY_ALGOS_KDTREE_H_
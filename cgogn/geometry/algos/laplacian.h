@@ -0,0 +1,286 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef CGOGN_GEOMETRY_ALGOS_LAPLACIAN_H_
+#define CGOGN_GEOMETRY_ALGOS_LAPLACIAN_H_
+
+#include <vector>
+
+#include <Eigen/Sparse>
+
+#include <cgogn/core/utils/numerics.h>
+#include <cgogn/core/utils/parallel_foreach_element.h>
+#include <cgogn/core/basic/cell.h>
+#include <cgogn/core/basic/dart.h>
+
+#include <cgogn/geometry/types/geometry_traits.h>
+
+namespace cgogn
+{
+
+namespace geometry
+{
+
+/**
+ * \brief The LaplacianOperator class is the weighted adjacency of the vertices of a surface map,
+ * assembled once (in parallel) as a CSR matrix whose rows and columns are the vertex embeddings.
+ * Row i holds the weights w_ij of the vertices j adjacent to i through an edge, either uniform (1)
+ * or cotangent ((cot(alpha_ij) + cot(beta_ij)) / 2, for triangle meshes).
+ * The smoothing filters are sparse matrix-vector products on vertex attributes, with the same
+ * results as the traversal based filters of filtering.h for uniform weights.
+ * When only the positions change, reweight() updates the cotangent weights on the same pattern.
+ * After a change of the topology, the operator must be rebuilt.
+ */
+template <typename MAP, typename VEC3>
+class LaplacianOperator
+{
+public:
+
+	using Self = LaplacianOperator<MAP, VEC3>;
+	using Scalar = ScalarOf<VEC3>;
+	using Vertex = typename MAP::Vertex;
+	using SparseMatrix = Eigen::SparseMatrix<Scalar, Eigen::RowMajor>;
+
+	template <typename T>
+	using VertexAttribute = typename MAP::template VertexAttribute<T>;
+
+	enum Weights
+	{
+		UNIFORM = 0,
+		COTANGENT
+	};
+
+	CGOGN_NOT_COPYABLE_NOR_MOVABLE(LaplacianOperator);
+
+	/**
+	 * \brief build an operator with uniform weights
+	 */
+	inline LaplacianOperator(const MAP& map) :
+		map_(map),
+		weights_type_(UNIFORM)
+	{
+		build_pattern();
+		reweight();
+	}
+
+	/**
+	 * \brief build an operator with cotangent weights
+	 */
+	inline LaplacianOperator(const MAP& map, const VertexAttribute<VEC3>& position) :
+		map_(map),
+		weights_type_(COTANGENT)
+	{
+		build_pattern();
+		reweight(position);
+	}
+
+	inline Weights weights_type() const { return weights_type_; }
+	inline uint32 nb_rows() const { return uint32(row_start_.size()) - 1u; }
+	inline uint32 nb_entries() const { return uint32(columns_.size()); }
+
+	/**
+	 * \brief set the weights to uniform
+	 */
+	void reweight()
+	{
+		weights_type_ = UNIFORM;
+		std::fill(weights_.begin(), weights_.end(), Scalar(1));
+		parallel_foreach_index(0u, nb_rows(), [&] (uint32 i)
+		{
+			row_weight_[i] = Scalar(row_start_[i + 1u] - row_start_[i]);
+		});
+	}
+
+	/**
+	 * \brief compute the cotangent weights of the given positions (the pattern is not rebuilt)
+	 */
+	void reweight(const VertexAttribute<VEC3>& position)
+	{
+		weights_type_ = COTANGENT;
+		parallel_foreach_index(0u, nb_rows(), [&] (uint32 i)
+		{
+			Scalar sum(0);
+			for (uint32 k = row_start_[i]; k < row_start_[i + 1u]; ++k)
+			{
+				const Dart d = darts_[k];
+				const Dart d2 = map_.phi2(d);
+				Scalar w(0);
+				if (!map_.is_boundary(d))
+					w += cotangent(position, d);
+				if (!map_.is_boundary(d2))
+					w += cotangent(position, d2);
+				weights_[k] = Scalar(0.5) * w;
+				sum += weights_[k];
+			}
+			row_weight_[i] = sum;
+		});
+	}
+
+	/**
+	 * \brief out = L in, with (L in)_i = sum_j w_ij (in_j - in_i)
+	 */
+	template <typename T>
+	void multiply(const VertexAttribute<T>& in, VertexAttribute<T>& out) const
+	{
+		parallel_foreach_index(0u, nb_rows(), [&] (uint32 i)
+		{
+			T sum;
+			set_zero(sum);
+			for (uint32 k = row_start_[i]; k < row_start_[i + 1u]; ++k)
+				sum += in[columns_[k]] * weights_[k];
+			out[i] = sum - in[i] * row_weight_[i];
+		});
+	}
+
+	/**
+	 * \brief out_i = weighted average of the in_j (filter_average for uniform weights)
+	 */
+	template <typename T>
+	void average(const VertexAttribute<T>& in, VertexAttribute<T>& out) const
+	{
+		smooth(in, out, Scalar(1));
+	}
+
+	/**
+	 * \brief out_i = in_i + lambda (weighted average of the in_j - in_i)
+	 * (in and out must be different attributes, vertices without neighbors or weights are copied)
+	 */
+	template <typename T>
+	void smooth(const VertexAttribute<T>& in, VertexAttribute<T>& out, Scalar lambda) const
+	{
+		parallel_foreach_index(0u, nb_rows(), [&] (uint32 i)
+		{
+			if (row_weight_[i] == Scalar(0))
+			{
+				out[i] = in[i];
+				return;
+			}
+			T avg;
+			set_zero(avg);
+			for (uint32 k = row_start_[i]; k < row_start_[i + 1u]; ++k)
+				avg += in[columns_[k]] * weights_[k];
+			avg /= row_weight_[i];
+			const T& p = in[i];
+			out[i] = p + ((avg - p) * lambda);
+		});
+	}
+
+	/**
+	 * \brief the two steps of filter_taubin, position_tmp receives the intermediate positions
+	 */
+	void filter_taubin(
+		VertexAttribute<VEC3>& position,
+		VertexAttribute<VEC3>& position_tmp,
+		Scalar lambda = Scalar(0.6307),
+		Scalar mu = Scalar(0.6732)
+	) const
+	{
+		smooth(position, position_tmp, lambda);
+		smooth(position_tmp, position, mu);
+	}
+
+	/**
+	 * \brief the Laplacian matrix L (L_ij = w_ij, L_ii = -sum_j w_ij) as an Eigen sparse matrix,
+	 * indexed by vertex embeddings (the rows and columns of unused embeddings are empty)
+	 */
+	SparseMatrix matrix() const
+	{
+		std::vector<Eigen::Triplet<Scalar>> triplets;
+		triplets.reserve(columns_.size() + nb_rows());
+		for (uint32 i = 0u; i < nb_rows(); ++i)
+		{
+			if (row_start_[i] == row_start_[i + 1u])
+				continue;
+			triplets.push_back(Eigen::Triplet<Scalar>(int(i), int(i), -row_weight_[i]));
+			for (uint32 k = row_start_[i]; k < row_start_[i + 1u]; ++k)
+				triplets.push_back(Eigen::Triplet<Scalar>(int(i), int(columns_[k]), weights_[k]));
+		}
+		SparseMatrix m(nb_rows(), nb_rows());
+		m.setFromTriplets(triplets.begin(), triplets.end());
+		return m;
+	}
+
+private:
+
+	/**
+	 * \brief the rows are sized, then filled, in parallel.
+	 * The entries of a row follow the darts of the vertex: entry k of row i is the edge of dart darts_[k] of vertex i.
+	 */
+	void build_pattern()
+	{
+		const uint32 nb = map_.template attribute_container<Vertex::ORBIT>().end();
+		row_start_.assign(nb + 1u, 0u);
+		row_weight_.assign(nb, Scalar(0));
+
+		map_.parallel_foreach_cell([&] (Vertex v)
+		{
+			uint32 degree = 0u;
+			map_.foreach_dart_of_orbit(v, [&] (Dart) { ++degree; });
+			row_start_[map_.embedding(v) + 1u] = degree;
+		});
+		for (uint32 i = 0u; i < nb; ++i)
+			row_start_[i + 1u] += row_start_[i];
+
+		columns_.resize(row_start_[nb]);
+		darts_.resize(row_start_[nb]);
+		weights_.resize(row_start_[nb]);
+
+		map_.parallel_foreach_cell([&] (Vertex v)
+		{
+			uint32 k = row_start_[map_.embedding(v)];
+			map_.foreach_dart_of_orbit(v, [&] (Dart d)
+			{
+				darts_[k] = d;
+				columns_[k] = map_.embedding(Vertex(map_.phi2(d)));
+				++k;
+			});
+		});
+	}
+
+	/**
+	 * \brief cotangent of the angle opposite to the edge of d in the face of d (at its previous vertex)
+	 */
+	inline Scalar cotangent(const VertexAttribute<VEC3>& position, Dart d) const
+	{
+		const VEC3& c = position[Vertex(map_.phi_1(d))];
+		const VEC3 a = position[Vertex(d)] - c;
+		const VEC3 b = position[Vertex(map_.phi1(d))] - c;
+		const Scalar s = a.cross(b).norm();
+		return s > Scalar(0) ? a.dot(b) / s : Scalar(0);
+	}
+
+	const MAP& map_;
+	Weights weights_type_;
+
+	std::vector<uint32> row_start_;
+	std::vector<uint32> columns_;
+	std::vector<Dart> darts_;
+	std::vector<Scalar> weights_;
+	std::vector<Scalar> row_weight_;
+};
+
+} // namespace geometry
+
+} // namespace cgogn
+
+#endif // CGOGN_GEOMETRY_ALGOS_LAPLACIAN_H_
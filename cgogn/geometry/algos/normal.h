@@ -28,8 +28,18 @@
 #include <cgogn/core/basic/cell.h>
 #include <cgogn/core/cmap/attribute.h>
 #include <cgogn/core/utils/masks.h>
+#include <cgogn/core/utils/parallel_foreach_element.h>
+
+#include <array>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+
+#include <Eigen/Core>
+#include <Eigen/Eigenvalues>
 
 #include <cgogn/geometry/algos/area.h>
+#include <cgogn/geometry/algos/kdtree.h>
 #include <cgogn/geometry/functions/basics.h>
 #include <cgogn/geometry/functions/normal.h>
 #include <cgogn/geometry/types/geometry_traits.h>
@@ -140,6 +150,189 @@ inline InsideTypeOf<VERTEX_ATTR> normal(
 }
 
 
+namespace internal
+{
+
+const uint32 NORMAL_BLOCK_SIZE = 8u;
+
+/**
+ * \brief first phase of the batched normal computation on maps made of triangle primitives:
+ * the slots of the topology container are processed by blocks of NORMAL_BLOCK_SIZE triangles
+ * stored as structures of arrays, so that the cross products and lengths run on SIMD packets
+ * (Eigen fixed size arrays, vectorized when CGOGN_USE_SIMD enables the SSE/AVX flags).
+ * For each valid triangle, the (optional) face normal is written and each of its 3 darts
+ * receives the weighted contribution of the face to the normal of its vertex.
+ */
+template <typename MAP, typename VERTEX_ATTR>
+inline void corner_normals(
+	const MAP& map,
+	const VERTEX_ATTR& position,
+	Attribute<InsideTypeOf<VERTEX_ATTR>, Orbit::PHI1>* face_normal,
+	std::vector<InsideTypeOf<VERTEX_ATTR>>* corners,
+	std::true_type
+)
+{
+	using VEC3 = InsideTypeOf<VERTEX_ATTR>;
+	using Scalar = ScalarOf<VEC3>;
+	using Vertex = typename MAP::Vertex;
+	using Face = Cell<Orbit::PHI1>;
+	using Lanes = Eigen::Array<Scalar, NORMAL_BLOCK_SIZE, 1>;
+
+	const auto& topo = map.topology_container();
+	const uint32 nb_slots = (topo.end() + MAP::PRIM_SIZE - 1u) / MAP::PRIM_SIZE;
+	const uint32 nb_blocks = (nb_slots + NORMAL_BLOCK_SIZE - 1u) / NORMAL_BLOCK_SIZE;
+
+	parallel_foreach_index(0u, nb_blocks, [&] (uint32 b)
+	{
+		const uint32 first = b * NORMAL_BLOCK_SIZE;
+		const uint32 nb = std::min(NORMAL_BLOCK_SIZE, nb_slots - first);
+
+		// gather (invalid lanes are null triangles)
+		Lanes x[3], y[3], z[3];
+		std::array<bool, NORMAL_BLOCK_SIZE> valid;
+		for (uint32 c = 0u; c < 3u; ++c)
+		{
+			x[c].setZero();
+			y[c].setZero();
+			z[c].setZero();
+		}
+		for (uint32 i = 0u; i < NORMAL_BLOCK_SIZE; ++i)
+		{
+			const Dart d((first + i) * MAP::PRIM_SIZE);
+			valid[i] = i < nb && topo.used(d.index) && !map.is_boundary(d);
+			if (!valid[i])
+				continue;
+			Dart dc = d;
+			for (uint32 c = 0u; c < 3u; ++c)
+			{
+				const VEC3& p = position[Vertex(dc)];
+				x[c][i] = p[0];
+				y[c][i] = p[1];
+				z[c][i] = p[2];
+				dc = map.phi1(dc);
+			}
+		}
+
+		// compute
+		const Lanes ux = x[1] - x[0], uy = y[1] - y[0], uz = z[1] - z[0];
+		const Lanes vx = x[2] - x[0], vy = y[2] - y[0], vz = z[2] - z[0];
+		const Lanes nx = uy * vz - uz * vy;
+		const Lanes ny = uz * vx - ux * vz;
+		const Lanes nz = ux * vy - uy * vx;
+		const Lanes l01 = ux.square() + uy.square() + uz.square();
+		const Lanes l20 = vx.square() + vy.square() + vz.square();
+		const Lanes l12 = (x[2] - x[1]).square() + (y[2] - y[1]).square() + (z[2] - z[1]).square();
+
+		// corner weights: half of the cross product (the area) over the squared lengths of the 2 incident edges
+		// (degenerate corners get the unit face normal, as in normal(map, Vertex, position))
+		const Lanes n2 = nx.square() + ny.square() + nz.square();
+		const Lanes inv_n = (n2 > Scalar(0)).select(n2.sqrt().inverse(), Lanes::Constant(Scalar(1)));
+		const Lanes lc[3] = { l01 * l20, l01 * l12, l12 * l20 };
+		Lanes w[3];
+		for (uint32 c = 0u; c < 3u; ++c)
+			w[c] = (lc[c] != Scalar(0)).select(Scalar(0.5) / lc[c], inv_n);
+
+		// scatter
+		for (uint32 i = 0u; i < nb; ++i)
+		{
+			if (!valid[i])
+				continue;
+			Dart d((first + i) * MAP::PRIM_SIZE);
+			if (face_normal)
+				(*face_normal)[Face(d)] = VEC3{nx[i] * inv_n[i], ny[i] * inv_n[i], nz[i] * inv_n[i]};
+			if (corners)
+			{
+				for (uint32 c = 0u; c < 3u; ++c)
+				{
+					(*corners)[d.index] = VEC3{nx[i] * w[c][i], ny[i] * w[c][i], nz[i] * w[c][i]};
+					d = map.phi1(d);
+				}
+			}
+		}
+	});
+}
+
+/**
+ * \brief first phase of the batched normal computation on general maps (one face per task)
+ */
+template <typename MAP, typename VERTEX_ATTR>
+inline void corner_normals(
+	const MAP& map,
+	const VERTEX_ATTR& position,
+	Attribute<InsideTypeOf<VERTEX_ATTR>, Orbit::PHI1>* face_normal,
+	std::vector<InsideTypeOf<VERTEX_ATTR>>* corners,
+	std::false_type
+)
+{
+	using VEC3 = InsideTypeOf<VERTEX_ATTR>;
+	using Scalar = ScalarOf<VEC3>;
+	using Vertex = typename MAP::Vertex;
+
+	map.parallel_foreach_cell([&] (Cell<Orbit::PHI1> f)
+	{
+		const VEC3 n = normal(map, f, position);
+		if (face_normal)
+			(*face_normal)[f] = n;
+		if (corners)
+		{
+			const Scalar a = convex_area(map, f, position);
+			map.foreach_dart_of_orbit(f, [&] (Dart d)
+			{
+				const VEC3& p = position[Vertex(d)];
+				const Scalar l = (position[Vertex(map.phi1(d))] - p).squaredNorm() * (position[Vertex(map.phi_1(d))] - p).squaredNorm();
+				(*corners)[d.index] = l != Scalar(0) ? VEC3(n * (a / l)) : n;
+			});
+		}
+	});
+}
+
+/**
+ * \brief second phase of the batched normal computation: each vertex gathers the contributions
+ * of its darts (a CSR traversal of the topology, no concurrent write)
+ */
+template <typename MAP, typename VEC3>
+inline void gather_corner_normals(
+	const MAP& map,
+	const std::vector<VEC3>& corners,
+	Attribute<VEC3, Orbit::PHI21>& vertex_normal
+)
+{
+	using Scalar = ScalarOf<VEC3>;
+
+	map.parallel_foreach_cell([&] (Cell<Orbit::PHI21> v)
+	{
+		VEC3 n{Scalar(0), Scalar(0), Scalar(0)};
+		map.foreach_dart_of_orbit(v, [&] (Dart d)
+		{
+			if (!map.is_boundary(d))
+				n += corners[d.index];
+		});
+		normalize_safe(n);
+		vertex_normal[v] = n;
+	});
+}
+
+template <typename MAP, typename VERTEX_ATTR>
+inline void batched_normals(
+	const MAP& map,
+	const VERTEX_ATTR& position,
+	Attribute<InsideTypeOf<VERTEX_ATTR>, Orbit::PHI1>* face_normal,
+	Attribute<InsideTypeOf<VERTEX_ATTR>, Orbit::PHI21>* vertex_normal
+)
+{
+	using VEC3 = InsideTypeOf<VERTEX_ATTR>;
+	using IsTriangleMap = std::integral_constant<bool, MAP::PRIM_SIZE == 3u>;
+
+	std::vector<VEC3> corners;
+	if (vertex_normal)
+		corners.resize(map.topology_container().end());
+	corner_normals(map, position, face_normal, vertex_normal ? &corners : nullptr, IsTriangleMap());
+	if (vertex_normal)
+		gather_corner_normals(map, corners, *vertex_normal);
+}
+
+} // namespace internal
+
 template <typename MAP, typename VERTEX_ATTR, typename MASK>
 inline void compute_normal(
 	const MAP& map,
@@ -167,7 +360,7 @@ inline void compute_normal(
 {
 	static_assert(is_orbit_of<VERTEX_ATTR, MAP::Vertex::ORBIT>::value,"position must be a vertex attribute");
 
-	compute_normal(map, AllCellsFilter(), position, face_normal);
+	internal::batched_normals(map, position, &face_normal, nullptr);
 }
 
 template <typename MAP, typename VERTEX_ATTR, typename MASK>
@@ -197,7 +390,7 @@ inline void compute_normal(
 {
 	static_assert(is_orbit_of<VERTEX_ATTR, MAP::Vertex::ORBIT>::value,"position must be a vertex attribute");
 
-	compute_normal(map, AllCellsFilter(), position, vertex_normal);
+	internal::batched_normals(map, position, nullptr, &vertex_normal);
 }
 
 
@@ -233,6 +426,63 @@ inline void compute_normal(
 	compute_normal(map, AllCellsFilter(), position, face_normal, vertex_normal);
 }
 
+/**
+ * \brief compute the face and the vertex normals of the whole map in a single pass
+ */
+template <typename MAP, typename VERTEX_ATTR>
+inline void compute_normals(
+	const MAP& map,
+	const VERTEX_ATTR& position,
+	Attribute<InsideTypeOf<VERTEX_ATTR>, Orbit::PHI1>& face_normal,
+	Attribute<InsideTypeOf<VERTEX_ATTR>, Orbit::PHI21>& vertex_normal
+)
+{
+	static_assert(is_orbit_of<VERTEX_ATTR, MAP::Vertex::ORBIT>::value,"position must be a vertex attribute");
+
+	internal::batched_normals(map, position, &face_normal, &vertex_normal);
+}
+
+/**
+ * \brief estimate the vertex normals of a point set (or of any map) by principal component analysis:
+ * the normal of a vertex is the direction of least variance of its k nearest neighbors.
+ * The PCA gives no orientation: a normal is flipped to agree with the previous value of vertex_normal
+ * when this one is not null (e.g. a scanner view direction), otherwise its orientation is arbitrary.
+ */
+template <typename MAP, typename VEC3>
+inline void compute_normal_pca(
+	const KDTree<MAP, VEC3>& kdtree,
+	uint32 k,
+	typename MAP::template VertexAttribute<VEC3>& vertex_normal
+)
+{
+	using Scalar = ScalarOf<VEC3>;
+	using Vertex = typename MAP::Vertex;
+	using Matrix3 = Eigen::Matrix<Scalar, 3, 3>;
+
+	const typename MAP::template VertexAttribute<VEC3>& position = kdtree.position();
+
+	kdtree.parallel_foreach_knn(k, [&] (Vertex v, const std::vector<Vertex>& neighbors)
+	{
+		VEC3 c = VEC3::Zero();
+		for (Vertex n : neighbors)
+			c += position[n];
+		c /= Scalar(neighbors.size());
+
+		Matrix3 cov = Matrix3::Zero();
+		for (Vertex n : neighbors)
+		{
+			const VEC3 d = position[n] - c;
+			cov += d * d.transpose();
+		}
+
+		Eigen::SelfAdjointEigenSolver<Matrix3> solver(cov);
+		VEC3 n = solver.eigenvectors().col(0); // eigenvalues are sorted in increasing order
+		if (n.dot(vertex_normal[v]) < Scalar(0))
+			n = -n;
+		vertex_normal[v] = n;
+	});
+}
+
 } // namespace geometry
 
 } // namespace cgogn
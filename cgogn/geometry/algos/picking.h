@@ -34,6 +34,7 @@
 #include <cgogn/geometry/functions/intersection.h>
 #include <cgogn/geometry/functions/distance.h>
 #include <cgogn/geometry/algos/ear_triangulation.h>
+#include <cgogn/geometry/algos/face_bvh.h>
 
 #include <tuple>
 
@@ -117,23 +118,37 @@ inline void picking_internal_face(
 	std::sort(selected.begin(), selected.end(), dist_sort);
 }
 
+/**
+ * \brief same as picking_internal_face, only the faces of the leaves of the BVH crossed by the ray are tested
+ */
+template <typename MAP, typename VEC3>
+inline void picking_internal_face(
+	const FaceBVH<MAP, VEC3>& bvh,
+	const VEC3& A,
+	const VEC3& B,
+	typename std::vector<std::tuple<typename MAP::Face, VEC3, ScalarOf<VEC3>>>& selected
+)
+{
+	using Hit = typename FaceBVH<MAP, VEC3>::Hit;
+
+	VEC3 AB = B - A ;
+	cgogn_message_assert(AB.squaredNorm() > 0.0, "line must be defined by 2 different points");
+
+	std::vector<Hit> hits;
+	bvh.intersect_ray_all(A, AB, hits);
+	for (const Hit& h : hits)
+		selected.push_back(std::make_tuple(h.face, h.point, h.distance * h.distance));
+}
+
 template <typename MAP, typename VERTEX_ATTR>
-bool picking(
-	const MAP& m,
-	const VERTEX_ATTR& position,
-	const InsideTypeOf<VERTEX_ATTR>& A,
-	const InsideTypeOf<VERTEX_ATTR>& B,
+bool picked_cells(
+	const MAP& /*m*/,
+	const VERTEX_ATTR& /*position*/,
+	const std::vector<std::tuple<typename MAP::Face, InsideTypeOf<VERTEX_ATTR>, ScalarOf<InsideTypeOf<VERTEX_ATTR>>>>& sel,
 	typename std::vector<typename MAP::Face>& selected
 )
 {
 	static_assert(is_orbit_of<VERTEX_ATTR, MAP::Vertex::ORBIT>::value,"position must be a vertex attribute");
-	using VEC3 = InsideTypeOf<VERTEX_ATTR>;
-	using Scalar = ScalarOf<VEC3>;
-	using Face = typename MAP::Face;
-	using Triplet = typename std::tuple<Face, VEC3, Scalar>;
-
-	std::vector<Triplet> sel;
-	picking_internal_face(m, position, A, B, sel);
 
 	selected.clear();
 	for (const auto& fs : sel)
@@ -143,11 +158,10 @@ bool picking(
 }
 
 template <typename MAP, typename VERTEX_ATTR>
-bool picking(
+bool picked_cells(
 	const MAP& m,
 	const VERTEX_ATTR& position,
-	const InsideTypeOf<VERTEX_ATTR>& A,
-	const InsideTypeOf<VERTEX_ATTR>& B,
+	const std::vector<std::tuple<typename MAP::Face, InsideTypeOf<VERTEX_ATTR>, ScalarOf<InsideTypeOf<VERTEX_ATTR>>>>& sel,
 	typename std::vector<typename MAP::Vertex>& selected
 )
 {
@@ -157,10 +171,6 @@ bool picking(
 	using Scalar = ScalarOf<VEC3>;
 	using Vertex = typename MAP::Vertex;
 	using Face = typename MAP::Face;
-	using Triplet = typename std::tuple<Face, VEC3, Scalar>;
-
-	std::vector<Triplet> sel;
-	picking_internal_face(m, position, A, B, sel);
 
 	DartMarkerStore<MAP> dm(m);
 	selected.clear();
@@ -193,11 +203,10 @@ bool picking(
 }
 
 template <typename MAP, typename VERTEX_ATTR>
-bool picking(
+bool picked_cells(
 	const MAP& m,
 	const VERTEX_ATTR& position,
-	const InsideTypeOf<VERTEX_ATTR>& A,
-	const InsideTypeOf<VERTEX_ATTR>& B,
+	const std::vector<std::tuple<typename MAP::Face, InsideTypeOf<VERTEX_ATTR>, ScalarOf<InsideTypeOf<VERTEX_ATTR>>>>& sel,
 	typename std::vector<typename MAP::Edge>& selected
 )
 {
@@ -207,10 +216,6 @@ bool picking(
 	using Vertex = typename MAP::Vertex;
 	using Edge = typename MAP::Edge;
 	using Face = typename MAP::Face;
-	using Triplet = typename std::tuple<Face, VEC3, Scalar>;
-
-	std::vector<Triplet> sel;
-	picking_internal_face(m, position, A, B, sel);
 
 	DartMarkerStore<MAP> dm(m);
 	selected.clear();
@@ -245,23 +250,16 @@ bool picking(
 }
 
 template <typename MAP, typename VERTEX_ATTR>
-bool picking(
+bool picked_cells(
 	const MAP& m,
 	const VERTEX_ATTR& position,
-	const InsideTypeOf<VERTEX_ATTR>& A,
-	const InsideTypeOf<VERTEX_ATTR>& B,
+	const std::vector<std::tuple<typename MAP::Face, InsideTypeOf<VERTEX_ATTR>, ScalarOf<InsideTypeOf<VERTEX_ATTR>>>>& sel,
 	typename std::vector<typename MAP::Volume>& selected
 )
 {
 	static_assert(is_orbit_of<VERTEX_ATTR, MAP::Vertex::ORBIT>::value,"position must be a vertex attribute");
-	using VEC3 = InsideTypeOf<VERTEX_ATTR>;
-	using Scalar = ScalarOf<VEC3>;
 	using Face = typename MAP::Face;
 	using Volume = typename MAP::Volume;
-	using Triplet = typename std::tuple<Face, VEC3, Scalar>;
-
-	std::vector<Triplet> sel;
-	picking_internal_face(m, position, A, B, sel);
 
 	selected.clear();
 	DartMarker<MAP> dm(m);
@@ -281,6 +279,52 @@ bool picking(
 	return !selected.empty();
 }
 
+/**
+ * \brief picking of the cells (Vertex, Edge, Face or Volume) of the faces crossed by the ray (A,B)
+ * @param selected [out] the selected cells, sorted by increasing distance to A
+ * @return true if some cells are selected
+ */
+template <typename MAP, typename VERTEX_ATTR, typename CELL>
+bool picking(
+	const MAP& m,
+	const VERTEX_ATTR& position,
+	const InsideTypeOf<VERTEX_ATTR>& A,
+	const InsideTypeOf<VERTEX_ATTR>& B,
+	typename std::vector<CELL>& selected
+)
+{
+	static_assert(is_orbit_of<VERTEX_ATTR, MAP::Vertex::ORBIT>::value,"position must be a vertex attribute");
+	using VEC3 = InsideTypeOf<VERTEX_ATTR>;
+	using Scalar = ScalarOf<VEC3>;
+	using Face = typename MAP::Face;
+	using Triplet = typename std::tuple<Face, VEC3, Scalar>;
+
+	std::vector<Triplet> sel;
+	picking_internal_face(m, position, A, B, sel);
+	return picked_cells(m, position, sel, selected);
+}
+
+/**
+ * \brief picking of the cells (Vertex, Edge, Face or Volume) of the faces crossed by the ray (A,B), accelerated by a FaceBVH
+ * The selected cells are the same as the ones given by the picking function that tests all the faces.
+ */
+template <typename MAP, typename VEC3, typename CELL>
+bool picking(
+	const FaceBVH<MAP, VEC3>& bvh,
+	const VEC3& A,
+	const VEC3& B,
+	typename std::vector<CELL>& selected
+)
+{
+	using Scalar = ScalarOf<VEC3>;
+	using Face = typename MAP::Face;
+	using Triplet = typename std::tuple<Face, VEC3, Scalar>;
+
+	std::vector<Triplet> sel;
+	picking_internal_face(bvh, A, B, sel);
+	return picked_cells(bvh.map(), bvh.position(), sel, selected);
+}
+
 } // namespace geometry
 
 } // namespace cgogn
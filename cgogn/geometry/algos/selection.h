@@ -29,6 +29,7 @@
 #include <cgogn/core/cmap/attribute.h>
 #include <cgogn/geometry/types/geometry_traits.h>
 #include <cgogn/geometry/algos/area.h>
+#include <cgogn/geometry/algos/kdtree.h>
 #include <cgogn/geometry/functions/inclusion.h>
 #include <cgogn/geometry/functions/intersection.h>
 
@@ -218,7 +219,8 @@ public:
 		const typename MAP::template VertexAttribute<VEC3>& position
 	) : Inherit(map),
 		radius_(radius),
-		position_(position)
+		position_(position),
+		dm_(map)
 	{}
 
 	CGOGN_NOT_COPYABLE_NOR_MOVABLE(Collector_WithinSphere);
@@ -230,43 +232,6 @@ public:
 
 		const VEC3& center_position = position_[center];
 
-		typename MAP::DartMarkerStore dm(this->map_);
-
-		auto mark_vertex = [&] (Vertex v)
-		{
-			this->map_.foreach_dart_of_orbit(v, [&] (Dart d)
-			{
-				// mark a dart of the vertex
-				dm.mark(d);
-
-				// check if the edge of d is now completely marked
-				// (which means all the vertices of the edge are in the sphere)
-				Edge e(d);
-				bool all_in = true;
-				this->map_.foreach_dart_of_orbit(e, [&] (Dart dd) -> bool
-				{
-					if (!dm.is_marked(dd))
-						all_in = false;
-					return all_in;
-				});
-				if (all_in)
-					this->cells_[Edge::ORBIT].push_back(d);
-
-				// check if the face of d is now completely marked
-				// (which means all the vertices of the face are in the sphere)
-				Face f(d);
-				all_in = true;
-				this->map_.foreach_dart_of_orbit(f, [&] (Dart dd) -> bool
-				{
-					if (!dm.is_marked(dd))
-						all_in = false;
-					return all_in;
-				});
-				if (all_in)
-					this->cells_[Face::ORBIT].push_back(d);
-			});
-		};
-
 		this->cells_[Vertex::ORBIT].push_back(center.dart);
 		mark_vertex(center);
 
@@ -280,7 +245,7 @@ public:
 				// if it is in the sphere and has not been marked yet, put it in the queue
 				if (in_sphere(position_[av], center_position, radius_))
 				{
-					if (!dm.is_marked(av.dart))
+					if (!dm_.is_marked(av.dart))
 					{
 						this->cells_[Vertex::ORBIT].push_back(av.dart);
 						mark_vertex(av);
@@ -293,6 +258,7 @@ public:
 
 			++i;
 		}
+		dm_.unmark_all();
 
 		this->traversed_cells_ |= orbit_mask<Vertex>() | orbit_mask<Edge>() | orbit_mask<Face>();
 	}
@@ -331,8 +297,117 @@ public:
 
 protected:
 
+	/**
+	 * \brief mark the darts of v and collect the edges and faces of v that are now completely marked
+	 */
+	void mark_vertex(Vertex v)
+	{
+		this->map_.foreach_dart_of_orbit(v, [&] (Dart d)
+		{
+			// mark a dart of the vertex
+			dm_.mark(d);
+
+			// check if the edge of d is now completely marked
+			// (which means all the vertices of the edge are in the sphere)
+			Edge e(d);
+			bool all_in = true;
+			this->map_.foreach_dart_of_orbit(e, [&] (Dart dd) -> bool
+			{
+				if (!dm_.is_marked(dd))
+					all_in = false;
+				return all_in;
+			});
+			if (all_in)
+				this->cells_[Edge::ORBIT].push_back(d);
+
+			// check if the face of d is now completely marked
+			// (which means all the vertices of the face are in the sphere)
+			Face f(d);
+			all_in = true;
+			this->map_.foreach_dart_of_orbit(f, [&] (Dart dd) -> bool
+			{
+				if (!dm_.is_marked(dd))
+					all_in = false;
+				return all_in;
+			});
+			if (all_in)
+				this->cells_[Face::ORBIT].push_back(d);
+		});
+	}
+
 	Scalar radius_;
 	const typename MAP::template VertexAttribute<VEC3>& position_;
+
+	// reused by each collect and unmarked at its end (only the marked darts are cleared)
+	typename MAP::DartMarkerStore dm_;
+};
+
+/**
+ * \brief The Collector_WithinRadius class collects the vertices at a Euclidean distance lower than radius
+ * from the center, with a k-d tree query instead of a region growing over the topology
+ * (so the collected vertices need not be connected to the center inside of the sphere).
+ * Edges and faces are collected when all their vertices are in the sphere, the area is computed as in Collector_WithinSphere.
+ */
+template <typename VEC3, typename MAP>
+class Collector_WithinRadius : public Collector_WithinSphere<VEC3, MAP>
+{
+public:
+
+	using Self = Collector_WithinRadius<VEC3, MAP>;
+	using Inherit = Collector_WithinSphere<VEC3, MAP>;
+
+	using Scalar = ScalarOf<VEC3>;
+	using Vertex = typename MAP::Vertex;
+	using Edge = typename MAP::Edge;
+	using Face = typename MAP::Face;
+
+	using Inherit::collect;
+	using Inherit::area;
+
+	Collector_WithinRadius(const KDTree<MAP, VEC3>& kdtree, const Scalar radius) :
+		Inherit(kdtree.map(), radius, kdtree.position()),
+		kdtree_(kdtree)
+	{}
+
+	CGOGN_NOT_COPYABLE_NOR_MOVABLE(Collector_WithinRadius);
+
+	void collect(const Vertex center) override
+	{
+		this->clear();
+		this->center_ = center.dart;
+
+		const VEC3& center_position = this->position_[center];
+		kdtree_.find_within_radius(center_position, this->radius_, neighbors_);
+
+		this->cells_[Vertex::ORBIT].push_back(center.dart);
+		this->mark_vertex(center);
+		for (Vertex v : neighbors_)
+		{
+			if (!this->dm_.is_marked(v.dart))
+			{
+				this->cells_[Vertex::ORBIT].push_back(v.dart);
+				this->mark_vertex(v);
+			}
+		}
+
+		// darts of the edges pointing out of the sphere
+		for (Dart d : this->cells_[Vertex::ORBIT])
+		{
+			this->map_.foreach_adjacent_vertex_through_edge(Vertex(d), [&] (Vertex av)
+			{
+				if (!this->dm_.is_marked(av.dart))
+					this->border_.push_back(this->map_.phi2(av.dart));
+			});
+		}
+		this->dm_.unmark_all();
+
+		this->traversed_cells_ |= orbit_mask<Vertex>() | orbit_mask<Edge>() | orbit_mask<Face>();
+	}
+
+protected:
+
+	const KDTree<MAP, VEC3>& kdtree_;
+	std::vector<Vertex> neighbors_;
 };
 
 #if defined(CGOGN_USE_EXTERNAL_TEMPLATES) && (!defined(CGOGN_GEOMETRY_EXTERNAL_TEMPLATES_CPP_))
@@ -0,0 +1,579 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef CGOGN_GEOMETRY_ALGOS_VOLUME_BVH_H_
+#define CGOGN_GEOMETRY_ALGOS_VOLUME_BVH_H_
+
+#include <array>
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <future>
+
+#include <cgogn/core/utils/numerics.h>
+#include <cgogn/core/utils/thread.h>
+#include <cgogn/core/utils/thread_pool.h>
+#include <cgogn/core/utils/parallel_foreach_element.h>
+#include <cgogn/core/basic/cell.h>
+
+#include <cgogn/geometry/types/eigen.h>
+#include <cgogn/geometry/types/geometry_traits.h>
+
+namespace cgogn
+{
+
+namespace geometry
+{
+
+/**
+ * \brief The VolumeBVH class locates points in the volumes of a 3D map.
+ * Volumes are decomposed into tetrahedra: tetrahedra are kept as they are, other volumes are
+ * fanned from one of their vertices over their (fan triangulated) faces, which is valid for convex volumes.
+ * The tetrahedra are sorted by a median split bounding volume hierarchy (the ranges below the upper levels
+ * are split in parallel) and know their neighbors through their faces, so that a query can walk from the
+ * tetrahedron of a previous query before falling back to the hierarchy.
+ * The returned barycentric coordinates refer to the 4 vertices of the tetrahedron containing the point,
+ * interpolation is thus linear in tetrahedra and piecewise linear in other volumes.
+ * After moving vertices or changing the topology, build() must be called again.
+ */
+template <typename MAP, typename VEC3>
+class VolumeBVH
+{
+	static_assert(MAP::DIMENSION == 3, "VolumeBVH works only with 3D Maps.");
+
+public:
+
+	using Self = VolumeBVH<MAP, VEC3>;
+	using Scalar = ScalarOf<VEC3>;
+	using Vertex = typename MAP::Vertex;
+	using Face = typename MAP::Face;
+	using Volume = typename MAP::Volume;
+	using VertexAttribute = typename MAP::template VertexAttribute<VEC3>;
+
+	static const uint32 LEAF_SIZE = 4u;
+	static const uint32 MAX_WALK_STEPS = 64u;
+
+	/**
+	 * \brief location of a point in a volume
+	 */
+	struct Location
+	{
+		Volume volume;
+		uint32 tetra; // INVALID_INDEX if the point is not in the map
+		std::array<uint32, 4> vertices; // vertex embeddings of the tetrahedron
+		std::array<Scalar, 4> barycentric; // coordinates of the point w.r.t. these vertices
+	};
+
+	inline VolumeBVH(const MAP& map, const VertexAttribute& position) :
+		map_(map),
+		position_(position)
+	{
+		build();
+	}
+
+	CGOGN_NOT_COPYABLE_NOR_MOVABLE(VolumeBVH);
+
+	inline const MAP& map() const { return map_; }
+
+	inline const VertexAttribute& position() const { return position_; }
+
+	inline uint32 nb_tetras() const { return uint32(tetras_.size()); }
+
+	inline uint32 nb_nodes() const { return uint32(nodes_.size()); }
+
+	/**
+	 * \brief (re)build the tetrahedra, the hierarchy and the adjacency of the tetrahedra
+	 */
+	void build()
+	{
+		nodes_.clear();
+		tetrahedralize();
+
+		const uint32 nb = nb_tetras();
+		if (nb == 0u)
+		{
+			inverses_.clear();
+			neighbors_.clear();
+			return;
+		}
+
+		centroids_.resize(nb);
+		order_.resize(nb);
+		parallel_foreach_index(0u, nb, [&] (uint32 t)
+		{
+			const std::array<uint32, 4>& tet = tetras_[t];
+			centroids_[t] = (position_[tet[0]] + position_[tet[1]] + position_[tet[2]] + position_[tet[3]]) / Scalar(4);
+			order_[t] = t;
+		});
+
+		// the upper levels are split here, ranges smaller than task_size are deferred
+		const uint32 nb_workers = thread_pool()->nb_workers();
+		const uint32 task_size = nb_workers > 0u ? std::max(4096u, nb / (4u * nb_workers)) : nb;
+		std::vector<std::pair<uint32, uint32>> tasks;
+		split_range(0u, nb, &tasks, task_size);
+
+		if (nb_workers == 0u || tasks.size() < 2u)
+		{
+			for (const auto& t : tasks)
+				split_range(t.first, t.second, nullptr, 0u);
+		}
+		else
+		{
+			std::vector<std::future<void>> futures;
+			futures.reserve(tasks.size());
+			for (const auto& t : tasks)
+				futures.push_back(thread_pool()->enqueue([this, t] () { split_range(t.first, t.second, nullptr, 0u); }));
+			for (auto& fu : futures)
+				fu.wait();
+		}
+
+		// leaves address contiguous ranges of tetrahedra
+		std::vector<std::array<uint32, 4>> tetras(nb);
+		std::vector<Volume> volumes(nb);
+		parallel_foreach_index(0u, nb, [&] (uint32 i)
+		{
+			tetras[i] = tetras_[order_[i]];
+			volumes[i] = volumes_[order_[i]];
+		});
+		tetras_.swap(tetras);
+		volumes_.swap(volumes);
+		std::vector<VEC3>().swap(centroids_);
+		std::vector<uint32>().swap(order_);
+
+		nodes_.reserve(2u * (nb / LEAF_SIZE + 1u));
+		build_node(0u, nb);
+
+		inverses_.resize(nb);
+		parallel_foreach_index(0u, nb, [&] (uint32 t)
+		{
+			const std::array<uint32, 4>& tet = tetras_[t];
+			const VEC3& a = position_[tet[0]];
+			Matrix3 m;
+			m.col(0) = position_[tet[1]] - a;
+			m.col(1) = position_[tet[2]] - a;
+			m.col(2) = position_[tet[3]] - a;
+			inverses_[t] = m.inverse();
+		});
+
+		compute_neighbors();
+	}
+
+	/**
+	 * \brief locate P
+	 * \param[out] loc the volume and the barycentric coordinates of P
+	 * \param[in] hint a tetrahedron near P (e.g. the one of a previous location) to walk from
+	 * \return false if P is not in a volume of the map
+	 */
+	bool locate(const VEC3& P, Location& loc, uint32 hint = INVALID_INDEX) const
+	{
+		uint32 t = INVALID_INDEX;
+		if (hint < nb_tetras())
+			t = walk(P, hint, loc.barycentric);
+		if (t == INVALID_INDEX)
+			t = search(P, loc.barycentric);
+
+		loc.tetra = t;
+		if (t == INVALID_INDEX)
+		{
+			loc.volume = Volume();
+			return false;
+		}
+		loc.volume = volumes_[t];
+		loc.vertices = tetras_[t];
+		return true;
+	}
+
+	/**
+	 * \brief locate in parallel a set of points (the queries of a thread walk from its previous location)
+	 * \return the number of located points
+	 */
+	uint32 locate(const std::vector<VEC3>& points, std::vector<Location>& locations) const
+	{
+		locations.resize(points.size());
+		std::vector<uint32> last_th(thread_pool()->nb_workers() + 1u, INVALID_INDEX);
+		std::vector<uint32> nb_located_th(thread_pool()->nb_workers() + 1u, 0u);
+		parallel_foreach_index(0u, uint32(points.size()), [&] (uint32 i)
+		{
+			const uint32 th = current_thread_index();
+			if (locate(points[i], locations[i], last_th[th]))
+			{
+				last_th[th] = locations[i].tetra;
+				++nb_located_th[th];
+			}
+		});
+
+		uint32 nb_located = 0u;
+		for (uint32 n : nb_located_th)
+			nb_located += n;
+		return nb_located;
+	}
+
+	/**
+	 * \brief interpolate a vertex attribute at a located point
+	 */
+	template <typename T>
+	inline T interpolate(const Location& loc, const typename MAP::template VertexAttribute<T>& attribute) const
+	{
+		cgogn_message_assert(loc.tetra != INVALID_INDEX, "interpolate: the point is not located");
+		return attribute[loc.vertices[0]] * loc.barycentric[0] + attribute[loc.vertices[1]] * loc.barycentric[1] +
+			attribute[loc.vertices[2]] * loc.barycentric[2] + attribute[loc.vertices[3]] * loc.barycentric[3];
+	}
+
+	/**
+	 * \brief interpolate in parallel a vertex attribute at a set of located points
+	 * \param[in] outside the value given to the points that are not in the map
+	 */
+	template <typename T>
+	void interpolate(const std::vector<Location>& locations, const typename MAP::template VertexAttribute<T>& attribute, std::vector<T>& values, const T& outside) const
+	{
+		values.resize(locations.size());
+		parallel_foreach_index(0u, uint32(locations.size()), [&] (uint32 i)
+		{
+			values[i] = locations[i].tetra != INVALID_INDEX ? interpolate(locations[i], attribute) : outside;
+		});
+	}
+
+private:
+
+	using Matrix3 = Eigen::Matrix<Scalar, 3, 3>;
+
+	struct Node
+	{
+		VEC3 min;
+		VEC3 max;
+		uint32 left;
+		uint32 right;
+		uint32 first;
+		uint32 count; // 0 for internal nodes
+	};
+
+	inline uint32 embedding(Dart d) const
+	{
+		return map_.embedding(Vertex(d));
+	}
+
+	/**
+	 * \brief call f(d) on a dart of each face of w that is not incident to the vertex of w.dart
+	 */
+	template <typename FUNC>
+	inline void foreach_opposite_face(Volume w, const FUNC& f) const
+	{
+		const uint32 e0 = embedding(w.dart);
+		map_.foreach_incident_face(w, [&] (Face fa)
+		{
+			Dart it = fa.dart;
+			do
+			{
+				if (embedding(it) == e0)
+					return;
+				it = map_.phi1(it);
+			} while (it != fa.dart);
+			f(fa.dart);
+		});
+	}
+
+	/**
+	 * \brief decompose the volumes into tetrahedra (volumes fanned from their first vertex)
+	 */
+	void tetrahedralize()
+	{
+		std::vector<Volume> volumes;
+		volumes.reserve(map_.template nb_cells<Volume::ORBIT>());
+		map_.foreach_cell([&] (Volume w) { volumes.push_back(w); });
+		const uint32 nb_volumes = uint32(volumes.size());
+
+		std::vector<uint32> offsets(nb_volumes + 1u, 0u);
+		parallel_foreach_index(0u, nb_volumes, [&] (uint32 i)
+		{
+			uint32 nb = 0u;
+			foreach_opposite_face(volumes[i], [&] (Dart d) { nb += map_.codegree(Face(d)) - 2u; });
+			offsets[i + 1u] = nb;
+		});
+		for (uint32 i = 1u; i <= nb_volumes; ++i)
+			offsets[i] += offsets[i - 1u];
+
+		std::vector<std::array<uint32, 4>> tetras(offsets[nb_volumes]);
+		std::vector<Volume> tetra_volumes(offsets[nb_volumes]);
+		std::vector<uint8> degenerate(offsets[nb_volumes], 0u);
+		std::vector<Scalar> det(offsets[nb_volumes]);
+		parallel_foreach_index(0u, nb_volumes, [&] (uint32 i)
+		{
+			const Volume w = volumes[i];
+			const uint32 e0 = embedding(w.dart);
+			const VEC3& p0 = position_[e0];
+			uint32 k = offsets[i];
+			foreach_opposite_face(w, [&] (Dart d)
+			{
+				Dart it = map_.phi1(d);
+				for (Dart next = map_.phi1(it); next != d; it = next, next = map_.phi1(next), ++k)
+				{
+					tetras[k] = {{ e0, embedding(d), embedding(it), embedding(next) }};
+					tetra_volumes[k] = w;
+					const VEC3 u = position_[tetras[k][1]] - p0;
+					const VEC3 v = position_[tetras[k][2]] - p0;
+					const VEC3 n = position_[tetras[k][3]] - p0;
+					det[k] = u.dot(v.cross(n));
+					// flat relative to the length of its edges (independent of the scale of the model)
+					degenerate[k] = std::abs(det[k]) <= tolerance() * u.norm() * v.norm() * n.norm();
+				}
+			});
+
+			// the fan of a non convex volume contains tetrahedra oriented against the volume:
+			// the points they cover are also covered by a well oriented tetrahedron of the fan when they are inside the volume
+			Scalar volume = Scalar(0);
+			for (uint32 t = offsets[i]; t < offsets[i + 1u]; ++t)
+				volume += det[t];
+			for (uint32 t = offsets[i]; t < offsets[i + 1u]; ++t)
+			{
+				if (det[t] * volume < Scalar(0))
+					degenerate[t] = 1u;
+			}
+		});
+
+		// flat tetrahedra and tetrahedra inverted with respect to their volume (non convex volumes) are removed
+		uint32 nb = 0u;
+		for (uint32 t = 0u; t < uint32(tetras.size()); ++t)
+		{
+			if (!degenerate[t])
+			{
+				tetras[nb] = tetras[t];
+				tetra_volumes[nb] = tetra_volumes[t];
+				++nb;
+			}
+		}
+		tetras.resize(nb);
+		tetra_volumes.resize(nb);
+		tetras_.swap(tetras);
+		volumes_.swap(tetra_volumes);
+	}
+
+	/**
+	 * \brief put the median of the centroids of order_[first,last[ in the middle along their largest extent and recurse
+	 * (ranges smaller than task_size are appended to tasks when it is given)
+	 */
+	void split_range(uint32 first, uint32 last, std::vector<std::pair<uint32, uint32>>* tasks, uint32 task_size)
+	{
+		if (last - first <= LEAF_SIZE)
+			return;
+
+		if (tasks && last - first <= task_size)
+		{
+			tasks->push_back(std::make_pair(first, last));
+			return;
+		}
+
+		VEC3 cmin = centroids_[order_[first]];
+		VEC3 cmax = cmin;
+		for (uint32 i = first + 1u; i < last; ++i)
+			grow(cmin, cmax, centroids_[order_[i]]);
+		uint32 axis = 0u;
+		for (uint32 c = 1u; c < 3u; ++c)
+			if (cmax[c] - cmin[c] > cmax[axis] - cmin[axis])
+				axis = c;
+
+		const uint32 mid = first + (last - first) / 2u;
+		std::nth_element(order_.begin() + first, order_.begin() + mid, order_.begin() + last, [&] (uint32 a, uint32 b)
+		{
+			return centroids_[a][axis] < centroids_[b][axis];
+		});
+
+		split_range(first, mid, tasks, task_size);
+		split_range(mid, last, tasks, task_size);
+	}
+
+	/**
+	 * \brief build the node of the (already split) range [first,last[ of tetrahedra
+	 * \return the index of the node
+	 */
+	uint32 build_node(uint32 first, uint32 last)
+	{
+		const uint32 n = uint32(nodes_.size());
+		nodes_.resize(n + 1u);
+		if (last - first <= LEAF_SIZE)
+		{
+			Node& node = nodes_[n];
+			node.min = position_[tetras_[first][0]];
+			node.max = node.min;
+			for (uint32 t = first; t < last; ++t)
+				for (uint32 k = 0u; k < 4u; ++k)
+					grow(node.min, node.max, position_[tetras_[t][k]]);
+			node.first = first;
+			node.count = last - first;
+			return n;
+		}
+
+		const uint32 mid = first + (last - first) / 2u;
+		const uint32 left = build_node(first, mid);
+		const uint32 right = build_node(mid, last);
+		Node& node = nodes_[n];
+		node.left = left;
+		node.right = right;
+		node.count = 0u;
+		node.min = nodes_[left].min;
+		node.max = nodes_[left].max;
+		grow(node.min, node.max, nodes_[right].min);
+		grow(node.min, node.max, nodes_[right].max);
+		return n;
+	}
+
+	/**
+	 * \brief neighbors_[4t+k] is the tetrahedron adjacent to t through the face opposite to its vertex k
+	 */
+	void compute_neighbors()
+	{
+		const uint32 nb = nb_tetras();
+		std::vector<std::pair<std::array<uint32, 3>, uint32>> faces(4u * nb);
+		parallel_foreach_index(0u, nb, [&] (uint32 t)
+		{
+			const std::array<uint32, 4>& tet = tetras_[t];
+			for (uint32 k = 0u; k < 4u; ++k)
+			{
+				std::array<uint32, 3> f = {{ tet[(k + 1u) % 4u], tet[(k + 2u) % 4u], tet[(k + 3u) % 4u] }};
+				std::sort(f.begin(), f.end());
+				faces[4u * t + k] = std::make_pair(f, 4u * t + k);
+			}
+		});
+		std::sort(faces.begin(), faces.end());
+
+		neighbors_.assign(4u * nb, INVALID_INDEX);
+		for (std::size_t i = 0u; i + 1u < faces.size(); ++i)
+		{
+			if (faces[i].first == faces[i + 1u].first)
+			{
+				neighbors_[faces[i].second] = faces[i + 1u].second / 4u;
+				neighbors_[faces[i + 1u].second] = faces[i].second / 4u;
+				++i;
+			}
+		}
+	}
+
+	static inline void grow(VEC3& min, VEC3& max, const VEC3& p)
+	{
+		for (uint32 c = 0u; c < 3u; ++c)
+		{
+			min[c] = std::min(min[c], p[c]);
+			max[c] = std::max(max[c], p[c]);
+		}
+	}
+
+	static inline bool in_box(const Node& n, const VEC3& P)
+	{
+		return
+			P[0] >= n.min[0] && P[0] <= n.max[0] &&
+			P[1] >= n.min[1] && P[1] <= n.max[1] &&
+			P[2] >= n.min[2] && P[2] <= n.max[2];
+	}
+
+	/**
+	 * \brief barycentric coordinates of P in the tetrahedron t
+	 * \return the smallest coordinate
+	 */
+	inline Scalar barycentric(uint32 t, const VEC3& P, std::array<Scalar, 4>& bc) const
+	{
+		const VEC3 l = inverses_[t] * (P - position_[tetras_[t][0]]);
+		bc[1] = l[0];
+		bc[2] = l[1];
+		bc[3] = l[2];
+		bc[0] = Scalar(1) - l[0] - l[1] - l[2];
+		return std::min(std::min(bc[0], bc[1]), std::min(bc[2], bc[3]));
+	}
+
+	static inline Scalar tolerance()
+	{
+		return Scalar(1e3) * std::numeric_limits<Scalar>::epsilon();
+	}
+
+	/**
+	 * \brief walk from t towards P, crossing the face opposite to the most negative coordinate
+	 * \return the tetrahedron containing P or INVALID_INDEX if the walk leaves the map or is too long
+	 */
+	uint32 walk(const VEC3& P, uint32 t, std::array<Scalar, 4>& bc) const
+	{
+		for (uint32 step = 0u; step < MAX_WALK_STEPS && t != INVALID_INDEX; ++step)
+		{
+			const Scalar min_bc = barycentric(t, P, bc);
+			if (min_bc >= -tolerance())
+				return t;
+			// a coordinate of -m means that P is about m tetrahedra away: too far to walk
+			if (step == 0u && min_bc < -Scalar(MAX_WALK_STEPS / 8u))
+				return INVALID_INDEX;
+			uint32 k = 0u;
+			for (uint32 j = 1u; j < 4u; ++j)
+				if (bc[j] < bc[k])
+					k = j;
+			t = neighbors_[4u * t + k];
+		}
+		return INVALID_INDEX;
+	}
+
+	/**
+	 * \brief find the tetrahedron containing P in the hierarchy
+	 */
+	uint32 search(const VEC3& P, std::array<Scalar, 4>& bc) const
+	{
+		if (nodes_.empty() || !in_box(nodes_[0u], P))
+			return INVALID_INDEX;
+
+		uint32 stack[64];
+		uint32 stack_size = 0u;
+		stack[stack_size++] = 0u;
+		while (stack_size > 0u)
+		{
+			const Node& n = nodes_[stack[--stack_size]];
+			if (n.count > 0u)
+			{
+				for (uint32 t = n.first; t < n.first + n.count; ++t)
+					if (barycentric(t, P, bc) >= -tolerance())
+						return t;
+			}
+			else
+			{
+				if (in_box(nodes_[n.right], P))
+					stack[stack_size++] = n.right;
+				if (in_box(nodes_[n.left], P))
+					stack[stack_size++] = n.left;
+			}
+		}
+		return INVALID_INDEX;
+	}
+
+	const MAP& map_;
+	const VertexAttribute& position_;
+
+	std::vector<Node> nodes_;
+	std::vector<std::array<uint32, 4>> tetras_; // vertex embeddings
+	std::vector<Volume> volumes_;
+	std::vector<Matrix3> inverses_; // inverse of the edge matrix (v1-v0, v2-v0, v3-v0) of the tetrahedra
+	std::vector<uint32> neighbors_;
+
+	// build data
+	std::vector<VEC3> centroids_;
+	std::vector<uint32> order_;
+};
+
+} // namespace geometry
+
+} // namespace cgogn
+
+#endif // CGOGN_GEOMETRY_ALGOS_VOLUME_BVH_H_
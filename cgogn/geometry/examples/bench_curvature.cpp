@@ -0,0 +1,102 @@
+
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include <cgogn/core/utils/logger.h>
+#include <cgogn/core/cmap/cmap2_tri.h>
+
+#include <cgogn/geometry/types/eigen.h>
+#include <cgogn/geometry/algos/angle.h>
+#include <cgogn/geometry/algos/normal.h>
+#include <cgogn/geometry/algos/curvature.h>
+
+using namespace cgogn::numerics;
+
+using Map2 = cgogn::CMap2Tri;
+using Vertex = Map2::Vertex;
+using Edge = Map2::Edge;
+using Vec3 = Eigen::Vector3d;
+
+using TimePoint = std::chrono::time_point<std::chrono::system_clock>;
+
+static float64 elapsed(const TimePoint& start)
+{
+	std::chrono::duration<float64> d = std::chrono::system_clock::now() - start;
+	return d.count();
+}
+
+int main(int argc, char** argv)
+{
+	uint32 n = 600u;
+	float64 radius = 0.1;
+	if (argc < 3)
+		cgogn_log_info("bench_curvature") << "USAGE: " << argv[0] << " [torus_size] [radius] (using " << n << " " << radius << ")";
+	else
+	{
+		n = std::max(4u, uint32(std::stoi(argv[1])));
+		radius = std::stod(argv[2]);
+	}
+
+	// closed triangulated torus, 2n x n vertices
+	const uint32 m = n;
+	n *= 2u;
+	std::vector<uint32> triangles;
+	triangles.reserve(6u * n * m);
+	for (uint32 j = 0u; j < m; ++j)
+	{
+		for (uint32 i = 0u; i < n; ++i)
+		{
+			const uint32 a = j * n + i;
+			const uint32 b = j * n + (i + 1u) % n;
+			const uint32 c = ((j + 1u) % m) * n + (i + 1u) % n;
+			const uint32 d = ((j + 1u) % m) * n + i;
+			triangles.insert(triangles.end(), { a, b, c, a, c, d });
+		}
+	}
+	Map2 map;
+	Map2::Builder builder(map);
+	const uint32 first = builder.create_faces_from_indices(triangles, n * m);
+	auto position = map.add_attribute<Vec3, Vertex>("position");
+	for (uint32 j = 0u; j < m; ++j)
+	{
+		for (uint32 i = 0u; i < n; ++i)
+		{
+			const float64 u = 2.0 * M_PI * float64(i) / float64(n);
+			const float64 v = 2.0 * M_PI * float64(j) / float64(m);
+			position[first + j * n + i] = Vec3((3.0 + std::cos(v)) * std::cos(u), (3.0 + std::cos(v)) * std::sin(u), std::sin(v));
+		}
+	}
+
+	auto normal = map.add_attribute<Vec3, Vertex>("normal");
+	auto edge_angle = map.add_attribute<float64, Edge>("edge_angle");
+	auto edge_area = map.add_attribute<float64, Edge>("edge_area");
+	auto kmax = map.add_attribute<float64, Vertex>("kmax");
+	auto kmin = map.add_attribute<float64, Vertex>("kmin");
+	auto Kmax = map.add_attribute<Vec3, Vertex>("Kmax");
+	auto Kmin = map.add_attribute<Vec3, Vertex>("Kmin");
+	auto Knormal = map.add_attribute<Vec3, Vertex>("Knormal");
+	cgogn::geometry::compute_normal(map, position, normal);
+	cgogn::geometry::compute_angle_between_face_normals(map, position, edge_angle);
+	cgogn_log_info("bench_curvature") << map.nb_cells<Vertex::ORBIT>() << " vertices";
+
+	// one collector per vertex
+	TimePoint start = std::chrono::system_clock::now();
+	map.parallel_foreach_cell([&] (Vertex v)
+	{
+		cgogn::geometry::curvature(map, v, radius, position, normal, edge_angle, edge_area, kmax, kmin, Kmax, Kmin, Knormal);
+	});
+	cgogn_log_info("bench_curvature") << "one collector per vertex: " << elapsed(start) << "s";
+
+	start = std::chrono::system_clock::now();
+	cgogn::geometry::compute_curvature(map, radius, position, normal, edge_angle, edge_area, kmax, kmin, Kmax, Kmin, Knormal);
+	cgogn_log_info("bench_curvature") << "compute_curvature (one collector per thread): " << elapsed(start) << "s";
+
+	start = std::chrono::system_clock::now();
+	cgogn::geometry::KDTree<Map2, Vec3> kdtree(map, position);
+	cgogn::geometry::compute_curvature(kdtree, radius, normal, edge_angle, edge_area, kmax, kmin, Kmax, Kmin, Knormal);
+	cgogn_log_info("bench_curvature") << "compute_curvature with a k-d tree (build included): " << elapsed(start) << "s";
+
+	return 0;
+}
@@ -0,0 +1,113 @@
+
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <cgogn/core/utils/logger.h>
+#include <cgogn/core/cmap/cmap2.h>
+
+#include <cgogn/io/map_import.h>
+
+#include <cgogn/geometry/types/eigen.h>
+#include <cgogn/geometry/algos/ear_triangulation.h>
+
+#define DEFAULT_MESH_PATH CGOGN_STR(CGOGN_TEST_MESHES_PATH)
+
+using namespace cgogn::numerics;
+
+using Map2 = cgogn::CMap2;
+using Vertex = Map2::Vertex;
+using Edge = Map2::Edge;
+using Face = Map2::Face;
+using Vec3 = Eigen::Vector3d;
+
+using TimePoint = std::chrono::time_point<std::chrono::system_clock>;
+
+static float64 elapsed(const TimePoint& start)
+{
+	std::chrono::duration<float64> d = std::chrono::system_clock::now() - start;
+	return d.count();
+}
+
+/**
+ * \brief triangulate all the faces as MapRender::init_triangles_ear does, with the reference and with the pooled triangulation
+ */
+static void bench(Map2& map, const Map2::VertexAttribute<Vec3>& position, uint32 nb_runs)
+{
+	std::map<uint32, uint32> degrees;
+	map.foreach_cell([&] (Face f) { ++degrees[map.codegree(f)]; });
+	std::string degrees_str;
+	for (const auto& it : degrees)
+		degrees_str += " " + std::to_string(it.second) + "x" + std::to_string(it.first);
+	cgogn_log_info("bench_ear_triangulation") << "faces:" << degrees_str;
+
+	std::vector<uint32> table_indices;
+
+	TimePoint start = std::chrono::system_clock::now();
+	for (uint32 r = 0u; r < nb_runs; ++r)
+	{
+		table_indices.clear();
+		map.foreach_cell([&] (Face f)
+		{
+			cgogn::geometry::EarTriangulation<Vec3, Map2> tri(map, f, position);
+			tri.append_indices(table_indices);
+		});
+	}
+	cgogn_log_info("bench_ear_triangulation") << "EarTriangulation: " << elapsed(start) / float64(nb_runs) << "s (" << table_indices.size() / 3u << " triangles)";
+
+	start = std::chrono::system_clock::now();
+	for (uint32 r = 0u; r < nb_runs; ++r)
+	{
+		table_indices.clear();
+		map.foreach_cell([&] (Face f)
+		{
+			cgogn::geometry::append_ear_triangulation(map, f, position, table_indices);
+		});
+	}
+	cgogn_log_info("bench_ear_triangulation") << "PooledEarTriangulation: " << elapsed(start) / float64(nb_runs) << "s (" << table_indices.size() / 3u << " triangles)";
+}
+
+int main(int argc, char** argv)
+{
+	std::vector<std::string> meshes;
+	uint32 nb_runs = 10u;
+	if (argc < 2)
+	{
+		cgogn_log_info("bench_ear_triangulation") << "USAGE: " << argv[0] << " [filename] [nb_runs]";
+		meshes.push_back(std::string(DEFAULT_MESH_PATH) + std::string("off/aneurysm_quad.off"));
+		meshes.push_back(std::string(DEFAULT_MESH_PATH) + std::string("obj/hand_remeshed.obj"));
+	}
+	else
+	{
+		meshes.push_back(std::string(argv[1]));
+		if (argc > 2)
+			nb_runs = std::max(1u, uint32(std::stoi(argv[2])));
+	}
+
+	for (const std::string& filename : meshes)
+	{
+		Map2 map;
+		cgogn::io::import_surface<Vec3>(map, filename);
+		Map2::VertexAttribute<Vec3> position = map.get_attribute<Vec3, Vertex>("position");
+		cgogn_log_info("bench_ear_triangulation") << filename;
+		bench(map, position, nb_runs);
+
+		// CAD like polygons: merge each face with (at most) one of its neighbors
+		Map2::CellMarker<Face::ORBIT> merged(map);
+		map.foreach_cell([&] (Edge e)
+		{
+			const Face f1(e.dart);
+			const Face f2(map.phi2(e.dart));
+			if (map.is_incident_to_boundary(e) || merged.is_marked(f1) || merged.is_marked(f2))
+				return;
+			merged.mark(f1);
+			merged.mark(f2);
+			map.merge_incident_faces(e);
+		});
+		cgogn_log_info("bench_ear_triangulation") << filename << " (merged faces)";
+		bench(map, position, nb_runs);
+	}
+
+	return 0;
+}
@@ -0,0 +1,96 @@
+
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include <cgogn/core/utils/logger.h>
+#include <cgogn/core/cmap/cmap2_tri.h>
+
+#include <cgogn/geometry/types/eigen.h>
+#include <cgogn/geometry/algos/filtering.h>
+#include <cgogn/geometry/algos/laplacian.h>
+
+using namespace cgogn::numerics;
+
+using Map2 = cgogn::CMap2Tri;
+using Vertex = Map2::Vertex;
+using Vec3 = Eigen::Vector3d;
+using Laplacian = cgogn::geometry::LaplacianOperator<Map2, Vec3>;
+
+using TimePoint = std::chrono::time_point<std::chrono::system_clock>;
+
+static float64 elapsed(const TimePoint& start)
+{
+	std::chrono::duration<float64> d = std::chrono::system_clock::now() - start;
+	return d.count();
+}
+
+int main(int argc, char** argv)
+{
+	uint32 n = 700u;
+	uint32 nb_iterations = 50u;
+	if (argc < 3)
+		cgogn_log_info("bench_laplacian") << "USAGE: " << argv[0] << " [grid_size] [nb_iterations] (using " << n << " " << nb_iterations << ")";
+	else
+	{
+		n = std::max(1u, uint32(std::stoi(argv[1])));
+		nb_iterations = std::max(1u, uint32(std::stoi(argv[2])));
+	}
+
+	// n x n noisy triangulated grid
+	std::vector<uint32> triangles;
+	triangles.reserve(6u * n * n);
+	for (uint32 j = 0u; j < n; ++j)
+	{
+		for (uint32 i = 0u; i < n; ++i)
+		{
+			const uint32 v = j * (n + 1u) + i;
+			triangles.insert(triangles.end(), { v, v + 1u, v + n + 2u, v, v + n + 2u, v + n + 1u });
+		}
+	}
+	Map2 map;
+	Map2::Builder builder(map);
+	const uint32 first = builder.create_faces_from_indices(triangles, (n + 1u) * (n + 1u));
+	auto position = map.add_attribute<Vec3, Vertex>("position");
+	auto position2 = map.add_attribute<Vec3, Vertex>("position2");
+	auto tmp = map.add_attribute<Vec3, Vertex>("tmp");
+	for (uint32 j = 0u; j <= n; ++j)
+	{
+		for (uint32 i = 0u; i <= n; ++i)
+		{
+			const Vec3 p = Vec3(float64(i), float64(j), 0.3 * std::sin(float64(i * 7u + j * 13u)));
+			position[first + j * (n + 1u) + i] = p;
+			position2[first + j * (n + 1u) + i] = p;
+		}
+	}
+	const float64 nb_vertices = float64(map.nb_cells<Vertex::ORBIT>());
+	cgogn_log_info("bench_laplacian") << nb_vertices << " vertices, " << nb_iterations << " Taubin iterations";
+
+	TimePoint start = std::chrono::system_clock::now();
+	for (uint32 k = 0u; k < nb_iterations; ++k)
+		cgogn::geometry::filter_taubin(map, position, tmp);
+	cgogn_log_info("bench_laplacian") << "traversal filter_taubin: " << elapsed(start) << "s";
+
+	start = std::chrono::system_clock::now();
+	Laplacian uniform(map);
+	cgogn_log_info("bench_laplacian") << "uniform operator assembly (" << uniform.nb_entries() << " entries): " << elapsed(start) << "s";
+	start = std::chrono::system_clock::now();
+	for (uint32 k = 0u; k < nb_iterations; ++k)
+		uniform.filter_taubin(position2, tmp);
+	cgogn_log_info("bench_laplacian") << "operator filter_taubin: " << elapsed(start) << "s";
+
+	float64 max_diff = 0.0;
+	map.foreach_cell([&] (Vertex v) { max_diff = std::max(max_diff, (position[v] - position2[v]).norm()); });
+	cgogn_log_info("bench_laplacian") << "max difference: " << max_diff;
+
+	start = std::chrono::system_clock::now();
+	Laplacian cotangent(map, position);
+	cgogn_log_info("bench_laplacian") << "cotangent operator assembly: " << elapsed(start) << "s";
+	start = std::chrono::system_clock::now();
+	for (uint32 k = 0u; k < nb_iterations; ++k)
+		cotangent.reweight(position);
+	cgogn_log_info("bench_laplacian") << "cotangent reweighting: " << elapsed(start) / float64(nb_iterations) << "s";
+
+	return 0;
+}
@@ -0,0 +1,168 @@
+
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <cgogn/core/utils/logger.h>
+#include <cgogn/core/cmap/cmap3_tetra.h>
+
+#include <cgogn/geometry/types/eigen.h>
+#include <cgogn/geometry/algos/volume_bvh.h>
+
+using namespace cgogn::numerics;
+
+using Map3 = cgogn::CMap3Tetra;
+using Vertex = Map3::Vertex;
+using Volume = Map3::Volume;
+using Vec3 = Eigen::Vector3d;
+using VolumeBVH = cgogn::geometry::VolumeBVH<Map3, Vec3>;
+
+using TimePoint = std::chrono::time_point<std::chrono::system_clock>;
+
+static float64 elapsed(const TimePoint& start)
+{
+	std::chrono::duration<float64> d = std::chrono::system_clock::now() - start;
+	return d.count();
+}
+
+static uint32 grid_vertex(uint32 n, uint32 i, uint32 j, uint32 k)
+{
+	return (k * (n + 1u) + j) * (n + 1u) + i;
+}
+
+int main(int argc, char** argv)
+{
+	uint32 n = 60u;
+	uint32 nb_queries = 1000000u;
+	if (argc < 3)
+		cgogn_log_info("bench_locate") << "USAGE: " << argv[0] << " [grid_size] [nb_queries] (using " << n << " " << nb_queries << ")";
+	else
+	{
+		n = std::max(1u, uint32(std::stoi(argv[1])));
+		nb_queries = uint32(std::stoi(argv[2]));
+	}
+
+	// n x n x n cubes, 6 tetrahedra per cube, vertices slightly jittered
+	std::vector<uint32> tetras;
+	tetras.reserve(24u * n * n * n);
+	for (uint32 k = 0u; k < n; ++k)
+	{
+		for (uint32 j = 0u; j < n; ++j)
+		{
+			for (uint32 i = 0u; i < n; ++i)
+			{
+				std::array<uint32, 8> c;
+				for (uint32 b = 0u; b < 8u; ++b)
+					c[b] = grid_vertex(n, i + (b & 1u), j + ((b >> 1u) & 1u), k + ((b >> 2u) & 1u));
+				tetras.insert(tetras.end(), {
+					c[0], c[1], c[3], c[7], c[0], c[3], c[2], c[7], c[0], c[2], c[6], c[7],
+					c[0], c[6], c[4], c[7], c[0], c[4], c[5], c[7], c[0], c[5], c[1], c[7]
+				});
+			}
+		}
+	}
+
+	Map3 map;
+	Map3::VertexAttribute<Vec3> position = map.add_attribute<Vec3, Vertex>("position");
+	Map3::VertexAttribute<float64> field = map.add_attribute<float64, Vertex>("field");
+	Map3::Builder builder(map);
+	const uint32 first = builder.create_volumes_from_indices(tetras, (n + 1u) * (n + 1u) * (n + 1u));
+	std::mt19937 gen(42);
+	std::uniform_real_distribution<float64> jitter(-0.1, 0.1);
+	for (uint32 k = 0u; k <= n; ++k)
+	{
+		for (uint32 j = 0u; j <= n; ++j)
+		{
+			for (uint32 i = 0u; i <= n; ++i)
+			{
+				const Vec3 p = Vec3(float64(i), float64(j), float64(k));
+				const bool inside = i > 0u && j > 0u && k > 0u && i < n && j < n && k < n;
+				position[first + grid_vertex(n, i, j, k)] = inside ? Vec3(p + Vec3(jitter(gen), jitter(gen), jitter(gen))) : p;
+				field[first + grid_vertex(n, i, j, k)] = std::sin(p[0]) * std::cos(p[1]) + p[2];
+			}
+		}
+	}
+	cgogn_log_info("bench_locate") << map.nb_cells<Volume::ORBIT>() << " tetrahedra";
+
+	TimePoint start = std::chrono::system_clock::now();
+	VolumeBVH bvh(map, position);
+	cgogn_log_info("bench_locate") << "BVH build (" << bvh.nb_nodes() << " nodes): " << elapsed(start) << "s";
+
+	// random points, and points along particle paths
+	std::uniform_real_distribution<float64> coord(0.0, float64(n));
+	std::vector<Vec3> random_points(nb_queries);
+	for (Vec3& p : random_points)
+		p = Vec3(coord(gen), coord(gen), coord(gen));
+	std::vector<Vec3> path_points(nb_queries);
+	const uint32 path_length = 1000u;
+	for (uint32 i = 0u; i < nb_queries; ++i)
+	{
+		if (i % path_length == 0u)
+			path_points[i] = Vec3(coord(gen), coord(gen), coord(gen));
+		else
+		{
+			const float64 t = 0.01 * float64(i % path_length);
+			path_points[i] = path_points[i - 1u] + 0.05 * Vec3(std::cos(t), std::sin(t), std::cos(0.7 * t));
+			for (uint32 c = 0u; c < 3u; ++c)
+				path_points[i][c] = std::max(0.0, std::min(float64(n), path_points[i][c]));
+		}
+	}
+
+	// brute force scan on a few points
+	const uint32 nb_brute = std::min(nb_queries, 20u);
+	start = std::chrono::system_clock::now();
+	uint32 nb_brute_found = 0u;
+	for (uint32 i = 0u; i < nb_brute; ++i)
+	{
+		const Vec3& P = random_points[i];
+		map.foreach_cell([&] (Volume w) -> bool
+		{
+			std::array<Vec3, 4> p;
+			uint32 k = 0u;
+			map.foreach_incident_vertex(w, [&] (Vertex v) { p[k++] = position[v]; });
+			Eigen::Matrix3d m;
+			m << p[1] - p[0], p[2] - p[0], p[3] - p[0];
+			const Vec3 l = m.inverse() * (P - p[0]);
+			if (l.minCoeff() >= 0.0 && l.sum() <= 1.0)
+			{
+				++nb_brute_found;
+				return false;
+			}
+			return true;
+		});
+	}
+	const float64 brute_time = elapsed(start);
+	cgogn_log_info("bench_locate") << "brute force: " << float64(nb_brute) / brute_time << " queries/s (" << nb_brute_found << "/" << nb_brute << " found)";
+
+	std::vector<VolumeBVH::Location> locations;
+	VolumeBVH::Location loc;
+
+	start = std::chrono::system_clock::now();
+	uint32 nb_found = 0u;
+	for (const Vec3& P : random_points)
+		nb_found += bvh.locate(P, loc) ? 1u : 0u;
+	cgogn_log_info("bench_locate") << "BVH random points: " << float64(nb_queries) / elapsed(start) << " queries/s (" << nb_found << " found)";
+
+	start = std::chrono::system_clock::now();
+	nb_found = 0u;
+	for (const Vec3& P : path_points)
+		nb_found += bvh.locate(P, loc) ? 1u : 0u;
+	cgogn_log_info("bench_locate") << "BVH path points: " << float64(nb_queries) / elapsed(start) << " queries/s (" << nb_found << " found)";
+
+	start = std::chrono::system_clock::now();
+	nb_found = bvh.locate(random_points, locations);
+	cgogn_log_info("bench_locate") << "batch random points: " << float64(nb_queries) / elapsed(start) << " queries/s (" << nb_found << " found)";
+
+	start = std::chrono::system_clock::now();
+	nb_found = bvh.locate(path_points, locations);
+	cgogn_log_info("bench_locate") << "batch path points (walking): " << float64(nb_queries) / elapsed(start) << " queries/s (" << nb_found << " found)";
+
+	std::vector<float64> values;
+	start = std::chrono::system_clock::now();
+	bvh.interpolate(locations, field, values, 0.0);
+	cgogn_log_info("bench_locate") << "interpolation: " << float64(nb_queries) / elapsed(start) << " values/s";
+
+	return 0;
+}
@@ -0,0 +1,111 @@
+
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include <cgogn/core/utils/logger.h>
+#include <cgogn/core/cmap/cmap2_tri.h>
+#include <cgogn/core/cmap/cmap2_quad.h>
+
+#include <cgogn/geometry/types/eigen.h>
+#include <cgogn/geometry/algos/normal.h>
+
+using namespace cgogn::numerics;
+
+using Vec3 = Eigen::Vector3d;
+
+using TimePoint = std::chrono::time_point<std::chrono::system_clock>;
+
+static float64 elapsed(const TimePoint& start)
+{
+	std::chrono::duration<float64> d = std::chrono::system_clock::now() - start;
+	return d.count();
+}
+
+/**
+ * \brief time the per cell (masked) and the batched normal computations on a n x n bumpy grid
+ * of triangles (SIMD blocks) or of quads (generic faces)
+ */
+template <typename MAP>
+static void bench(const std::string& name, uint32 n, uint32 nb_runs)
+{
+	using Vertex = typename MAP::Vertex;
+	using Face = typename MAP::Face;
+
+	std::vector<uint32> faces;
+	faces.reserve(6u * n * n);
+	for (uint32 j = 0u; j < n; ++j)
+	{
+		for (uint32 i = 0u; i < n; ++i)
+		{
+			const uint32 v = j * (n + 1u) + i;
+			if (MAP::PRIM_SIZE == 3u)
+				faces.insert(faces.end(), { v, v + 1u, v + n + 2u, v, v + n + 2u, v + n + 1u });
+			else
+				faces.insert(faces.end(), { v, v + 1u, v + n + 2u, v + n + 1u });
+		}
+	}
+
+	MAP map;
+	typename MAP::Builder builder(map);
+	const uint32 first = builder.create_faces_from_indices(faces, (n + 1u) * (n + 1u));
+	auto position = map.template add_attribute<Vec3, Vertex>("position");
+	for (uint32 j = 0u; j <= n; ++j)
+	{
+		for (uint32 i = 0u; i <= n; ++i)
+		{
+			const float64 x = float64(i) / float64(n);
+			const float64 y = float64(j) / float64(n);
+			position[first + j * (n + 1u) + i] = Vec3(x, y, 0.1 * std::sin(20.0 * x) * std::cos(15.0 * y));
+		}
+	}
+	auto face_normal = map.template add_attribute<Vec3, Face>("face_normal");
+	auto vertex_normal = map.template add_attribute<Vec3, Vertex>("vertex_normal");
+	const float64 nb_faces = float64(map.template nb_cells<Face::ORBIT>());
+	const float64 nb_vertices = float64(map.template nb_cells<Vertex::ORBIT>());
+	cgogn_log_info("bench_normals") << name << ": " << nb_faces << " faces, " << nb_vertices << " vertices";
+
+	TimePoint start = std::chrono::system_clock::now();
+	for (uint32 r = 0u; r < nb_runs; ++r)
+		cgogn::geometry::compute_normal(map, cgogn::AllCellsFilter(), position, face_normal);
+	cgogn_log_info("bench_normals") << "  per cell face normals: " << nb_faces * nb_runs / elapsed(start) << " faces/s";
+
+	start = std::chrono::system_clock::now();
+	for (uint32 r = 0u; r < nb_runs; ++r)
+		cgogn::geometry::compute_normal(map, position, face_normal);
+	cgogn_log_info("bench_normals") << "  batched face normals: " << nb_faces * nb_runs / elapsed(start) << " faces/s";
+
+	start = std::chrono::system_clock::now();
+	for (uint32 r = 0u; r < nb_runs; ++r)
+		cgogn::geometry::compute_normal(map, cgogn::AllCellsFilter(), position, vertex_normal);
+	cgogn_log_info("bench_normals") << "  per cell vertex normals: " << nb_vertices * nb_runs / elapsed(start) << " vertices/s";
+
+	start = std::chrono::system_clock::now();
+	for (uint32 r = 0u; r < nb_runs; ++r)
+		cgogn::geometry::compute_normal(map, position, vertex_normal);
+	cgogn_log_info("bench_normals") << "  batched vertex normals: " << nb_vertices * nb_runs / elapsed(start) << " vertices/s";
+
+	start = std::chrono::system_clock::now();
+	for (uint32 r = 0u; r < nb_runs; ++r)
+		cgogn::geometry::compute_normals(map, position, face_normal, vertex_normal);
+	cgogn_log_info("bench_normals") << "  batched face and vertex normals: " << nb_vertices * nb_runs / elapsed(start) << " vertices/s";
+}
+
+int main(int argc, char** argv)
+{
+	uint32 n = 500u;
+	uint32 nb_runs = 10u;
+	if (argc < 3)
+		cgogn_log_info("bench_normals") << "USAGE: " << argv[0] << " [grid_size] [nb_runs] (using " << n << " " << nb_runs << ")";
+	else
+	{
+		n = std::max(1u, uint32(std::stoi(argv[1])));
+		nb_runs = std::max(1u, uint32(std::stoi(argv[2])));
+	}
+
+	bench<cgogn::CMap2Tri>("CMap2Tri", n, nb_runs);
+	bench<cgogn::CMap2Quad>("CMap2Quad", n, nb_runs);
+
+	return 0;
+}
@@ -0,0 +1,128 @@
+
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <cgogn/core/utils/logger.h>
+#include <cgogn/core/cmap/cmap2_tri.h>
+
+#include <cgogn/geometry/types/eigen.h>
+#include <cgogn/geometry/algos/face_bvh.h>
+#include <cgogn/geometry/algos/picking.h>
+
+using namespace cgogn::numerics;
+
+using Map2 = cgogn::CMap2Tri;
+using Vertex = Map2::Vertex;
+using Face = Map2::Face;
+using Vec3 = Eigen::Vector3d;
+using FaceBVH = cgogn::geometry::FaceBVH<Map2, Vec3>;
+
+using TimePoint = std::chrono::time_point<std::chrono::system_clock>;
+
+static float64 elapsed(const TimePoint& start)
+{
+	std::chrono::duration<float64> d = std::chrono::system_clock::now() - start;
+	return d.count();
+}
+
+int main(int argc, char** argv)
+{
+	uint32 n = 1000u;
+	uint32 nb_rays = 100u;
+	if (argc < 3)
+		cgogn_log_info("bench_picking") << "USAGE: " << argv[0] << " [grid_size] [nb_rays] (using " << n << " " << nb_rays << ")";
+	else
+	{
+		n = std::max(2u, uint32(std::stoi(argv[1])));
+		nb_rays = uint32(std::stoi(argv[2]));
+	}
+
+	// wavy triangulated n x n grid
+	std::vector<uint32> triangles;
+	triangles.reserve(6u * n * n);
+	for (uint32 j = 0u; j < n; ++j)
+	{
+		for (uint32 i = 0u; i < n; ++i)
+		{
+			const uint32 v = j * (n + 1u) + i;
+			triangles.insert(triangles.end(), { v, v + 1u, v + n + 2u, v, v + n + 2u, v + n + 1u });
+		}
+	}
+
+	Map2 map;
+	Map2::VertexAttribute<Vec3> position = map.add_attribute<Vec3, Vertex>("position");
+	Map2::Builder builder(map);
+	const uint32 first = builder.create_faces_from_indices(triangles, (n + 1u) * (n + 1u));
+	for (uint32 j = 0u; j <= n; ++j)
+		for (uint32 i = 0u; i <= n; ++i)
+			position[first + j * (n + 1u) + i] = Vec3(float64(i), float64(j), 0.5 * std::sin(0.1 * float64(i)) * std::cos(0.1 * float64(j)));
+	cgogn_log_info("bench_picking") << map.nb_cells<Face::ORBIT>() << " faces";
+
+	std::mt19937 gen(42);
+	std::uniform_real_distribution<float64> coord(0.0, float64(n));
+	std::vector<std::pair<Vec3, Vec3>> rays(nb_rays);
+	for (auto& r : rays)
+	{
+		r.first = Vec3(coord(gen), coord(gen), 10.0);
+		r.second = Vec3(coord(gen), coord(gen), -10.0);
+	}
+
+	TimePoint start = std::chrono::system_clock::now();
+	std::vector<std::vector<Face>> brute_selection(nb_rays);
+	for (uint32 i = 0u; i < nb_rays; ++i)
+		cgogn::geometry::picking(map, position, rays[i].first, rays[i].second, brute_selection[i]);
+	cgogn_log_info("bench_picking") << "brute force picking: " << elapsed(start) << "s";
+
+	start = std::chrono::system_clock::now();
+	FaceBVH bvh(map, position);
+	cgogn_log_info("bench_picking") << "BVH build (" << bvh.nb_nodes() << " nodes): " << elapsed(start) << "s";
+
+	start = std::chrono::system_clock::now();
+	std::vector<std::vector<Face>> bvh_selection(nb_rays);
+	for (uint32 i = 0u; i < nb_rays; ++i)
+		cgogn::geometry::picking(bvh, rays[i].first, rays[i].second, bvh_selection[i]);
+	cgogn_log_info("bench_picking") << "BVH picking: " << elapsed(start) << "s";
+
+	bool same = true;
+	for (uint32 i = 0u; i < nb_rays && same; ++i)
+	{
+		same = brute_selection[i].size() == bvh_selection[i].size();
+		for (std::size_t k = 0u; k < brute_selection[i].size() && same; ++k)
+			same = brute_selection[i][k].dart == bvh_selection[i][k].dart;
+	}
+	cgogn_log_info("bench_picking") << "same selections: " << std::boolalpha << same;
+
+	map.parallel_foreach_cell([&] (Vertex v) { position[v][2] *= 2.0; });
+	start = std::chrono::system_clock::now();
+	bvh.refit();
+	cgogn_log_info("bench_picking") << "BVH refit: " << elapsed(start) << "s";
+
+	// closest points and signed distances of nb_rays * 100 points
+	std::uniform_real_distribution<float64> height(-2.0, 2.0);
+	std::vector<Vec3> points(100u * nb_rays);
+	for (Vec3& p : points)
+		p = Vec3(coord(gen), coord(gen), height(gen));
+
+	start = std::chrono::system_clock::now();
+	std::vector<FaceBVH::Projection> projections;
+	bvh.closest_points(points, projections);
+	cgogn_log_info("bench_picking") << "BVH closest points (" << points.size() << "): " << elapsed(start) << "s";
+
+	start = std::chrono::system_clock::now();
+	bvh.update_sign_data();
+	cgogn_log_info("bench_picking") << "BVH sign data: " << elapsed(start) << "s";
+
+	std::vector<float64> distances;
+	start = std::chrono::system_clock::now();
+	bvh.signed_distances(points, distances, FaceBVH::PSEUDO_NORMAL);
+	cgogn_log_info("bench_picking") << "BVH signed distances (pseudo-normals): " << elapsed(start) << "s";
+
+	start = std::chrono::system_clock::now();
+	bvh.signed_distances(points, distances, FaceBVH::WINDING_NUMBER);
+	cgogn_log_info("bench_picking") << "BVH signed distances (winding number): " << elapsed(start) << "s";
+
+	return 0;
+}
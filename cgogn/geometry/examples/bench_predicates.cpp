@@ -0,0 +1,128 @@
+
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <cgogn/core/utils/logger.h>
+
+#include <cgogn/geometry/types/eigen.h>
+#include <cgogn/geometry/functions/predicates.h>
+#include <cgogn/geometry/functions/intersection.h>
+
+using namespace cgogn::numerics;
+
+using Vec3 = Eigen::Vector3d;
+
+using TimePoint = std::chrono::time_point<std::chrono::system_clock>;
+
+static float64 elapsed(const TimePoint& start)
+{
+	std::chrono::duration<float64> d = std::chrono::system_clock::now() - start;
+	return d.count();
+}
+
+/**
+ * \brief time the naive and the filtered orient3d and insphere on the given points (taken 5 by 5)
+ */
+static void bench(const std::string& name, const std::vector<Vec3>& points)
+{
+	const uint32 n = uint32(points.size()) / 5u;
+	int32 checksum = 0;
+
+	uint32 nb_failures = 0u;
+	for (uint32 i = 0u; i < n; ++i)
+	{
+		float64 det;
+		const Vec3* p = &points[5u * i];
+		if (!cgogn::geometry::internal::orient3d_fast(p[0].data(), p[1].data(), p[2].data(), p[3].data(), det))
+			++nb_failures;
+	}
+	cgogn_log_info("bench_predicates") << name << ": orient3d filter failures " << 100.0 * float64(nb_failures) / float64(n) << "%";
+
+	TimePoint start = std::chrono::system_clock::now();
+	for (uint32 i = 0u; i < n; ++i)
+	{
+		const Vec3* p = &points[5u * i];
+		const float64 det = (p[0] - p[3]).dot((p[1] - p[3]).cross(p[2] - p[3]));
+		checksum += det > 0.0 ? 1 : (det < 0.0 ? -1 : 0);
+	}
+	cgogn_log_info("bench_predicates") << name << ": naive orient3d " << float64(n) / elapsed(start) * 1e-6 << " M/s";
+
+	start = std::chrono::system_clock::now();
+	for (uint32 i = 0u; i < n; ++i)
+	{
+		const Vec3* p = &points[5u * i];
+		const float64 det = cgogn::geometry::orient3d(p[0], p[1], p[2], p[3]);
+		checksum += det > 0.0 ? 1 : (det < 0.0 ? -1 : 0);
+	}
+	cgogn_log_info("bench_predicates") << name << ": orient3d " << float64(n) / elapsed(start) * 1e-6 << " M/s";
+
+	nb_failures = 0u;
+	for (uint32 i = 0u; i < n; ++i)
+	{
+		float64 det;
+		const Vec3* p = &points[5u * i];
+		if (!cgogn::geometry::internal::insphere_fast(p[0].data(), p[1].data(), p[2].data(), p[3].data(), p[4].data(), det))
+			++nb_failures;
+	}
+	cgogn_log_info("bench_predicates") << name << ": insphere filter failures " << 100.0 * float64(nb_failures) / float64(n) << "%";
+
+	start = std::chrono::system_clock::now();
+	for (uint32 i = 0u; i < n; ++i)
+	{
+		const Vec3* p = &points[5u * i];
+		const float64 det = cgogn::geometry::insphere(p[0], p[1], p[2], p[3], p[4]);
+		checksum += det > 0.0 ? 1 : (det < 0.0 ? -1 : 0);
+	}
+	cgogn_log_info("bench_predicates") << name << ": insphere " << float64(n) / elapsed(start) * 1e-6 << " M/s (checksum " << checksum << ")";
+}
+
+int main(int argc, char** argv)
+{
+	uint32 n = 2000000u;
+	if (argc < 2)
+		cgogn_log_info("bench_predicates") << "USAGE: " << argv[0] << " [nb_tests] (using " << n << ")";
+	else
+		n = std::max(1u, uint32(std::stoi(argv[1])));
+
+	std::mt19937 gen(42);
+	std::uniform_real_distribution<float64> coord(0.0, 1.0);
+	std::uniform_int_distribution<int32> grid(0, 100);
+	std::uniform_int_distribution<int32> axis(0, 2);
+
+	// random points
+	std::vector<Vec3> points(5u * n);
+	for (Vec3& p : points)
+		p = Vec3(coord(gen), coord(gen), coord(gen));
+	bench("random", points);
+
+	// CAD like: groups of points on the same axis aligned plane, coordinates on a 0.01 grid
+	for (uint32 i = 0u; i < n; ++i)
+	{
+		const int32 a = axis(gen);
+		const float64 v = 0.01 * float64(grid(gen));
+		for (uint32 k = 0u; k < 5u; ++k)
+		{
+			Vec3& p = points[5u * i + k];
+			p = Vec3(0.01 * float64(grid(gen)), 0.01 * float64(grid(gen)), 0.01 * float64(grid(gen)));
+			if (k < 4u)
+				p[a] = v;
+		}
+	}
+	bench("coplanar", points);
+
+	// rays against triangles
+	const uint32 nb_rays = n / 4u;
+	uint32 nb_hits = 0u;
+	TimePoint start = std::chrono::system_clock::now();
+	for (uint32 i = 0u; i < nb_rays; ++i)
+	{
+		const Vec3* p = &points[5u * i];
+		if (cgogn::geometry::intersection_ray_triangle(p[3], Vec3(p[4] - p[3]), p[0], p[1], p[2]))
+			++nb_hits;
+	}
+	cgogn_log_info("bench_predicates") << "intersection_ray_triangle (coplanar set): " << float64(nb_rays) / elapsed(start) * 1e-6 << " M/s (" << nb_hits << " hits)";
+
+	return 0;
+}
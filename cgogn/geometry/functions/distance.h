@@ -24,6 +24,8 @@
 #ifndef CGOGN_GEOMETRY_FUNCTIONS_DISTANCE_H_
 #define CGOGN_GEOMETRY_FUNCTIONS_DISTANCE_H_
 
+#include <array>
+
 #include <cgogn/core/utils/assert.h>
 #include <cgogn/geometry/types/geometry_traits.h>
 
@@ -185,6 +187,87 @@ ScalarOf<VEC3a> squared_distance_seg_point(const Eigen::MatrixBase<VEC3a>& A, co
 }
 
 
+/**
+* compute squared distance from triangle to point
+* The closest point is located by region tests on the barycentric coordinates (Ericson, Real-Time Collision Detection),
+* only dot products are used and the branches exit early, so the test is cheap enough to be called on many triangles.
+* @param A first vertex of the triangle
+* @param B second vertex of the triangle
+* @param C third vertex of the triangle
+* @param P the point
+* @param barycentric [out] if given, barycentric coordinates (w.r.t. A, B, C) of the closest point of the triangle,
+* a coordinate is exactly 0 when the closest point lies on the opposite edge
+* @return the squared distance
+*/
+template <typename VEC3a, typename VEC3b, typename VEC3c, typename VEC3d>
+ScalarOf<VEC3a> squared_distance_triangle_point(
+	const Eigen::MatrixBase<VEC3a>& A, const Eigen::MatrixBase<VEC3b>& B, const Eigen::MatrixBase<VEC3c>& C,
+	const Eigen::MatrixBase<VEC3d>& P,
+	std::array<ScalarOf<VEC3a>, 3>* barycentric = nullptr)
+{
+	static_assert(is_same_vector<VEC3a,VEC3b,VEC3c,VEC3d>::value, "parameters must have same type");
+	static_assert(is_dim_of<VEC3a, 3>::value, "The size of the vector must be equal to 3.");
+
+	using Scalar = ScalarOf<VEC3a>;
+	using NVEC3 = VecType<VEC3a>;
+
+	std::array<Scalar, 3> bc;
+
+	const NVEC3 AB = B - A;
+	const NVEC3 AC = C - A;
+	const NVEC3 AP = P - A;
+	const Scalar d1 = AB.dot(AP);
+	const Scalar d2 = AC.dot(AP);
+
+	const NVEC3 BP = P - B;
+	const Scalar d3 = AB.dot(BP);
+	const Scalar d4 = AC.dot(BP);
+
+	const NVEC3 CP = P - C;
+	const Scalar d5 = AB.dot(CP);
+	const Scalar d6 = AC.dot(CP);
+
+	const Scalar va = d3 * d6 - d5 * d4;
+	const Scalar vb = d5 * d2 - d1 * d6;
+	const Scalar vc = d1 * d4 - d3 * d2;
+
+	if (d1 <= Scalar(0) && d2 <= Scalar(0)) // vertex A
+		bc = {{ Scalar(1), Scalar(0), Scalar(0) }};
+	else if (d3 >= Scalar(0) && d4 <= d3) // vertex B
+		bc = {{ Scalar(0), Scalar(1), Scalar(0) }};
+	else if (d6 >= Scalar(0) && d5 <= d6) // vertex C
+		bc = {{ Scalar(0), Scalar(0), Scalar(1) }};
+	else if (vc <= Scalar(0) && d1 >= Scalar(0) && d3 <= Scalar(0)) // edge AB
+	{
+		const Scalar v = d1 / (d1 - d3);
+		bc = {{ Scalar(1) - v, v, Scalar(0) }};
+	}
+	else if (vb <= Scalar(0) && d2 >= Scalar(0) && d6 <= Scalar(0)) // edge AC
+	{
+		const Scalar w = d2 / (d2 - d6);
+		bc = {{ Scalar(1) - w, Scalar(0), w }};
+	}
+	else if (va <= Scalar(0) && (d4 - d3) >= Scalar(0) && (d5 - d6) >= Scalar(0)) // edge BC
+	{
+		const Scalar w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+		bc = {{ Scalar(0), Scalar(1) - w, w }};
+	}
+	else // inside the triangle
+	{
+		const Scalar denom = Scalar(1) / (va + vb + vc);
+		const Scalar v = vb * denom;
+		const Scalar w = vc * denom;
+		bc = {{ Scalar(1) - v - w, v, w }};
+	}
+
+	if (barycentric)
+		*barycentric = bc;
+
+	const NVEC3 X = A * bc[0] + B * bc[1] + C * bc[2];
+	return (P - X).squaredNorm();
+}
+
+
 /// non Eigen versions
 
 template <typename VEC3>
@@ -229,6 +312,14 @@ inline auto squared_distance_seg_point(const VEC3& A, const VEC3& AB, const VEC3
 	return squared_distance_seg_point(eigenize(A),eigenize(AB),eigenize(P));
 }
 
+
+template <typename VEC3>
+inline auto squared_distance_triangle_point(const VEC3& A, const VEC3& B, const VEC3& C, const VEC3& P, std::array<ScalarOf<VEC3>, 3>* barycentric = nullptr)
+-> typename std::enable_if <is_vec_non_eigen<VEC3>::value, ScalarOf<VEC3> >::type
+{
+	return squared_distance_triangle_point(eigenize(A),eigenize(B),eigenize(C),eigenize(P),barycentric);
+}
+
 } // namespace geometry
 
 } // namespace cgogn
@@ -26,6 +26,7 @@
 
 #include <cgogn/geometry/types/geometry_traits.h>
 #include <cgogn/geometry/functions/normal.h>
+#include <cgogn/geometry/functions/predicates.h>
 
 namespace cgogn
 {
@@ -64,9 +65,10 @@ bool in_triangle(const Eigen::MatrixBase<VEC3a>& P, const Eigen::MatrixBase<VEC3
 	static_assert(is_same_vector<VEC3a,VEC3b,VEC3c,VEC3d,VEC3e>::value, "parameters must have same type");
 	static_assert(is_dim_of<VEC3a, 3>::value, "The size of the vector must be equal to 3.");
 
-	if (triple_product(P-Ta, Tb-Ta, normal) >= 0 ||
-		triple_product(P-Tb, Tc-Tb, normal) >= 0  ||
-		triple_product(P-Tc, Ta-Tc, normal) >= 0  )
+	// exact signs of the triple products (P-Ta).((Tb-Ta)^normal), ...
+	if (orient3d_vector(P, Tb, Ta, normal) >= 0 ||
+		orient3d_vector(P, Tc, Tb, normal) >= 0 ||
+		orient3d_vector(P, Ta, Tc, normal) >= 0)
 		return false;
 
 	return true;
@@ -29,6 +29,7 @@
 
 #include <cgogn/geometry/types/geometry_traits.h>
 #include <cgogn/geometry/functions/inclusion.h>
+#include <cgogn/geometry/functions/predicates.h>
 
 namespace cgogn
 {
@@ -56,44 +57,42 @@ bool intersection_ray_triangle(const Eigen::MatrixBase<VEC3a>& P, const Eigen::M
 	using Scalar = ScalarOf<VEC3a>;
 	using NVEC3 = typename vector_traits<VEC3a>::Type;
 
-	NVEC3 u = Ta - P;
-	NVEC3 v = Tb - P;
-	NVEC3 w = Tc - P;
-
-	Scalar x = Dir.dot(u.cross(v));
-	Scalar y = Dir.dot(v.cross(w));
-	Scalar z = Dir.dot(w.cross(u));
+	// exact signs of Dir.((Ta-P)^(Tb-P)), Dir.((Tb-P)^(Tc-P)) and Dir.((Tc-P)^(Ta-P))
+	const float64 x = orient3d_vector(Ta, Tb, P, Dir);
+	const float64 y = orient3d_vector(Tb, Tc, P, Dir);
+	const float64 z = orient3d_vector(Tc, Ta, P, Dir);
 
 	uint32 np = 0;
 	uint32 nn = 0;
 	uint32 nz = 0;
 
-	if (x > Scalar(0)) ++np;
-	else if (x < Scalar(0)) ++nn;
+	if (x > 0.0) ++np;
+	else if (x < 0.0) ++nn;
 	else ++nz;
 
-	if (y > Scalar(0)) ++np;
-	else if (y < Scalar(0)) ++nn;
+	if (y > 0.0) ++np;
+	else if (y < 0.0) ++nn;
 	else ++nz;
 
-	if (z > Scalar(0)) ++np;
-	else if (z < Scalar(0)) ++nn;
+	if (z > 0.0) ++np;
+	else if (z < 0.0) ++nn;
 	else ++nz;
 
 	// line intersect the triangle
 	if (((np != 0) && (nn != 0)) || (nz == 3))
 		return false;
 
-	Scalar sum = x + y + z;
-	Scalar alpha = y / sum;
-	Scalar beta = z / sum;
+	// it's a ray not a line ! (Dir.(I-P) has the sign of (Ta-P).((Tb-P)^(Tc-P)) times the sign of x+y+z)
+	const float64 o = orient3d(Ta, Tb, Tc, P);
+	if ((np != 0 && o < 0.0) || (nn != 0 && o > 0.0))
+		return false;
+
+	float64 sum = x + y + z;
+	Scalar alpha = Scalar(y / sum);
+	Scalar beta = Scalar(z / sum);
 	Scalar gamma =Scalar(1) - alpha - beta;
 	NVEC3 I = Ta * alpha + Tb * beta + Tc * gamma;
 
-	// it's a ray not a line !
-	if (Dir.dot(I-P) < 0.0)
-		return false;
-
 	if (inter)
 		*inter = I;
 
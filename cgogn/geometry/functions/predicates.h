@@ -0,0 +1,678 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef CGOGN_GEOMETRY_FUNCTIONS_PREDICATES_H_
+#define CGOGN_GEOMETRY_FUNCTIONS_PREDICATES_H_
+
+#include <cmath>
+#include <array>
+#include <limits>
+#include <vector>
+#include <algorithm>
+
+#include <cgogn/core/utils/numerics.h>
+#include <cgogn/geometry/types/geometry_traits.h>
+
+namespace cgogn
+{
+
+namespace geometry
+{
+
+/**
+ * Robust geometric predicates (J. R. Shewchuk, Adaptive Precision Floating-Point Arithmetic
+ * and Fast Robust Geometric Predicates, 1997).
+ * The determinant is first evaluated in double precision and its sign is kept when it is larger
+ * than an error bound computed from the magnitude of its terms (the filter). Otherwise it is
+ * evaluated exactly with floating-point expansions.
+ * The returned values are approximations of the determinants with the exact sign.
+ */
+
+namespace internal
+{
+
+// half of the machine epsilon (2^-53)
+const float64 PREDICATE_EPSILON = std::numeric_limits<float64>::epsilon() * 0.5;
+const float64 ORIENT2D_BOUND = (3.0 + 16.0 * PREDICATE_EPSILON) * PREDICATE_EPSILON;
+const float64 ORIENT3D_BOUND = (7.0 + 56.0 * PREDICATE_EPSILON) * PREDICATE_EPSILON;
+const float64 INCIRCLE_BOUND = (10.0 + 96.0 * PREDICATE_EPSILON) * PREDICATE_EPSILON;
+const float64 INSPHERE_BOUND = (16.0 + 224.0 * PREDICATE_EPSILON) * PREDICATE_EPSILON;
+
+/**
+ * \brief a floating-point expansion: exact sum of non-overlapping components, by increasing magnitude
+ */
+class Expansion
+{
+	/**
+	 * \brief components storage, on the stack up to INLINE_SIZE components
+	 */
+	class Components
+	{
+		static const uint32 INLINE_SIZE = 32u;
+
+		std::array<float64, INLINE_SIZE> inline_;
+		std::vector<float64> heap_;
+		float64* data_;
+		uint32 size_;
+		uint32 capacity_;
+
+	public:
+
+		Components() : data_(nullptr), size_(0u), capacity_(INLINE_SIZE)
+		{
+			data_ = inline_.data();
+		}
+
+		Components(const Components& c) : Components()
+		{
+			*this = c;
+		}
+
+		Components& operator=(const Components& c)
+		{
+			if (this != &c)
+			{
+				size_ = 0u;
+				reserve(c.size_);
+				std::copy(c.data_, c.data_ + c.size_, data_);
+				size_ = c.size_;
+			}
+			return *this;
+		}
+
+		inline void reserve(uint32 n)
+		{
+			if (n <= capacity_)
+				return;
+			if (data_ == inline_.data())
+			{
+				heap_.resize(n);
+				std::copy(inline_.begin(), inline_.begin() + size_, heap_.begin());
+			}
+			else
+				heap_.resize(n);
+			data_ = heap_.data();
+			capacity_ = n;
+		}
+
+		inline void push_back(float64 a)
+		{
+			if (size_ == capacity_)
+				reserve(2u * capacity_);
+			data_[size_++] = a;
+		}
+
+		inline void clear() { size_ = 0u; }
+		inline uint32 size() const { return size_; }
+		inline bool empty() const { return size_ == 0u; }
+		inline float64& operator[](uint32 i) { return data_[i]; }
+		inline float64 operator[](uint32 i) const { return data_[i]; }
+		inline float64 back() const { return data_[size_ - 1u]; }
+		inline float64* begin() { return data_; }
+		inline float64* end() { return data_ + size_; }
+		inline const float64* begin() const { return data_; }
+		inline const float64* end() const { return data_ + size_; }
+	};
+
+	Components c_;
+
+	static inline void fast_two_sum(float64 a, float64 b, float64& x, float64& y)
+	{
+		x = a + b;
+		y = b - (x - a);
+	}
+
+	static inline void two_sum(float64 a, float64 b, float64& x, float64& y)
+	{
+		x = a + b;
+		const float64 bv = x - a;
+		const float64 av = x - bv;
+		y = (a - av) + (b - bv);
+	}
+
+	static inline void two_product(float64 a, float64 b, float64& x, float64& y)
+	{
+		x = a * b;
+		y = std::fma(a, b, -x);
+	}
+
+	inline void push(float64 a)
+	{
+		if (a != 0.0)
+			c_.push_back(a);
+	}
+
+public:
+
+	Expansion() {}
+
+	explicit Expansion(float64 a)
+	{
+		push(a);
+	}
+
+	/**
+	 * \brief exact difference a - b
+	 */
+	static Expansion diff(float64 a, float64 b)
+	{
+		Expansion e;
+		const float64 x = a - b;
+		const float64 bv = a - x;
+		const float64 av = x + bv;
+		e.push((a - av) + (bv - b));
+		e.push(x);
+		return e;
+	}
+
+	inline int32 sign() const
+	{
+		return c_.empty() ? 0 : (c_.back() > 0.0 ? 1 : -1);
+	}
+
+	/**
+	 * \brief the most significant component (same sign as the expansion)
+	 */
+	inline float64 estimate() const
+	{
+		return c_.empty() ? 0.0 : c_.back();
+	}
+
+	friend Expansion operator-(const Expansion& e)
+	{
+		Expansion r(e);
+		for (float64& c : r.c_)
+			c = -c;
+		return r;
+	}
+
+	friend Expansion operator+(const Expansion& e, const Expansion& f)
+	{
+		if (e.c_.empty())
+			return f;
+		if (f.c_.empty())
+			return e;
+
+		// merge the components by magnitude and sum them (fast expansion sum with zero elimination)
+		Expansion h;
+		h.c_.reserve(e.c_.size() + f.c_.size());
+		uint32 i = 0u, j = 0u;
+		auto next = [&] () -> float64
+		{
+			if (j == f.c_.size() || (i < e.c_.size() && ((f.c_[j] > e.c_[i]) == (f.c_[j] > -e.c_[i]))))
+				return e.c_[i++];
+			return f.c_[j++];
+		};
+		float64 Q = next();
+		float64 Qnew, hh;
+		if (i + j < e.c_.size() + f.c_.size())
+		{
+			fast_two_sum(next(), Q, Qnew, hh);
+			Q = Qnew;
+			h.push(hh);
+		}
+		while (i + j < e.c_.size() + f.c_.size())
+		{
+			two_sum(Q, next(), Qnew, hh);
+			Q = Qnew;
+			h.push(hh);
+		}
+		if (Q != 0.0 || h.c_.empty())
+			h.c_.push_back(Q);
+		if (h.c_.size() == 1u && h.c_[0] == 0.0)
+			h.c_.clear();
+		return h;
+	}
+
+	friend Expansion operator-(const Expansion& e, const Expansion& f)
+	{
+		return e + (-f);
+	}
+
+	/**
+	 * \brief exact product of an expansion by a double (scale expansion with zero elimination)
+	 */
+	friend Expansion operator*(const Expansion& e, float64 b)
+	{
+		Expansion h;
+		if (e.c_.empty() || b == 0.0)
+			return h;
+		h.c_.reserve(2u * e.c_.size());
+		float64 Q, hh, product1, product0, sum;
+		two_product(e.c_[0], b, Q, hh);
+		h.push(hh);
+		for (uint32 i = 1u; i < e.c_.size(); ++i)
+		{
+			two_product(e.c_[i], b, product1, product0);
+			two_sum(Q, product0, sum, hh);
+			h.push(hh);
+			fast_two_sum(product1, sum, Q, hh);
+			h.push(hh);
+		}
+		h.push(Q);
+		return h;
+	}
+
+	friend Expansion operator*(const Expansion& e, const Expansion& f)
+	{
+		Expansion h;
+		for (float64 c : f.c_)
+			h = h + e * c;
+		return h;
+	}
+};
+
+inline Expansion det2_exact(const Expansion& a, const Expansion& b, const Expansion& c, const Expansion& d)
+{
+	return a * d - b * c;
+}
+
+/**
+ * \brief exact determinant of the rows r0, r1, r2
+ */
+inline Expansion det3_exact(const Expansion* r0, const Expansion* r1, const Expansion* r2)
+{
+	return
+		r0[0] * det2_exact(r1[1], r1[2], r2[1], r2[2]) +
+		r0[1] * det2_exact(r1[2], r1[0], r2[2], r2[0]) +
+		r0[2] * det2_exact(r1[0], r1[1], r2[0], r2[1]);
+}
+
+inline bool orient2d_fast(const float64* a, const float64* b, const float64* c, float64& det)
+{
+	const float64 detleft = (a[0] - c[0]) * (b[1] - c[1]);
+	const float64 detright = (a[1] - c[1]) * (b[0] - c[0]);
+	det = detleft - detright;
+
+	float64 detsum;
+	if (detleft > 0.0)
+	{
+		if (detright <= 0.0)
+			return true;
+		detsum = detleft + detright;
+	}
+	else if (detleft < 0.0)
+	{
+		if (detright >= 0.0)
+			return true;
+		detsum = -detleft - detright;
+	}
+	else
+		return true;
+
+	const float64 errbound = ORIENT2D_BOUND * detsum;
+	return det >= errbound || -det >= errbound;
+}
+
+inline float64 orient2d_exact(const float64* a, const float64* b, const float64* c)
+{
+	return det2_exact(
+		Expansion::diff(a[0], c[0]), Expansion::diff(a[1], c[1]),
+		Expansion::diff(b[0], c[0]), Expansion::diff(b[1], c[1])
+	).estimate();
+}
+
+/**
+ * \brief filtered determinant of the rows ad, bd, cd
+ */
+inline bool det3_fast(const float64* ad, const float64* bd, const float64* cd, float64& det)
+{
+	const float64 bdxcdy = bd[0] * cd[1];
+	const float64 cdxbdy = cd[0] * bd[1];
+	const float64 cdxady = cd[0] * ad[1];
+	const float64 adxcdy = ad[0] * cd[1];
+	const float64 adxbdy = ad[0] * bd[1];
+	const float64 bdxady = bd[0] * ad[1];
+
+	det = ad[2] * (bdxcdy - cdxbdy) + bd[2] * (cdxady - adxcdy) + cd[2] * (adxbdy - bdxady);
+
+	const float64 permanent =
+		(std::abs(bdxcdy) + std::abs(cdxbdy)) * std::abs(ad[2]) +
+		(std::abs(cdxady) + std::abs(adxcdy)) * std::abs(bd[2]) +
+		(std::abs(adxbdy) + std::abs(bdxady)) * std::abs(cd[2]);
+	const float64 errbound = ORIENT3D_BOUND * permanent;
+	return det > errbound || -det > errbound;
+}
+
+inline bool orient3d_fast(const float64* a, const float64* b, const float64* c, const float64* d, float64& det)
+{
+	const float64 ad[3] = { a[0] - d[0], a[1] - d[1], a[2] - d[2] };
+	const float64 bd[3] = { b[0] - d[0], b[1] - d[1], b[2] - d[2] };
+	const float64 cd[3] = { c[0] - d[0], c[1] - d[1], c[2] - d[2] };
+	return det3_fast(ad, bd, cd, det);
+}
+
+inline float64 orient3d_exact(const float64* a, const float64* b, const float64* c, const float64* d)
+{
+	const Expansion ad[3] = { Expansion::diff(a[0], d[0]), Expansion::diff(a[1], d[1]), Expansion::diff(a[2], d[2]) };
+	const Expansion bd[3] = { Expansion::diff(b[0], d[0]), Expansion::diff(b[1], d[1]), Expansion::diff(b[2], d[2]) };
+	const Expansion cd[3] = { Expansion::diff(c[0], d[0]), Expansion::diff(c[1], d[1]), Expansion::diff(c[2], d[2]) };
+	return det3_exact(ad, bd, cd).estimate();
+}
+
+inline bool orient3d_vector_fast(const float64* a, const float64* b, const float64* c, const float64* v, float64& det)
+{
+	const float64 ac[3] = { a[0] - c[0], a[1] - c[1], a[2] - c[2] };
+	const float64 bc[3] = { b[0] - c[0], b[1] - c[1], b[2] - c[2] };
+	return det3_fast(ac, bc, v, det);
+}
+
+inline float64 orient3d_vector_exact(const float64* a, const float64* b, const float64* c, const float64* v)
+{
+	const Expansion ac[3] = { Expansion::diff(a[0], c[0]), Expansion::diff(a[1], c[1]), Expansion::diff(a[2], c[2]) };
+	const Expansion bc[3] = { Expansion::diff(b[0], c[0]), Expansion::diff(b[1], c[1]), Expansion::diff(b[2], c[2]) };
+	const Expansion vv[3] = { Expansion(v[0]), Expansion(v[1]), Expansion(v[2]) };
+	return det3_exact(ac, bc, vv).estimate();
+}
+
+inline bool incircle_fast(const float64* a, const float64* b, const float64* c, const float64* d, float64& det)
+{
+	const float64 adx = a[0] - d[0];
+	const float64 bdx = b[0] - d[0];
+	const float64 cdx = c[0] - d[0];
+	const float64 ady = a[1] - d[1];
+	const float64 bdy = b[1] - d[1];
+	const float64 cdy = c[1] - d[1];
+
+	const float64 bdxcdy = bdx * cdy;
+	const float64 cdxbdy = cdx * bdy;
+	const float64 alift = adx * adx + ady * ady;
+
+	const float64 cdxady = cdx * ady;
+	const float64 adxcdy = adx * cdy;
+	const float64 blift = bdx * bdx + bdy * bdy;
+
+	const float64 adxbdy = adx * bdy;
+	const float64 bdxady = bdx * ady;
+	const float64 clift = cdx * cdx + cdy * cdy;
+
+	det = alift * (bdxcdy - cdxbdy) + blift * (cdxady - adxcdy) + clift * (adxbdy - bdxady);
+
+	const float64 permanent =
+		(std::abs(bdxcdy) + std::abs(cdxbdy)) * alift +
+		(std::abs(cdxady) + std::abs(adxcdy)) * blift +
+		(std::abs(adxbdy) + std::abs(bdxady)) * clift;
+	const float64 errbound = INCIRCLE_BOUND * permanent;
+	return det > errbound || -det > errbound;
+}
+
+inline float64 incircle_exact(const float64* a, const float64* b, const float64* c, const float64* d)
+{
+	const Expansion adx = Expansion::diff(a[0], d[0]);
+	const Expansion bdx = Expansion::diff(b[0], d[0]);
+	const Expansion cdx = Expansion::diff(c[0], d[0]);
+	const Expansion ady = Expansion::diff(a[1], d[1]);
+	const Expansion bdy = Expansion::diff(b[1], d[1]);
+	const Expansion cdy = Expansion::diff(c[1], d[1]);
+
+	const Expansion alift = adx * adx + ady * ady;
+	const Expansion blift = bdx * bdx + bdy * bdy;
+	const Expansion clift = cdx * cdx + cdy * cdy;
+
+	return (
+		alift * det2_exact(bdx, bdy, cdx, cdy) +
+		blift * det2_exact(cdx, cdy, adx, ady) +
+		clift * det2_exact(adx, ady, bdx, bdy)
+	).estimate();
+}
+
+inline bool insphere_fast(const float64* a, const float64* b, const float64* c, const float64* d, const float64* e, float64& det)
+{
+	const float64 aex = a[0] - e[0], aey = a[1] - e[1], aez = a[2] - e[2];
+	const float64 bex = b[0] - e[0], bey = b[1] - e[1], bez = b[2] - e[2];
+	const float64 cex = c[0] - e[0], cey = c[1] - e[1], cez = c[2] - e[2];
+	const float64 dex = d[0] - e[0], dey = d[1] - e[1], dez = d[2] - e[2];
+
+	const float64 aexbey = aex * bey, bexaey = bex * aey;
+	const float64 bexcey = bex * cey, cexbey = cex * bey;
+	const float64 cexdey = cex * dey, dexcey = dex * cey;
+	const float64 dexaey = dex * aey, aexdey = aex * dey;
+	const float64 aexcey = aex * cey, cexaey = cex * aey;
+	const float64 bexdey = bex * dey, dexbey = dex * bey;
+
+	const float64 ab = aexbey - bexaey;
+	const float64 bc = bexcey - cexbey;
+	const float64 cd = cexdey - dexcey;
+	const float64 da = dexaey - aexdey;
+	const float64 ac = aexcey - cexaey;
+	const float64 bd = bexdey - dexbey;
+
+	const float64 abc = aez * bc - bez * ac + cez * ab;
+	const float64 bcd = bez * cd - cez * bd + dez * bc;
+	const float64 cda = cez * da + dez * ac + aez * cd;
+	const float64 dab = dez * ab + aez * bd + bez * da;
+
+	const float64 alift = aex * aex + aey * aey + aez * aez;
+	const float64 blift = bex * bex + bey * bey + bez * bez;
+	const float64 clift = cex * cex + cey * cey + cez * cez;
+	const float64 dlift = dex * dex + dey * dey + dez * dez;
+
+	det = (dlift * abc - clift * dab) + (blift * cda - alift * bcd);
+
+	const float64 aezp = std::abs(aez), bezp = std::abs(bez), cezp = std::abs(cez), dezp = std::abs(dez);
+	const float64 aexbeyp = std::abs(aexbey), bexaeyp = std::abs(bexaey);
+	const float64 bexceyp = std::abs(bexcey), cexbeyp = std::abs(cexbey);
+	const float64 cexdeyp = std::abs(cexdey), dexceyp = std::abs(dexcey);
+	const float64 dexaeyp = std::abs(dexaey), aexdeyp = std::abs(aexdey);
+	const float64 aexceyp = std::abs(aexcey), cexaeyp = std::abs(cexaey);
+	const float64 bexdeyp = std::abs(bexdey), dexbeyp = std::abs(dexbey);
+
+	const float64 permanent =
+		((cexdeyp + dexceyp) * bezp + (dexbeyp + bexdeyp) * cezp + (bexceyp + cexbeyp) * dezp) * alift +
+		((dexaeyp + aexdeyp) * cezp + (aexceyp + cexaeyp) * dezp + (cexdeyp + dexceyp) * aezp) * blift +
+		((aexbeyp + bexaeyp) * dezp + (bexdeyp + dexbeyp) * aezp + (dexaeyp + aexdeyp) * bezp) * clift +
+		((bexceyp + cexbeyp) * aezp + (cexaeyp + aexceyp) * bezp + (aexbeyp + bexaeyp) * cezp) * dlift;
+	const float64 errbound = INSPHERE_BOUND * permanent;
+	return det > errbound || -det > errbound;
+}
+
+inline float64 insphere_exact(const float64* a, const float64* b, const float64* c, const float64* d, const float64* e)
+{
+	const Expansion aex = Expansion::diff(a[0], e[0]), aey = Expansion::diff(a[1], e[1]), aez = Expansion::diff(a[2], e[2]);
+	const Expansion bex = Expansion::diff(b[0], e[0]), bey = Expansion::diff(b[1], e[1]), bez = Expansion::diff(b[2], e[2]);
+	const Expansion cex = Expansion::diff(c[0], e[0]), cey = Expansion::diff(c[1], e[1]), cez = Expansion::diff(c[2], e[2]);
+	const Expansion dex = Expansion::diff(d[0], e[0]), dey = Expansion::diff(d[1], e[1]), dez = Expansion::diff(d[2], e[2]);
+
+	const Expansion ab = det2_exact(aex, aey, bex, bey);
+	const Expansion bc = det2_exact(bex, bey, cex, cey);
+	const Expansion cd = det2_exact(cex, cey, dex, dey);
+	const Expansion da = det2_exact(dex, dey, aex, aey);
+	const Expansion ac = det2_exact(aex, aey, cex, cey);
+	const Expansion bd = det2_exact(bex, bey, dex, dey);
+
+	const Expansion abc = aez * bc - bez * ac + cez * ab;
+	const Expansion bcd = bez * cd - cez * bd + dez * bc;
+	const Expansion cda = cez * da + dez * ac + aez * cd;
+	const Expansion dab = dez * ab + aez * bd + bez * da;
+
+	const Expansion alift = aex * aex + aey * aey + aez * aez;
+	const Expansion blift = bex * bex + bey * bey + bez * bez;
+	const Expansion clift = cex * cex + cey * cey + cez * cez;
+	const Expansion dlift = dex * dex + dey * dey + dez * dez;
+
+	return ((dlift * abc - clift * dab) + (blift * cda - alift * bcd)).estimate();
+}
+
+template <typename VEC>
+inline void to_float64(const Eigen::MatrixBase<VEC>& v, float64* r)
+{
+	for (int32 i = 0; i < int32(VEC::RowsAtCompileTime); ++i)
+		r[i] = float64(v[i]);
+}
+
+} // namespace internal
+
+/**
+ * \brief orientation of the triangle (a, b, c) in the plane
+ * @return a positive value if a, b, c are in counterclockwise order, negative if clockwise, 0 if they are aligned
+ */
+template <typename VEC2a, typename VEC2b, typename VEC2c>
+float64 orient2d(const Eigen::MatrixBase<VEC2a>& a, const Eigen::MatrixBase<VEC2b>& b, const Eigen::MatrixBase<VEC2c>& c)
+{
+	static_assert(is_same_vector<VEC2a,VEC2b,VEC2c>::value, "parameters must have same type");
+	static_assert(is_dim_of<VEC2a, 2>::value, "The size of the vector must be equal to 2.");
+
+	float64 pa[2], pb[2], pc[2];
+	internal::to_float64(a, pa);
+	internal::to_float64(b, pb);
+	internal::to_float64(c, pc);
+
+	float64 det;
+	if (internal::orient2d_fast(pa, pb, pc, det))
+		return det;
+	return internal::orient2d_exact(pa, pb, pc);
+}
+
+/**
+ * \brief orientation of the tetrahedron (a, b, c, d): determinant of (a-d, b-d, c-d)
+ * @return a positive value if d is below the plane of a, b, c (a, b, c counterclockwise seen from above),
+ * negative if d is above, 0 if the points are coplanar
+ */
+template <typename VEC3a, typename VEC3b, typename VEC3c, typename VEC3d>
+float64 orient3d(const Eigen::MatrixBase<VEC3a>& a, const Eigen::MatrixBase<VEC3b>& b, const Eigen::MatrixBase<VEC3c>& c, const Eigen::MatrixBase<VEC3d>& d)
+{
+	static_assert(is_same_vector<VEC3a,VEC3b,VEC3c,VEC3d>::value, "parameters must have same type");
+	static_assert(is_dim_of<VEC3a, 3>::value, "The size of the vector must be equal to 3.");
+
+	float64 pa[3], pb[3], pc[3], pd[3];
+	internal::to_float64(a, pa);
+	internal::to_float64(b, pb);
+	internal::to_float64(c, pc);
+	internal::to_float64(d, pd);
+
+	float64 det;
+	if (internal::orient3d_fast(pa, pb, pc, pd, det))
+		return det;
+	return internal::orient3d_exact(pa, pb, pc, pd);
+}
+
+/**
+ * \brief orientation of a vector w.r.t. a triangle: triple product (a-c).((b-c)^v)
+ * @return a positive value if a, b, c are counterclockwise seen from the side v points to,
+ * negative if they are clockwise, 0 if v is parallel to the plane of a, b, c
+ */
+template <typename VEC3a, typename VEC3b, typename VEC3c, typename VEC3d>
+float64 orient3d_vector(const Eigen::MatrixBase<VEC3a>& a, const Eigen::MatrixBase<VEC3b>& b, const Eigen::MatrixBase<VEC3c>& c, const Eigen::MatrixBase<VEC3d>& v)
+{
+	static_assert(is_same_vector<VEC3a,VEC3b,VEC3c,VEC3d>::value, "parameters must have same type");
+	static_assert(is_dim_of<VEC3a, 3>::value, "The size of the vector must be equal to 3.");
+
+	float64 pa[3], pb[3], pc[3], pv[3];
+	internal::to_float64(a, pa);
+	internal::to_float64(b, pb);
+	internal::to_float64(c, pc);
+	internal::to_float64(v, pv);
+
+	float64 det;
+	if (internal::orient3d_vector_fast(pa, pb, pc, pv, det))
+		return det;
+	return internal::orient3d_vector_exact(pa, pb, pc, pv);
+}
+
+/**
+ * \brief position of d w.r.t. the circle through a, b, c (counterclockwise)
+ * @return a positive value if d is inside the circle, negative if outside, 0 if the points are cocircular
+ */
+template <typename VEC2a, typename VEC2b, typename VEC2c, typename VEC2d>
+float64 incircle(const Eigen::MatrixBase<VEC2a>& a, const Eigen::MatrixBase<VEC2b>& b, const Eigen::MatrixBase<VEC2c>& c, const Eigen::MatrixBase<VEC2d>& d)
+{
+	static_assert(is_same_vector<VEC2a,VEC2b,VEC2c,VEC2d>::value, "parameters must have same type");
+	static_assert(is_dim_of<VEC2a, 2>::value, "The size of the vector must be equal to 2.");
+
+	float64 pa[2], pb[2], pc[2], pd[2];
+	internal::to_float64(a, pa);
+	internal::to_float64(b, pb);
+	internal::to_float64(c, pc);
+	internal::to_float64(d, pd);
+
+	float64 det;
+	if (internal::incircle_fast(pa, pb, pc, pd, det))
+		return det;
+	return internal::incircle_exact(pa, pb, pc, pd);
+}
+
+/**
+ * \brief position of e w.r.t. the sphere through a, b, c, d (with orient3d(a, b, c, d) > 0)
+ * @return a positive value if e is inside the sphere, negative if outside, 0 if the points are cospherical
+ */
+template <typename VEC3a, typename VEC3b, typename VEC3c, typename VEC3d, typename VEC3e>
+float64 insphere(const Eigen::MatrixBase<VEC3a>& a, const Eigen::MatrixBase<VEC3b>& b, const Eigen::MatrixBase<VEC3c>& c, const Eigen::MatrixBase<VEC3d>& d, const Eigen::MatrixBase<VEC3e>& e)
+{
+	static_assert(is_same_vector<VEC3a,VEC3b,VEC3c,VEC3d,VEC3e>::value, "parameters must have same type");
+	static_assert(is_dim_of<VEC3a, 3>::value, "The size of the vector must be equal to 3.");
+
+	float64 pa[3], pb[3], pc[3], pd[3], pe[3];
+	internal::to_float64(a, pa);
+	internal::to_float64(b, pb);
+	internal::to_float64(c, pc);
+	internal::to_float64(d, pd);
+	internal::to_float64(e, pe);
+
+	float64 det;
+	if (internal::insphere_fast(pa, pb, pc, pd, pe, det))
+		return det;
+	return internal::insphere_exact(pa, pb, pc, pd, pe);
+}
+
+/// non eigen versions
+
+template <typename VEC2>
+inline auto orient2d(const VEC2& a, const VEC2& b, const VEC2& c)
+-> typename std::enable_if <is_vec_non_eigen<VEC2>::value, float64>::type
+{
+	return orient2d(eigenize(a), eigenize(b), eigenize(c));
+}
+
+template <typename VEC3>
+inline auto orient3d(const VEC3& a, const VEC3& b, const VEC3& c, const VEC3& d)
+-> typename std::enable_if <is_vec_non_eigen<VEC3>::value, float64>::type
+{
+	return orient3d(eigenize(a), eigenize(b), eigenize(c), eigenize(d));
+}
+
+template <typename VEC3>
+inline auto orient3d_vector(const VEC3& a, const VEC3& b, const VEC3& c, const VEC3& v)
+-> typename std::enable_if <is_vec_non_eigen<VEC3>::value, float64>::type
+{
+	return orient3d_vector(eigenize(a), eigenize(b), eigenize(c), eigenize(v));
+}
+
+template <typename VEC2>
+inline auto incircle(const VEC2& a, const VEC2& b, const VEC2& c, const VEC2& d)
+-> typename std::enable_if <is_vec_non_eigen<VEC2>::value, float64>::type
+{
+	return incircle(eigenize(a), eigenize(b), eigenize(c), eigenize(d));
+}
+
+template <typename VEC3>
+inline auto insphere(const VEC3& a, const VEC3& b, const VEC3& c, const VEC3& d, const VEC3& e)
+-> typename std::enable_if <is_vec_non_eigen<VEC3>::value, float64>::type
+{
+	return insphere(eigenize(a), eigenize(b), eigenize(c), eigenize(d), eigenize(e));
+}
+
+} // namespace geometry
+
+} // namespace cgogn
+
+#endif // CGOGN_GEOMETRY_FUNCTIONS_PREDICATES_H_
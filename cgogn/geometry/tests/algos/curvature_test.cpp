@@ -0,0 +1,157 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include <cgogn/core/cmap/cmap2_tri.h>
+
+#include <cgogn/geometry/types/eigen.h>
+#include <cgogn/geometry/algos/angle.h>
+#include <cgogn/geometry/algos/normal.h>
+#include <cgogn/geometry/algos/curvature.h>
+
+using namespace cgogn::numerics;
+
+using Vec3 = Eigen::Vector3d;
+using Map2 = cgogn::CMap2Tri;
+using Vertex = Map2::Vertex;
+using Edge = Map2::Edge;
+
+class CurvatureTest : public testing::Test
+{
+protected:
+
+	Map2 map_;
+	Map2::VertexAttribute<Vec3> position_;
+	Map2::VertexAttribute<Vec3> normal_;
+	Map2::EdgeAttribute<float64> edge_angle_;
+	Map2::EdgeAttribute<float64> edge_area_;
+
+	CurvatureTest()
+	{
+		// closed triangulated torus, n x m vertices
+		const uint32 n = 40u;
+		const uint32 m = 20u;
+		std::vector<uint32> triangles;
+		for (uint32 j = 0u; j < m; ++j)
+		{
+			for (uint32 i = 0u; i < n; ++i)
+			{
+				const uint32 a = j * n + i;
+				const uint32 b = j * n + (i + 1u) % n;
+				const uint32 c = ((j + 1u) % m) * n + (i + 1u) % n;
+				const uint32 d = ((j + 1u) % m) * n + i;
+				triangles.insert(triangles.end(), { a, b, c, a, c, d });
+			}
+		}
+		Map2::Builder builder(map_);
+		const uint32 first = builder.create_faces_from_indices(triangles, n * m);
+		position_ = map_.add_attribute<Vec3, Vertex>("position");
+		for (uint32 j = 0u; j < m; ++j)
+		{
+			for (uint32 i = 0u; i < n; ++i)
+			{
+				const float64 u = 2.0 * M_PI * float64(i) / float64(n);
+				const float64 v = 2.0 * M_PI * float64(j) / float64(m);
+				position_[first + j * n + i] = Vec3((3.0 + std::cos(v)) * std::cos(u), (3.0 + std::cos(v)) * std::sin(u), std::sin(v));
+			}
+		}
+
+		normal_ = map_.add_attribute<Vec3, Vertex>("normal");
+		edge_angle_ = map_.add_attribute<float64, Edge>("edge_angle");
+		edge_area_ = map_.add_attribute<float64, Edge>("edge_area");
+		cgogn::geometry::compute_normal(map_, position_, normal_);
+		cgogn::geometry::compute_angle_between_face_normals(map_, position_, edge_angle_);
+	}
+
+	struct Curvature
+	{
+		Map2::VertexAttribute<float64> kmax, kmin;
+		Map2::VertexAttribute<Vec3> Kmax, Kmin, Knormal;
+
+		Curvature(Map2& map, const std::string& name)
+		{
+			kmax = map.add_attribute<float64, Vertex>(name + "_kmax");
+			kmin = map.add_attribute<float64, Vertex>(name + "_kmin");
+			Kmax = map.add_attribute<Vec3, Vertex>(name + "_Kmax");
+			Kmin = map.add_attribute<Vec3, Vertex>(name + "_Kmin");
+			Knormal = map.add_attribute<Vec3, Vertex>(name + "_Knormal");
+		}
+	};
+};
+
+TEST_F(CurvatureTest, parallel_is_serial)
+{
+	const float64 radius = 0.6;
+
+	Curvature serial(map_, "serial");
+	map_.foreach_cell([&] (Vertex v)
+	{
+		cgogn::geometry::curvature(map_, v, radius, position_, normal_, edge_angle_, edge_area_,
+			serial.kmax, serial.kmin, serial.Kmax, serial.Kmin, serial.Knormal);
+	});
+
+	Curvature parallel(map_, "parallel");
+	cgogn::geometry::compute_curvature(map_, radius, position_, normal_, edge_angle_, edge_area_,
+		parallel.kmax, parallel.kmin, parallel.Kmax, parallel.Kmin, parallel.Knormal);
+
+	map_.foreach_cell([&] (Vertex v)
+	{
+		EXPECT_EQ(serial.kmax[v], parallel.kmax[v]);
+		EXPECT_EQ(serial.kmin[v], parallel.kmin[v]);
+		EXPECT_EQ(serial.Kmax[v], parallel.Kmax[v]);
+		EXPECT_EQ(serial.Kmin[v], parallel.Kmin[v]);
+		EXPECT_EQ(serial.Knormal[v], parallel.Knormal[v]);
+
+		// on the outer equator of the torus, the principal curvatures are 1 and 1/4
+		if (position_[v][2] == 0.0 && position_[v].norm() > 3.5)
+		{
+			EXPECT_NEAR(serial.kmax[v], 1.0, 0.1);
+			EXPECT_NEAR(serial.kmin[v], 0.25, 0.1);
+		}
+	});
+}
+
+TEST_F(CurvatureTest, kdtree_neighborhood)
+{
+	// (the radius is small enough for the Euclidean and the topological neighborhoods to be the same)
+	const float64 radius = 0.6;
+
+	Curvature sphere(map_, "sphere");
+	cgogn::geometry::compute_curvature(map_, radius, position_, normal_, edge_angle_, edge_area_,
+		sphere.kmax, sphere.kmin, sphere.Kmax, sphere.Kmin, sphere.Knormal);
+
+	cgogn::geometry::KDTree<Map2, Vec3> kdtree(map_, position_);
+	Curvature ball(map_, "ball");
+	cgogn::geometry::compute_curvature(kdtree, radius, normal_, edge_angle_, edge_area_,
+		ball.kmax, ball.kmin, ball.Kmax, ball.Kmin, ball.Knormal);
+
+	map_.foreach_cell([&] (Vertex v)
+	{
+		EXPECT_NEAR(sphere.kmax[v], ball.kmax[v], 1e-9);
+		EXPECT_NEAR(sphere.kmin[v], ball.kmin[v], 1e-9);
+		EXPECT_NEAR(std::abs(sphere.Knormal[v].dot(ball.Knormal[v])), 1.0, 1e-9);
+	});
+}
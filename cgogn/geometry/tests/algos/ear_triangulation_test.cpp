@@ -0,0 +1,221 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <cmath>
+#include <random>
+#include <array>
+#include <algorithm>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <cgogn/core/cmap/cmap2.h>
+
+#include <cgogn/geometry/types/eigen.h>
+#include <cgogn/geometry/algos/ear_triangulation.h>
+
+#include <cgogn/io/map_import.h>
+
+#define DEFAULT_MESH_PATH CGOGN_STR(CGOGN_TEST_MESHES_PATH)
+
+using namespace cgogn::numerics;
+
+using Vec3 = Eigen::Vector3d;
+using Map2 = cgogn::CMap2;
+using Vertex = Map2::Vertex;
+using Edge = Map2::Edge;
+using Face = Map2::Face;
+
+/**
+ * \brief a n-gon in a random plane, convex or star shaped (with reflex vertices)
+ */
+static Face random_polygon(Map2& map, Map2::VertexAttribute<Vec3>& position, std::mt19937& gen, uint32 n, bool convex)
+{
+	std::uniform_real_distribution<float64> unit(0.0, 1.0);
+	const Vec3 u = Vec3(unit(gen), unit(gen), unit(gen)).normalized();
+	const Vec3 w = u.unitOrthogonal();
+	const Vec3 v = u.cross(w);
+
+	std::vector<float64> angles(n);
+	for (uint32 i = 0u; i < n; ++i)
+		angles[i] = 2.0 * M_PI * (float64(i) + 0.8 * unit(gen)) / float64(n);
+
+	Face f = map.add_face(n);
+	cgogn::Dart d = f.dart;
+	for (uint32 i = 0u; i < n; ++i)
+	{
+		const float64 r = convex ? 1.0 : 0.5 + 0.5 * unit(gen);
+		position[Vertex(d)] = r * (std::cos(angles[i]) * w + std::sin(angles[i]) * v);
+		d = map.phi1(d);
+	}
+	return f;
+}
+
+static float64 triangles_area(const Map2::VertexAttribute<Vec3>& position, const std::vector<uint32>& indices)
+{
+	float64 area = 0.0;
+	for (uint32 i = 0u; i < indices.size(); i += 3u)
+		area += 0.5 * (position[indices[i+1u]] - position[indices[i]]).cross(position[indices[i+2u]] - position[indices[i]]).norm();
+	return area;
+}
+
+/**
+ * \brief check that the triangles cover the polygon (planar, through the origin) without overlap
+ */
+static void check_triangulation(Map2& map, const Map2::VertexAttribute<Vec3>& position, Face f, const std::vector<uint32>& indices)
+{
+	Vec3 n = Vec3::Zero();
+	map.foreach_incident_vertex(f, [&] (Vertex v)
+	{
+		n += position[v].cross(position[Vertex(map.phi1(v.dart))]);
+	});
+	const float64 area = 0.5 * n.norm();
+	n.normalize();
+
+	ASSERT_EQ(indices.size(), 3u * (map.codegree(f) - 2u));
+	for (uint32 i = 0u; i < indices.size(); i += 3u)
+	{
+		const Vec3& A = position[indices[i]];
+		const Vec3& B = position[indices[i+1u]];
+		const Vec3& C = position[indices[i+2u]];
+		EXPECT_GE((B - A).cross(C - A).dot(n), -1e-12);
+	}
+	EXPECT_NEAR(triangles_area(position, indices), area, 1e-9);
+}
+
+TEST(EarTriangulationTest, pooled_triangulation)
+{
+	Map2 map;
+	auto position = map.add_attribute<Vec3, Vertex>("position");
+	std::mt19937 gen(11);
+
+	std::vector<uint32> expected;
+	std::vector<uint32> indices;
+	for (uint32 k = 0u; k < 2000u; ++k)
+	{
+		const uint32 n = 4u + k % 24u;
+		Face f = random_polygon(map, position, gen, n, k % 3u == 0u);
+
+		expected.clear();
+		cgogn::geometry::EarTriangulation<Vec3, Map2> reference(map, f, position);
+		reference.append_indices(expected);
+		check_triangulation(map, position, f, expected);
+
+		indices.clear();
+		cgogn::geometry::PooledEarTriangulation<Vec3, Map2> pooled(map, f, position);
+		pooled.append_indices(indices);
+		EXPECT_EQ(indices, expected);
+	}
+
+	// polygons smaller than a triangle give no indices
+	indices.clear();
+	cgogn::geometry::append_ear_triangulation(map, map.add_face(2u), position, indices);
+	EXPECT_TRUE(indices.empty());
+}
+
+/**
+ * \brief the indices of the reference and pooled ear triangulations of all the faces of the map
+ */
+static void expect_same_indices(Map2& map, const Map2::VertexAttribute<Vec3>& position)
+{
+	std::vector<uint32> expected;
+	std::vector<uint32> indices;
+	map.foreach_cell([&] (Face f)
+	{
+		cgogn::geometry::EarTriangulation<Vec3, Map2> reference(map, f, position);
+		reference.append_indices(expected);
+		cgogn::geometry::append_ear_triangulation(map, f, position, indices);
+	});
+	EXPECT_FALSE(indices.empty());
+	EXPECT_TRUE(indices == expected);
+}
+
+TEST(EarTriangulationTest, pooled_meshes)
+{
+	for (const std::string& name : { std::string("off/aneurysm_quad.off"), std::string("obj/hand_remeshed.obj") })
+	{
+		Map2 map;
+		cgogn::io::import_surface<Vec3>(map, std::string(DEFAULT_MESH_PATH) + name);
+		Map2::VertexAttribute<Vec3> position = map.get_attribute<Vec3, Vertex>("position");
+		ASSERT_TRUE(position.is_valid());
+		expect_same_indices(map, position);
+
+		// larger polygons: merge each face with (at most) one of its neighbors
+		Map2::CellMarker<Face::ORBIT> merged(map);
+		map.foreach_cell([&] (Edge e)
+		{
+			const Face f1(e.dart);
+			const Face f2(map.phi2(e.dart));
+			if (map.is_incident_to_boundary(e) || merged.is_marked(f1) || merged.is_marked(f2))
+				return;
+			merged.mark(f1);
+			merged.mark(f2);
+			map.merge_incident_faces(e);
+		});
+		expect_same_indices(map, position);
+	}
+}
+
+TEST(EarTriangulationTest, pooled_apply)
+{
+	Map2 map;
+	auto position = map.add_attribute<Vec3, Vertex>("position");
+	std::mt19937 gen(5);
+
+	std::vector<uint32> indices;
+	for (uint32 n = 3u; n < 40u; ++n)
+	{
+		Face f = random_polygon(map, position, gen, n, n % 2u == 0u);
+		cgogn::geometry::append_ear_triangulation(map, f, position, indices);
+	}
+	const float64 area = triangles_area(position, indices);
+
+	cgogn::geometry::apply_ear_triangulation(map, position);
+
+	// same triangles as the appended indices
+	std::vector<std::array<uint32, 3>> triangles;
+	float64 faces_area = 0.0;
+	map.foreach_cell([&] (Face f)
+	{
+		if (map.is_boundary(f.dart))
+			return;
+		EXPECT_EQ(map.codegree(f), 3u);
+		std::array<uint32, 3> t;
+		uint32 i = 0u;
+		map.foreach_incident_vertex(f, [&] (Vertex v) { t[i++] = map.embedding(v); });
+		std::sort(t.begin(), t.end());
+		triangles.push_back(t);
+		faces_area += triangles_area(position, std::vector<uint32>(t.begin(), t.end()));
+	});
+	std::vector<std::array<uint32, 3>> expected;
+	for (uint32 i = 0u; i < indices.size(); i += 3u)
+	{
+		std::array<uint32, 3> t = {{ indices[i], indices[i+1u], indices[i+2u] }};
+		std::sort(t.begin(), t.end());
+		expected.push_back(t);
+	}
+	std::sort(triangles.begin(), triangles.end());
+	std::sort(expected.begin(), expected.end());
+	EXPECT_EQ(triangles, expected);
+	EXPECT_NEAR(faces_area, area, 1e-9);
+}
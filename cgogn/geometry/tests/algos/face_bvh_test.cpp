@@ -0,0 +1,237 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <cmath>
+#include <limits>
+
+#include <gtest/gtest.h>
+
+#include <cgogn/core/cmap/cmap2_tri.h>
+#include <cgogn/core/cmap/cmap2_quad.h>
+
+#include <cgogn/geometry/types/eigen.h>
+#include <cgogn/geometry/algos/face_bvh.h>
+#include <cgogn/geometry/algos/picking.h>
+
+using namespace cgogn::numerics;
+
+using Vec3 = Eigen::Vector3d;
+
+/**
+ * \brief fill a map with a wavy n x n grid of PRIM_SIZE-gons (triangles or quads) in the plane z ~ 0
+ */
+template <typename MAP>
+static void wavy_grid(MAP& map, typename MAP::template VertexAttribute<Vec3>& position, uint32 n)
+{
+	std::vector<uint32> faces;
+	for (uint32 j = 0u; j < n; ++j)
+	{
+		for (uint32 i = 0u; i < n; ++i)
+		{
+			const uint32 v = j * (n + 1u) + i;
+			if (MAP::PRIM_SIZE == 3u)
+				faces.insert(faces.end(), { v, v + 1u, v + n + 2u, v, v + n + 2u, v + n + 1u });
+			else
+				faces.insert(faces.end(), { v, v + 1u, v + n + 2u, v + n + 1u });
+		}
+	}
+	typename MAP::Builder builder(map);
+	const uint32 first = builder.create_faces_from_indices(faces, (n + 1u) * (n + 1u));
+	for (uint32 j = 0u; j <= n; ++j)
+		for (uint32 i = 0u; i <= n; ++i)
+			position[first + j * (n + 1u) + i] = Vec3(float64(i), float64(j), 0.3 * std::sin(float64(i + j)));
+}
+
+template <typename MAP>
+static void check_same_picking(const MAP& map, const typename MAP::template VertexAttribute<Vec3>& position, const cgogn::geometry::FaceBVH<MAP, Vec3>& bvh, uint32 n)
+{
+	using Face = typename MAP::Face;
+	using Vertex = typename MAP::Vertex;
+
+	for (uint32 k = 0u; k < 50u; ++k)
+	{
+		const Vec3 A(0.37 + float64(k % 7u) * float64(n) / 7.0, 0.61 + float64(k % 5u) * float64(n) / 5.0, 5.0);
+		const Vec3 B = A + Vec3(0.1 * float64(k % 3u), -0.05 * float64(k % 4u), -1.0);
+
+		std::vector<Face> brute_faces;
+		std::vector<Face> bvh_faces;
+		cgogn::geometry::picking(map, position, A, B, brute_faces);
+		EXPECT_EQ(cgogn::geometry::picking(bvh, A, B, bvh_faces), !brute_faces.empty());
+		ASSERT_EQ(bvh_faces.size(), brute_faces.size());
+		for (std::size_t i = 0u; i < brute_faces.size(); ++i)
+			EXPECT_EQ(bvh_faces[i].dart, brute_faces[i].dart);
+
+		std::vector<Vertex> brute_vertices;
+		std::vector<Vertex> bvh_vertices;
+		cgogn::geometry::picking(map, position, A, B, brute_vertices);
+		cgogn::geometry::picking(bvh, A, B, bvh_vertices);
+		ASSERT_EQ(bvh_vertices.size(), brute_vertices.size());
+		for (std::size_t i = 0u; i < brute_vertices.size(); ++i)
+			EXPECT_EQ(bvh_vertices[i].dart, brute_vertices[i].dart);
+
+		typename cgogn::geometry::FaceBVH<MAP, Vec3>::Hit hit;
+		EXPECT_EQ(bvh.intersect_ray(A, B - A, hit), !brute_faces.empty());
+		if (!brute_faces.empty())
+		{
+			EXPECT_EQ(hit.face.dart, brute_faces.front().dart);
+		}
+	}
+}
+
+TEST(FaceBVHTest, tri_picking)
+{
+	cgogn::CMap2Tri map;
+	auto position = map.add_attribute<Vec3, cgogn::CMap2Tri::Vertex>("position");
+	wavy_grid(map, position, 80u);
+
+	cgogn::geometry::FaceBVH<cgogn::CMap2Tri, Vec3> bvh(map, position);
+	EXPECT_EQ(bvh.nb_triangles(), 2u * 80u * 80u);
+	check_same_picking(map, position, bvh, 80u);
+}
+
+TEST(FaceBVHTest, quad_picking)
+{
+	cgogn::CMap2Quad map;
+	auto position = map.add_attribute<Vec3, cgogn::CMap2Quad::Vertex>("position");
+	wavy_grid(map, position, 40u);
+
+	cgogn::geometry::FaceBVH<cgogn::CMap2Quad, Vec3> bvh(map, position);
+	EXPECT_EQ(bvh.nb_triangles(), 2u * 40u * 40u);
+	check_same_picking(map, position, bvh, 40u);
+}
+
+TEST(FaceBVHTest, segment_and_refit)
+{
+	using Hit = cgogn::geometry::FaceBVH<cgogn::CMap2Tri, Vec3>::Hit;
+
+	cgogn::CMap2Tri map;
+	auto position = map.add_attribute<Vec3, cgogn::CMap2Tri::Vertex>("position");
+	wavy_grid(map, position, 20u);
+
+	cgogn::geometry::FaceBVH<cgogn::CMap2Tri, Vec3> bvh(map, position);
+
+	Hit hit;
+	EXPECT_TRUE(bvh.intersect_segment(Vec3(5.3, 5.4, 2.0), Vec3(5.3, 5.4, -2.0), hit));
+	EXPECT_NEAR(hit.point[0], 5.3, 1e-9);
+	EXPECT_NEAR(hit.distance, 2.0 - hit.point[2], 1e-9);
+	EXPECT_FALSE(bvh.intersect_segment(Vec3(5.3, 5.4, 2.0), Vec3(5.3, 5.4, 1.0), hit));
+	EXPECT_FALSE(bvh.intersect_ray(Vec3(5.3, 5.4, 2.0), Vec3(0.0, 0.0, 1.0), hit));
+
+	// move the grid aside, the ray misses the old bounding boxes
+	map.foreach_cell([&] (cgogn::CMap2Tri::Vertex v) { position[v][0] += 100.0; });
+	EXPECT_FALSE(bvh.intersect_segment(Vec3(105.3, 5.4, 2.0), Vec3(105.3, 5.4, -2.0), hit));
+	bvh.refit();
+	EXPECT_TRUE(bvh.intersect_segment(Vec3(105.3, 5.4, 2.0), Vec3(105.3, 5.4, -2.0), hit));
+	EXPECT_NEAR(hit.point[0], 105.3, 1e-9);
+}
+
+TEST(FaceBVHTest, closest_point)
+{
+	using BVH = cgogn::geometry::FaceBVH<cgogn::CMap2Tri, Vec3>;
+
+	cgogn::CMap2Tri map;
+	auto position = map.add_attribute<Vec3, cgogn::CMap2Tri::Vertex>("position");
+	wavy_grid(map, position, 30u);
+
+	BVH bvh(map, position);
+
+	std::vector<Vec3> points;
+	for (uint32 k = 0u; k < 200u; ++k)
+		points.push_back(Vec3(-2.0 + 0.17 * float64(k % 23u) * 1.5, -2.0 + 0.13 * float64(k % 31u) * 1.1, 3.0 * std::cos(float64(k))));
+
+	std::vector<BVH::Projection> projections;
+	bvh.closest_points(points, projections);
+	ASSERT_EQ(projections.size(), points.size());
+
+	for (std::size_t k = 0u; k < points.size(); ++k)
+	{
+		const Vec3& P = points[k];
+
+		// brute force over the triangles
+		float64 best = std::numeric_limits<float64>::max();
+		map.foreach_cell([&] (cgogn::CMap2Tri::Face f)
+		{
+			const cgogn::Dart d = f.dart;
+			const Vec3& a = position[cgogn::CMap2Tri::Vertex(d)];
+			const Vec3& b = position[cgogn::CMap2Tri::Vertex(map.phi1(d))];
+			const Vec3& c = position[cgogn::CMap2Tri::Vertex(map.phi_1(d))];
+			best = std::min(best, cgogn::geometry::squared_distance_triangle_point(a, b, c, P));
+		});
+
+		const BVH::Projection& proj = projections[k];
+		EXPECT_NEAR(proj.distance, std::sqrt(best), 1e-9);
+		EXPECT_NEAR((proj.point - P).norm(), proj.distance, 1e-9);
+		EXPECT_NEAR(proj.barycentric[0] + proj.barycentric[1] + proj.barycentric[2], 1.0, 1e-9);
+	}
+
+	BVH::Projection proj;
+	EXPECT_FALSE(bvh.closest_point(Vec3(15.0, 15.0, 10.0), proj, 5.0));
+	EXPECT_TRUE(bvh.closest_point(Vec3(15.0, 15.0, 10.0), proj, 11.0));
+}
+
+TEST(FaceBVHTest, signed_distance)
+{
+	using BVH = cgogn::geometry::FaceBVH<cgogn::CMap2Tri, Vec3>;
+
+	// closed outward-oriented octahedron
+	cgogn::CMap2Tri map;
+	auto position = map.add_attribute<Vec3, cgogn::CMap2Tri::Vertex>("position");
+	cgogn::CMap2Tri::Builder builder(map);
+	const uint32 first = builder.create_faces_from_indices({
+		0,2,4, 2,1,4, 1,3,4, 3,0,4,
+		2,0,5, 1,2,5, 3,1,5, 0,3,5 }, 6u);
+	position[first] = Vec3(1, 0, 0);
+	position[first + 1u] = Vec3(-1, 0, 0);
+	position[first + 2u] = Vec3(0, 1, 0);
+	position[first + 3u] = Vec3(0, -1, 0);
+	position[first + 4u] = Vec3(0, 0, 1);
+	position[first + 5u] = Vec3(0, 0, -1);
+
+	BVH bvh(map, position);
+
+	// inside, and outside near a face, an edge and a vertex
+	const std::vector<Vec3> points = {
+		Vec3(0.1, 0.2, -0.1), Vec3(0.5, 0.5, 0.5), Vec3(0.7, 0.7, 0.0), Vec3(2.0, 0.0, 0.0), Vec3(0.0, 0.0, -1.5)
+	};
+	const std::vector<float64> expected = {
+		-(1.0 - 0.4) / std::sqrt(3.0), 0.5 / std::sqrt(3.0), std::sqrt(2.0) * 0.2, 1.0, 0.5
+	};
+
+	for (BVH::SignMethod method : { BVH::PSEUDO_NORMAL, BVH::WINDING_NUMBER })
+	{
+		std::vector<float64> distances;
+		bvh.signed_distances(points, distances, method);
+		ASSERT_EQ(distances.size(), points.size());
+		for (std::size_t k = 0u; k < points.size(); ++k)
+			EXPECT_NEAR(distances[k], expected[k], 1e-9);
+	}
+
+	EXPECT_NEAR(bvh.winding_number(Vec3(0.1, 0.2, -0.1)), 1.0, 1e-9);
+	EXPECT_NEAR(bvh.winding_number(Vec3(3.0, 1.0, 2.0)), 0.0, 1e-9);
+
+	// the sign data follow the refit
+	map.foreach_cell([&] (cgogn::CMap2Tri::Vertex v) { position[v] *= 2.0; });
+	bvh.refit();
+	EXPECT_NEAR(bvh.signed_distance(Vec3(1.0, 0.0, 0.0), BVH::PSEUDO_NORMAL), -1.0 / std::sqrt(3.0), 1e-9);
+	EXPECT_NEAR(bvh.signed_distance(Vec3(1.0, 0.0, 0.0), BVH::WINDING_NUMBER), -1.0 / std::sqrt(3.0), 1e-9);
+}
@@ -0,0 +1,219 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include <cgogn/core/cmap/cmap2_tri.h>
+
+#include <cgogn/geometry/types/eigen.h>
+#include <cgogn/geometry/algos/geometry_cache.h>
+
+using namespace cgogn::numerics;
+
+using Vec3 = Eigen::Vector3d;
+using Map2 = cgogn::CMap2Tri;
+using Vertex = Map2::Vertex;
+using Edge = Map2::Edge;
+using Face = Map2::Face;
+using GeometryCache = cgogn::geometry::GeometryCache<Map2, Vec3>;
+
+class GeometryCacheTest : public testing::Test
+{
+protected:
+
+	static const uint32 N = 10u;
+
+	Map2 map_;
+	Map2::VertexAttribute<Vec3> position_;
+	std::vector<uint32> grid_;
+
+	GeometryCacheTest()
+	{
+		// n x n bumpy triangulated grid, vertex (i,j) is at line grid_[j * (N + 1) + i]
+		std::vector<uint32> triangles;
+		for (uint32 j = 0u; j < N; ++j)
+		{
+			for (uint32 i = 0u; i < N; ++i)
+			{
+				const uint32 v = j * (N + 1u) + i;
+				triangles.insert(triangles.end(), { v, v + 1u, v + N + 2u, v, v + N + 2u, v + N + 1u });
+			}
+		}
+		Map2::Builder builder(map_);
+		const uint32 first = builder.create_faces_from_indices(triangles, (N + 1u) * (N + 1u));
+		position_ = map_.add_attribute<Vec3, Vertex>("position");
+		for (uint32 j = 0u; j <= N; ++j)
+		{
+			for (uint32 i = 0u; i <= N; ++i)
+			{
+				grid_.push_back(first + j * (N + 1u) + i);
+				position_[first + j * (N + 1u) + i] = Vec3(float64(i), float64(j), std::sin(float64(i)) * std::cos(float64(j)));
+			}
+		}
+	}
+
+	Vertex grid_vertex(uint32 i, uint32 j)
+	{
+		Vertex res;
+		const uint32 emb = grid_[j * (N + 1u) + i];
+		map_.foreach_cell([&] (Vertex v) -> bool
+		{
+			if (map_.embedding(v) != emb)
+				return true;
+			res = v;
+			return false;
+		});
+		return res;
+	}
+
+	/**
+	 * \brief the cached values are the ones computed from scratch
+	 */
+	void check_values(GeometryCache& cache)
+	{
+		auto face_normal = map_.add_attribute<Vec3, Face>("face_normal");
+		auto face_area = map_.add_attribute<float64, Face>("face_area");
+		auto edge_length = map_.add_attribute<float64, Edge>("edge_length");
+		auto edge_angle = map_.add_attribute<float64, Edge>("edge_angle");
+		cgogn::geometry::compute_normal(map_, position_, face_normal);
+		cgogn::geometry::compute_area<Face>(map_, position_, face_area);
+		cgogn::geometry::compute_length(map_, position_, edge_length);
+		cgogn::geometry::compute_angle_between_face_normals(map_, position_, edge_angle);
+
+		const auto& cached_normal = cache.face_normal();
+		const auto& cached_area = cache.face_area();
+		const auto& cached_length = cache.edge_length();
+		const auto& cached_angle = cache.edge_angle();
+		EXPECT_EQ(cache.nb_dirty_faces(), 0u);
+		EXPECT_EQ(cache.nb_dirty_edges(), 0u);
+		map_.foreach_cell([&] (Face f)
+		{
+			EXPECT_NEAR((cached_normal[f] - face_normal[f]).norm(), 0.0, 1e-12);
+			EXPECT_NEAR(cached_area[f], face_area[f], 1e-12);
+		});
+		map_.foreach_cell([&] (Edge e)
+		{
+			EXPECT_NEAR(cached_length[e], edge_length[e], 1e-12);
+			EXPECT_NEAR(cached_angle[e], edge_angle[e], 1e-12);
+		});
+
+		map_.remove_attribute(face_normal);
+		map_.remove_attribute(face_area);
+		map_.remove_attribute(edge_length);
+		map_.remove_attribute(edge_angle);
+	}
+};
+
+TEST_F(GeometryCacheTest, initial_values)
+{
+	GeometryCache cache(map_, position_);
+	check_values(cache);
+
+	map_.foreach_cell([&] (Edge e)
+	{
+		if (map_.is_incident_to_boundary(e))
+		{
+			EXPECT_EQ(cache.angle(e), 0.0);
+		}
+	});
+}
+
+TEST_F(GeometryCacheTest, local_update)
+{
+	GeometryCache cache(map_, position_);
+
+	// an interior vertex of the grid has 6 incident triangles with 12 edges
+	const Vertex v = grid_vertex(4u, 5u);
+	cache.position(v) += Vec3(0.1, -0.2, 0.5);
+	EXPECT_EQ(cache.nb_dirty_faces(), 6u);
+	EXPECT_EQ(cache.nb_dirty_edges(), 12u);
+
+	// single values are recomputed on the fly
+	Face f;
+	map_.foreach_incident_face(v, [&] (Face inc) { f = inc; });
+	const Vec3 n = cgogn::geometry::normal(map_, f, position_);
+	EXPECT_NEAR((cache.normal(f) - n).norm(), 0.0, 1e-12);
+	EXPECT_EQ(cache.nb_dirty_faces(), 5u);
+
+	Edge e(v.dart);
+	EXPECT_NEAR(cache.angle(e), cgogn::geometry::angle_between_face_normals(map_, e, position_), 1e-12);
+	EXPECT_NEAR(cache.length(e), cgogn::geometry::length(map_, e, position_), 1e-12);
+	EXPECT_EQ(cache.nb_dirty_edges(), 11u);
+	EXPECT_LE(cache.nb_dirty_faces(), 4u);
+
+	check_values(cache);
+}
+
+TEST_F(GeometryCacheTest, touch_after_local_update)
+{
+	GeometryCache cache(map_, position_);
+
+	// the faces updated on the fly are dirty again before update()
+	const Vertex v = grid_vertex(4u, 5u);
+	Face f;
+	map_.foreach_incident_face(v, [&] (Face inc) { f = inc; });
+	Edge e(v.dart);
+	for (uint32 i = 0u; i < 10u; ++i)
+	{
+		position_[v] += Vec3(0.0, 0.0, 0.1);
+		cache.touch(v);
+		EXPECT_NEAR((cache.normal(f) - cgogn::geometry::normal(map_, f, position_)).norm(), 0.0, 1e-12);
+		EXPECT_NEAR(cache.length(e), cgogn::geometry::length(map_, e, position_), 1e-12);
+		EXPECT_LE(cache.nb_dirty_faces(), 5u);
+	}
+	position_[v] += Vec3(0.2, 0.0, 0.0);
+	cache.touch(v);
+	EXPECT_EQ(cache.nb_dirty_faces(), 6u);
+	EXPECT_EQ(cache.nb_dirty_edges(), 12u);
+	cache.update();
+	EXPECT_EQ(cache.nb_dirty_faces(), 0u);
+	check_values(cache);
+}
+
+TEST_F(GeometryCacheTest, touch)
+{
+	GeometryCache cache(map_, position_);
+
+	// positions written directly, then touched (twice for one of them)
+	const Vertex v1 = grid_vertex(0u, 0u);
+	const Vertex v2 = grid_vertex(1u, 0u);
+	const Vertex v3 = grid_vertex(7u, 3u);
+	position_[v1] += Vec3(0.0, 0.0, 1.0);
+	position_[v2] += Vec3(0.0, 0.0, -1.0);
+	position_[v3] += Vec3(0.3, 0.3, 0.3);
+	cache.touch(v1);
+	cache.touch(v2);
+	cache.touch(v1);
+	cache.touch(v3);
+
+	// corner (0,0) has 2 faces, (1,0) has 3 faces (1 of them shared), (7,3) has 6
+	EXPECT_EQ(cache.nb_dirty_faces(), 4u + 6u);
+	check_values(cache);
+
+	// after a change of the topology
+	map_.flip_edge(Edge(grid_vertex(5u, 5u).dart));
+	cache.refresh();
+	check_values(cache);
+}
@@ -0,0 +1,191 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <cmath>
+#include <random>
+#include <algorithm>
+
+#include <gtest/gtest.h>
+
+#include <cgogn/core/cmap/cmap0.h>
+#include <cgogn/core/cmap/cmap2_tri.h>
+
+#include <cgogn/geometry/types/eigen.h>
+#include <cgogn/geometry/algos/kdtree.h>
+#include <cgogn/geometry/algos/normal.h>
+#include <cgogn/geometry/algos/selection.h>
+
+using namespace cgogn::numerics;
+
+using Vec3 = Eigen::Vector3d;
+using Map0 = cgogn::CMap0;
+using KDTree0 = cgogn::geometry::KDTree<Map0, Vec3>;
+
+/**
+ * \brief random points in the unit cube, on the plane z = 0.5 x when planar is true
+ */
+static void random_points(Map0& map, Map0::VertexAttribute<Vec3>& position, uint32 n, bool planar)
+{
+	std::mt19937 gen(7);
+	std::uniform_real_distribution<float64> coord(0.0, 1.0);
+	for (uint32 i = 0u; i < n; ++i)
+	{
+		Map0::Vertex v = map.add_vertex();
+		const float64 x = coord(gen);
+		const float64 y = coord(gen);
+		position[v] = Vec3(x, y, planar ? 0.5 * x : coord(gen));
+	}
+}
+
+TEST(KDTreeTest, knn_and_radius)
+{
+	Map0 map;
+	auto position = map.add_attribute<Vec3, Map0::Vertex>("position");
+	random_points(map, position, 10000u, false);
+
+	KDTree0 kdtree(map, position);
+	EXPECT_EQ(kdtree.nb_points(), 10000u);
+
+	std::vector<float64> all;
+	for (uint32 q = 0u; q < 20u; ++q)
+	{
+		const Vec3 P(0.05 * float64(q), 0.5 + 0.02 * float64(q), 1.0 - 0.04 * float64(q));
+
+		all.clear();
+		map.foreach_cell([&] (Map0::Vertex v) { all.push_back((position[v] - P).squaredNorm()); });
+		std::sort(all.begin(), all.end());
+
+		std::vector<Map0::Vertex> neighbors;
+		std::vector<float64> d2;
+		ASSERT_EQ(kdtree.find_knn(P, 10u, neighbors, &d2), 10u);
+		for (uint32 i = 0u; i < 10u; ++i)
+		{
+			EXPECT_DOUBLE_EQ(d2[i], all[i]);
+			EXPECT_DOUBLE_EQ((position[neighbors[i]] - P).squaredNorm(), all[i]);
+		}
+
+		Map0::Vertex nearest;
+		float64 nearest_d2 = 0.0;
+		EXPECT_TRUE(kdtree.find_nearest(P, nearest, &nearest_d2));
+		EXPECT_DOUBLE_EQ(nearest_d2, all[0]);
+
+		const float64 radius = 0.08;
+		const uint32 nb_in = uint32(std::lower_bound(all.begin(), all.end(), radius * radius) - all.begin());
+		EXPECT_EQ(kdtree.find_within_radius(P, radius, neighbors, &d2), nb_in);
+		for (float64 d : d2)
+			EXPECT_LT(d, radius * radius);
+	}
+}
+
+TEST(KDTreeTest, batch_queries)
+{
+	Map0 map;
+	auto position = map.add_attribute<Vec3, Map0::Vertex>("position");
+	random_points(map, position, 5000u, false);
+
+	KDTree0 kdtree(map, position);
+
+	auto nb_knn = map.add_attribute<uint32, Map0::Vertex>("nb_knn");
+	auto self_first = map.add_attribute<bool, Map0::Vertex>("self_first");
+	kdtree.parallel_foreach_knn(6u, [&] (Map0::Vertex v, const std::vector<Map0::Vertex>& neighbors)
+	{
+		nb_knn[v] = uint32(neighbors.size());
+		self_first[v] = neighbors.front().dart == v.dart;
+	});
+
+	auto nb_radius = map.add_attribute<uint32, Map0::Vertex>("nb_radius");
+	kdtree.parallel_foreach_within_radius(0.1, [&] (Map0::Vertex v, const std::vector<Map0::Vertex>& neighbors)
+	{
+		nb_radius[v] = uint32(neighbors.size());
+	});
+
+	std::vector<Map0::Vertex> neighbors;
+	map.foreach_cell([&] (Map0::Vertex v)
+	{
+		EXPECT_EQ(nb_knn[v], 6u);
+		EXPECT_TRUE(self_first[v]);
+		EXPECT_EQ(nb_radius[v], kdtree.find_within_radius(position[v], 0.1, neighbors));
+	});
+}
+
+TEST(KDTreeTest, normal_pca)
+{
+	Map0 map;
+	auto position = map.add_attribute<Vec3, Map0::Vertex>("position");
+	auto normal = map.add_attribute<Vec3, Map0::Vertex>("normal");
+	random_points(map, position, 2000u, true);
+
+	// oriented towards +z
+	map.foreach_cell([&] (Map0::Vertex v) { normal[v] = Vec3(0.0, 0.0, 1.0); });
+
+	KDTree0 kdtree(map, position);
+	cgogn::geometry::compute_normal_pca(kdtree, 8u, normal);
+
+	const Vec3 expected = Vec3(-0.5, 0.0, 1.0).normalized();
+	map.foreach_cell([&] (Map0::Vertex v)
+	{
+		EXPECT_NEAR(normal[v].dot(expected), 1.0, 1e-9);
+	});
+}
+
+TEST(KDTreeTest, collector_within_radius)
+{
+	using Map2 = cgogn::CMap2Tri;
+
+	// flat triangulated grid, the Euclidean and the topological neighborhoods are the same
+	const uint32 n = 20u;
+	std::vector<uint32> triangles;
+	for (uint32 j = 0u; j < n; ++j)
+	{
+		for (uint32 i = 0u; i < n; ++i)
+		{
+			const uint32 v = j * (n + 1u) + i;
+			triangles.insert(triangles.end(), { v, v + 1u, v + n + 2u, v, v + n + 2u, v + n + 1u });
+		}
+	}
+	Map2 map;
+	auto position = map.add_attribute<Vec3, Map2::Vertex>("position");
+	Map2::Builder builder(map);
+	const uint32 first = builder.create_faces_from_indices(triangles, (n + 1u) * (n + 1u));
+	for (uint32 j = 0u; j <= n; ++j)
+		for (uint32 i = 0u; i <= n; ++i)
+			position[first + j * (n + 1u) + i] = Vec3(float64(i), float64(j), 0.0);
+
+	cgogn::geometry::KDTree<Map2, Vec3> kdtree(map, position);
+	cgogn::geometry::Collector_WithinSphere<Vec3, Map2> sphere(map, 3.5, position);
+	cgogn::geometry::Collector_WithinRadius<Vec3, Map2> radius(kdtree, 3.5);
+
+	// (centers far from the boundary)
+	map.foreach_cell([&] (Map2::Vertex v)
+	{
+		const Vec3& p = position[v];
+		if (p[0] < 4.0 || p[0] > float64(n) - 4.0 || p[1] < 4.0 || p[1] > float64(n) - 4.0)
+			return;
+		sphere.collect(v);
+		radius.collect(v);
+		EXPECT_EQ(radius.size<Map2::Vertex>(), sphere.size<Map2::Vertex>());
+		EXPECT_EQ(radius.size<Map2::Edge>(), sphere.size<Map2::Edge>());
+		EXPECT_EQ(radius.size<Map2::Face>(), sphere.size<Map2::Face>());
+		EXPECT_NEAR(radius.area(position), sphere.area(position), 1e-9);
+	});
+}
@@ -0,0 +1,169 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include <cgogn/core/cmap/cmap2_tri.h>
+#include <cgogn/core/cmap/cmap2_quad.h>
+
+#include <cgogn/geometry/types/eigen.h>
+#include <cgogn/geometry/algos/filtering.h>
+#include <cgogn/geometry/algos/laplacian.h>
+
+using namespace cgogn::numerics;
+
+using Vec3 = Eigen::Vector3d;
+
+/**
+ * \brief fill a map with a n x n grid of triangles or quads, bumpy or flat
+ */
+template <typename MAP>
+static typename MAP::template VertexAttribute<Vec3> grid(MAP& map, uint32 n, bool bumpy)
+{
+	std::vector<uint32> faces;
+	for (uint32 j = 0u; j < n; ++j)
+	{
+		for (uint32 i = 0u; i < n; ++i)
+		{
+			const uint32 v = j * (n + 1u) + i;
+			if (MAP::PRIM_SIZE == 3u)
+				faces.insert(faces.end(), { v, v + 1u, v + n + 2u, v, v + n + 2u, v + n + 1u });
+			else
+				faces.insert(faces.end(), { v, v + 1u, v + n + 2u, v + n + 1u });
+		}
+	}
+	typename MAP::Builder builder(map);
+	const uint32 first = builder.create_faces_from_indices(faces, (n + 1u) * (n + 1u));
+	auto position = map.template add_attribute<Vec3, typename MAP::Vertex>("position");
+	for (uint32 j = 0u; j <= n; ++j)
+	{
+		for (uint32 i = 0u; i <= n; ++i)
+		{
+			// (irregular spacing on the flat grid)
+			const float64 x = float64(i) + (bumpy ? 0.0 : 0.3 * std::sin(float64(j)));
+			const float64 y = float64(j) + (bumpy ? 0.0 : 0.2 * std::cos(float64(i)));
+			position[first + j * (n + 1u) + i] = Vec3(x, y, bumpy ? std::sin(float64(i)) * std::cos(0.7 * float64(j)) : 0.0);
+		}
+	}
+	return position;
+}
+
+template <typename MAP>
+static void check_uniform()
+{
+	using Vertex = typename MAP::Vertex;
+
+	MAP map;
+	auto position = grid(map, 15u, true);
+	auto position2 = map.template add_attribute<Vec3, Vertex>("position2");
+	auto tmp = map.template add_attribute<Vec3, Vertex>("tmp");
+	auto tmp2 = map.template add_attribute<Vec3, Vertex>("tmp2");
+	map.foreach_cell([&] (Vertex v) { position2[v] = position[v]; });
+
+	cgogn::geometry::LaplacianOperator<MAP, Vec3> laplacian(map);
+	EXPECT_EQ(laplacian.weights_type(), (cgogn::geometry::LaplacianOperator<MAP, Vec3>::UNIFORM));
+	EXPECT_EQ(laplacian.nb_entries(), 2u * map.template nb_cells<MAP::Edge::ORBIT>());
+
+	cgogn::geometry::filter_average(map, position, tmp);
+	laplacian.average(position, tmp2);
+	map.foreach_cell([&] (Vertex v) { EXPECT_NEAR((tmp[v] - tmp2[v]).norm(), 0.0, 1e-12); });
+
+	for (uint32 k = 0u; k < 10u; ++k)
+	{
+		cgogn::geometry::filter_taubin(map, position, tmp);
+		laplacian.filter_taubin(position2, tmp2);
+	}
+	map.foreach_cell([&] (Vertex v) { EXPECT_NEAR((position[v] - position2[v]).norm(), 0.0, 1e-10); });
+
+	// scalar attributes
+	auto h = map.template add_attribute<float64, Vertex>("h");
+	auto h2 = map.template add_attribute<float64, Vertex>("h2");
+	auto h3 = map.template add_attribute<float64, Vertex>("h3");
+	map.foreach_cell([&] (Vertex v) { h[v] = position[v][2]; });
+	cgogn::geometry::filter_average(map, h, h2);
+	laplacian.average(h, h3);
+	map.foreach_cell([&] (Vertex v) { EXPECT_NEAR(h2[v], h3[v], 1e-12); });
+}
+
+TEST(LaplacianTest, uniform_triangles)
+{
+	check_uniform<cgogn::CMap2Tri>();
+}
+
+TEST(LaplacianTest, uniform_quads)
+{
+	check_uniform<cgogn::CMap2Quad>();
+}
+
+TEST(LaplacianTest, cotangent)
+{
+	using Map2 = cgogn::CMap2Tri;
+	using Vertex = Map2::Vertex;
+	using Laplacian = cgogn::geometry::LaplacianOperator<Map2, Vec3>;
+
+	Map2 map;
+	auto position = grid(map, 12u, false);
+	auto lp = map.add_attribute<Vec3, Vertex>("lp");
+
+	Laplacian laplacian(map, position);
+	EXPECT_EQ(laplacian.weights_type(), Laplacian::COTANGENT);
+
+	// linear precision: the cotangent Laplacian of a planar mesh vanishes at interior vertices
+	laplacian.multiply(position, lp);
+	map.foreach_cell([&] (Vertex v)
+	{
+		if (!map.is_incident_to_boundary(v))
+		{
+			EXPECT_NEAR(lp[v].norm(), 0.0, 1e-10);
+		}
+	});
+
+	// the Eigen matrix is symmetric with null row sums, and gives the same product
+	const Laplacian::SparseMatrix m = laplacian.matrix();
+	EXPECT_NEAR((Laplacian::SparseMatrix(m.transpose()) - m).norm(), 0.0, 1e-12);
+	Eigen::VectorXd ones = Eigen::VectorXd::Ones(m.cols());
+	EXPECT_NEAR((m * ones).norm(), 0.0, 1e-12);
+	Eigen::VectorXd x = Eigen::VectorXd::Zero(m.cols());
+	map.foreach_cell([&] (Vertex v) { x[map.embedding(v)] = position[v][0]; });
+	const Eigen::VectorXd mx = m * x;
+	map.foreach_cell([&] (Vertex v) { EXPECT_NEAR(mx[map.embedding(v)], lp[v][0], 1e-12); });
+
+	// moving the vertices only needs new weights
+	map.foreach_cell([&] (Vertex v) { position[v][2] = 0.1 * std::sin(position[v][0] + 2.0 * position[v][1]); });
+	laplacian.reweight(position);
+	Laplacian laplacian2(map, position);
+	auto lp2 = map.add_attribute<Vec3, Vertex>("lp2");
+	laplacian.multiply(position, lp);
+	laplacian2.multiply(position, lp2);
+	map.foreach_cell([&] (Vertex v) { EXPECT_NEAR((lp[v] - lp2[v]).norm(), 0.0, 1e-12); });
+
+	// back to uniform weights
+	laplacian.reweight();
+	EXPECT_EQ(laplacian.weights_type(), Laplacian::UNIFORM);
+	auto avg = map.add_attribute<Vec3, Vertex>("avg");
+	cgogn::geometry::filter_average(map, position, lp);
+	laplacian.average(position, avg);
+	map.foreach_cell([&] (Vertex v) { EXPECT_NEAR((lp[v] - avg[v]).norm(), 0.0, 1e-12); });
+}
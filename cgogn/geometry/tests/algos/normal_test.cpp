@@ -0,0 +1,204 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <cmath>
+#include <map>
+
+#include <gtest/gtest.h>
+
+#include <cgogn/core/cmap/cmap2.h>
+#include <cgogn/core/cmap/cmap2_tri.h>
+
+#include <cgogn/geometry/types/eigen.h>
+#include <cgogn/geometry/types/vec.h>
+#include <cgogn/geometry/algos/normal.h>
+
+using namespace cgogn::numerics;
+
+using Dart = cgogn::Dart;
+
+using StdArrayd = cgogn::geometry::Vec_T<std::array<float64,3>>;
+using EigenVec3f = Eigen::Vector3f;
+using EigenVec3d = Eigen::Vector3d;
+
+/**
+ * \brief create the faces of the given vertex indices, return the vertex attribute lines of the vertices
+ */
+static std::vector<uint32> create_faces(cgogn::CMap2Tri& map, const std::vector<uint32>& faces, const std::vector<uint32>& /*degrees*/, uint32 nb_vertices)
+{
+	cgogn::CMap2Tri::Builder builder(map);
+	const uint32 first = builder.create_faces_from_indices(faces, nb_vertices);
+	std::vector<uint32> lines(nb_vertices);
+	for (uint32 i = 0u; i < nb_vertices; ++i)
+		lines[i] = first + i;
+	return lines;
+}
+
+static std::vector<uint32> create_faces(cgogn::CMap2& map, const std::vector<uint32>& faces, const std::vector<uint32>& degrees, uint32 nb_vertices)
+{
+	using Vertex = cgogn::CMap2::Vertex;
+
+	cgogn::CMap2::Builder builder(map);
+	std::map<std::pair<uint32, uint32>, Dart> half_edges;
+	std::vector<Dart> vertex_darts(nb_vertices);
+	uint32 k = 0u;
+	for (uint32 deg : degrees)
+	{
+		Dart d = builder.add_face_topo_fp(deg);
+		for (uint32 i = 0u; i < deg; ++i)
+		{
+			const uint32 u = faces[k + i];
+			const uint32 v = faces[k + (i + 1u) % deg];
+			vertex_darts[u] = d;
+			half_edges[std::make_pair(u, v)] = d;
+			auto it = half_edges.find(std::make_pair(v, u));
+			if (it != half_edges.end())
+				builder.phi2_sew(d, it->second);
+			d = map.phi1(d);
+		}
+		k += deg;
+	}
+	builder.close_map();
+	builder.create_embedding<Vertex::ORBIT>();
+	std::vector<uint32> lines(nb_vertices);
+	for (uint32 i = 0u; i < nb_vertices; ++i)
+		lines[i] = map.embedding(Vertex(vertex_darts[i]));
+	return lines;
+}
+
+/**
+ * \brief fill a map with a n x n bumpy grid of triangles (CMap2Tri) or of quads and triangles (CMap2),
+ * the grid is left open so that its border darts are boundary darts
+ */
+template <typename MAP, typename VEC3>
+static typename MAP::template VertexAttribute<VEC3> bumpy_grid(MAP& map, uint32 n)
+{
+	using Scalar = cgogn::geometry::ScalarOf<VEC3>;
+	using Vertex = typename MAP::Vertex;
+
+	std::vector<uint32> faces;
+	std::vector<uint32> degrees;
+	for (uint32 j = 0u; j < n; ++j)
+	{
+		for (uint32 i = 0u; i < n; ++i)
+		{
+			const uint32 v = j * (n + 1u) + i;
+			if (MAP::PRIM_SIZE == 3u || (i + j) % 3u == 0u)
+			{
+				faces.insert(faces.end(), { v, v + 1u, v + n + 2u, v, v + n + 2u, v + n + 1u });
+				degrees.insert(degrees.end(), { 3u, 3u });
+			}
+			else
+			{
+				faces.insert(faces.end(), { v, v + 1u, v + n + 2u, v + n + 1u });
+				degrees.push_back(4u);
+			}
+		}
+	}
+	const std::vector<uint32> lines = create_faces(map, faces, degrees, (n + 1u) * (n + 1u));
+	auto position = map.template add_attribute<VEC3, Vertex>("position");
+	for (uint32 j = 0u; j <= n; ++j)
+	{
+		for (uint32 i = 0u; i <= n; ++i)
+		{
+			const float64 x = float64(i) / float64(n);
+			const float64 y = float64(j) / float64(n);
+			position[lines[j * (n + 1u) + i]] = VEC3(Scalar(x), Scalar(y), Scalar(0.2 * std::sin(7.0 * x) * std::cos(5.0 * y)));
+		}
+	}
+	return position;
+}
+
+/**
+ * \brief the batched computation gives the same normals as the per cell one
+ */
+template <typename MAP, typename VEC3>
+static void check_normals(uint32 n, float64 tolerance)
+{
+	using Vertex = typename MAP::Vertex;
+	using Face = typename MAP::Face;
+
+	MAP map;
+	auto position = bumpy_grid<MAP, VEC3>(map, n);
+
+	auto face_normal = map.template add_attribute<VEC3, Face>("face_normal");
+	auto face_normal_ref = map.template add_attribute<VEC3, Face>("face_normal_ref");
+	auto vertex_normal = map.template add_attribute<VEC3, Vertex>("vertex_normal");
+	auto vertex_normal_ref = map.template add_attribute<VEC3, Vertex>("vertex_normal_ref");
+
+	cgogn::geometry::compute_normal(map, cgogn::AllCellsFilter(), position, face_normal_ref);
+	cgogn::geometry::compute_normal(map, cgogn::AllCellsFilter(), position, vertex_normal_ref);
+
+	cgogn::geometry::compute_normal(map, position, face_normal);
+	cgogn::geometry::compute_normal(map, position, vertex_normal);
+	map.foreach_cell([&] (Face f) { EXPECT_NEAR((face_normal[f] - face_normal_ref[f]).norm(), 0.0, tolerance); });
+	map.foreach_cell([&] (Vertex v) { EXPECT_NEAR((vertex_normal[v] - vertex_normal_ref[v]).norm(), 0.0, tolerance); });
+
+	map.foreach_cell([&] (Face f) { face_normal[f] = VEC3(0, 0, 0); });
+	map.foreach_cell([&] (Vertex v) { vertex_normal[v] = VEC3(0, 0, 0); });
+	cgogn::geometry::compute_normals(map, position, face_normal, vertex_normal);
+	map.foreach_cell([&] (Face f) { EXPECT_NEAR((face_normal[f] - face_normal_ref[f]).norm(), 0.0, tolerance); });
+	map.foreach_cell([&] (Vertex v) { EXPECT_NEAR((vertex_normal[v] - vertex_normal_ref[v]).norm(), 0.0, tolerance); });
+}
+
+TEST(NormalTest, batched_triangles)
+{
+	// more than one block per thread, and a last incomplete block
+	check_normals<cgogn::CMap2Tri, EigenVec3d>(45u, 1e-12);
+	check_normals<cgogn::CMap2Tri, EigenVec3f>(45u, 1e-5);
+	check_normals<cgogn::CMap2Tri, StdArrayd>(12u, 1e-12);
+}
+
+TEST(NormalTest, batched_polygons)
+{
+	check_normals<cgogn::CMap2, EigenVec3d>(45u, 1e-12);
+	check_normals<cgogn::CMap2, StdArrayd>(12u, 1e-12);
+}
+
+TEST(NormalTest, batched_triangles_with_free_slots)
+{
+	using Map2 = cgogn::CMap2Tri;
+	using Vec3 = EigenVec3d;
+
+	Map2 map;
+	auto position = bumpy_grid<Map2, Vec3>(map, 20u);
+
+	// a split triangle leaves an unused slot in the topology container
+	std::vector<Map2::Face> split;
+	uint32 k = 0u;
+	map.foreach_cell([&] (Map2::Face f) { if (k++ % 7u == 3u) split.push_back(f); });
+	for (Map2::Face f : split)
+	{
+		Vec3 c = Vec3::Zero();
+		map.foreach_incident_vertex(f, [&] (Map2::Vertex v) { c += position[v]; });
+		const Map2::Vertex v = map.split_triangle(f);
+		position[v] = c / 3.0 + Vec3(0.0, 0.0, 0.01);
+	}
+	EXPECT_LT(map.nb_cells<Map2::Face::ORBIT>() * 3u, map.topology_container().end());
+
+	auto vertex_normal = map.add_attribute<Vec3, Map2::Vertex>("vertex_normal");
+	auto vertex_normal_ref = map.add_attribute<Vec3, Map2::Vertex>("vertex_normal_ref");
+	cgogn::geometry::compute_normal(map, cgogn::AllCellsFilter(), position, vertex_normal_ref);
+	cgogn::geometry::compute_normal(map, position, vertex_normal);
+	map.foreach_cell([&] (Map2::Vertex v) { EXPECT_NEAR((vertex_normal[v] - vertex_normal_ref[v]).norm(), 0.0, 1e-12); });
+}
@@ -0,0 +1,169 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <cmath>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include <cgogn/core/cmap/cmap3_tetra.h>
+#include <cgogn/core/cmap/cmap3_hexa.h>
+
+#include <cgogn/geometry/types/eigen.h>
+#include <cgogn/geometry/algos/volume_bvh.h>
+
+using namespace cgogn::numerics;
+
+using Vec3 = Eigen::Vector3d;
+
+static uint32 grid_vertex(uint32 n, uint32 i, uint32 j, uint32 k)
+{
+	return (k * (n + 1u) + j) * (n + 1u) + i;
+}
+
+/**
+ * \brief fill a map with a n x n x n grid of unit cubes (hexahedra or 6 tetrahedra per cube)
+ */
+template <typename MAP>
+static void cube_grid(MAP& map, typename MAP::template VertexAttribute<Vec3>& position, uint32 n)
+{
+	std::vector<uint32> volumes;
+	for (uint32 k = 0u; k < n; ++k)
+	{
+		for (uint32 j = 0u; j < n; ++j)
+		{
+			for (uint32 i = 0u; i < n; ++i)
+			{
+				// corner c of the cube: bit 0 -> +x, bit 1 -> +y, bit 2 -> +z
+				std::array<uint32, 8> c;
+				for (uint32 b = 0u; b < 8u; ++b)
+					c[b] = grid_vertex(n, i + (b & 1u), j + ((b >> 1u) & 1u), k + ((b >> 2u) & 1u));
+				if (MAP::PRIM_SIZE == 12u)
+				{
+					// Kuhn decomposition along the diagonal 0-7, all tetrahedra with the same orientation
+					const uint32 paths[6][2] = { {1,3}, {2,3}, {2,6}, {4,6}, {4,5}, {1,5} };
+					for (uint32 p = 0u; p < 6u; ++p)
+					{
+						if (p % 2u == 0u)
+							volumes.insert(volumes.end(), { c[0], c[paths[p][0]], c[paths[p][1]], c[7] });
+						else
+							volumes.insert(volumes.end(), { c[0], c[paths[p][1]], c[paths[p][0]], c[7] });
+					}
+				}
+				else
+					volumes.insert(volumes.end(), { c[0], c[1], c[3], c[2], c[4], c[5], c[7], c[6] });
+			}
+		}
+	}
+	typename MAP::Builder builder(map);
+	const uint32 first = builder.create_volumes_from_indices(volumes, (n + 1u) * (n + 1u) * (n + 1u));
+	for (uint32 k = 0u; k <= n; ++k)
+		for (uint32 j = 0u; j <= n; ++j)
+			for (uint32 i = 0u; i <= n; ++i)
+				position[first + grid_vertex(n, i, j, k)] = Vec3(float64(i), float64(j), float64(k));
+}
+
+template <typename MAP>
+static void check_locations(MAP& map, const typename MAP::template VertexAttribute<Vec3>& position, uint32 n)
+{
+	using BVH = cgogn::geometry::VolumeBVH<MAP, Vec3>;
+	using Vertex = typename MAP::Vertex;
+
+	BVH bvh(map, position);
+
+	// a linear field is exactly interpolated
+	auto field = map.template add_attribute<float64, Vertex>("field");
+	map.foreach_cell([&] (Vertex v) { field[v] = 2.0 * position[v][0] - position[v][1] + 0.5 * position[v][2]; });
+
+	std::mt19937 gen(3);
+	std::uniform_real_distribution<float64> coord(0.0, float64(n));
+	std::vector<Vec3> points(2000u);
+	for (Vec3& p : points)
+		p = Vec3(coord(gen), coord(gen), coord(gen));
+	points.push_back(Vec3(-0.5, 1.0, 1.0));
+	points.push_back(Vec3(1.0, float64(n) + 0.5, 1.0));
+
+	std::vector<typename BVH::Location> locations;
+	EXPECT_EQ(bvh.locate(points, locations), 2000u);
+	for (uint32 i = 0u; i < 2000u; ++i)
+	{
+		const typename BVH::Location& loc = locations[i];
+		ASSERT_NE(loc.tetra, cgogn::INVALID_INDEX);
+
+		// the point is in the cube of its volume
+		Vec3 vmin = position[Vertex(loc.volume.dart)];
+		map.foreach_incident_vertex(loc.volume, [&] (Vertex v) { vmin = vmin.cwiseMin(position[v]); });
+		for (uint32 c = 0u; c < 3u; ++c)
+			EXPECT_EQ(vmin[c], std::floor(points[i][c]));
+
+		Vec3 p = Vec3::Zero();
+		for (uint32 k = 0u; k < 4u; ++k)
+		{
+			EXPECT_GE(loc.barycentric[k], -1e-9);
+			p += position[loc.vertices[k]] * loc.barycentric[k];
+		}
+		EXPECT_NEAR((p - points[i]).norm(), 0.0, 1e-9);
+
+		const Vec3& q = points[i];
+		EXPECT_NEAR(bvh.interpolate(loc, field), 2.0 * q[0] - q[1] + 0.5 * q[2], 1e-9);
+	}
+	EXPECT_EQ(locations[2000u].tetra, cgogn::INVALID_INDEX);
+	EXPECT_EQ(locations[2001u].tetra, cgogn::INVALID_INDEX);
+
+	std::vector<float64> values;
+	bvh.interpolate(locations, field, values, -1.0);
+	EXPECT_EQ(values[2001u], -1.0);
+
+	// walking from a far away tetrahedron gives the same location
+	typename BVH::Location loc;
+	EXPECT_TRUE(bvh.locate(points[10], loc, locations[20].tetra));
+	EXPECT_EQ(loc.volume.dart, locations[10].volume.dart);
+	EXPECT_FALSE(bvh.locate(points[2000u], loc, locations[20].tetra));
+}
+
+TEST(VolumeBVHTest, tetra_location)
+{
+	cgogn::CMap3Tetra map;
+	auto position = map.add_attribute<Vec3, cgogn::CMap3Tetra::Vertex>("position");
+	cube_grid(map, position, 6u);
+	EXPECT_EQ(map.nb_cells<cgogn::CMap3Tetra::Volume::ORBIT>(), 6u * 6u * 6u * 6u);
+
+	cgogn::geometry::VolumeBVH<cgogn::CMap3Tetra, Vec3> bvh(map, position);
+	EXPECT_EQ(bvh.nb_tetras(), 6u * 6u * 6u * 6u);
+
+	check_locations(map, position, 6u);
+}
+
+TEST(VolumeBVHTest, hexa_location)
+{
+	cgogn::CMap3Hexa map;
+	auto position = map.add_attribute<Vec3, cgogn::CMap3Hexa::Vertex>("position");
+	cube_grid(map, position, 5u);
+	EXPECT_EQ(map.nb_cells<cgogn::CMap3Hexa::Volume::ORBIT>(), 5u * 5u * 5u);
+
+	// 3 faces of a hexahedron are opposite to its first vertex
+	cgogn::geometry::VolumeBVH<cgogn::CMap3Hexa, Vec3> bvh(map, position);
+	EXPECT_EQ(bvh.nb_tetras(), 6u * 5u * 5u * 5u);
+
+	check_locations(map, position, 5u);
+}
@@ -88,3 +88,35 @@ TYPED_TEST(Distance_TEST, squared_distance_line_seg)
 	EXPECT_NEAR(cgogn::geometry::squared_distance_line_seg(A,B,P2,Q2), Scalar(3*3), tolerence);
 
 }
+
+TYPED_TEST(Distance_TEST, squared_distance_triangle_point)
+{
+	using Scalar = typename cgogn::geometry::vector_traits<TypeParam>::Scalar;
+	TypeParam A(Scalar(0), Scalar(0), Scalar(0));
+	TypeParam B(Scalar(4), Scalar(0), Scalar(0));
+	TypeParam C(Scalar(0), Scalar(4), Scalar(0));
+	std::array<Scalar, 3> bc;
+
+	const Scalar tolerence = std::is_same<Scalar,double>::value ? Scalar(1e-8) : Scalar(1e-4f);
+
+	// inside
+	TypeParam P0(Scalar(1), Scalar(1), Scalar(2));
+	EXPECT_NEAR(cgogn::geometry::squared_distance_triangle_point(A,B,C,P0,&bc), Scalar(4), tolerence);
+	EXPECT_NEAR(bc[0], Scalar(0.5), tolerence);
+	EXPECT_NEAR(bc[1], Scalar(0.25), tolerence);
+	EXPECT_NEAR(bc[2], Scalar(0.25), tolerence);
+
+	// vertex region
+	TypeParam P1(Scalar(-1), Scalar(-2), Scalar(0));
+	EXPECT_NEAR(cgogn::geometry::squared_distance_triangle_point(A,B,C,P1,&bc), Scalar(5), tolerence);
+	EXPECT_EQ(bc[0], Scalar(1));
+	EXPECT_EQ(bc[1], Scalar(0));
+	EXPECT_EQ(bc[2], Scalar(0));
+
+	// edge region (BC)
+	TypeParam P2(Scalar(3), Scalar(3), Scalar(1));
+	EXPECT_NEAR(cgogn::geometry::squared_distance_triangle_point(A,B,C,P2,&bc), Scalar(3), tolerence);
+	EXPECT_EQ(bc[0], Scalar(0));
+	EXPECT_NEAR(bc[1], Scalar(0.5), tolerence);
+	EXPECT_NEAR(bc[2], Scalar(0.5), tolerence);
+}
@@ -0,0 +1,186 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <cmath>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include <cgogn/geometry/types/eigen.h>
+#include <cgogn/geometry/functions/predicates.h>
+#include <cgogn/geometry/functions/intersection.h>
+
+using namespace cgogn::numerics;
+
+using Vec2 = Eigen::Vector2d;
+using Vec3 = Eigen::Vector3d;
+
+static int32 sign(float64 x)
+{
+	return x > 0.0 ? 1 : (x < 0.0 ? -1 : 0);
+}
+
+static int32 sign(int64 x)
+{
+	return x > 0 ? 1 : (x < 0 ? -1 : 0);
+}
+
+TEST(PredicatesTest, simple_configurations)
+{
+	EXPECT_GT(cgogn::geometry::orient2d(Vec2(0, 0), Vec2(1, 0), Vec2(0, 1)), 0.0);
+	EXPECT_LT(cgogn::geometry::orient2d(Vec2(0, 0), Vec2(0, 1), Vec2(1, 0)), 0.0);
+	EXPECT_EQ(cgogn::geometry::orient2d(Vec2(0, 0), Vec2(1, 1), Vec2(3, 3)), 0.0);
+
+	const Vec3 a(0, 0, 0), b(1, 0, 0), c(0, 1, 0);
+	EXPECT_GT(cgogn::geometry::orient3d(a, b, c, Vec3(0, 0, -1)), 0.0);
+	EXPECT_LT(cgogn::geometry::orient3d(a, b, c, Vec3(0, 0, 1)), 0.0);
+	EXPECT_EQ(cgogn::geometry::orient3d(a, b, c, Vec3(5, 7, 0)), 0.0);
+	EXPECT_GT(cgogn::geometry::orient3d_vector(a, b, c, Vec3(0, 0, 1)), 0.0);
+	EXPECT_LT(cgogn::geometry::orient3d_vector(a, b, c, Vec3(0, 0, -1)), 0.0);
+	EXPECT_EQ(cgogn::geometry::orient3d_vector(a, b, c, Vec3(1, 1, 0)), 0.0);
+
+	EXPECT_GT(cgogn::geometry::incircle(Vec2(1, 0), Vec2(0, 1), Vec2(-1, 0), Vec2(0, 0)), 0.0);
+	EXPECT_LT(cgogn::geometry::incircle(Vec2(1, 0), Vec2(0, 1), Vec2(-1, 0), Vec2(2, 0)), 0.0);
+	EXPECT_EQ(cgogn::geometry::incircle(Vec2(1, 0), Vec2(0, 1), Vec2(-1, 0), Vec2(0, -1)), 0.0);
+
+	const Vec3 d(0, 0, -1);
+	ASSERT_GT(cgogn::geometry::orient3d(a, b, c, d), 0.0);
+	EXPECT_GT(cgogn::geometry::insphere(a, b, c, d, Vec3(0.2, 0.2, -0.2)), 0.0);
+	EXPECT_LT(cgogn::geometry::insphere(a, b, c, d, Vec3(3, 3, 3)), 0.0);
+	EXPECT_EQ(cgogn::geometry::insphere(a, b, c, d, Vec3(1, 1, -1)), 0.0);
+}
+
+TEST(PredicatesTest, near_degenerate)
+{
+	// points close to the line y = x (the naive evaluation gives wrong signs)
+	const float64 eps = std::ldexp(1.0, -53);
+	for (int32 i = 0; i < 64; ++i)
+	{
+		for (int32 j = 0; j < 64; ++j)
+		{
+			const Vec2 p(0.5 + i * eps, 0.5 + j * eps);
+			EXPECT_EQ(sign(cgogn::geometry::orient2d(p, Vec2(12, 12), Vec2(24, 24))), sign(int64(j - i)));
+		}
+	}
+
+	// points close to the plane z = x
+	const Vec3 a(12, 0, 12), b(0, 12, 0), c(24, 24, 24);
+	const int32 s = sign(cgogn::geometry::orient3d(a, b, c, Vec3(0, 0, 1)));
+	ASSERT_NE(s, 0);
+	for (int32 i = 0; i < 64; ++i)
+	{
+		for (int32 j = 0; j < 64; ++j)
+		{
+			const Vec3 p(0.5 + i * eps, 0.5, 0.5 + j * eps);
+			EXPECT_EQ(sign(cgogn::geometry::orient3d(a, b, c, p)), s * sign(int64(j - i)));
+		}
+	}
+}
+
+TEST(PredicatesTest, near_cocircular_and_cospherical)
+{
+	std::mt19937 gen(17);
+	std::uniform_int_distribution<int64> offset(-(int64(1) << 30), int64(1) << 30);
+	std::uniform_int_distribution<int64> scale(int64(1) << 24, int64(1) << 25);
+	std::uniform_int_distribution<int64> delta(-2, 2);
+
+	using IVec2 = Eigen::Matrix<int64, 2, 1>;
+	using IVec3 = Eigen::Matrix<int64, 3, 1>;
+
+	for (uint32 k = 0u; k < 2000u; ++k)
+	{
+		// the corners of a rectangle are cocircular, the 4th one is moved by a few units
+		const IVec2 c0(offset(gen), offset(gen));
+		const int64 su = scale(gen), sv = scale(gen);
+		const IVec2 u(3 * su, 4 * su);
+		const IVec2 v(-4 * sv, 3 * sv);
+		const IVec2 dl(delta(gen), delta(gen));
+		const IVec2 d = c0 + v + dl;
+
+		const int64 expected = (u + v).squaredNorm() - (v - u + 2 * dl).squaredNorm();
+		const float64 r = cgogn::geometry::incircle(c0.cast<float64>(), (c0 + u).cast<float64>(), (c0 + u + v).cast<float64>(), d.cast<float64>());
+		EXPECT_EQ(sign(r), sign(expected));
+	}
+
+	for (uint32 k = 0u; k < 2000u; ++k)
+	{
+		// the corners of a box are cospherical, the opposite corner is moved by a few units
+		const IVec3 c0(offset(gen), offset(gen), offset(gen));
+		const int64 su = scale(gen), sv = scale(gen), sw = scale(gen);
+		const IVec3 u(su, 2 * su, 2 * su);
+		const IVec3 v(2 * sv, sv, -2 * sv);
+		const IVec3 w(2 * sw, -2 * sw, sw);
+		const IVec3 dl(delta(gen), delta(gen), delta(gen));
+		const IVec3 e = c0 + u + v + w + dl;
+
+		const int64 expected = (u + v + w).squaredNorm() - (u + v + w + 2 * dl).squaredNorm();
+		Vec3 pa = c0.cast<float64>(), pb = (c0 + u).cast<float64>(), pc = (c0 + v).cast<float64>(), pd = (c0 + w).cast<float64>();
+		if (cgogn::geometry::orient3d(pa, pb, pc, pd) < 0.0)
+			std::swap(pb, pc);
+		const float64 r = cgogn::geometry::insphere(pa, pb, pc, pd, e.cast<float64>());
+		EXPECT_EQ(sign(r), sign(expected));
+	}
+}
+
+TEST(PredicatesTest, watertight_ray_triangle)
+{
+	// a closed octahedron: any ray from the inside hits at least one triangle,
+	// even when it is aimed at a vertex (the ray then passes at one ulp from it)
+	std::mt19937 gen(23);
+	std::uniform_real_distribution<float64> jitter(-0.3, 0.3);
+	std::vector<Vec3> vertices;
+	for (uint32 i = 0u; i < 3u; ++i)
+	{
+		for (float64 s : { -1.0, 1.0 })
+		{
+			Vec3 p(jitter(gen), jitter(gen), jitter(gen));
+			p[i] = s * (1.0 + 0.1 * jitter(gen));
+			vertices.push_back(p);
+		}
+	}
+	// faces (x-/x+, y-/y+, z-/z+)
+	std::vector<std::array<uint32, 3>> triangles;
+	for (uint32 x : { 0u, 1u })
+		for (uint32 y : { 2u, 3u })
+			for (uint32 z : { 4u, 5u })
+				triangles.push_back({{ x, y, z }});
+
+	std::uniform_real_distribution<float64> inside(-0.2, 0.2);
+	for (uint32 k = 0u; k < 5000u; ++k)
+	{
+		const Vec3 P(inside(gen), inside(gen), inside(gen));
+		const Vec3 Dir = vertices[k % 6u] - P;
+		uint32 nb_hits = 0u;
+		for (const auto& t : triangles)
+			if (cgogn::geometry::intersection_ray_triangle(P, Dir, vertices[t[0]], vertices[t[1]], vertices[t[2]]))
+				++nb_hits;
+		EXPECT_GE(nb_hits, 1u);
+
+		// and never behind
+		uint32 nb_back_hits = 0u;
+		for (const auto& t : triangles)
+			if (cgogn::geometry::intersection_ray_triangle(P, Vec3(-Dir), vertices[t[0]], vertices[t[1]], vertices[t[2]]))
+				++nb_back_hits;
+		EXPECT_GE(nb_back_hits, 1u);
+	}
+}
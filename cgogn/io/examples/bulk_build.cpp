@@ -0,0 +1,115 @@
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <cgogn/core/utils/logger.h>
+#include <cgogn/core/cmap/cmap2.h>
+#include <cgogn/core/cmap/cmap2_tri.h>
+#include <cgogn/core/cmap/cmap3.h>
+#include <cgogn/core/cmap/cmap3_hexa.h>
+#include <cgogn/io/surface_import.h>
+#include <cgogn/io/volume_import.h>
+
+using namespace cgogn::numerics;
+
+using Map2 = cgogn::CMap2;
+using Map2Tri = cgogn::CMap2Tri;
+using Map3 = cgogn::CMap3;
+using Map3Hexa = cgogn::CMap3Hexa;
+
+using TimePoint = std::chrono::time_point<std::chrono::system_clock>;
+
+static float64 elapsed(const TimePoint& start)
+{
+	std::chrono::duration<float64> d = std::chrono::system_clock::now() - start;
+	return d.count();
+}
+
+int main(int argc, char** argv)
+{
+	uint32 n = 1000u;
+	if (argc < 2)
+		cgogn_log_info("bulk_build") << "USAGE: " << argv[0] << " [grid_size] (using " << n << ")";
+	else
+		n = uint32(std::stoi(argv[1]));
+
+	// triangulated n x n grid
+	const uint32 nb_vertices_2 = (n + 1u) * (n + 1u);
+	std::vector<uint32> triangles;
+	triangles.reserve(6u * n * n);
+	for (uint32 j = 0u; j < n; ++j)
+	{
+		for (uint32 i = 0u; i < n; ++i)
+		{
+			const uint32 v = j * (n + 1u) + i;
+			triangles.insert(triangles.end(), { v, v + 1u, v + n + 2u, v, v + n + 2u, v + n + 1u });
+		}
+	}
+
+	{
+		Map2 map;
+		TimePoint start = std::chrono::system_clock::now();
+		cgogn::io::SurfaceImport<Map2> si(map);
+		si.reserve(2u * n * n);
+		for (uint32 i = 0u; i < nb_vertices_2; ++i)
+			si.insert_line_vertex_container();
+		for (uint32 i = 0u; i < uint32(triangles.size()); i += 3u)
+			si.add_triangle(triangles[i], triangles[i + 1u], triangles[i + 2u]);
+		si.create_map();
+		cgogn_log_info("bulk_build") << "CMap2 + SurfaceImport: " << elapsed(start) << "s";
+	}
+
+	{
+		Map2Tri map;
+		TimePoint start = std::chrono::system_clock::now();
+		Map2Tri::Builder builder(map);
+		builder.create_faces_from_indices(triangles, nb_vertices_2);
+		cgogn_log_info("bulk_build") << "CMap2Tri + create_faces_from_indices: " << elapsed(start) << "s";
+	}
+
+	// n/10 x n/10 x n/10 hexahedral grid
+	const uint32 m = std::max(1u, n / 10u);
+	const uint32 nb_vertices_3 = (m + 1u) * (m + 1u) * (m + 1u);
+	std::vector<uint32> hexas;
+	hexas.reserve(8u * m * m * m);
+	for (uint32 k = 0u; k < m; ++k)
+	{
+		for (uint32 j = 0u; j < m; ++j)
+		{
+			for (uint32 i = 0u; i < m; ++i)
+			{
+				const uint32 v = (k * (m + 1u) + j) * (m + 1u) + i;
+				const uint32 up = (m + 1u) * (m + 1u);
+				hexas.insert(hexas.end(), {
+					v, v + 1u, v + m + 2u, v + m + 1u,
+					v + up, v + up + 1u, v + up + m + 2u, v + up + m + 1u
+				});
+			}
+		}
+	}
+
+	{
+		Map3 map;
+		TimePoint start = std::chrono::system_clock::now();
+		cgogn::io::VolumeImport<Map3> vi(map);
+		vi.reserve(m * m * m);
+		for (uint32 i = 0u; i < nb_vertices_3; ++i)
+			vi.insert_line_vertex_container();
+		for (uint32 i = 0u; i < uint32(hexas.size()); i += 8u)
+			vi.add_hexa(hexas[i], hexas[i + 1u], hexas[i + 2u], hexas[i + 3u], hexas[i + 4u], hexas[i + 5u], hexas[i + 6u], hexas[i + 7u]);
+		vi.create_map();
+		cgogn_log_info("bulk_build") << "CMap3 + VolumeImport: " << elapsed(start) << "s";
+	}
+
+	{
+		Map3Hexa map;
+		TimePoint start = std::chrono::system_clock::now();
+		Map3Hexa::Builder builder(map);
+		builder.create_volumes_from_indices(hexas, nb_vertices_3);
+		cgogn_log_info("bulk_build") << "CMap3Hexa + create_volumes_from_indices: " << elapsed(start) << "s";
+	}
+
+	return 0;
+}
@@ -24,12 +24,17 @@
 #ifndef CGOGN_MODELING_ALGOS_DECIMATION_H_
 #define CGOGN_MODELING_ALGOS_DECIMATION_H_
 
+#include <atomic>
+#include <cstring>
+#include <limits>
+
 #include <cgogn/modeling/dll.h>
 
 #include <cgogn/geometry/functions/basics.h>
 #include <cgogn/geometry/types/geometry_traits.h>
 
 #include <cgogn/core/cmap/cmap2.h>
+#include <cgogn/core/utils/parallel_foreach_element.h>
 
 #include <cgogn/modeling/decimation/edge_traversor_map_order.h>
 #include <cgogn/modeling/decimation/edge_traversor_edge_length.h>
@@ -38,6 +43,8 @@
 #include <cgogn/modeling/decimation/edge_approximator_mid_edge.h>
 #include <cgogn/modeling/decimation/edge_approximator_qem.h>
 
+#include <cgogn/modeling/decimation/progressive_mesh.h>
+
 namespace cgogn
 {
 
@@ -48,7 +55,9 @@ enum EdgeTraversorType
 {
 	EdgeTraversor_MapOrder_T = 0,
 	EdgeTraversor_EdgeLength_T,
-	EdgeTraversor_QEM_T
+	EdgeTraversor_QEM_T,
+	EdgeTraversor_EdgeLength_Heap_T,
+	EdgeTraversor_QEM_Heap_T
 };
 
 enum EdgeApproximatorType
@@ -57,13 +66,29 @@ enum EdgeApproximatorType
 	EdgeApproximator_QEM_T
 };
 
-template <typename EdgeTraversor, typename VERTEX_ATTR>
+namespace internal
+{
+
+struct NoCollapseRecorder
+{
+	template <typename VEC3>
+	inline void pre_collapse(CMap2::Edge, const VEC3&) {}
+};
+
+} // namespace internal
+
+/**
+ * \brief decimate the map and record the collapses
+ * @param recorder pre_collapse(e, new_position) is called before the collapse of each edge e (see ProgressiveMeshRecorder)
+ */
+template <typename EdgeTraversor, typename VERTEX_ATTR, typename RECORDER>
 void decimate(
 	CMap2& map,
 	VERTEX_ATTR& position,
 	EdgeTraversor& trav,
 	EdgeApproximator<CMap2, InsideTypeOf<VERTEX_ATTR>>& approx,
-	uint32 nb
+	uint32 nb,
+	RECORDER& recorder
 )
 {
 	static_assert(is_orbit_of<VERTEX_ATTR, CMap2::Vertex::ORBIT>::value,"position must be a vertex attribute");
@@ -81,6 +106,7 @@ void decimate(
 		{
 			VEC3 newpos = approx(e);
 
+			recorder.pre_collapse(e, newpos);
 			trav.pre_collapse(e);
 
 			Vertex v = map.collapse_edge(e);
@@ -95,18 +121,58 @@ void decimate(
 	);
 }
 
+template <typename EdgeTraversor, typename VERTEX_ATTR>
+void decimate(
+	CMap2& map,
+	VERTEX_ATTR& position,
+	EdgeTraversor& trav,
+	EdgeApproximator<CMap2, InsideTypeOf<VERTEX_ATTR>>& approx,
+	uint32 nb
+)
+{
+	internal::NoCollapseRecorder recorder;
+	decimate(map, position, trav, approx, nb, recorder);
+}
+
+namespace internal
+{
+
+template <typename EdgeTraversor, typename VERTEX_ATTR>
+void decimate(
+	CMap2& map,
+	VERTEX_ATTR& position,
+	EdgeTraversor& trav,
+	EdgeApproximator<CMap2, InsideTypeOf<VERTEX_ATTR>>& approx,
+	uint32 nb,
+	ProgressiveMeshRecorder<InsideTypeOf<VERTEX_ATTR>>* recorder
+)
+{
+	if (recorder)
+		modeling::decimate(map, position, trav, approx, nb, *recorder);
+	else
+		modeling::decimate(map, position, trav, approx, nb);
+}
+
+} // namespace internal
+
+/**
+ * @param recorder if not null, records the collapses (see ProgressiveMeshRecorder)
+ */
 template <typename VERTEX_ATTR>
 void decimate(
 	CMap2& map,
 	VERTEX_ATTR& position,
 	EdgeTraversorType trav_type,
 	EdgeApproximatorType approx_type,
-	uint32 nb
+	uint32 nb,
+	ProgressiveMeshRecorder<InsideTypeOf<VERTEX_ATTR>>* recorder = nullptr
 )
 {
 	static_assert(is_orbit_of<VERTEX_ATTR, CMap2::Vertex::ORBIT>::value,"position must be a vertex attribute");
 
 	using VEC3 = InsideTypeOf<VERTEX_ATTR>;
+	using Scalar = typename geometry::vector_traits<VEC3>::Scalar;
+	using Heap = EdgeQueue_IndexedHeap<CMap2, Scalar>;
 	EdgeApproximator<CMap2, VEC3>* approx=nullptr;
 
 	switch (approx_type)
@@ -123,17 +189,27 @@ void decimate(
 	{
 		case EdgeTraversor_MapOrder_T: {
 			EdgeTraversor_MapOrder<CMap2> trav(map);
-			decimate(map, position, trav, *approx, nb);
+			internal::decimate(map, position, trav, *approx, nb, recorder);
 			break;
 		}
 		case EdgeTraversor_EdgeLength_T: {
 			EdgeTraversor_EdgeLength<CMap2, VEC3> trav(map, position);
-			decimate(map, position, trav, *approx, nb);
+			internal::decimate(map, position, trav, *approx, nb, recorder);
 			break;
 		}
 		case EdgeTraversor_QEM_T: {
 			EdgeTraversor_QEM<CMap2, VEC3> trav(map, position, *approx);
-			decimate(map, position, trav, *approx, nb);
+			internal::decimate(map, position, trav, *approx, nb, recorder);
+			break;
+		}
+		case EdgeTraversor_EdgeLength_Heap_T: {
+			EdgeTraversor_EdgeLength<CMap2, VEC3, Heap> trav(map, position);
+			internal::decimate(map, position, trav, *approx, nb, recorder);
+			break;
+		}
+		case EdgeTraversor_QEM_Heap_T: {
+			EdgeTraversor_QEM<CMap2, VEC3, Heap> trav(map, position, *approx);
+			internal::decimate(map, position, trav, *approx, nb, recorder);
 			break;
 		}
 	}
@@ -141,9 +217,226 @@ void decimate(
 	delete approx;
 }
 
+namespace internal
+{
+
+/**
+ * \brief apply f on the vertices of the closed 1-rings of the two vertices of e (some vertices are visited twice)
+ */
+template <typename FUNC>
+inline void foreach_vertex_around_edge(const CMap2& map, CMap2::Edge e, const FUNC& f)
+{
+	std::pair<CMap2::Vertex, CMap2::Vertex> v = map.vertices(e);
+	f(v.first);
+	f(v.second);
+	map.foreach_adjacent_vertex_through_edge(v.first, f);
+	map.foreach_adjacent_vertex_through_edge(v.second, f);
+}
+
+/**
+ * \brief total order on the candidate edges: cost first (as a float32), then edge index
+ */
+inline uint64 collapse_key(float32 cost, uint32 edge_index)
+{
+	uint32 bits;
+	std::memcpy(&bits, &cost, sizeof(bits)); // the order of non-negative floats is the order of their bits
+	return (uint64(bits) << 32u) | uint64(edge_index);
+}
+
+} // namespace internal
+
+/**
+ * \brief QEM decimation by rounds of independent collapses
+ * Each round (re)evaluates in parallel the edges whose neighborhood changed during the previous round,
+ * keeps the cheapest 1/16 of the collapsible edges, and selects among them the edges
+ * of minimal cost in their neighborhood: each candidate claims the vertices of the closed 1-rings
+ * of its two vertices (atomic min on the vertices) and is selected if it holds all its claims.
+ * The neighborhoods of the selected edges do not overlap, so their collapses are independent:
+ * the cost, new position and collapsibility of a selected edge are not changed by the collapse of another one.
+ * The collapses themselves are applied one after the other (the map containers are not thread-safe).
+ * The result does not depend on the number of threads.
+ * @param map the map to decimate (triangle mesh)
+ * @param position vertex positions
+ * @param nb_vertices the decimation stops when the map has at most nb_vertices vertices
+ * @param max_error edges whose quadric error is greater than max_error are not collapsed
+ * @return the number of collapsed edges
+ */
+template <typename VERTEX_ATTR>
+uint32 parallel_decimate(
+	CMap2& map,
+	VERTEX_ATTR& position,
+	uint32 nb_vertices,
+	geometry::ScalarOf<InsideTypeOf<VERTEX_ATTR>> max_error = std::numeric_limits<geometry::ScalarOf<InsideTypeOf<VERTEX_ATTR>>>::max()
+)
+{
+	static_assert(is_orbit_of<VERTEX_ATTR, CMap2::Vertex::ORBIT>::value,"position must be a vertex attribute");
+
+	using VEC3 = InsideTypeOf<VERTEX_ATTR>;
+	using Scalar = geometry::ScalarOf<VEC3>;
+
+	using Vertex = CMap2::Vertex;
+	using Edge = CMap2::Edge;
+
+	struct Candidate
+	{
+		uint64 key_;
+		Edge edge_;
+	};
+
+	auto quadric = map.add_attribute<geometry::Quadric, Vertex>("parallel_decimate_Quadric");
+	auto cost = map.add_attribute<Scalar, Edge>("parallel_decimate_Cost");
+	auto new_position = map.add_attribute<VEC3, Edge>("parallel_decimate_Position");
+	auto changed = map.add_attribute<uint32, Edge>("parallel_decimate_Round");
+	changed.set_all_values(0u);
+
+	compute_vertex_quadrics<VEC3>(map, position, quadric);
+
+	// the cost of an edge is negative if it cannot be collapsed
+	auto evaluate = [&] (Edge e)
+	{
+		if (!map.edge_can_collapse(e))
+		{
+			cost[e] = Scalar(-1);
+			return;
+		}
+		std::pair<Vertex,Vertex> v = map.vertices(e);
+		geometry::Quadric q(quadric[v.first]);
+		q += quadric[v.second];
+		VEC3 p;
+		if (!q.optimized(p))
+			p = Scalar(0.5) * (position[v.first] + position[v.second]);
+		new_position[e] = p;
+		cost[e] = std::max(Scalar(0), Scalar(q(p)));
+	};
+
+	std::vector<std::vector<Candidate>> thread_candidates(thread_pool()->nb_workers() + 1u);
+	std::vector<Candidate> candidates;
+	std::vector<Candidate> selected;
+	std::vector<uint8> is_selected;
+	std::vector<std::atomic<uint64>> claim(map.attribute_container<Vertex::ORBIT>().end());
+
+	uint32 nb_vertices_left = map.nb_cells<Vertex::ORBIT>();
+	uint32 nb_collapses = 0u;
+
+	for (uint32 round = 1u; nb_vertices_left > nb_vertices; ++round)
+	{
+		map.parallel_foreach_cell([&] (Edge e)
+		{
+			if (round == 1u || changed[e] == round - 1u)
+				evaluate(e);
+		});
+
+		for (std::vector<Candidate>& tc : thread_candidates)
+			tc.clear();
+		map.parallel_foreach_cell([&] (Edge e)
+		{
+			const Scalar c = cost[e];
+			if (c >= Scalar(0) && c <= max_error)
+				thread_candidates[current_thread_index()].push_back({ internal::collapse_key(float32(c), map.embedding(e)), e });
+		});
+		candidates.clear();
+		for (const std::vector<Candidate>& tc : thread_candidates)
+			candidates.insert(candidates.end(), tc.begin(), tc.end());
+		if (candidates.empty())
+			break;
+
+		const std::size_t nb_kept = std::max(std::size_t(1024u), candidates.size() / 16u);
+		if (candidates.size() > nb_kept)
+		{
+			std::nth_element(candidates.begin(), candidates.begin() + nb_kept, candidates.end(),
+				[] (const Candidate& a, const Candidate& b) { return a.key_ < b.key_; });
+			candidates.resize(nb_kept);
+		}
+
+		const uint32 nb_candidates = uint32(candidates.size());
+		parallel_foreach_index(0u, nb_candidates, [&] (uint32 i)
+		{
+			internal::foreach_vertex_around_edge(map, candidates[i].edge_, [&] (Vertex u)
+			{
+				claim[map.embedding(u)].store(std::numeric_limits<uint64>::max(), std::memory_order_relaxed);
+			});
+		});
+		parallel_foreach_index(0u, nb_candidates, [&] (uint32 i)
+		{
+			const uint64 key = candidates[i].key_;
+			internal::foreach_vertex_around_edge(map, candidates[i].edge_, [&] (Vertex u)
+			{
+				std::atomic<uint64>& c = claim[map.embedding(u)];
+				uint64 current = c.load(std::memory_order_relaxed);
+				while (key < current && !c.compare_exchange_weak(current, key, std::memory_order_relaxed)) {}
+			});
+		});
+		is_selected.assign(nb_candidates, 0u);
+		parallel_foreach_index(0u, nb_candidates, [&] (uint32 i)
+		{
+			const uint64 key = candidates[i].key_;
+			bool holds_all = true;
+			internal::foreach_vertex_around_edge(map, candidates[i].edge_, [&] (Vertex u)
+			{
+				holds_all = holds_all && claim[map.embedding(u)].load(std::memory_order_relaxed) == key;
+			});
+			is_selected[i] = holds_all ? 1u : 0u;
+		});
+
+		selected.clear();
+		for (uint32 i = 0u; i < nb_candidates; ++i)
+			if (is_selected[i])
+				selected.push_back(candidates[i]);
+		std::sort(selected.begin(), selected.end(), [] (const Candidate& a, const Candidate& b) { return a.key_ < b.key_; });
+		if (selected.size() > nb_vertices_left - nb_vertices)
+			selected.resize(nb_vertices_left - nb_vertices);
+
+		for (const Candidate& c : selected)
+		{
+			std::pair<Vertex,Vertex> v = map.vertices(c.edge_);
+			geometry::Quadric q(quadric[v.first]);
+			q += quadric[v.second];
+			const VEC3 p = new_position[c.edge_];
+			const Dart e1 = map.phi2(map.phi_1(c.edge_.dart));
+			const Dart e2 = map.phi2(map.phi_1(map.phi2(c.edge_.dart)));
+
+			Vertex nv = map.collapse_edge(c.edge_);
+			position[nv] = p;
+			quadric[nv] = q;
+
+			// mark the edges to re-evaluate (the edges updated by EdgeTraversor_QEM::post_collapse)
+			Dart vit = e1;
+			do
+			{
+				changed[Edge(vit)] = round;
+				changed[Edge(map.phi1(vit))] = round;
+				if (vit == e1 || vit == e2)
+				{
+					Dart vit2 = map.phi<121>(vit);
+					Dart stop = map.phi2(vit);
+					do
+					{
+						changed[Edge(vit2)] = round;
+						changed[Edge(map.phi1(vit2))] = round;
+						vit2 = map.phi1(map.phi2(vit2));
+					} while (vit2 != stop);
+				}
+				vit = map.phi2(map.phi_1(vit));
+			} while (vit != e1);
+		}
+
+		nb_vertices_left -= uint32(selected.size());
+		nb_collapses += uint32(selected.size());
+	}
+
+	map.remove_attribute(quadric);
+	map.remove_attribute(cost);
+	map.remove_attribute(new_position);
+	map.remove_attribute(changed);
+
+	return nb_collapses;
+}
+
 #if defined(CGOGN_USE_EXTERNAL_TEMPLATES) && (!defined(CGOGN_MODELING_EXTERNAL_TEMPLATES_CPP_))
-extern template CGOGN_MODELING_API void decimate(CMap2&, CMap2::VertexAttribute<Eigen::Vector3f>&, EdgeTraversorType, EdgeApproximatorType, uint32);
-extern template CGOGN_MODELING_API void decimate(CMap2&, CMap2::VertexAttribute<Eigen::Vector3d>&, EdgeTraversorType, EdgeApproximatorType, uint32);
+extern template CGOGN_MODELING_API void decimate(CMap2&, CMap2::VertexAttribute<Eigen::Vector3f>&, EdgeTraversorType, EdgeApproximatorType, uint32, ProgressiveMeshRecorder<Eigen::Vector3f>*);
+extern template CGOGN_MODELING_API void decimate(CMap2&, CMap2::VertexAttribute<Eigen::Vector3d>&, EdgeTraversorType, EdgeApproximatorType, uint32, ProgressiveMeshRecorder<Eigen::Vector3d>*);
+extern template CGOGN_MODELING_API uint32 parallel_decimate(CMap2&, CMap2::VertexAttribute<Eigen::Vector3f>&, uint32, float32);
+extern template CGOGN_MODELING_API uint32 parallel_decimate(CMap2&, CMap2::VertexAttribute<Eigen::Vector3d>&, uint32, float64);
 #endif // defined(CGOGN_USE_EXTERNAL_TEMPLATES) && (!defined(CGOGN_MODELING_EXTERNAL_TEMPLATES_CPP_))
 
 } // namespace modeling
@@ -27,7 +27,9 @@
 #include <vector>
 #include <cgogn/modeling/dll.h>
 #include<cgogn/core/cmap/cmap2.h>
+#include<cgogn/core/cmap/cmap3.h>
 #include<cgogn/core/utils/type_traits.h>
+#include<cgogn/core/utils/parallel_foreach_element.h>
 
 namespace cgogn
 {
@@ -387,6 +389,287 @@ void dual(const CMap2& src, CMap2& dst, CMap2::CellMarker<CMap2::Vertex::ORBIT>*
 }
 
 
+namespace Dual_internal
+{
+
+template <uint32 DIM>
+struct DualMap
+{};
+
+template <>
+struct DualMap<2u>
+{
+	using type = CMap2;
+	using VertexMarker = CMap2::CellMarker<CMap2::Vertex::ORBIT>;
+};
+
+template <>
+struct DualMap<3u>
+{
+	using type = CMap3;
+	using VertexMarker = CMap3::CellMarker<CMap3::Vertex::ORBIT>;
+};
+
+/**
+ * dual orbit of the cells of ORBIT in a map of dimension DIM,
+ * shift: the dual of the face of dart d is the vertex of phi2(d) (2D, see dual2_topo),
+ * the other cells are the dual of the cell of the same dart
+ */
+template <uint32 DIM, Orbit ORBIT>
+struct DualOrbit
+{};
+
+template <> struct DualOrbit<2u, Orbit::PHI21> { static const Orbit value = Orbit::PHI1; static const bool shift = false; };
+template <> struct DualOrbit<2u, Orbit::PHI2> { static const Orbit value = Orbit::PHI2; static const bool shift = false; };
+template <> struct DualOrbit<2u, Orbit::PHI1> { static const Orbit value = Orbit::PHI21; static const bool shift = true; };
+template <> struct DualOrbit<3u, Orbit::PHI21_PHI31> { static const Orbit value = Orbit::PHI1_PHI2; static const bool shift = false; };
+template <> struct DualOrbit<3u, Orbit::PHI2_PHI3> { static const Orbit value = Orbit::PHI1_PHI3; static const bool shift = false; };
+template <> struct DualOrbit<3u, Orbit::PHI1_PHI3> { static const Orbit value = Orbit::PHI2_PHI3; static const bool shift = false; };
+template <> struct DualOrbit<3u, Orbit::PHI1_PHI2> { static const Orbit value = Orbit::PHI21_PHI31; static const bool shift = false; };
+
+template <typename MAP>
+inline auto top_phi(const MAP& map, Dart d) -> typename std::enable_if<MAP::DIMENSION == 2, Dart>::type
+{
+	return map.phi2(d);
+}
+
+template <typename MAP>
+inline auto top_phi(const MAP& map, Dart d) -> typename std::enable_if<MAP::DIMENSION == 3, Dart>::type
+{
+	return map.phi3(d);
+}
+
+/**
+ * @brief phi2 in the volumes of a volume map, the holes being closed by one volume each
+ * The holes of the maps with fixed size volumes (CMap3Tetra, CMap3Hexa) are closed by one boundary volume per face,
+ * only their faces sewn to the map are faces of the hole: they are adjacent through the sewn side faces of their volumes.
+ */
+template <typename MAP>
+inline Dart volume_phi2(const MAP& src, Dart d)
+{
+	if (MAP::PRIM_SIZE > 1u && src.is_boundary(d))
+		return src.phi2(src.phi3(src.phi2(d)));
+	return src.phi2(d);
+}
+
+/**
+ * @brief dart of the cell of src whose dual is the cell of ORBIT of the dual of the dart d
+ */
+template <Orbit ORBIT, typename MAP>
+inline Dart src_cell_dart(const MAP& src, Dart d)
+{
+	return DualOrbit<MAP::DIMENSION, ORBIT>::shift ? src.phi2(d) : d;
+}
+
+/**
+ * @brief numbering of the darts of the dual of a closed map, grouped by vertex of the source map
+ * (dual face in 2D, dual volume in 3D). The darts of each vertex are counted in parallel,
+ * their offsets computed by a prefix sum, then each vertex numbers its darts in parallel.
+ */
+template <typename MAP>
+class DualDarts
+{
+public:
+
+	using Vertex = typename MAP::Vertex;
+
+	DualDarts(const MAP& src)
+	{
+		src.foreach_cell([&] (Vertex v) { vertices_.push_back(v.dart); });
+
+		const uint32 nb_vertices = uint32(vertices_.size());
+		offsets_.resize(nb_vertices + 1u);
+		offsets_[0] = 0u;
+		parallel_foreach_index(0u, nb_vertices, [&] (uint32 v)
+		{
+			offsets_[v + 1u] = src.nb_darts_of_orbit(Vertex(vertices_[v]));
+		});
+		for (uint32 v = 0u; v < nb_vertices; ++v)
+			offsets_[v + 1u] += offsets_[v];
+
+		src_darts_.resize(offsets_.back());
+		dual_index_.assign(src.topology_container().end(), INVALID_INDEX);
+		parallel_foreach_index(0u, nb_vertices, [&] (uint32 v)
+		{
+			uint32 i = offsets_[v];
+			foreach_dart_of_vertex(src, vertices_[v], [&] (Dart d)
+			{
+				src_darts_[i] = d;
+				dual_index_[d.index] = i++;
+			});
+		});
+	}
+
+	CGOGN_NOT_COPYABLE_NOR_MOVABLE(DualDarts);
+
+	inline uint32 nb_darts() const { return uint32(src_darts_.size()); }
+	/// dart of the source map of the i-th dart of the dual
+	inline Dart src_dart(uint32 i) const { return src_darts_[i]; }
+	/// index (from the first dart of the dual) of the dual of the dart d of the source map
+	inline uint32 dual_index(Dart d) const { return dual_index_[d.index]; }
+
+private:
+
+	// in 2D, the darts of a dual face are numbered in the phi1 order of the dual
+	template <typename FUNC, typename M = MAP>
+	static auto foreach_dart_of_vertex(const M& src, Dart d, const FUNC& f) -> typename std::enable_if<M::DIMENSION == 2>::type
+	{
+		Dart it = d;
+		do
+		{
+			f(it);
+			it = src.phi2(src.phi_1(it));
+		} while (it != d);
+	}
+
+	template <typename FUNC, typename M = MAP>
+	static auto foreach_dart_of_vertex(const M& src, Dart d, const FUNC& f) -> typename std::enable_if<M::DIMENSION == 3>::type
+	{
+		src.foreach_dart_of_orbit(Vertex(d), f);
+	}
+
+	std::vector<Dart> vertices_;
+	std::vector<uint32> offsets_;
+	std::vector<Dart> src_darts_;
+	std::vector<uint32> dual_index_;
+};
+
+/**
+ * @brief fill the phi relations of the dual (phi1(d) = phi2(phi_1(d)), phi2(d) = phi2(d) of the source map)
+ */
+template <typename MAP>
+auto dual_phi(const MAP& src, CMap2& dst, const DualDarts<MAP>& darts, uint32 first) -> typename std::enable_if<MAP::DIMENSION == 2>::type
+{
+	CMap2::Builder build_dst(dst);
+	auto& phi1_dst = build_dst.ca_phi1();
+	auto& phi_1_dst = build_dst.ca_phi_1();
+	auto& phi2_dst = build_dst.ca_phi2();
+	parallel_foreach_index(0u, darts.nb_darts(), [&] (uint32 i)
+	{
+		const Dart d = darts.src_dart(i);
+		phi1_dst[first + i] = Dart(first + darts.dual_index(src.phi2(src.phi_1(d))));
+		phi_1_dst[first + i] = Dart(first + darts.dual_index(src.phi1(src.phi2(d))));
+		phi2_dst[first + i] = Dart(first + darts.dual_index(src.phi2(d)));
+	});
+}
+
+/**
+ * @brief fill the phi relations of the dual (phi1(d) = phi2(phi3(d)), phi2(d) = phi1(phi3(d)), phi3(d) = phi3(d) of the source map)
+ * (the dual volumes are oriented as the volumes of src)
+ */
+template <typename MAP>
+auto dual_phi(const MAP& src, CMap3& dst, const DualDarts<MAP>& darts, uint32 first) -> typename std::enable_if<MAP::DIMENSION == 3>::type
+{
+	CMap3::Builder build_dst(dst);
+	auto& phi1_dst = build_dst.ca_phi1();
+	auto& phi_1_dst = build_dst.ca_phi_1();
+	auto& phi2_dst = build_dst.ca_phi2();
+	auto& phi3_dst = build_dst.ca_phi3();
+	parallel_foreach_index(0u, darts.nb_darts(), [&] (uint32 i)
+	{
+		const Dart d = darts.src_dart(i);
+		phi1_dst[first + i] = Dart(first + darts.dual_index(volume_phi2(src, src.phi3(d))));
+		phi_1_dst[first + i] = Dart(first + darts.dual_index(src.phi3(volume_phi2(src, d))));
+		phi2_dst[first + i] = Dart(first + darts.dual_index(src.phi1(src.phi3(d))));
+		phi3_dst[first + i] = Dart(first + darts.dual_index(src.phi3(d)));
+	});
+}
+
+template <typename MAP, typename DUAL>
+inline void parallel_dual_attributes(const MAP&, DUAL&, const DualDarts<MAP>&, uint32, const std::vector<std::string>&, uint32)
+{}
+
+template <typename MAP, typename DUAL, typename F, typename... Args>
+void parallel_dual_attributes(const MAP& src, DUAL& dst, const DualDarts<MAP>& darts, uint32 first,
+							  const std::vector<std::string>& att_name, uint32 n, const F& func, const Args&... args)
+{
+	using CELL_SRC = func_ith_parameter_type<F,0>;
+	using DUAL_ORBIT = DualOrbit<MAP::DIMENSION, CELL_SRC::ORBIT>;
+	using CELL_DST = Cell<DUAL_ORBIT::value>;
+	using ATTR = func_return_type<F>;
+
+	auto att = dst.template add_attribute<ATTR, CELL_DST>(att_name[n]);
+
+	dst.parallel_foreach_cell([&] (CELL_DST c)
+	{
+		const Dart d = darts.src_dart(c.dart.index - first);
+		att[c] = func(CELL_SRC(src_cell_dart<CELL_SRC::ORBIT>(src, d)));
+	});
+
+	parallel_dual_attributes(src, dst, darts, first, att_name, n + 1u, args...);
+}
+
+} // namespace Dual_internal
+
+/**
+ * @brief parallel_dual computes the dual of a surface (CMap2, or closed CMap2Tri, CMap2Quad) in a CMap2
+ * or of a volume map (CMap3, CMap3Tetra, CMap3Hexa) in a CMap3, the boundary faces / volumes become vertices of the dual
+ * (the boundary volumes of CMap3Tetra and CMap3Hexa that close a hole give a single vertex, as with CMap3)
+ * The darts of the dual are grouped by vertex of src (dual face / volume) and allocated at once,
+ * the phi relations and the attributes are computed in parallel.
+ * @param src source mesh (without fixed point of phi2 / phi3, i.e. closed with close_map)
+ * @param dst computed dual mesh (cleared)
+ * @param marker if is not null mark vertices that are dual of boundary faces (2D) / volumes (3D)
+ * @param att_name names of attributs to create & compute
+ * @param func lambdas of computing attribut (Cell of src) -> attribute_type, the attribute is created on the dual cells,
+ * order of lambdas must be coherent with att_names (for CMap3Tetra and CMap3Hexa, the dual vertex of a hole
+ * receives one of its boundary volumes)
+ * @return false if src is not closed (dst is then empty)
+ */
+template <typename MAP, typename... Args>
+bool parallel_dual(const MAP& src, typename Dual_internal::DualMap<MAP::DIMENSION>::type& dst,
+				   typename Dual_internal::DualMap<MAP::DIMENSION>::VertexMarker* marker,
+				   const std::vector<std::string>& att_name, const Args&... funcs)
+{
+	using DUAL = typename Dual_internal::DualMap<MAP::DIMENSION>::type;
+	using Vertex = typename DUAL::Vertex;
+	using TopCell = typename std::conditional<MAP::DIMENSION == 2u, typename MAP::Face, typename MAP::Volume>::type;
+
+	if (att_name.size() != sizeof...(funcs))
+		cgogn_log_error("parallel_dual") << "number of attribute names must equal to number of computing lambdas";
+
+	dst.clear_and_remove_attributes();
+
+	// the boundary faces of the surfaces with fixed size faces (CMap2Tri, CMap2Quad) are not regular faces,
+	// the boundary volumes of CMap3Hexa have an unsewn face
+	bool closed = true;
+	src.foreach_dart([&] (Dart d) -> bool
+	{
+		if (MAP::PRIM_SIZE == 1u)
+			closed = Dual_internal::top_phi(src, d) != d;
+		else if (MAP::DIMENSION == 3u)
+			closed = src.is_boundary(d) || Dual_internal::top_phi(src, d) != d;
+		else
+			closed = Dual_internal::top_phi(src, d) != d && !src.is_boundary(d);
+		return closed;
+	});
+	if (!closed)
+	{
+		cgogn_log_error("parallel_dual") << "can not compute dual of open map";
+		return false;
+	}
+
+	const Dual_internal::DualDarts<MAP> darts(src);
+	typename DUAL::Builder build_dst(dst);
+	const uint32 first = build_dst.add_topology_elements(darts.nb_darts()).index;
+	Dual_internal::dual_phi(src, dst, darts, first);
+
+	if ((marker != nullptr) && (marker->is_valid()))
+	{
+		build_dst.template create_embedding<Vertex::ORBIT>();
+		dst.foreach_cell([&] (Vertex v)
+		{
+			if (src.is_boundary(Dual_internal::src_cell_dart<TopCell::ORBIT>(src, darts.src_dart(v.dart.index - first))))
+				marker->mark(v);
+		});
+	}
+
+	Dual_internal::parallel_dual_attributes(src, dst, darts, first, att_name, 0u, funcs...);
+
+	return true;
+}
+
+
 } // namespace modeling
 
 } // namespace cgogn
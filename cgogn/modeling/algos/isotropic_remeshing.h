@@ -0,0 +1,641 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef CGOGN_MODELING_ALGOS_ISOTROPIC_REMESHING_H_
+#define CGOGN_MODELING_ALGOS_ISOTROPIC_REMESHING_H_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+#include <cgogn/modeling/dll.h>
+
+#include <cgogn/geometry/functions/basics.h>
+#include <cgogn/geometry/types/geometry_traits.h>
+#include <cgogn/geometry/algos/normal.h>
+#include <cgogn/geometry/algos/face_bvh.h>
+
+#include <cgogn/core/cmap/cmap2.h>
+#include <cgogn/core/utils/parallel_foreach_element.h>
+
+namespace cgogn
+{
+
+namespace modeling
+{
+
+/**
+ * \brief time spent in each phase of isotropic_remeshing (in seconds, summed over the iterations)
+ * and number of applied operations
+ */
+struct IsotropicRemeshingStatistics
+{
+	float64 split_time_;
+	float64 collapse_time_;
+	float64 flip_time_;
+	float64 smooth_time_;
+	float64 project_time_;
+	uint32 nb_splits_;
+	uint32 nb_collapses_;
+	uint32 nb_flips_;
+
+	IsotropicRemeshingStatistics()
+	{
+		reset();
+	}
+
+	void reset()
+	{
+		split_time_ = collapse_time_ = flip_time_ = smooth_time_ = project_time_ = 0.0;
+		nb_splits_ = nb_collapses_ = nb_flips_ = 0u;
+	}
+
+	inline float64 total_time() const
+	{
+		return split_time_ + collapse_time_ + flip_time_ + smooth_time_ + project_time_;
+	}
+};
+
+namespace internal
+{
+
+struct RemeshingCandidate
+{
+	uint64 key_;
+	CMap2::Edge edge_;
+	uint32 nb_claims_;
+};
+
+/**
+ * \brief total order on the candidate operations: priority first (smaller first), then a hash of the edge.
+ * The hash is a bijection of the edge index (the keys stay unique) that breaks the spatial coherence
+ * of the indices, so that the local minima of the keys, and thus the operations selected in a round, are numerous.
+ */
+inline uint64 remeshing_key(uint32 priority, const CMap2& map, CMap2::Edge e)
+{
+	uint32 h = std::min(e.dart.index, map.phi2(e.dart).index);
+	h ^= h >> 16u;
+	h *= 0x7feb352du;
+	h ^= h >> 15u;
+	h *= 0x846ca68bu;
+	h ^= h >> 16u;
+	return (uint64(priority) << 32u) | uint64(h);
+}
+
+/**
+ * \brief index of a triangle (smallest index of its darts)
+ */
+inline uint32 triangle_index(const CMap2& map, Dart d)
+{
+	return std::min(d.index, std::min(map.phi1(d).index, map.phi_1(d).index));
+}
+
+/**
+ * \brief apply rounds of independent operations on the edges until no edge is a candidate.
+ * The first round evaluates in parallel all the edges (evaluate(e, key) returns true for a candidate).
+ * Each round selects a maximal set of candidates whose neighborhoods do not overlap (claims(e, indices) pushes the index
+ * of each element of the neighborhood of e): by passes over the undecided candidates, a candidate that overlaps
+ * a selected one is discarded, the others claim their elements (atomic min of the keys) and the candidates that hold
+ * all their claims are selected. This is the set greedily built by increasing key, so it does not depend on the number of threads.
+ * The selected operations are then applied one after the other by increasing key (the map containers are not thread-safe).
+ * The next round evaluates the edges of the faces incident to the closed 1-rings of the vertices returned by apply(e),
+ * that must contain the vertices of the modified faces, and keeps the candidates whose support (support(e, indices) pushes
+ * a subset of the claims on which the evaluation of e depends) is disjoint from the claims of the selected operations.
+ * @param nb_claims returns the number of elements that may be claimed in the current map
+ * @return the number of applied operations
+ */
+template <typename NB_CLAIMS, typename EVALUATE, typename CLAIM, typename SUPPORT, typename APPLY>
+uint32 independent_edge_rounds(
+	CMap2& map,
+	const NB_CLAIMS& nb_claims,
+	const EVALUATE& evaluate,
+	const CLAIM& claims,
+	const SUPPORT& support,
+	const APPLY& apply
+)
+{
+	using Vertex = CMap2::Vertex;
+	using Edge = CMap2::Edge;
+
+	const uint64 FREE = std::numeric_limits<uint64>::max();
+	const uint64 TAKEN = FREE - 1u;
+
+	std::vector<std::vector<RemeshingCandidate>> thread_candidates(thread_pool()->nb_workers() + 1u);
+	std::vector<std::vector<uint32>> thread_indices(thread_pool()->nb_workers() + 1u);
+	std::vector<std::vector<uint32>> thread_support(thread_pool()->nb_workers() + 1u);
+	std::vector<RemeshingCandidate> candidates;
+	std::vector<RemeshingCandidate> next_candidates;
+	std::vector<RemeshingCandidate> selected;
+	std::vector<uint32> claim_offsets;
+	std::vector<uint32> claim_indices;
+	std::vector<uint32> next_claim_indices;
+	std::vector<std::atomic<uint64>> claim;
+	std::vector<uint32> undecided;
+	std::vector<uint8> status; // 0: undecided, 1: selected, 2: discarded
+	std::vector<uint8> keep;
+	std::vector<Vertex> modified;
+	std::vector<Edge> to_evaluate;
+	std::vector<uint32> edge_round; // indexed by the smallest dart of the edges
+
+	auto edge_index = [&] (Edge e) -> uint32 { return std::min(e.dart.index, map.phi2(e.dart).index); };
+
+	// the claims of a candidate are computed once, with its evaluation
+	auto evaluate_edge = [&] (Edge e)
+	{
+		uint64 key;
+		if (evaluate(e, key))
+		{
+			const uint32 t = current_thread_index();
+			std::vector<uint32>& indices = thread_indices[t];
+			const std::size_t first = indices.size();
+			claims(e, indices);
+			thread_candidates[t].push_back({ key, e, uint32(indices.size() - first) });
+		}
+	};
+
+	// the kept candidates (and their claims), then the newly evaluated ones
+	auto collect_candidates = [&] (uint32 round)
+	{
+		next_candidates.clear();
+		next_claim_indices.clear();
+		for (uint32 i = 0u, end = uint32(keep.size()); i < end; ++i)
+		{
+			if (keep[i] && edge_round[edge_index(candidates[i].edge_)] != round)
+			{
+				next_candidates.push_back(candidates[i]);
+				next_claim_indices.insert(next_claim_indices.end(), claim_indices.begin() + claim_offsets[i], claim_indices.begin() + claim_offsets[i + 1u]);
+			}
+		}
+		for (uint32 t = 0u, end = uint32(thread_candidates.size()); t < end; ++t)
+		{
+			next_candidates.insert(next_candidates.end(), thread_candidates[t].begin(), thread_candidates[t].end());
+			next_claim_indices.insert(next_claim_indices.end(), thread_indices[t].begin(), thread_indices[t].end());
+			thread_candidates[t].clear();
+			thread_indices[t].clear();
+		}
+		candidates.swap(next_candidates);
+		claim_indices.swap(next_claim_indices);
+		claim_offsets.resize(candidates.size() + 1u);
+		claim_offsets[0] = 0u;
+		for (uint32 i = 0u, end = uint32(candidates.size()); i < end; ++i)
+			claim_offsets[i + 1u] = claim_offsets[i] + candidates[i].nb_claims_;
+	};
+
+	map.parallel_foreach_cell(evaluate_edge);
+	collect_candidates(0u);
+
+	uint32 nb_applied = 0u;
+	for (uint32 round = 1u; !candidates.empty(); ++round)
+	{
+		const uint32 nb_candidates = uint32(candidates.size());
+
+		const std::size_t size = nb_claims();
+		if (claim.size() < size)
+			std::vector<std::atomic<uint64>>(size + size / 2u).swap(claim);
+		parallel_foreach_index(0u, claim_offsets[nb_candidates], [&] (uint32 j)
+		{
+			claim[claim_indices[j]].store(FREE, std::memory_order_relaxed);
+		});
+
+		// maximal independent set
+		undecided.resize(nb_candidates);
+		for (uint32 i = 0u; i < nb_candidates; ++i)
+			undecided[i] = i;
+		selected.clear();
+		keep.assign(nb_candidates, 1u);
+		while (!undecided.empty())
+		{
+			const uint32 nb_undecided = uint32(undecided.size());
+			status.assign(nb_undecided, 0u);
+			parallel_foreach_index(0u, nb_undecided, [&] (uint32 k)
+			{
+				const uint32 i = undecided[k];
+				for (uint32 j = claim_offsets[i]; j < claim_offsets[i + 1u]; ++j)
+				{
+					if (claim[claim_indices[j]].load(std::memory_order_relaxed) == TAKEN)
+					{
+						status[k] = 2u;
+						return;
+					}
+				}
+				for (uint32 j = claim_offsets[i]; j < claim_offsets[i + 1u]; ++j)
+					claim[claim_indices[j]].store(FREE, std::memory_order_relaxed);
+			});
+			parallel_foreach_index(0u, nb_undecided, [&] (uint32 k)
+			{
+				if (status[k] != 0u)
+					return;
+				const uint32 i = undecided[k];
+				const uint64 key = candidates[i].key_;
+				for (uint32 j = claim_offsets[i]; j < claim_offsets[i + 1u]; ++j)
+				{
+					std::atomic<uint64>& a = claim[claim_indices[j]];
+					uint64 current = a.load(std::memory_order_relaxed);
+					while (key < current && !a.compare_exchange_weak(current, key, std::memory_order_relaxed)) {}
+				}
+			});
+			parallel_foreach_index(0u, nb_undecided, [&] (uint32 k)
+			{
+				if (status[k] != 0u)
+					return;
+				const uint32 i = undecided[k];
+				const uint64 key = candidates[i].key_;
+				bool holds_all = true;
+				for (uint32 j = claim_offsets[i]; j < claim_offsets[i + 1u] && holds_all; ++j)
+					holds_all = claim[claim_indices[j]].load(std::memory_order_relaxed) == key;
+				if (holds_all)
+					status[k] = 1u;
+			});
+			parallel_foreach_index(0u, nb_undecided, [&] (uint32 k)
+			{
+				if (status[k] != 1u)
+					return;
+				const uint32 i = undecided[k];
+				for (uint32 j = claim_offsets[i]; j < claim_offsets[i + 1u]; ++j)
+					claim[claim_indices[j]].store(TAKEN, std::memory_order_relaxed);
+			});
+
+			uint32 nb_left = 0u;
+			for (uint32 k = 0u; k < nb_undecided; ++k)
+			{
+				if (status[k] == 1u)
+				{
+					selected.push_back(candidates[undecided[k]]);
+					keep[undecided[k]] = 0u;
+				}
+				else if (status[k] == 0u)
+					undecided[nb_left++] = undecided[k];
+			}
+			undecided.resize(nb_left);
+		}
+
+		// the other candidates stay valid if their support is not claimed by a selected one
+		parallel_foreach_index(0u, nb_candidates, [&] (uint32 i)
+		{
+			if (!keep[i])
+				return;
+			std::vector<uint32>& indices = thread_support[current_thread_index()];
+			indices.clear();
+			support(candidates[i].edge_, indices);
+			for (uint32 c : indices)
+			{
+				if (claim[c].load(std::memory_order_relaxed) == TAKEN)
+				{
+					keep[i] = 0u;
+					return;
+				}
+			}
+		});
+
+		std::sort(selected.begin(), selected.end(), [] (const RemeshingCandidate& a, const RemeshingCandidate& b) { return a.key_ < b.key_; });
+		modified.clear();
+		for (const RemeshingCandidate& c : selected)
+			modified.push_back(apply(c.edge_));
+		nb_applied += uint32(selected.size());
+
+		// the edges of the faces incident to the modified vertices and their neighbors
+		edge_round.resize(map.topology_container().end(), 0u);
+		to_evaluate.clear();
+		auto add_edge = [&] (Edge e)
+		{
+			uint32& r = edge_round[edge_index(e)];
+			if (r != round)
+			{
+				r = round;
+				to_evaluate.push_back(e);
+			}
+		};
+		auto add_faces = [&] (Vertex w)
+		{
+			map.foreach_dart_of_orbit(w, [&] (Dart d)
+			{
+				add_edge(Edge(d));
+				if (!map.is_boundary(d))
+					add_edge(Edge(map.phi1(d)));
+			});
+		};
+		for (Vertex v : modified)
+		{
+			add_faces(v);
+			map.foreach_adjacent_vertex_through_edge(v, add_faces);
+		}
+
+		parallel_foreach_index(0u, uint32(to_evaluate.size()), [&] (uint32 i) { evaluate_edge(to_evaluate[i]); });
+		collect_candidates(round);
+	}
+
+	return nb_applied;
+}
+
+} // namespace internal
+
+/**
+ * \brief isotropic remeshing of a triangle mesh (Botsch & Kobbelt 2004)
+ * Each iteration splits the edges longer than 4/3 target_edge_length, collapses the edges shorter
+ * than 4/5 target_edge_length (when no edge longer than 4/3 target_edge_length is created and no face is folded),
+ * flips the edges that reduce the deviation of the valences from 6 (4 on the boundary),
+ * moves the vertices towards the barycenter of their neighbors in their tangent plane
+ * and projects them back onto the input surface.
+ * Splits, collapses and flips are done by rounds of independent operations (see internal::independent_edge_rounds),
+ * smoothing and projection are done in parallel. The projection uses a FaceBVH of a copy of the input map
+ * made before the first iteration. Boundary vertices are not moved by the smoothing and boundary edges are only split.
+ * @param map the map to remesh (triangle mesh)
+ * @param position vertex positions
+ * @param target_edge_length the length of the edges of the result (e.g. the mean edge length of the input)
+ * @param nb_iterations number of iterations
+ * @param statistics if given, the time spent in each phase and the number of operations are added to it
+ */
+template <typename VERTEX_ATTR>
+void isotropic_remeshing(
+	CMap2& map,
+	VERTEX_ATTR& position,
+	geometry::ScalarOf<InsideTypeOf<VERTEX_ATTR>> target_edge_length,
+	uint32 nb_iterations = 5u,
+	IsotropicRemeshingStatistics* statistics = nullptr
+)
+{
+	static_assert(is_orbit_of<VERTEX_ATTR, CMap2::Vertex::ORBIT>::value,"position must be a vertex attribute");
+
+	using VEC3 = InsideTypeOf<VERTEX_ATTR>;
+	using Scalar = geometry::ScalarOf<VEC3>;
+
+	using Vertex = CMap2::Vertex;
+	using Edge = CMap2::Edge;
+	using Face = CMap2::Face;
+
+	using TimePoint = std::chrono::time_point<std::chrono::steady_clock>;
+	TimePoint start = std::chrono::steady_clock::now();
+	auto lap = [&] (float64 IsotropicRemeshingStatistics::* time)
+	{
+		TimePoint end = std::chrono::steady_clock::now();
+		if (statistics)
+			statistics->*time += std::chrono::duration<float64>(end - start).count();
+		start = end;
+	};
+
+	const Scalar squared_max_edge_length = Scalar(16) / Scalar(9) * target_edge_length * target_edge_length; // (4/3)^2
+	const Scalar squared_min_edge_length = Scalar(16) / Scalar(25) * target_edge_length * target_edge_length; // (4/5)^2
+
+	CMap2 reference;
+	typename CMap2::DartMarker dm(reference);
+	reference.merge(map, dm);
+	auto reference_position = reference.template get_attribute<VEC3, Vertex>(position.name());
+	geometry::FaceBVH<CMap2, VEC3> bvh(reference, reference_position);
+	lap(&IsotropicRemeshingStatistics::project_time_);
+
+	auto new_position = map.add_attribute<VEC3, Vertex>("isotropic_remeshing_NewPosition");
+
+	auto nb_vertex_claims = [&] () -> std::size_t { return map.attribute_container<Vertex::ORBIT>().end(); };
+	auto nb_face_claims = [&] () -> std::size_t { return map.topology_container().end(); };
+
+	auto vertex_target_degree = [&] (Vertex v) -> int32
+	{
+		return map.is_incident_to_boundary(v) ? 4 : 6;
+	};
+
+	// neighborhoods of an edge: its incident triangles, the vertices of these triangles, the closed 1-rings of its vertices
+	auto incident_triangles = [&] (Edge e, std::vector<uint32>& indices)
+	{
+		map.foreach_dart_of_orbit(e, [&] (Dart d)
+		{
+			if (!map.is_boundary(d))
+				indices.push_back(internal::triangle_index(map, d));
+		});
+	};
+	auto edge_vertices = [&] (Edge e, std::vector<uint32>& indices)
+	{
+		map.foreach_dart_of_orbit(e, [&] (Dart d)
+		{
+			indices.push_back(map.embedding(Vertex(d)));
+			if (!map.is_boundary(d))
+				indices.push_back(map.embedding(Vertex(map.phi_1(d))));
+		});
+	};
+	auto edge_rings = [&] (Edge e, std::vector<uint32>& indices)
+	{
+		std::pair<Vertex,Vertex> v = map.vertices(e);
+		indices.push_back(map.embedding(v.first));
+		indices.push_back(map.embedding(v.second));
+		auto push = [&] (Vertex u) { indices.push_back(map.embedding(u)); };
+		map.foreach_adjacent_vertex_through_edge(v.first, push);
+		map.foreach_adjacent_vertex_through_edge(v.second, push);
+	};
+
+	for (uint32 iteration = 0u; iteration < nb_iterations; ++iteration)
+	{
+		// split long edges, longest first (up to a quantization of the lengths), the split edges of a round do not share a face
+		const uint32 nb_splits = internal::independent_edge_rounds(map, nb_face_claims,
+			[&] (Edge e, uint64& key) -> bool
+			{
+				std::pair<Vertex,Vertex> v = map.vertices(e);
+				const Scalar l = (position[v.first] - position[v.second]).squaredNorm();
+				if (l <= squared_max_edge_length)
+					return false;
+				key = internal::remeshing_key(uint32(Scalar(16) * squared_max_edge_length / l), map, e);
+				return true;
+			},
+			incident_triangles,
+			incident_triangles,
+			[&] (Edge e) -> Vertex
+			{
+				std::pair<Vertex,Vertex> v = map.vertices(e);
+				const VEC3 p = Scalar(0.5) * (position[v.first] + position[v.second]);
+				const Dart e2 = map.phi2(e.dart);
+				Vertex nv = map.cut_edge(e);
+				position[nv] = p;
+				if (!map.is_boundary(e.dart))
+					map.cut_face(nv.dart, map.phi_1(e.dart));
+				if (!map.is_boundary(e2))
+					map.cut_face(map.phi1(e2), map.phi_1(e2));
+				return nv;
+			}
+		);
+		lap(&IsotropicRemeshingStatistics::split_time_);
+
+		// collapse short edges to their midpoint, shortest first (up to a quantization of the lengths), the closed 1-rings of the collapsed edges do not overlap
+		const uint32 nb_collapses = internal::independent_edge_rounds(map, nb_vertex_claims,
+			[&] (Edge e, uint64& key) -> bool
+			{
+				std::pair<Vertex,Vertex> v = map.vertices(e);
+				const VEC3& p1 = position[v.first];
+				const VEC3& p2 = position[v.second];
+				const Scalar l = (p1 - p2).squaredNorm();
+				if (l >= squared_min_edge_length || !map.edge_can_collapse(e))
+					return false;
+				const VEC3 p = Scalar(0.5) * (p1 + p2);
+				const uint32 emb1 = map.embedding(v.first);
+				const uint32 emb2 = map.embedding(v.second);
+				bool valid = true;
+				auto check_vertex = [&] (Vertex u)
+				{
+					const VEC3& pu = position[u];
+					map.foreach_incident_face(u, [&] (Face f) -> bool
+					{
+						const Vertex a(map.phi1(f.dart));
+						const Vertex b(map.phi_1(f.dart));
+						const uint32 emb_a = map.embedding(a);
+						const uint32 emb_b = map.embedding(b);
+						if (emb_a == emb1 || emb_a == emb2 || emb_b == emb1 || emb_b == emb2)
+							return true; // a face of the collapsed edge
+						const VEC3& pa = position[a];
+						const VEC3& pb = position[b];
+						valid = (p - pa).squaredNorm() < squared_max_edge_length &&
+							(pa - pu).cross(pb - pu).dot((pa - p).cross(pb - p)) > Scalar(0);
+						return valid;
+					});
+				};
+				check_vertex(v.first);
+				if (valid)
+					check_vertex(v.second);
+				if (!valid)
+					return false;
+				key = internal::remeshing_key(uint32(Scalar(16) * l / squared_min_edge_length), map, e);
+				return true;
+			},
+			edge_rings,
+			edge_vertices,
+			[&] (Edge e) -> Vertex
+			{
+				std::pair<Vertex,Vertex> v = map.vertices(e);
+				const VEC3 p = Scalar(0.5) * (position[v.first] + position[v.second]);
+				Vertex cv = map.collapse_edge(e);
+				position[cv] = p;
+				return cv;
+			}
+		);
+		lap(&IsotropicRemeshingStatistics::collapse_time_);
+
+		// flip the edges that reduce the valence deviation, largest reduction first, the flipped edges do not share a vertex
+		const uint32 nb_flips = internal::independent_edge_rounds(map, nb_vertex_claims,
+			[&] (Edge e, uint64& key) -> bool
+			{
+				if (map.is_incident_to_boundary(e))
+					return false;
+				const Dart d = e.dart;
+				const Dart d2 = map.phi2(d);
+				const Vertex a(d);
+				const Vertex b(d2);
+				const Vertex c(map.phi_1(d));
+				const Vertex o(map.phi_1(d2));
+				const int32 da = int32(map.degree(a));
+				const int32 db = int32(map.degree(b));
+				if (da <= 3 || db <= 3)
+					return false;
+				const int32 ta = vertex_target_degree(a);
+				const int32 tb = vertex_target_degree(b);
+				// each vertex changes the deviation by 1, at least 3 of them must reduce it
+				if (da <= ta && db <= tb)
+					return false;
+				const int32 dc = int32(map.degree(c));
+				const int32 dd = int32(map.degree(o));
+				const int32 tc = vertex_target_degree(c);
+				const int32 td = vertex_target_degree(o);
+				const int32 before = std::abs(da - ta) + std::abs(db - tb) + std::abs(dc - tc) + std::abs(dd - td);
+				const int32 after = std::abs(da - 1 - ta) + std::abs(db - 1 - tb) + std::abs(dc + 1 - tc) + std::abs(dd + 1 - td);
+				if (after >= before)
+					return false;
+				const uint32 emb_o = map.embedding(o);
+				bool adjacent = false;
+				map.foreach_adjacent_vertex_through_edge(c, [&] (Vertex u) -> bool
+				{
+					adjacent = map.embedding(u) == emb_o;
+					return !adjacent;
+				});
+				if (adjacent)
+					return false;
+				const VEC3& pa = position[a];
+				const VEC3& pb = position[b];
+				const VEC3& pc = position[c];
+				const VEC3& pd = position[o];
+				const VEC3 n = (pb - pa).cross(pc - pa) + (pa - pb).cross(pd - pb);
+				if ((pd - pa).cross(pc - pa).dot(n) <= Scalar(0) || (pc - pb).cross(pd - pb).dot(n) <= Scalar(0))
+					return false;
+				key = internal::remeshing_key(uint32(8 - (before - after)), map, e);
+				return true;
+			},
+			edge_vertices,
+			edge_vertices,
+			[&] (Edge e) -> Vertex
+			{
+				map.flip_edge(e);
+				return Vertex(e.dart); // an end of the new edge is adjacent to the 3 other vertices
+			}
+		);
+		lap(&IsotropicRemeshingStatistics::flip_time_);
+
+		// tangential smoothing
+		map.parallel_foreach_cell([&] (Vertex v)
+		{
+			const VEC3& p = position[v];
+			if (map.is_incident_to_boundary(v))
+			{
+				new_position[v] = p;
+				return;
+			}
+			VEC3 q(Scalar(0), Scalar(0), Scalar(0));
+			uint32 count = 0u;
+			map.foreach_adjacent_vertex_through_edge(v, [&] (Vertex u)
+			{
+				q += position[u];
+				++count;
+			});
+			q /= Scalar(count);
+			const VEC3 n = geometry::normal(map, v, position);
+			new_position[v] = q + n * n.dot(p - q);
+		});
+		map.swap_attributes(position, new_position);
+		lap(&IsotropicRemeshingStatistics::smooth_time_);
+
+		// projection onto the input surface
+		map.parallel_foreach_cell([&] (Vertex v)
+		{
+			typename geometry::FaceBVH<CMap2, VEC3>::Projection proj;
+			if (bvh.closest_point(position[v], proj))
+				position[v] = proj.point;
+		});
+		lap(&IsotropicRemeshingStatistics::project_time_);
+
+		if (statistics)
+		{
+			statistics->nb_splits_ += nb_splits;
+			statistics->nb_collapses_ += nb_collapses;
+			statistics->nb_flips_ += nb_flips;
+		}
+	}
+
+	map.remove_attribute(new_position);
+}
+
+#if defined(CGOGN_USE_EXTERNAL_TEMPLATES) && (!defined(CGOGN_MODELING_EXTERNAL_TEMPLATES_CPP_))
+extern template CGOGN_MODELING_API void isotropic_remeshing(CMap2&, CMap2::VertexAttribute<Eigen::Vector3f>&, float32, uint32, IsotropicRemeshingStatistics*);
+extern template CGOGN_MODELING_API void isotropic_remeshing(CMap2&, CMap2::VertexAttribute<Eigen::Vector3d>&, float64, uint32, IsotropicRemeshingStatistics*);
+#endif // defined(CGOGN_USE_EXTERNAL_TEMPLATES) && (!defined(CGOGN_MODELING_EXTERNAL_TEMPLATES_CPP_))
+
+} // namespace modeling
+
+} // namespace cgogn
+
+#endif // CGOGN_MODELING_ALGOS_ISOTROPIC_REMESHING_H_
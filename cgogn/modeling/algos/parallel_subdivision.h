@@ -0,0 +1,422 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef CGOGN_MODELING_ALGOS_PARALLEL_SUBDIVISION_H_
+#define CGOGN_MODELING_ALGOS_PARALLEL_SUBDIVISION_H_
+
+#include <vector>
+
+#include <cgogn/modeling/dll.h>
+#include <cgogn/core/cmap/cmap2.h>
+#include <cgogn/core/cmap/cmap2_quad.h>
+#include <cgogn/core/cmap/cmap2_tri.h>
+#include <cgogn/core/utils/parallel_foreach_element.h>
+#include <cgogn/geometry/types/geometry_traits.h>
+
+namespace cgogn
+{
+
+namespace modeling
+{
+
+namespace internal
+{
+
+/**
+ * \brief dense numbering of the vertices, edges and (non boundary) faces of a surface map
+ * and of the darts of each face (corners), used to emit a refined map with one new cell per old cell.
+ */
+template <typename MAP>
+class SurfaceCellIndexing
+{
+public:
+
+	using Vertex = typename MAP::Vertex;
+	using Edge = typename MAP::Edge;
+	using Face = typename MAP::Face;
+
+	SurfaceCellIndexing(const MAP& map) :
+		map_(map)
+	{
+		map.foreach_cell([&] (Vertex v) { vertices_.push_back(v.dart); });
+		map.foreach_cell([&] (Edge e) { edges_.push_back(e.dart); });
+		map.foreach_cell([&] (Face f) { faces_.push_back(f.dart); });
+
+		face_offsets_.resize(faces_.size() + 1u);
+		face_offsets_[0] = 0u;
+		for (uint32 f = 0u, end = nb_faces(); f < end; ++f)
+			face_offsets_[f + 1u] = face_offsets_[f] + map.codegree(Face(faces_[f]));
+
+		const uint32 nb_darts = map.topology_container().end();
+		dart_edge_.resize(nb_darts);
+		dart_face_.assign(nb_darts, INVALID_INDEX);
+		vertex_index_.resize(map.template attribute_container<Vertex::ORBIT>().end());
+
+		parallel_foreach_index(0u, nb_vertices(), [&] (uint32 v)
+		{
+			vertex_index_[map.embedding(Vertex(vertices_[v]))] = v;
+		});
+		parallel_foreach_index(0u, nb_edges(), [&] (uint32 e)
+		{
+			dart_edge_[edges_[e].index] = e;
+			dart_edge_[map.phi2(edges_[e]).index] = e;
+		});
+		parallel_foreach_index(0u, nb_faces(), [&] (uint32 f)
+		{
+			Dart d = faces_[f];
+			do
+			{
+				dart_face_[d.index] = f;
+				d = map.phi1(d);
+			} while (d != faces_[f]);
+		});
+	}
+
+	CGOGN_NOT_COPYABLE_NOR_MOVABLE(SurfaceCellIndexing);
+
+	inline uint32 nb_vertices() const { return uint32(vertices_.size()); }
+	inline uint32 nb_edges() const { return uint32(edges_.size()); }
+	inline uint32 nb_faces() const { return uint32(faces_.size()); }
+	inline uint32 nb_corners() const { return face_offsets_.back(); }
+
+	inline Dart vertex_dart(uint32 v) const { return vertices_[v]; }
+	inline Dart edge_dart(uint32 e) const { return edges_[e]; }
+	inline Dart face_dart(uint32 f) const { return faces_[f]; }
+	inline uint32 face_offset(uint32 f) const { return face_offsets_[f]; }
+
+	inline uint32 vertex(Dart d) const { return vertex_index_[map_.embedding(Vertex(d))]; }
+	inline uint32 edge(Dart d) const { return dart_edge_[d.index]; }
+	/// INVALID_INDEX for the boundary darts
+	inline uint32 face(Dart d) const { return dart_face_[d.index]; }
+
+private:
+
+	const MAP& map_;
+	std::vector<Dart> vertices_;
+	std::vector<Dart> edges_;
+	std::vector<Dart> faces_;
+	std::vector<uint32> face_offsets_;
+	std::vector<uint32> dart_edge_;
+	std::vector<uint32> dart_face_;
+	std::vector<uint32> vertex_index_;
+};
+
+template <typename MAP, typename VERTEX_ATTR>
+void catmull_clark_level(const MAP& src, const VERTEX_ATTR& position, CMap2Quad& dst, VERTEX_ATTR& dst_position)
+{
+	using VEC3 = InsideTypeOf<VERTEX_ATTR>;
+	using Scalar = geometry::ScalarOf<VEC3>;
+	using Vertex = typename MAP::Vertex;
+	using Face = typename MAP::Face;
+
+	const SurfaceCellIndexing<MAP> cells(src);
+	const uint32 nb_v = cells.nb_vertices();
+	const uint32 nb_e = cells.nb_edges();
+	const uint32 nb_f = cells.nb_faces();
+
+	// vertex, edge and face points are numbered in this order
+	std::vector<uint32> quads(4u * cells.nb_corners());
+	parallel_foreach_index(0u, nb_f, [&] (uint32 f)
+	{
+		const uint32 fp = nb_v + nb_e + f;
+		uint32* q = &quads[4u * cells.face_offset(f)];
+		const Dart first = cells.face_dart(f);
+		Dart d = first;
+		do
+		{
+			q[0] = cells.vertex(d);
+			q[1] = nb_v + cells.edge(d);
+			q[2] = fp;
+			q[3] = nb_v + cells.edge(src.phi_1(d));
+			q += 4u;
+			d = src.phi1(d);
+		} while (d != first);
+	});
+
+	CMap2Quad::Builder builder(dst);
+	const uint32 first = builder.create_faces_from_indices(quads, nb_v + nb_e + nb_f);
+	if (first == INVALID_INDEX)
+		return;
+	const uint32 first_edge_point = first + nb_v;
+	const uint32 first_face_point = first + nb_v + nb_e;
+
+	// face points
+	parallel_foreach_index(0u, nb_f, [&] (uint32 f)
+	{
+		VEC3 center;
+		center.setZero();
+		uint32 count = 0u;
+		src.foreach_incident_vertex(Face(cells.face_dart(f)), [&] (Vertex v)
+		{
+			center += position[v];
+			++count;
+		});
+		center /= Scalar(count);
+		dst_position[first_face_point + f] = center;
+	});
+
+	// edge points
+	parallel_foreach_index(0u, nb_e, [&] (uint32 e)
+	{
+		const Dart d = cells.edge_dart(e);
+		const Dart d2 = src.phi2(d);
+		VEC3 p = position[Vertex(d)] + position[Vertex(d2)];
+		const uint32 f1 = cells.face(d);
+		const uint32 f2 = cells.face(d2);
+		if (f1 != INVALID_INDEX && f2 != INVALID_INDEX)
+		{
+			p += dst_position[first_face_point + f1];
+			p += dst_position[first_face_point + f2];
+			p /= Scalar(4);
+		}
+		else
+			p /= Scalar(2);
+		dst_position[first_edge_point + e] = p;
+	});
+
+	// vertex points
+	parallel_foreach_index(0u, nb_v, [&] (uint32 v)
+	{
+		const Vertex vertex(cells.vertex_dart(v));
+		const VEC3& pos = position[vertex];
+
+		VEC3 sum_face;
+		sum_face.setZero();
+		VEC3 sum_edge;
+		sum_edge.setZero();
+		uint32 nb_faces = 0u;
+		uint32 nb_boundary = 0u;
+		VEC3 sum_boundary;
+		sum_boundary.setZero();
+
+		// (the darts of the vertex orbit start from the vertex and belong to distinct edges)
+		src.foreach_dart_of_orbit(vertex, [&] (Dart d)
+		{
+			const VEC3& ep = dst_position[first_edge_point + cells.edge(d)];
+			sum_edge += ep;
+			const uint32 f = cells.face(d);
+			if (f != INVALID_INDEX)
+			{
+				sum_face += dst_position[first_face_point + f];
+				++nb_faces;
+			}
+			if (f == INVALID_INDEX || cells.face(src.phi2(d)) == INVALID_INDEX)
+			{
+				sum_boundary += ep;
+				++nb_boundary;
+			}
+		});
+
+		// boundary case: the boundary edge points are midpoints, so this is 3/4 p + 1/8 (a + b)
+		if (nb_boundary > 0u)
+			dst_position[first + v] = Scalar(0.5) * pos + Scalar(0.25) * sum_boundary;
+		else
+		{
+			VEC3 delta = pos * Scalar(-3 * int32(nb_faces));
+			delta += sum_face + Scalar(2) * sum_edge;
+			delta /= Scalar(nb_faces * nb_faces);
+			dst_position[first + v] = pos + delta;
+		}
+	});
+}
+
+template <typename MAP, typename VERTEX_ATTR>
+void loop_level(const MAP& src, const VERTEX_ATTR& position, CMap2Tri& dst, VERTEX_ATTR& dst_position)
+{
+	using VEC3 = InsideTypeOf<VERTEX_ATTR>;
+	using Scalar = geometry::ScalarOf<VEC3>;
+	using Vertex = typename MAP::Vertex;
+
+	const SurfaceCellIndexing<MAP> cells(src);
+	const uint32 nb_v = cells.nb_vertices();
+	const uint32 nb_e = cells.nb_edges();
+	const uint32 nb_f = cells.nb_faces();
+	cgogn_message_assert(cells.nb_corners() == 3u * nb_f, "parallel_loop: the map must be a triangle mesh");
+
+	// vertex points then edge points
+	std::vector<uint32> triangles(12u * nb_f);
+	parallel_foreach_index(0u, nb_f, [&] (uint32 f)
+	{
+		const Dart d0 = cells.face_dart(f);
+		const Dart d1 = src.phi1(d0);
+		const Dart d2 = src.phi1(d1);
+		const uint32 v0 = cells.vertex(d0), v1 = cells.vertex(d1), v2 = cells.vertex(d2);
+		const uint32 m0 = nb_v + cells.edge(d0), m1 = nb_v + cells.edge(d1), m2 = nb_v + cells.edge(d2);
+		uint32* t = &triangles[12u * f];
+		t[0] = v0; t[1] = m0; t[2] = m2;
+		t[3] = v1; t[4] = m1; t[5] = m0;
+		t[6] = v2; t[7] = m2; t[8] = m1;
+		t[9] = m0; t[10] = m1; t[11] = m2;
+	});
+
+	CMap2Tri::Builder builder(dst);
+	const uint32 first = builder.create_faces_from_indices(triangles, nb_v + nb_e);
+	if (first == INVALID_INDEX)
+		return;
+	const uint32 first_edge_point = first + nb_v;
+
+	// edge points
+	parallel_foreach_index(0u, nb_e, [&] (uint32 e)
+	{
+		const Dart d = cells.edge_dart(e);
+		const Dart d2 = src.phi2(d);
+		const VEC3& p1 = position[Vertex(d)];
+		const VEC3& p2 = position[Vertex(d2)];
+		if (cells.face(d) != INVALID_INDEX && cells.face(d2) != INVALID_INDEX)
+		{
+			const VEC3& pl = position[Vertex(src.phi_1(d))];
+			const VEC3& pr = position[Vertex(src.phi_1(d2))];
+			dst_position[first_edge_point + e] = Scalar(3.0/8.0) * (p1 + p2) + Scalar(1.0/8.0) * (pr + pl);
+		}
+		else
+			dst_position[first_edge_point + e] = Scalar(0.5) * (p1 + p2);
+	});
+
+	// vertex points
+	parallel_foreach_index(0u, nb_v, [&] (uint32 v)
+	{
+		const Vertex vertex(cells.vertex_dart(v));
+		const VEC3& pos = position[vertex];
+
+		VEC3 sum_edge;
+		sum_edge.setZero();
+		int nb_edges = 0;
+		VEC3 sum_boundary;
+		sum_boundary.setZero();
+		bool boundary = false;
+
+		// (the darts of the vertex orbit start from the vertex and belong to distinct edges)
+		src.foreach_dart_of_orbit(vertex, [&] (Dart d)
+		{
+			++nb_edges;
+			const VEC3& p = position[Vertex(src.phi1(d))];
+			sum_edge += p;
+			if (cells.face(d) == INVALID_INDEX || cells.face(src.phi2(d)) == INVALID_INDEX)
+			{
+				sum_boundary += p;
+				boundary = true;
+			}
+		});
+
+		if (boundary)
+			dst_position[first + v] = Scalar(3.0/4.0) * pos + Scalar(1.0/8.0) * sum_boundary;
+		else
+		{
+			float64 beta = 3.0 / 16.0;
+			if (nb_edges > 3)
+				beta = 3.0 / (8.0 * nb_edges);
+			dst_position[first + v] = Scalar(beta) * sum_edge + Scalar(1.0 - beta * nb_edges) * pos;
+		}
+	});
+}
+
+struct CatmullClarkLevel
+{
+	template <typename MAP, typename VERTEX_ATTR>
+	void operator()(const MAP& src, const VERTEX_ATTR& position, CMap2Quad& dst, VERTEX_ATTR& dst_position) const
+	{
+		catmull_clark_level(src, position, dst, dst_position);
+	}
+};
+
+struct LoopLevel
+{
+	template <typename MAP, typename VERTEX_ATTR>
+	void operator()(const MAP& src, const VERTEX_ATTR& position, CMap2Tri& dst, VERTEX_ATTR& dst_position) const
+	{
+		loop_level(src, position, dst, dst_position);
+	}
+};
+
+/**
+ * \brief apply a single-level subdivision nb_levels times, the intermediate levels are built in two temporary maps
+ */
+template <typename DST_MAP, typename MAP, typename VERTEX_ATTR, typename LEVEL>
+void subdivide_levels(const MAP& src, const VERTEX_ATTR& position, DST_MAP& dst, VERTEX_ATTR& dst_position, uint32 nb_levels, const LEVEL& level)
+{
+	using VEC3 = InsideTypeOf<VERTEX_ATTR>;
+	using DstVertex = typename DST_MAP::Vertex;
+
+	if (nb_levels <= 1u)
+	{
+		level(src, position, dst, dst_position);
+		return;
+	}
+
+	DST_MAP tmp[2];
+	VERTEX_ATTR tmp_position[2] = {
+		tmp[0].template add_attribute<VEC3, DstVertex>(dst_position.name()),
+		tmp[1].template add_attribute<VEC3, DstVertex>(dst_position.name())
+	};
+
+	level(src, position, tmp[0], tmp_position[0]);
+	for (uint32 l = 1u; l + 1u < nb_levels; ++l)
+	{
+		tmp[l % 2u].clear();
+		level(tmp[(l - 1u) % 2u], tmp_position[(l - 1u) % 2u], tmp[l % 2u], tmp_position[l % 2u]);
+	}
+	level(tmp[nb_levels % 2u], tmp_position[nb_levels % 2u], dst, dst_position);
+}
+
+} // namespace internal
+
+/**
+ * \brief Catmull-Clark subdivision of src emitted in the quad map dst (the faces are added to dst).
+ * The refined topology is known from the cells of src: one vertex per vertex, edge and face of src,
+ * one quad per corner of the faces of src. The quads are created at once (CMap2Quad::Builder::create_faces_from_indices)
+ * and the positions are computed in parallel with the same stencils as catmull_clark.
+ * @param src the map to subdivide (not modified)
+ * @param position vertex positions of src
+ * @param dst quad map receiving the subdivided surface
+ * @param dst_position vertex positions of dst
+ * @param nb_levels number of subdivision levels (the intermediate levels are built in temporary maps)
+ */
+template <typename MAP, typename VERTEX_ATTR>
+void parallel_catmull_clark(const MAP& src, const VERTEX_ATTR& position, CMap2Quad& dst, VERTEX_ATTR& dst_position, uint32 nb_levels = 1u)
+{
+	static_assert(is_orbit_of<VERTEX_ATTR, MAP::Vertex::ORBIT>::value,"position must be a vertex attribute");
+	internal::subdivide_levels(src, position, dst, dst_position, nb_levels, internal::CatmullClarkLevel());
+}
+
+/**
+ * \brief Loop subdivision of the triangle mesh src emitted in the triangle map dst (the faces are added to dst).
+ * One vertex per vertex and edge of src, four triangles per triangle of src, created at once
+ * (CMap2Tri::Builder::create_faces_from_indices); the positions are computed in parallel with the same stencils as loop.
+ * @param src the triangle mesh to subdivide (not modified)
+ * @param position vertex positions of src
+ * @param dst triangle map receiving the subdivided surface
+ * @param dst_position vertex positions of dst
+ * @param nb_levels number of subdivision levels (the intermediate levels are built in temporary maps)
+ */
+template <typename MAP, typename VERTEX_ATTR>
+void parallel_loop(const MAP& src, const VERTEX_ATTR& position, CMap2Tri& dst, VERTEX_ATTR& dst_position, uint32 nb_levels = 1u)
+{
+	static_assert(is_orbit_of<VERTEX_ATTR, MAP::Vertex::ORBIT>::value,"position must be a vertex attribute");
+	internal::subdivide_levels(src, position, dst, dst_position, nb_levels, internal::LoopLevel());
+}
+
+} // namespace modeling
+
+} // namespace cgogn
+
+#endif // CGOGN_MODELING_ALGOS_PARALLEL_SUBDIVISION_H_
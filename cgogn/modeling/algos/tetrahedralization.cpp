@@ -358,6 +358,8 @@ CGOGN_MODELING_API Dart swap_gen_32(CMap3& map, CMap3::Edge e)
 }
 
 //template CGOGN_MODELING_API std::vector<Dart> swap_gen_32_optimized<Eigen::Vector3f>(CMap3&, CMap3::Edge);
+template CGOGN_MODELING_API uint32 tetrahedralize(const CMap3&, const CMap3::VertexAttribute<Eigen::Vector3f>&, CMap3Tetra&, CMap3Tetra::VertexAttribute<Eigen::Vector3f>&);
+template CGOGN_MODELING_API uint32 tetrahedralize(const CMap3&, const CMap3::VertexAttribute<Eigen::Vector3d>&, CMap3Tetra&, CMap3Tetra::VertexAttribute<Eigen::Vector3d>&);
 
 } // namespace modeling
 
@@ -24,6 +24,9 @@
 #ifndef CGOGN_MODELING_ALGOS_TETRAHEDRALIZATION_H_
 #define CGOGN_MODELING_ALGOS_TETRAHEDRALIZATION_H_
 
+#include <cgogn/core/cmap/cmap3_tetra.h>
+#include <cgogn/core/utils/parallel_foreach_element.h>
+
 #include <cgogn/modeling/algos/refinements.h>
 #include <cgogn/geometry/algos/ear_triangulation.h>
 
@@ -93,8 +96,124 @@ CGOGN_MODELING_API Dart swap_gen_32(CMap3& map, CMap3::Edge e);
 
 //void swapGen2To3(CMap3& map, typename CMap3::Volume d);
 
+namespace internal
+{
+
+/**
+ * \brief tetrahedra of the volume of w: each face that is not incident to the smallest vertex v of the volume
+ * is fanned from its own smallest vertex and each triangle is joined to v (6 tetrahedra for a hexahedron).
+ * The fan of a face only depends on its vertices, so the two volumes of an inner face split it along the same diagonals.
+ * @param index global index of the vertex of a dart
+ * @param tetras if not null, receives 4 indices per tetrahedron: the triangle in the phi1 order of the volume, then v
+ * @return the number of tetrahedra
+ */
+template <typename MAP, typename INDEX>
+uint32 cone_tetrahedra(const MAP& map, Dart w, const INDEX& index, uint32* tetras)
+{
+	using Volume = typename MAP::Volume;
+
+	uint32 apex = index(w);
+	map.foreach_dart_of_orbit(Volume(w), [&] (Dart d) { apex = std::min(apex, index(d)); });
+
+	uint32 nb = 0u;
+	map.foreach_dart_of_orbit(Volume(w), [&] (Dart d)
+	{
+		// the face is fanned once, from the dart of its smallest vertex
+		const uint32 i = index(d);
+		if (i == apex)
+			return;
+		for (Dart it = map.phi1(d); it != d; it = map.phi1(it))
+		{
+			const uint32 j = index(it);
+			if (j < i || j == apex)
+				return;
+		}
+
+		for (Dart it = map.phi1(d); map.phi1(it) != d; it = map.phi1(it))
+		{
+			if (tetras)
+			{
+				tetras[0] = i;
+				tetras[1] = index(it);
+				tetras[2] = index(map.phi1(it));
+				tetras[3] = apex;
+				tetras += 4u;
+			}
+			++nb;
+		}
+	});
+	return nb;
+}
+
+} // namespace internal
+
+/**
+ * \brief tetrahedralization of the volumes of src (hexahedra, prisms, pyramids or any convex polyhedra) emitted in the tetrahedral map dst.
+ * The face diagonals are chosen with a rule on the global vertex indices (fan from the smallest vertex of each face,
+ * cone from the smallest vertex of each volume), so the neighbouring volumes agree without any exchange and the result is conforming.
+ * The tetrahedra are counted and written in parallel, then created at once (CMap3Tetra::Builder::create_volumes_from_indices)
+ * and they keep the orientation of their volume.
+ * @param src the map to tetrahedralize (not modified)
+ * @param position vertex positions of src
+ * @param dst tetrahedral map receiving the tetrahedra (they are added to dst)
+ * @param dst_position vertex positions of dst (an attribute of dst with the type of position)
+ * @return the number of created tetrahedra
+ */
+template <typename MAP, typename VERTEX_ATTR>
+uint32 tetrahedralize(const MAP& src, const VERTEX_ATTR& position, CMap3Tetra& dst, CMap3Tetra::VertexAttribute<InsideTypeOf<VERTEX_ATTR>>& dst_position)
+{
+	static_assert(MAP::DIMENSION == 3, "tetrahedralize: src must be a volume map");
+	static_assert(is_orbit_of<VERTEX_ATTR, MAP::Vertex::ORBIT>::value,"position must be a vertex attribute");
+	using Vertex = typename MAP::Vertex;
+	using Volume = typename MAP::Volume;
+
+	std::vector<Dart> vertices;
+	std::vector<Dart> volumes;
+	src.foreach_cell([&] (Vertex v) { vertices.push_back(v.dart); });
+	src.foreach_cell([&] (Volume w) { volumes.push_back(w.dart); });
+	const uint32 nb_vertices = uint32(vertices.size());
+	const uint32 nb_volumes = uint32(volumes.size());
+	if (nb_volumes == 0u)
+		return 0u;
+
+	std::vector<uint32> vertex_index(src.template attribute_container<Vertex::ORBIT>().end());
+	parallel_foreach_index(0u, nb_vertices, [&] (uint32 v)
+	{
+		vertex_index[src.embedding(Vertex(vertices[v]))] = v;
+	});
+	auto index = [&] (Dart d) { return vertex_index[src.embedding(Vertex(d))]; };
+
+	std::vector<uint32> offsets(nb_volumes + 1u);
+	offsets[0] = 0u;
+	parallel_foreach_index(0u, nb_volumes, [&] (uint32 w)
+	{
+		offsets[w + 1u] = internal::cone_tetrahedra(src, volumes[w], index, nullptr);
+	});
+	for (uint32 w = 0u; w < nb_volumes; ++w)
+		offsets[w + 1u] += offsets[w];
+
+	std::vector<uint32> tetras(4u * offsets.back());
+	parallel_foreach_index(0u, nb_volumes, [&] (uint32 w)
+	{
+		internal::cone_tetrahedra(src, volumes[w], index, tetras.data() + 4u * offsets[w]);
+	});
+
+	CMap3Tetra::Builder builder(dst);
+	const uint32 first = builder.create_volumes_from_indices(tetras, nb_vertices);
+	if (first == INVALID_INDEX)
+		return 0u;
+	parallel_foreach_index(0u, nb_vertices, [&] (uint32 v)
+	{
+		dst_position[first + v] = position[Vertex(vertices[v])];
+	});
+
+	return offsets.back();
+}
+
 #if defined(CGOGN_USE_EXTERNAL_TEMPLATES) && (!defined(CGOGN_MODELING_ALGOS_TETRAHEDRALIZATION_CPP_))
 //extern template CGOGN_MODELING_API std::vector<Dart> swap_gen_32_optimized<Eigen::Vector3f>(CMap3&, CMap3::Edge);
+extern template CGOGN_MODELING_API uint32 tetrahedralize(const CMap3&, const CMap3::VertexAttribute<Eigen::Vector3f>&, CMap3Tetra&, CMap3Tetra::VertexAttribute<Eigen::Vector3f>&);
+extern template CGOGN_MODELING_API uint32 tetrahedralize(const CMap3&, const CMap3::VertexAttribute<Eigen::Vector3d>&, CMap3Tetra&, CMap3Tetra::VertexAttribute<Eigen::Vector3d>&);
 #endif // defined(CGOGN_USE_EXTERNAL_TEMPLATES) && (!defined(CGOGN_MODELING_ALGOS_TETRAHEDRALIZATION_CPP_))
 
 } // namespace modeling
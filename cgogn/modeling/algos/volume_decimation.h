@@ -0,0 +1,159 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef CGOGN_MODELING_ALGOS_VOLUME_DECIMATION_H_
+#define CGOGN_MODELING_ALGOS_VOLUME_DECIMATION_H_
+
+#include <cgogn/modeling/dll.h>
+
+#include <cgogn/geometry/functions/predicates.h>
+#include <cgogn/geometry/types/geometry_traits.h>
+
+#include <cgogn/core/cmap/cmap3.h>
+#include <cgogn/core/cmap/cmap3_tetra.h>
+
+#include <cgogn/modeling/decimation/edge_traversor_tetra_edge_length.h>
+
+namespace cgogn
+{
+
+namespace modeling
+{
+
+enum VolumeBoundaryConstraint
+{
+	VolumeBoundary_Fixed = 0,	// the boundary vertices do not move, interior vertices can be collapsed onto them
+	VolumeBoundary_Locked		// the edges incident to a boundary vertex are not collapsed
+};
+
+namespace internal
+{
+
+/**
+ * \brief check that moving the vertices of the edge of d to new_position does not flip or flatten a tetrahedron
+ * The tetrahedra incident to only one of the two vertices must keep the sign of their orientation
+ * (the tetrahedra incident to the edge are removed by the collapse).
+ */
+template <typename MAP, typename VERTEX_ATTR>
+bool collapse_preserves_orientation(const MAP& map, const VERTEX_ATTR& position, Dart d, const InsideTypeOf<VERTEX_ATTR>& new_position)
+{
+	using Vertex = typename MAP::Vertex;
+
+	const Vertex v[2] = { Vertex(d), Vertex(map.phi1(d)) };
+	bool result = true;
+	for (uint32 i = 0u; i < 2u && result; ++i)
+	{
+		const uint32 other = map.embedding(v[1u - i]);
+		map.foreach_dart_of_orbit(v[i], [&] (Dart vd) -> bool
+		{
+			if (map.is_boundary(vd))
+				return true;
+			const Vertex v1(map.phi1(vd));
+			const Vertex v2(map.phi_1(vd));
+			const Vertex v3(map.phi_1(map.phi2(vd)));
+			if (map.embedding(v1) == other || map.embedding(v2) == other || map.embedding(v3) == other)
+				return true;
+			const float64 before = geometry::orient3d(position[v[i]], position[v1], position[v2], position[v3]);
+			const float64 after = geometry::orient3d(new_position, position[v1], position[v2], position[v3]);
+			result = after != 0.0 && (after > 0.0) == (before > 0.0);
+			return result;
+		});
+	}
+	return result;
+}
+
+} // namespace internal
+
+/**
+ * \brief decimate a tetrahedral mesh by collapsing its shortest edges first
+ * An edge is collapsed onto its midpoint, or onto its boundary vertex, if it satisfies the link condition
+ * (see edge_can_collapse) and if no remaining tetrahedron is inverted or flattened by the collapse.
+ * The boundary is never modified: edges whose both vertices are on the boundary are not collapsed.
+ * @param map the map to decimate (all its volumes are tetrahedra)
+ * @param position vertex positions
+ * @param nb the maximal number of collapses
+ * @param boundary the constraint on the vertices of the boundary
+ * @return the number of collapsed edges
+ */
+template <typename MAP, typename VERTEX_ATTR>
+uint32 decimate_volume(
+	MAP& map,
+	VERTEX_ATTR& position,
+	uint32 nb,
+	VolumeBoundaryConstraint boundary = VolumeBoundary_Fixed
+)
+{
+	static_assert(is_orbit_of<VERTEX_ATTR, MAP::Vertex::ORBIT>::value,"position must be a vertex attribute");
+
+	using VEC3 = InsideTypeOf<VERTEX_ATTR>;
+	using Scalar = geometry::ScalarOf<VEC3>;
+	using Vertex = typename MAP::Vertex;
+	using Edge = typename MAP::Edge;
+
+	if (nb == 0u)
+		return 0u;
+
+	EdgeTraversor_TetraEdgeLength<MAP, VEC3> trav(map, position, boundary == VolumeBoundary_Locked);
+
+	uint32 count = 0u;
+	map.foreach_cell(
+		[&] (Edge e) -> bool
+		{
+			// the collapsed edge starts from the vertex that is kept
+			const Dart d = trav.is_boundary(Vertex(map.phi1(e.dart))) ? map.phi2(e.dart) : e.dart;
+			const Vertex v1(d);
+			const Vertex v2(map.phi1(d));
+			const VEC3 new_position = trav.is_boundary(v1) ? position[v1] : VEC3(Scalar(0.5) * (position[v1] + position[v2]));
+
+			if (!map.edge_can_collapse(Edge(d)) || !internal::collapse_preserves_orientation(map, position, d, new_position))
+			{
+				trav.remove(e);
+				return true;
+			}
+
+			trav.pre_collapse(Edge(d));
+			const Vertex v = map.collapse_edge(Edge(d));
+			position[v] = new_position;
+			trav.post_collapse(v);
+
+			++count;
+			return count < nb;
+		},
+		trav
+	);
+
+	return count;
+}
+
+#if defined(CGOGN_USE_EXTERNAL_TEMPLATES) && (!defined(CGOGN_MODELING_EXTERNAL_TEMPLATES_CPP_))
+extern template CGOGN_MODELING_API uint32 decimate_volume(CMap3&, CMap3::VertexAttribute<Eigen::Vector3f>&, uint32, VolumeBoundaryConstraint);
+extern template CGOGN_MODELING_API uint32 decimate_volume(CMap3&, CMap3::VertexAttribute<Eigen::Vector3d>&, uint32, VolumeBoundaryConstraint);
+extern template CGOGN_MODELING_API uint32 decimate_volume(CMap3Tetra&, CMap3Tetra::VertexAttribute<Eigen::Vector3f>&, uint32, VolumeBoundaryConstraint);
+extern template CGOGN_MODELING_API uint32 decimate_volume(CMap3Tetra&, CMap3Tetra::VertexAttribute<Eigen::Vector3d>&, uint32, VolumeBoundaryConstraint);
+#endif // defined(CGOGN_USE_EXTERNAL_TEMPLATES) && (!defined(CGOGN_MODELING_EXTERNAL_TEMPLATES_CPP_))
+
+} // namespace modeling
+
+} // namespace cgogn
+
+#endif // CGOGN_MODELING_ALGOS_VOLUME_DECIMATION_H_
@@ -0,0 +1,355 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef CGOGN_MODELING_DECIMATION_EDGE_QUEUE_H_
+#define CGOGN_MODELING_DECIMATION_EDGE_QUEUE_H_
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <cgogn/core/utils/definitions.h>
+#include <cgogn/core/utils/numerics.h>
+
+namespace cgogn
+{
+
+namespace modeling
+{
+
+/**
+ * Priority queues of edges used by the cost driven edge traversors.
+ * They all provide the same interface:
+ * - update(e, cost) inserts e or changes its cost
+ * - remove(e) removes e if it is in the queue
+ * - empty() / top() give access to the edge of minimal cost
+ * The per-edge bookkeeping is stored in an edge attribute named after the given prefix.
+ */
+
+/**
+ * \brief queue backed by a std::multimap, the edge attribute stores the iterators.
+ * Every update allocates and rebalances a tree node.
+ */
+template <typename MAP, typename Scalar>
+class EdgeQueue_Multimap
+{
+public:
+
+	using Edge = typename MAP::Edge;
+
+	struct EdgeInfo
+	{
+		typename std::multimap<Scalar, Edge>::const_iterator it_;
+		bool valid_;
+
+		EdgeInfo() : valid_(false) {}
+
+		friend std::ostream& operator<<(std::ostream& out, const EdgeInfo&) { return out; }
+		friend std::istream& operator>>(std::istream& in, const EdgeInfo&) { return in; }
+	};
+
+	CGOGN_NOT_COPYABLE_NOR_MOVABLE(EdgeQueue_Multimap);
+
+	inline EdgeQueue_Multimap(MAP& m, const std::string& prefix) :
+		map_(m)
+	{
+		einfo_ = map_.template add_attribute<EdgeInfo, Edge>(prefix + "_EdgeInfo");
+	}
+
+	~EdgeQueue_Multimap()
+	{
+		map_.remove_attribute(einfo_);
+	}
+
+	inline bool empty() const { return edges_.empty(); }
+	inline uint32 size() const { return uint32(edges_.size()); }
+	inline Edge top() const { return edges_.begin()->second; }
+	inline bool contains(Edge e) const { return einfo_[e].valid_; }
+
+	void update(Edge e, Scalar cost)
+	{
+		EdgeInfo& ei = einfo_[e];
+		if (ei.valid_)
+			edges_.erase(ei.it_);
+		ei.it_ = edges_.insert(std::make_pair(cost, e));
+		ei.valid_ = true;
+	}
+
+	void remove(Edge e)
+	{
+		EdgeInfo& ei = einfo_[e];
+		if (ei.valid_) { edges_.erase(ei.it_); ei.valid_ = false; }
+	}
+
+private:
+
+	MAP& map_;
+	typename MAP::template EdgeAttribute<EdgeInfo> einfo_;
+	std::multimap<Scalar, Edge> edges_;
+};
+
+/**
+ * \brief queue backed by a flat 4-ary min-heap.
+ * The edge attribute stores the position of each edge in the heap (INVALID_INDEX when absent),
+ * so that its cost can be decreased or increased in place and the edge removed in O(log n).
+ */
+template <typename MAP, typename Scalar>
+class EdgeQueue_IndexedHeap
+{
+public:
+
+	using Edge = typename MAP::Edge;
+
+	static const uint32 ARITY = 4u;
+
+	CGOGN_NOT_COPYABLE_NOR_MOVABLE(EdgeQueue_IndexedHeap);
+
+	inline EdgeQueue_IndexedHeap(MAP& m, const std::string& prefix) :
+		map_(m)
+	{
+		position_ = map_.template add_attribute<uint32, Edge>(prefix + "_HeapPosition");
+		position_.set_all_values(INVALID_INDEX);
+		heap_.reserve(map_.template nb_cells<Edge::ORBIT>());
+	}
+
+	~EdgeQueue_IndexedHeap()
+	{
+		map_.remove_attribute(position_);
+	}
+
+	inline bool empty() const { return heap_.empty(); }
+	inline uint32 size() const { return uint32(heap_.size()); }
+	inline Edge top() const { return heap_.front().edge_; }
+	inline bool contains(Edge e) const { return position_[e] != INVALID_INDEX; }
+
+	void update(Edge e, Scalar cost)
+	{
+		const uint32 index = map_.embedding(e);
+		const uint32 pos = position_[index];
+		if (pos == INVALID_INDEX)
+		{
+			heap_.push_back(Entry(cost, index, e));
+			sift_up(uint32(heap_.size()) - 1u);
+		}
+		else
+		{
+			Entry& entry = heap_[pos];
+			const Scalar old_cost = entry.cost_;
+			entry.cost_ = cost;
+			entry.edge_ = e;
+			if (cost < old_cost)
+				sift_up(pos);
+			else
+				sift_down(pos);
+		}
+	}
+
+	void remove(Edge e)
+	{
+		const uint32 index = map_.embedding(e);
+		const uint32 pos = position_[index];
+		if (pos == INVALID_INDEX)
+			return;
+
+		position_[index] = INVALID_INDEX;
+		const uint32 last = uint32(heap_.size()) - 1u;
+		if (pos != last)
+		{
+			const Scalar old_cost = heap_[pos].cost_;
+			heap_[pos] = heap_[last];
+			heap_.pop_back();
+			if (heap_[pos].cost_ < old_cost)
+				sift_up(pos);
+			else
+				sift_down(pos);
+		}
+		else
+			heap_.pop_back();
+	}
+
+private:
+
+	struct Entry
+	{
+		Scalar cost_;
+		uint32 index_;
+		Edge edge_;
+
+		inline Entry(Scalar cost, uint32 index, Edge e) : cost_(cost), index_(index), edge_(e) {}
+	};
+
+	void sift_up(uint32 pos)
+	{
+		const Entry entry = heap_[pos];
+		while (pos > 0u)
+		{
+			const uint32 parent = (pos - 1u) / ARITY;
+			if (!(entry.cost_ < heap_[parent].cost_))
+				break;
+			heap_[pos] = heap_[parent];
+			position_[heap_[pos].index_] = pos;
+			pos = parent;
+		}
+		heap_[pos] = entry;
+		position_[entry.index_] = pos;
+	}
+
+	void sift_down(uint32 pos)
+	{
+		const Entry entry = heap_[pos];
+		const uint32 size = uint32(heap_.size());
+		for (;;)
+		{
+			const uint32 first = pos * ARITY + 1u;
+			if (first >= size)
+				break;
+			const uint32 last = std::min(first + ARITY, size);
+			uint32 child = first;
+			for (uint32 c = first + 1u; c < last; ++c)
+				if (heap_[c].cost_ < heap_[child].cost_)
+					child = c;
+			if (!(heap_[child].cost_ < entry.cost_))
+				break;
+			heap_[pos] = heap_[child];
+			position_[heap_[pos].index_] = pos;
+			pos = child;
+		}
+		heap_[pos] = entry;
+		position_[entry.index_] = pos;
+	}
+
+	MAP& map_;
+	typename MAP::template EdgeAttribute<uint32> position_;
+	std::vector<Entry> heap_;
+};
+
+/**
+ * \brief queue backed by a flat binary min-heap with lazy deletion.
+ * Updates push a new entry and never move the older ones: the edge attribute stores a version stamp
+ * and an entry is only valid while its stamp is the current one. An odd stamp means that the edge is in the queue.
+ * Stale entries are dropped when they reach the top, and the heap is compacted when they outnumber the live ones.
+ */
+template <typename MAP, typename Scalar>
+class EdgeQueue_LazyHeap
+{
+public:
+
+	using Edge = typename MAP::Edge;
+
+	CGOGN_NOT_COPYABLE_NOR_MOVABLE(EdgeQueue_LazyHeap);
+
+	inline EdgeQueue_LazyHeap(MAP& m, const std::string& prefix) :
+		map_(m),
+		nb_live_(0u)
+	{
+		stamp_ = map_.template add_attribute<uint32, Edge>(prefix + "_HeapStamp");
+		stamp_.set_all_values(0u);
+		heap_.reserve(2u * map_.template nb_cells<Edge::ORBIT>());
+	}
+
+	~EdgeQueue_LazyHeap()
+	{
+		map_.remove_attribute(stamp_);
+	}
+
+	inline bool empty() const { return heap_.empty(); }
+	inline uint32 size() const { return nb_live_; }
+	inline Edge top() const { return heap_.front().edge_; }
+	inline bool contains(Edge e) const { return (stamp_[e] & 1u) != 0u; }
+
+	void update(Edge e, Scalar cost)
+	{
+		const uint32 index = map_.embedding(e);
+		uint32& stamp = stamp_[index];
+		if (stamp & 1u)
+			stamp += 2u;
+		else
+		{
+			stamp += 1u;
+			++nb_live_;
+		}
+		heap_.push_back(Entry(cost, stamp, index, e));
+		std::push_heap(heap_.begin(), heap_.end(), greater_cost);
+		clean();
+	}
+
+	void remove(Edge e)
+	{
+		uint32& stamp = stamp_[e];
+		if (stamp & 1u)
+		{
+			stamp += 1u;
+			--nb_live_;
+			clean();
+		}
+	}
+
+private:
+
+	struct Entry
+	{
+		Scalar cost_;
+		uint32 stamp_;
+		uint32 index_;
+		Edge edge_;
+
+		inline Entry(Scalar cost, uint32 stamp, uint32 index, Edge e) : cost_(cost), stamp_(stamp), index_(index), edge_(e) {}
+	};
+
+	static inline bool greater_cost(const Entry& a, const Entry& b)
+	{
+		return b.cost_ < a.cost_;
+	}
+
+	inline bool is_stale(const Entry& entry) const
+	{
+		return entry.stamp_ != stamp_[entry.index_];
+	}
+
+	// keep a valid entry at the top (if any) so that top() can stay const
+	void clean()
+	{
+		if (heap_.size() > 2u * nb_live_ + 1024u)
+		{
+			heap_.erase(std::remove_if(heap_.begin(), heap_.end(), [&] (const Entry& entry) { return is_stale(entry); }), heap_.end());
+			std::make_heap(heap_.begin(), heap_.end(), greater_cost);
+		}
+		while (!heap_.empty() && is_stale(heap_.front()))
+		{
+			std::pop_heap(heap_.begin(), heap_.end(), greater_cost);
+			heap_.pop_back();
+		}
+	}
+
+	MAP& map_;
+	typename MAP::template EdgeAttribute<uint32> stamp_;
+	std::vector<Entry> heap_;
+	uint32 nb_live_;
+};
+
+} // namespace modeling
+
+} // namespace cgogn
+
+#endif // CGOGN_MODELING_DECIMATION_EDGE_QUEUE_H_
@@ -26,6 +26,7 @@
 
 #include <cgogn/core/utils/masks.h>
 #include <cgogn/geometry/algos/length.h>
+#include <cgogn/modeling/decimation/edge_queue.h>
 
 namespace cgogn
 {
@@ -33,28 +34,18 @@ namespace cgogn
 namespace modeling
 {
 
-template <typename MAP, typename VEC3>
+template <typename MAP, typename VEC3,
+		  typename QUEUE = EdgeQueue_Multimap<MAP, typename geometry::vector_traits<VEC3>::Scalar>>
 class EdgeTraversor_EdgeLength : public CellTraversor
 {
 public:
 
 	using Inherit = CellTraversor;
-	using Self = EdgeTraversor_EdgeLength<MAP, VEC3>;
+	using Self = EdgeTraversor_EdgeLength<MAP, VEC3, QUEUE>;
 	using Scalar = typename geometry::vector_traits<VEC3>::Scalar;
 	using Vertex = typename MAP::Vertex;
 	using Edge = typename MAP::Edge;
 
-	struct EdgeInfo
-	{
-		typename std::multimap<Scalar, Edge>::const_iterator it_;
-		bool valid_;
-
-		EdgeInfo() : valid_(false) {}
-
-		friend std::ostream& operator<<(std::ostream& out, const EdgeInfo&) { return out; }
-		friend std::istream& operator>>(std::istream& in, const EdgeInfo&) { return in; }
-	};
-
 	CGOGN_NOT_COPYABLE_NOR_MOVABLE(EdgeTraversor_EdgeLength);
 
 	inline EdgeTraversor_EdgeLength(
@@ -62,13 +53,11 @@ public:
 		const typename MAP::template VertexAttribute<VEC3>& position
 	) : Inherit(),
 		map_(m),
-		position_(position)
+		position_(position),
+		edges_(m, "EdgeTraversor_EdgeLength")
 	{
-		einfo_ = map_.template add_attribute<EdgeInfo, Edge>("EdgeTraversor_EdgeLength_EdgeInfo");
-
 		map_.foreach_cell([&] (Edge e)
 		{
-			einfo_[e].valid_ = false;
 			update_edge_info(e);
 		});
 
@@ -76,14 +65,11 @@ public:
 	}
 
 	~EdgeTraversor_EdgeLength() override
-	{
-		map_.remove_attribute(einfo_);
-	}
+	{}
 
 	void pre_collapse(Edge e)
 	{
-		EdgeInfo& ei = einfo_[e];
-		if (ei.valid_) { edges_.erase(ei.it_); ei.valid_ = false; }
+		edges_.remove(e);
 
 		e1_ = Edge(map_.phi2(map_.phi_1(e.dart)));
 		e2_ = Edge(map_.phi2(map_.phi_1(map_.phi2(e.dart))));
@@ -91,17 +77,10 @@ public:
 		Dart ed1 = e.dart;
 		Dart ed2 = map_.phi2(ed1);
 
-		EdgeInfo& ei1 = einfo_[Edge(map_.phi1(ed1))];
-		if (ei1.valid_) { edges_.erase(ei1.it_); ei1.valid_ = false; }
-
-		EdgeInfo& ei2 = einfo_[Edge(map_.phi_1(ed1))];
-		if (ei2.valid_) { edges_.erase(ei2.it_); ei2.valid_ = false; }
-
-		EdgeInfo& ei3 = einfo_[Edge(map_.phi1(ed2))];
-		if (ei3.valid_) { edges_.erase(ei3.it_); ei3.valid_ = false; }
-
-		EdgeInfo& ei4 = einfo_[Edge(map_.phi_1(ed2))];
-		if (ei4.valid_) { edges_.erase(ei4.it_); ei4.valid_ = false; }
+		edges_.remove(Edge(map_.phi1(ed1)));
+		edges_.remove(Edge(map_.phi_1(ed1)));
+		edges_.remove(Edge(map_.phi1(ed2)));
+		edges_.remove(Edge(map_.phi_1(ed2)));
 	}
 
 	void post_collapse()
@@ -132,70 +111,62 @@ public:
 
 	void update_edge_info(Edge e)
 	{
-		EdgeInfo& ei = einfo_[e];
 		if (map_.edge_can_collapse(e))
 		{
-			Scalar cost = geometry::length(map_, e, position_);
-			if (ei.valid_)
-			{
-				edges_.erase(ei.it_);
-				ei.it_ = edges_.insert(std::make_pair(cost, e));
-			}
-			else
-			{
-				ei.it_ = edges_.insert(std::make_pair(cost, e));
-				ei.valid_ = true;
-			}
+			edges_.update(e, geometry::length(map_, e, position_));
 		}
 		else
-		{
-			if (ei.valid_)
-			{
-				edges_.erase(ei.it_);
-				ei.valid_ = false;
-			}
-		}
+			edges_.remove(e);
 	}
 
 	class const_iterator
 	{
 	public:
 
-		const Self* const trav_ptr_;
-		typename std::multimap<Scalar, Edge>::const_iterator edge_it_;
+		const Self* trav_ptr_;
+		Edge edge_;
+		bool end_;
 
-		inline const_iterator(const Self* trav, typename std::multimap<Scalar, Edge>::const_iterator it) :
+		inline const_iterator(const Self* trav, bool end) :
 			trav_ptr_(trav),
-			edge_it_(it)
-		{}
+			end_(end || trav->edges_.empty())
+		{
+			if (!end_)
+				edge_ = trav_ptr_->edges_.top();
+		}
 
 		inline const_iterator(const const_iterator& it) :
 			trav_ptr_(it.trav_ptr_),
-			edge_it_(it.edge_it_)
+			edge_(it.edge_),
+			end_(it.end_)
 		{}
 
 		inline const_iterator& operator=(const const_iterator& it)
 		{
 			trav_ptr_ = it.trav_ptr_;
-			edge_it_ = it.edge_it_;
+			edge_ = it.edge_;
+			end_ = it.end_;
 			return *this;
 		}
 
+		// the traversal always goes on with the current cheapest edge
 		inline const_iterator& operator++()
 		{
-			edge_it_ = trav_ptr_->edges_.begin();
+			end_ = trav_ptr_->edges_.empty();
+			if (!end_)
+				edge_ = trav_ptr_->edges_.top();
 			return *this;
 		}
 
 		inline const Edge& operator*() const
 		{
-			return (*edge_it_).second;
+			return edge_;
 		}
 
 		inline bool operator!=(const_iterator it) const
 		{
 			cgogn_assert(trav_ptr_ == it.trav_ptr_);
-			return edge_it_ != it.edge_it_;
+			return end_ != it.end_;
 		}
 	};
 
@@ -203,22 +174,21 @@ public:
 			  typename std::enable_if<std::is_same<CellType, typename MAP::Edge>::value>::type* = nullptr>
 	inline const_iterator begin() const
 	{
-		return const_iterator(this, edges_.begin());
+		return const_iterator(this, false);
 	}
 
 	template <typename CellType,
 			  typename std::enable_if<std::is_same<CellType, typename MAP::Edge>::value>::type* = nullptr>
 	inline const_iterator end() const
 	{
-		return const_iterator(this, edges_.end());
+		return const_iterator(this, true);
 	}
 
 private:
 
 	MAP& map_;
 	const typename MAP::template VertexAttribute<VEC3>& position_;
-	typename MAP::template EdgeAttribute<EdgeInfo> einfo_;
-	std::multimap<Scalar, Edge> edges_;
+	QUEUE edges_;
 	Edge e1_, e2_;
 };
 
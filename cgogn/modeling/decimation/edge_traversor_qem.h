@@ -27,6 +27,7 @@
 #include <cgogn/core/utils/masks.h>
 #include <cgogn/geometry/types/quadric.h>
 #include <cgogn/modeling/decimation/edge_approximator.h>
+#include <cgogn/modeling/decimation/edge_queue.h>
 
 namespace cgogn
 {
@@ -34,29 +35,48 @@ namespace cgogn
 namespace modeling
 {
 
-template <typename MAP, typename VEC3>
+/**
+ * \brief compute for each vertex the sum of the quadrics of its incident (triangular) faces
+ * Each vertex gathers the quadrics of its own faces: the face quadrics are computed
+ * several times but no two tasks accumulate into the same vertex quadric.
+ */
+template <typename VEC3, typename MAP>
+void compute_vertex_quadrics(
+	const MAP& map,
+	const typename MAP::template VertexAttribute<VEC3>& position,
+	typename MAP::template VertexAttribute<geometry::Quadric>& quadric
+)
+{
+	using Vertex = typename MAP::Vertex;
+	using Face = typename MAP::Face;
+
+	map.parallel_foreach_cell([&] (Vertex v)
+	{
+		geometry::Quadric& q = quadric[v];
+		q.zero();
+		map.foreach_incident_face(v, [&] (Face f)
+		{
+			Dart d = f.dart;
+			Dart d1 = map.phi1(d);
+			Dart d_1 = map.phi_1(d);
+			q += geometry::Quadric(position[Vertex(d)], position[Vertex(d1)], position[Vertex(d_1)]);
+		});
+	});
+}
+
+template <typename MAP, typename VEC3,
+		  typename QUEUE = EdgeQueue_Multimap<MAP, typename geometry::vector_traits<VEC3>::Scalar>>
 class EdgeTraversor_QEM : public CellTraversor
 {
 public:
 
 	using Inherit = CellTraversor;
-	using Self = EdgeTraversor_QEM<MAP, VEC3>;
+	using Self = EdgeTraversor_QEM<MAP, VEC3, QUEUE>;
 	using Scalar = typename geometry::vector_traits<VEC3>::Scalar;
 	using Vertex = typename MAP::Vertex;
 	using Edge = typename MAP::Edge;
 	using Face = typename MAP::Face;
 
-	struct EdgeInfo
-	{
-		typename std::multimap<Scalar, Edge>::const_iterator it_;
-		bool valid_;
-
-		EdgeInfo() : valid_(false) {}
-
-		friend std::ostream& operator<<(std::ostream& out, const EdgeInfo&) { return out; }
-		friend std::istream& operator>>(std::istream& in, const EdgeInfo&) { return in; }
-	};
-
 	CGOGN_NOT_COPYABLE_NOR_MOVABLE(EdgeTraversor_QEM);
 
 	inline EdgeTraversor_QEM(
@@ -66,30 +86,15 @@ public:
 	) : Inherit(),
 		map_(m),
 		position_(position),
-		approx_(approx)
+		approx_(approx),
+		edges_(m, "EdgeTraversor_QEM")
 	{
-		einfo_ = map_.template add_attribute<EdgeInfo, Edge>("EdgeTraversor_QEM_EdgeInfo");
 		quadric_ = map_.template add_attribute<geometry::Quadric, Vertex>("EdgeTraversor_QEM_Quadric");
 
-		map_.parallel_foreach_cell([&] (Vertex v)
-		{
-			quadric_[v].zero();
-		});
-
-		map_.parallel_foreach_cell([&] (Face f)
-		{
-			Dart d = f.dart;
-			Dart d1 = map_.phi1(d);
-			Dart d_1 = map_.phi_1(d);
-			geometry::Quadric q(position_[Vertex(d)], position_[Vertex(d1)], position_[Vertex(d_1)]);
-			quadric_[d] += q;
-			quadric_[d1] += q;
-			quadric_[d_1] += q;
-		});
+		compute_vertex_quadrics<VEC3>(map_, position_, quadric_);
 
 		map_.foreach_cell([&] (Edge e)
 		{
-			einfo_[e].valid_ = false;
 			update_edge_info(e);
 		});
 
@@ -98,14 +103,12 @@ public:
 
 	~EdgeTraversor_QEM() override
 	{
-		map_.remove_attribute(einfo_);
 		map_.remove_attribute(quadric_);
 	}
 
 	void pre_collapse(Edge e)
 	{
-		EdgeInfo& ei = einfo_[e];
-		if (ei.valid_) { edges_.erase(ei.it_); ei.valid_ = false; }
+		edges_.remove(e);
 
 		e1_ = Edge(map_.phi2(map_.phi_1(e.dart)));
 		e2_ = Edge(map_.phi2(map_.phi_1(map_.phi2(e.dart))));
@@ -113,17 +116,10 @@ public:
 		Dart ed1 = e.dart;
 		Dart ed2 = map_.phi2(ed1);
 
-		EdgeInfo& ei1 = einfo_[Edge(map_.phi1(ed1))];
-		if (ei1.valid_) { edges_.erase(ei1.it_); ei1.valid_ = false; }
-
-		EdgeInfo& ei2 = einfo_[Edge(map_.phi_1(ed1))];
-		if (ei2.valid_) { edges_.erase(ei2.it_); ei2.valid_ = false; }
-
-		EdgeInfo& ei3 = einfo_[Edge(map_.phi1(ed2))];
-		if (ei3.valid_) { edges_.erase(ei3.it_); ei3.valid_ = false; }
-
-		EdgeInfo& ei4 = einfo_[Edge(map_.phi_1(ed2))];
-		if (ei4.valid_) { edges_.erase(ei4.it_); ei4.valid_ = false; }
+		edges_.remove(Edge(map_.phi1(ed1)));
+		edges_.remove(Edge(map_.phi_1(ed1)));
+		edges_.remove(Edge(map_.phi1(ed2)));
+		edges_.remove(Edge(map_.phi_1(ed2)));
 
 		std::pair<Vertex,Vertex> vertices = map_.vertices(e);
 		q_.zero();
@@ -161,74 +157,66 @@ public:
 
 	void update_edge_info(Edge e)
 	{
-		EdgeInfo& ei = einfo_[e];
 		if (map_.edge_can_collapse(e))
 		{
 			std::pair<Vertex,Vertex> vertices = map_.vertices(e);
 			geometry::Quadric q;
 			q += quadric_[vertices.first];
 			q += quadric_[vertices.second];
-			Scalar cost = q(approx_(e));
-			if (ei.valid_)
-			{
-				edges_.erase(ei.it_);
-				ei.it_ = edges_.insert(std::make_pair(cost, e));
-			}
-			else
-			{
-				ei.it_ = edges_.insert(std::make_pair(cost, e));
-				ei.valid_ = true;
-			}
+			edges_.update(e, q(approx_(e)));
 		}
 		else
-		{
-			if (ei.valid_)
-			{
-				edges_.erase(ei.it_);
-				ei.valid_ = false;
-			}
-		}
+			edges_.remove(e);
 	}
 
 	class const_iterator
 	{
 	public:
 
-		const Self* const trav_ptr_;
-		typename std::multimap<Scalar, Edge>::const_iterator edge_it_;
+		const Self* trav_ptr_;
+		Edge edge_;
+		bool end_;
 
-		inline const_iterator(const Self* trav, typename std::multimap<Scalar, Edge>::const_iterator it) :
+		inline const_iterator(const Self* trav, bool end) :
 			trav_ptr_(trav),
-			edge_it_(it)
-		{}
+			end_(end || trav->edges_.empty())
+		{
+			if (!end_)
+				edge_ = trav_ptr_->edges_.top();
+		}
 
 		inline const_iterator(const const_iterator& it) :
 			trav_ptr_(it.trav_ptr_),
-			edge_it_(it.edge_it_)
+			edge_(it.edge_),
+			end_(it.end_)
 		{}
 
 		inline const_iterator& operator=(const const_iterator& it)
 		{
 			trav_ptr_ = it.trav_ptr_;
-			edge_it_ = it.edge_it_;
+			edge_ = it.edge_;
+			end_ = it.end_;
 			return *this;
 		}
 
+		// the traversal always goes on with the current cheapest edge
 		inline const_iterator& operator++()
 		{
-			edge_it_ = trav_ptr_->edges_.begin();
+			end_ = trav_ptr_->edges_.empty();
+			if (!end_)
+				edge_ = trav_ptr_->edges_.top();
 			return *this;
 		}
 
 		inline const Edge& operator*() const
 		{
-			return (*edge_it_).second;
+			return edge_;
 		}
 
 		inline bool operator!=(const_iterator it) const
 		{
 			cgogn_assert(trav_ptr_ == it.trav_ptr_);
-			return edge_it_ != it.edge_it_;
+			return end_ != it.end_;
 		}
 	};
 
@@ -236,14 +224,14 @@ public:
 			  typename std::enable_if<std::is_same<CellType, typename MAP::Edge>::value>::type* = nullptr>
 	inline const_iterator begin() const
 	{
-		return const_iterator(this, edges_.begin());
+		return const_iterator(this, false);
 	}
 
 	template <typename CellType,
 			  typename std::enable_if<std::is_same<CellType, typename MAP::Edge>::value>::type* = nullptr>
 	inline const_iterator end() const
 	{
-		return const_iterator(this, edges_.end());
+		return const_iterator(this, true);
 	}
 
 private:
@@ -252,9 +240,8 @@ private:
 	const typename MAP::template VertexAttribute<VEC3>& position_;
 	const EdgeApproximator<MAP, VEC3>& approx_;
 
-	typename MAP::template EdgeAttribute<EdgeInfo> einfo_;
 	typename MAP::template VertexAttribute<geometry::Quadric> quadric_;
-	std::multimap<Scalar, Edge> edges_;
+	QUEUE edges_;
 	Edge e1_, e2_;
 	geometry::Quadric q_;
 };
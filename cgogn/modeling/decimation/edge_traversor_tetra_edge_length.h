@@ -0,0 +1,201 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef CGOGN_MODELING_DECIMATION_EDGE_TRAVERSOR_TETRA_EDGE_LENGTH_H_
+#define CGOGN_MODELING_DECIMATION_EDGE_TRAVERSOR_TETRA_EDGE_LENGTH_H_
+
+#include <cgogn/core/utils/masks.h>
+#include <cgogn/geometry/algos/length.h>
+#include <cgogn/modeling/decimation/edge_queue.h>
+
+namespace cgogn
+{
+
+namespace modeling
+{
+
+/**
+ * \brief traversal of the edges of a tetrahedral mesh (CMap3 or CMap3Tetra) by increasing length.
+ * The edges whose both vertices are incident to the boundary are never traversed.
+ * If lock_boundary is true, the edges incident to a boundary vertex are not traversed either.
+ * The validity of a collapse is not checked when the edges are queued (see decimate_volume):
+ * an edge that cannot be collapsed has to be removed from the traversor.
+ */
+template <typename MAP, typename VEC3,
+		  typename QUEUE = EdgeQueue_IndexedHeap<MAP, typename geometry::vector_traits<VEC3>::Scalar>>
+class EdgeTraversor_TetraEdgeLength : public CellTraversor
+{
+public:
+
+	using Inherit = CellTraversor;
+	using Self = EdgeTraversor_TetraEdgeLength<MAP, VEC3, QUEUE>;
+	using Scalar = typename geometry::vector_traits<VEC3>::Scalar;
+	using Vertex = typename MAP::Vertex;
+	using Edge = typename MAP::Edge;
+
+	CGOGN_NOT_COPYABLE_NOR_MOVABLE(EdgeTraversor_TetraEdgeLength);
+
+	inline EdgeTraversor_TetraEdgeLength(
+		MAP& m,
+		const typename MAP::template VertexAttribute<VEC3>& position,
+		bool lock_boundary = false
+	) : Inherit(),
+		map_(m),
+		position_(position),
+		lock_boundary_(lock_boundary),
+		boundary_(m),
+		edges_(m, "EdgeTraversor_TetraEdgeLength")
+	{
+		map_.foreach_cell([&] (Vertex v)
+		{
+			if (map_.is_incident_to_boundary(v))
+				boundary_.mark(v);
+		});
+
+		map_.foreach_cell([&] (Edge e)
+		{
+			update_edge_info(e);
+		});
+
+		this->traversed_cells_ |= orbit_mask<Edge>();
+	}
+
+	~EdgeTraversor_TetraEdgeLength() override
+	{}
+
+	inline bool is_boundary(Vertex v) const
+	{
+		return boundary_.is_marked(v);
+	}
+
+	inline void remove(Edge e)
+	{
+		edges_.remove(e);
+	}
+
+	// the edges incident to both vertices are removed or merged by the collapse
+	void pre_collapse(Edge e)
+	{
+		map_.foreach_incident_edge(Vertex(e.dart), [&] (Edge ie) { edges_.remove(ie); });
+		map_.foreach_incident_edge(Vertex(map_.phi1(e.dart)), [&] (Edge ie) { edges_.remove(ie); });
+	}
+
+	// the length of the edges incident to v and the link of the edges incident to its neighbors have changed
+	void post_collapse(Vertex v)
+	{
+		map_.foreach_incident_edge(v, [&] (Edge e) { update_edge_info(e); });
+		map_.foreach_adjacent_vertex_through_edge(v, [&] (Vertex av)
+		{
+			map_.foreach_incident_edge(av, [&] (Edge e) { update_edge_info(e); });
+		});
+	}
+
+	void update_edge_info(Edge e)
+	{
+		const bool b1 = is_boundary(Vertex(e.dart));
+		const bool b2 = is_boundary(Vertex(map_.phi1(e.dart)));
+		if ((b1 && b2) || (lock_boundary_ && (b1 || b2)))
+			edges_.remove(e);
+		else
+			edges_.update(e, geometry::length(map_, e, position_));
+	}
+
+	class const_iterator
+	{
+	public:
+
+		const Self* trav_ptr_;
+		Edge edge_;
+		bool end_;
+
+		inline const_iterator(const Self* trav, bool end) :
+			trav_ptr_(trav),
+			end_(end || trav->edges_.empty())
+		{
+			if (!end_)
+				edge_ = trav_ptr_->edges_.top();
+		}
+
+		inline const_iterator(const const_iterator& it) :
+			trav_ptr_(it.trav_ptr_),
+			edge_(it.edge_),
+			end_(it.end_)
+		{}
+
+		inline const_iterator& operator=(const const_iterator& it)
+		{
+			trav_ptr_ = it.trav_ptr_;
+			edge_ = it.edge_;
+			end_ = it.end_;
+			return *this;
+		}
+
+		// the traversal always goes on with the current shortest edge
+		inline const_iterator& operator++()
+		{
+			end_ = trav_ptr_->edges_.empty();
+			if (!end_)
+				edge_ = trav_ptr_->edges_.top();
+			return *this;
+		}
+
+		inline const Edge& operator*() const
+		{
+			return edge_;
+		}
+
+		inline bool operator!=(const_iterator it) const
+		{
+			cgogn_assert(trav_ptr_ == it.trav_ptr_);
+			return end_ != it.end_;
+		}
+	};
+
+	template <typename CellType,
+			  typename std::enable_if<std::is_same<CellType, typename MAP::Edge>::value>::type* = nullptr>
+	inline const_iterator begin() const
+	{
+		return const_iterator(this, false);
+	}
+
+	template <typename CellType,
+			  typename std::enable_if<std::is_same<CellType, typename MAP::Edge>::value>::type* = nullptr>
+	inline const_iterator end() const
+	{
+		return const_iterator(this, true);
+	}
+
+private:
+
+	MAP& map_;
+	const typename MAP::template VertexAttribute<VEC3>& position_;
+	bool lock_boundary_;
+	typename MAP::template CellMarker<Vertex::ORBIT> boundary_;
+	QUEUE edges_;
+};
+
+} // namespace modeling
+
+} // namespace cgogn
+
+#endif // CGOGN_MODELING_DECIMATION_EDGE_TRAVERSOR_TETRA_EDGE_LENGTH_H_
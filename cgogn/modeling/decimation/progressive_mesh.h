@@ -0,0 +1,641 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef CGOGN_MODELING_DECIMATION_PROGRESSIVE_MESH_H_
+#define CGOGN_MODELING_DECIMATION_PROGRESSIVE_MESH_H_
+
+#include <algorithm>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <cgogn/core/utils/endian.h>
+#include <cgogn/core/cmap/cmap2.h>
+#include <cgogn/core/cmap/cmap2_builder.h>
+
+#include <cgogn/geometry/types/geometry_traits.h>
+
+namespace cgogn
+{
+
+namespace modeling
+{
+
+/**
+ * Progressive meshes: a coarse base triangle mesh and the sequence of vertex splits
+ * that reverts the edge collapses of a decimation (finest vertex split last).
+ * The vertices of the base mesh are numbered 0..n0-1, the split i creates the vertex n0+i.
+ *
+ * Binary stream format (little endian):
+ * - header: "CGPM", version (uint32), size of the scalars (uint32, 4 or 8),
+ *   number of extra vertex attributes (uint32) and their names (uint32 length + chars),
+ *   number of base vertices, of base triangles and of splits (3 x uint32)
+ * - base vertices: position then the value of each extra attribute (3 scalars each)
+ * - base triangles: 3 x uint32 vertex indices
+ * - splits: vertex, left, right (3 x uint32), vertex_delta, new_delta, then the delta of each extra attribute (3 scalars each)
+ * The base mesh is read at once and the splits can be read in batches while the mesh is refined.
+ */
+template <typename VEC3>
+class ProgressiveMesh
+{
+public:
+
+	using Scalar = geometry::ScalarOf<VEC3>;
+
+	static const uint32 VERSION = 1u;
+
+	/**
+	 * \brief a vertex split: the vertex of index vertex_ is split into itself and a new vertex,
+	 * along the edges vertex_-left_ and vertex_-right_ which become the triangles vertex_-new-left_ and new-vertex_-right_.
+	 * The positions of the two vertices are the position of vertex_ plus vertex_delta_ and new_delta_.
+	 */
+	struct VertexSplit
+	{
+		uint32 vertex_;
+		uint32 left_;
+		uint32 right_;
+		VEC3 vertex_delta_;
+		VEC3 new_delta_;
+	};
+
+	inline ProgressiveMesh() : nb_splits_in_stream_(0u), stream_scalar_size_(uint32(sizeof(Scalar))) {}
+
+	CGOGN_NOT_COPYABLE_NOR_MOVABLE(ProgressiveMesh);
+
+	inline uint32 nb_base_vertices() const { return uint32(base_positions_.size()); }
+	inline uint32 nb_base_triangles() const { return uint32(base_triangles_.size() / 3u); }
+	/// number of splits available (recorded or read so far)
+	inline uint32 nb_splits() const { return uint32(splits_.size()); }
+	/// number of splits announced by the header of the stream being read
+	inline uint32 nb_splits_in_stream() const { return nb_splits_in_stream_; }
+	/// number of vertices of the finest level of detail available
+	inline uint32 nb_vertices() const { return nb_base_vertices() + nb_splits(); }
+	inline uint32 nb_attributes() const { return uint32(attribute_names_.size()); }
+
+	inline const std::string& attribute_name(uint32 a) const { return attribute_names_[a]; }
+	inline const VEC3& base_position(uint32 v) const { return base_positions_[v]; }
+	inline const VEC3& base_attribute_value(uint32 v, uint32 a) const { return base_attribute_values_[v * nb_attributes() + a]; }
+	inline const std::vector<uint32>& base_triangles() const { return base_triangles_; }
+	inline const VertexSplit& split(uint32 i) const { return splits_[i]; }
+	inline const VEC3& split_attribute_delta(uint32 i, uint32 a) const { return split_attribute_deltas_[i * nb_attributes() + a]; }
+
+	void clear()
+	{
+		attribute_names_.clear();
+		base_positions_.clear();
+		base_attribute_values_.clear();
+		base_triangles_.clear();
+		splits_.clear();
+		split_attribute_deltas_.clear();
+		nb_splits_in_stream_ = 0u;
+	}
+
+	void save(std::ostream& out) const
+	{
+		out.write("CGPM", 4);
+		write_value(out, VERSION);
+		write_value(out, uint32(sizeof(Scalar)));
+		write_value(out, nb_attributes());
+		for (const std::string& name : attribute_names_)
+		{
+			write_value(out, uint32(name.size()));
+			out.write(name.data(), std::streamsize(name.size()));
+		}
+		write_value(out, nb_base_vertices());
+		write_value(out, nb_base_triangles());
+		write_value(out, nb_splits());
+
+		for (uint32 v = 0u, end = nb_base_vertices(); v < end; ++v)
+		{
+			write_vec(out, base_positions_[v]);
+			for (uint32 a = 0u; a < nb_attributes(); ++a)
+				write_vec(out, base_attribute_value(v, a));
+		}
+		for (uint32 i : base_triangles_)
+			write_value(out, i);
+		for (uint32 i = 0u, end = nb_splits(); i < end; ++i)
+		{
+			const VertexSplit& s = splits_[i];
+			write_value(out, s.vertex_);
+			write_value(out, s.left_);
+			write_value(out, s.right_);
+			write_vec(out, s.vertex_delta_);
+			write_vec(out, s.new_delta_);
+			for (uint32 a = 0u; a < nb_attributes(); ++a)
+				write_vec(out, split_attribute_delta(i, a));
+		}
+	}
+
+	/**
+	 * \brief read the header and the base mesh, the splits are then read with read_splits
+	 * @return false if the stream is not a (supported) progressive mesh
+	 */
+	bool read_base(std::istream& in)
+	{
+		clear();
+
+		char magic[4];
+		if (!in.read(magic, 4) || std::memcmp(magic, "CGPM", 4) != 0)
+			return false;
+		uint32 version = 0u;
+		if (!read_value(in, version) || version != VERSION)
+			return false;
+		if (!read_value(in, stream_scalar_size_) || (stream_scalar_size_ != 4u && stream_scalar_size_ != 8u))
+			return false;
+
+		uint32 nb_attr = 0u;
+		if (!read_value(in, nb_attr))
+			return false;
+		for (uint32 a = 0u; a < nb_attr; ++a)
+		{
+			uint32 length = 0u;
+			if (!read_value(in, length))
+				return false;
+			std::string name(length, ' ');
+			if (length > 0u && !in.read(&name[0], std::streamsize(length)))
+				return false;
+			attribute_names_.push_back(name);
+		}
+
+		uint32 nb_vert = 0u, nb_tri = 0u;
+		if (!read_value(in, nb_vert) || !read_value(in, nb_tri) || !read_value(in, nb_splits_in_stream_))
+			return false;
+
+		const std::size_t vertex_size = 3u * stream_scalar_size_ * (1u + nb_attr);
+		if (!read_buffer(in, vertex_size * nb_vert))
+			return false;
+		const char* p = buffer_.data();
+		base_positions_.resize(nb_vert);
+		base_attribute_values_.resize(std::size_t(nb_vert) * nb_attr);
+		for (uint32 v = 0u; v < nb_vert; ++v)
+		{
+			base_positions_[v] = decode_vec(p);
+			for (uint32 a = 0u; a < nb_attr; ++a)
+				base_attribute_values_[v * nb_attr + a] = decode_vec(p);
+		}
+
+		if (!read_buffer(in, 12u * std::size_t(nb_tri)))
+			return false;
+		p = buffer_.data();
+		base_triangles_.resize(3u * std::size_t(nb_tri));
+		std::vector<bool> used(nb_vert, false);
+		for (uint32& i : base_triangles_)
+		{
+			i = decode<uint32>(p);
+			if (i >= nb_vert)
+			{
+				clear();
+				return false;
+			}
+			used[i] = true;
+		}
+		// a base vertex that is not in any triangle cannot be embedded
+		if (std::find(used.begin(), used.end(), false) != used.end())
+		{
+			clear();
+			return false;
+		}
+
+		return true;
+	}
+
+	/**
+	 * \brief read (at most) the nb next splits of the stream
+	 * @return the number of splits read (0 if a split refers to a vertex that does not exist before it)
+	 */
+	uint32 read_splits(std::istream& in, uint32 nb)
+	{
+		nb = std::min(nb, nb_splits_in_stream_ - nb_splits());
+		const uint32 nb_attr = nb_attributes();
+		const std::size_t split_size = 12u + 3u * stream_scalar_size_ * (2u + nb_attr);
+		if (nb == 0u || !read_buffer(in, split_size * nb))
+			return 0u;
+
+		const char* p = buffer_.data();
+		const uint32 nb_read = nb_splits();
+		splits_.reserve(splits_.size() + nb);
+		split_attribute_deltas_.reserve(split_attribute_deltas_.size() + std::size_t(nb) * nb_attr);
+		for (uint32 i = 0u; i < nb; ++i)
+		{
+			VertexSplit s;
+			s.vertex_ = decode<uint32>(p);
+			s.left_ = decode<uint32>(p);
+			s.right_ = decode<uint32>(p);
+			// the split of index k only refers to the base vertices and to the vertices added by the k previous splits
+			const uint32 nb_vert = nb_base_vertices() + nb_read + i;
+			if (s.vertex_ >= nb_vert || s.left_ >= nb_vert || s.right_ >= nb_vert ||
+				s.vertex_ == s.left_ || s.vertex_ == s.right_ || s.left_ == s.right_)
+			{
+				splits_.resize(nb_read);
+				split_attribute_deltas_.resize(std::size_t(nb_read) * nb_attr);
+				return 0u;
+			}
+			s.vertex_delta_ = decode_vec(p);
+			s.new_delta_ = decode_vec(p);
+			splits_.push_back(s);
+			for (uint32 a = 0u; a < nb_attr; ++a)
+				split_attribute_deltas_.push_back(decode_vec(p));
+		}
+		return nb;
+	}
+
+	/**
+	 * \brief read the whole progressive mesh
+	 */
+	bool load(std::istream& in)
+	{
+		if (!read_base(in))
+			return false;
+		return read_splits(in, nb_splits_in_stream_) == nb_splits_in_stream_;
+	}
+
+private:
+
+	template <typename T>
+	static void write_value(std::ostream& out, T x)
+	{
+		x = swap_endianness_native_little(x);
+		out.write(reinterpret_cast<const char*>(&x), sizeof(T));
+	}
+
+	static void write_vec(std::ostream& out, const VEC3& v)
+	{
+		for (uint32 c = 0u; c < 3u; ++c)
+			write_value(out, Scalar(v[c]));
+	}
+
+	template <typename T>
+	static bool read_value(std::istream& in, T& x)
+	{
+		if (!in.read(reinterpret_cast<char*>(&x), sizeof(T)))
+			return false;
+		x = swap_endianness_native_little(x);
+		return true;
+	}
+
+	bool read_buffer(std::istream& in, std::size_t size)
+	{
+		buffer_.resize(size);
+		return size == 0u || bool(in.read(buffer_.data(), std::streamsize(size)));
+	}
+
+	template <typename T>
+	static T decode(const char*& p)
+	{
+		T x;
+		std::memcpy(&x, p, sizeof(T));
+		p += sizeof(T);
+		return swap_endianness_native_little(x);
+	}
+
+	VEC3 decode_vec(const char*& p) const
+	{
+		VEC3 v;
+		for (uint32 c = 0u; c < 3u; ++c)
+			v[c] = stream_scalar_size_ == 4u ? Scalar(decode<float32>(p)) : Scalar(decode<float64>(p));
+		return v;
+	}
+
+	template <typename V> friend class ProgressiveMeshRecorder;
+
+	std::vector<std::string> attribute_names_;
+	std::vector<VEC3> base_positions_;
+	std::vector<VEC3> base_attribute_values_;
+	std::vector<uint32> base_triangles_;
+	std::vector<VertexSplit> splits_;
+	std::vector<VEC3> split_attribute_deltas_;
+
+	uint32 nb_splits_in_stream_;
+	uint32 stream_scalar_size_;
+	std::vector<char> buffer_;
+};
+
+/**
+ * \brief records the edge collapses of a decimation (see decimate) and builds the corresponding progressive mesh.
+ * The attributes given to add_attribute are not modified by the decimation,
+ * the value of the removed vertex is stored as a delta to the value of the kept vertex.
+ */
+template <typename VEC3>
+class ProgressiveMeshRecorder
+{
+public:
+
+	using Vertex = CMap2::Vertex;
+	using Edge = CMap2::Edge;
+	using Face = CMap2::Face;
+	using VertexAttribute = CMap2::VertexAttribute<VEC3>;
+
+	inline ProgressiveMeshRecorder(const CMap2& map, const VertexAttribute& position) :
+		map_(map),
+		position_(position)
+	{}
+
+	CGOGN_NOT_COPYABLE_NOR_MOVABLE(ProgressiveMeshRecorder);
+
+	/**
+	 * \brief also record the given attribute (before the decimation)
+	 */
+	inline void add_attribute(const VertexAttribute& attribute)
+	{
+		cgogn_message_assert(collapses_.empty(), "ProgressiveMeshRecorder: attributes must be added before the decimation");
+		attributes_.push_back(attribute);
+	}
+
+	inline uint32 nb_collapses() const { return uint32(collapses_.size()); }
+
+	inline void clear()
+	{
+		collapses_.clear();
+		attribute_deltas_.clear();
+	}
+
+	/**
+	 * \brief to be called before the collapse of e (the vertex of e.dart is kept and moved to new_position)
+	 */
+	void pre_collapse(Edge e, const VEC3& new_position)
+	{
+		const Dart d = e.dart;
+		const Dart d2 = map_.phi2(d);
+		const Vertex kept(d);
+		const Vertex removed(d2);
+
+		Collapse c;
+		c.kept_ = map_.embedding(kept);
+		c.removed_ = map_.embedding(removed);
+		c.left_ = map_.embedding(Vertex(map_.phi_1(d)));
+		c.right_ = map_.embedding(Vertex(map_.phi_1(d2)));
+		c.kept_delta_ = position_[kept] - new_position;
+		c.removed_delta_ = position_[removed] - new_position;
+		collapses_.push_back(c);
+
+		for (const VertexAttribute& a : attributes_)
+			attribute_deltas_.push_back(a[removed] - a[kept]);
+	}
+
+	/**
+	 * \brief build the progressive mesh from the decimated map and the recorded collapses
+	 */
+	void build(ProgressiveMesh<VEC3>& pm) const
+	{
+		pm.clear();
+		for (const VertexAttribute& a : attributes_)
+			pm.attribute_names_.push_back(a.name());
+		const uint32 nb_attr = uint32(attributes_.size());
+
+		std::vector<uint32> id(map_.template attribute_container<Vertex::ORBIT>().end(), INVALID_INDEX);
+
+		map_.foreach_cell([&] (Vertex v)
+		{
+			id[map_.embedding(v)] = uint32(pm.base_positions_.size());
+			pm.base_positions_.push_back(position_[v]);
+			for (const VertexAttribute& a : attributes_)
+				pm.base_attribute_values_.push_back(a[v]);
+		});
+		const uint32 nb_base = uint32(pm.base_positions_.size());
+
+		map_.foreach_cell([&] (Face f)
+		{
+			cgogn_message_assert(map_.codegree(f) == 3u, "ProgressiveMeshRecorder: the decimated map must be a triangle mesh");
+			map_.foreach_incident_vertex(f, [&] (Vertex v) { pm.base_triangles_.push_back(id[map_.embedding(v)]); });
+		});
+
+		// the last collapse is the first split
+		const uint32 nb = nb_collapses();
+		for (uint32 k = 0u; k < nb; ++k)
+			id[collapses_[k].removed_] = nb_base + nb - 1u - k;
+
+		pm.splits_.reserve(nb);
+		pm.split_attribute_deltas_.reserve(std::size_t(nb) * nb_attr);
+		for (uint32 k = nb; k-- > 0u;)
+		{
+			const Collapse& c = collapses_[k];
+			typename ProgressiveMesh<VEC3>::VertexSplit s;
+			s.vertex_ = id[c.kept_];
+			s.left_ = id[c.left_];
+			s.right_ = id[c.right_];
+			s.vertex_delta_ = c.kept_delta_;
+			s.new_delta_ = c.removed_delta_;
+			pm.splits_.push_back(s);
+			for (uint32 a = 0u; a < nb_attr; ++a)
+				pm.split_attribute_deltas_.push_back(attribute_deltas_[k * nb_attr + a]);
+		}
+		pm.nb_splits_in_stream_ = nb;
+	}
+
+private:
+
+	struct Collapse
+	{
+		uint32 kept_;
+		uint32 removed_;
+		uint32 left_;
+		uint32 right_;
+		VEC3 kept_delta_;
+		VEC3 removed_delta_;
+	};
+
+	const CMap2& map_;
+	const VertexAttribute& position_;
+	std::vector<VertexAttribute> attributes_;
+	std::vector<Collapse> collapses_;
+	std::vector<VEC3> attribute_deltas_;
+};
+
+/**
+ * \brief builds the base mesh of a progressive mesh in a CMap2 and refines it by applying its vertex splits.
+ * The extra attributes of the progressive mesh are vertex attributes of the map with the same names
+ * (they are created when they do not exist).
+ * The splits are applied in order and can be applied while the progressive mesh is read from a stream.
+ */
+template <typename VEC3>
+class ProgressiveMeshPlayer
+{
+public:
+
+	using Vertex = CMap2::Vertex;
+	using VertexAttribute = CMap2::VertexAttribute<VEC3>;
+	using VertexSplit = typename ProgressiveMesh<VEC3>::VertexSplit;
+
+	ProgressiveMeshPlayer(const ProgressiveMesh<VEC3>& pm, CMap2& map, VertexAttribute& position) :
+		pm_(pm),
+		map_(map),
+		position_(position),
+		nb_splits_(0u)
+	{
+		for (uint32 a = 0u; a < pm_.nb_attributes(); ++a)
+		{
+			VertexAttribute attribute = map_.template get_attribute<VEC3, Vertex::ORBIT>(pm_.attribute_name(a));
+			if (!attribute.is_valid())
+				attribute = map_.template add_attribute<VEC3, Vertex::ORBIT>(pm_.attribute_name(a));
+			attributes_.push_back(attribute);
+		}
+		create_base_mesh();
+	}
+
+	CGOGN_NOT_COPYABLE_NOR_MOVABLE(ProgressiveMeshPlayer);
+
+	/// number of vertices of the current level of detail
+	inline uint32 nb_vertices() const { return uint32(vertex_dart_.size()); }
+	inline uint32 nb_applied_splits() const { return nb_splits_; }
+	inline const VertexAttribute& attribute(uint32 a) const { return attributes_[a]; }
+
+	/**
+	 * \brief apply the next splits (among the available ones) until the mesh has nb_vertices vertices
+	 * @return the number of applied splits
+	 */
+	uint32 refine(uint32 nb_vertices)
+	{
+		const uint32 end = std::min(pm_.nb_splits(), nb_vertices - std::min(nb_vertices, pm_.nb_base_vertices()));
+		if (end <= nb_splits_)
+			return 0u;
+
+		const uint32 nb = end - nb_splits_;
+		vertex_dart_.reserve(vertex_dart_.size() + nb);
+		for (; nb_splits_ < end; ++nb_splits_)
+			apply_split(nb_splits_);
+		return nb;
+	}
+
+private:
+
+	void create_base_mesh()
+	{
+		CMap2::Builder builder(map_);
+		const std::vector<uint32>& triangles = pm_.base_triangles();
+		const uint32 nb_base = pm_.nb_base_vertices();
+
+		// darts of each vertex (compressed rows)
+		std::vector<Dart> darts(triangles.size());
+		for (uint32 t = 0u, nb_tri = pm_.nb_base_triangles(); t < nb_tri; ++t)
+		{
+			Dart d = builder.add_face_topo_fp(3u);
+			for (uint32 k = 0u; k < 3u; ++k)
+			{
+				darts[3u * t + k] = d;
+				d = map_.phi1(d);
+			}
+		}
+		std::vector<uint32> offsets(nb_base + 1u, 0u);
+		for (uint32 v : triangles)
+			++offsets[v + 1u];
+		for (uint32 v = 1u; v <= nb_base; ++v)
+			offsets[v] += offsets[v - 1u];
+		std::vector<uint32> vertex_darts(triangles.size());
+		{
+			std::vector<uint32> pos(offsets.begin(), offsets.end() - 1);
+			for (uint32 i = 0u, end = uint32(triangles.size()); i < end; ++i)
+				vertex_darts[pos[triangles[i]]++] = i;
+		}
+
+		// dart i (a -> b) is sewed with the dart b -> a
+		const auto next = [] (uint32 i) -> uint32 { return (i % 3u == 2u) ? i - 2u : i + 1u; };
+		bool has_boundary = false;
+		for (uint32 i = 0u, end = uint32(triangles.size()); i < end; ++i)
+		{
+			if (map_.phi2(darts[i]) != darts[i])
+				continue;
+			const uint32 a = triangles[i];
+			const uint32 b = triangles[next(i)];
+			bool found = false;
+			for (uint32 k = offsets[b]; k < offsets[b + 1u] && !found; ++k)
+			{
+				const uint32 j = vertex_darts[k];
+				if (triangles[next(j)] == a && map_.phi2(darts[j]) == darts[j])
+				{
+					builder.phi2_sew(darts[i], darts[j]);
+					found = true;
+				}
+			}
+			has_boundary = has_boundary || !found;
+		}
+		if (has_boundary)
+			builder.close_map();
+
+		vertex_dart_.assign(nb_base, Dart());
+		for (uint32 v = 0u; v < nb_base; ++v)
+		{
+			cgogn_message_assert(offsets[v + 1u] > offsets[v], "ProgressiveMeshPlayer: isolated base vertex");
+			const Vertex vertex(darts[vertex_darts[offsets[v]]]);
+			builder.new_orbit_embedding(vertex);
+			vertex_dart_[v] = vertex.dart;
+			position_[vertex] = pm_.base_position(v);
+			for (uint32 a = 0u; a < pm_.nb_attributes(); ++a)
+				attributes_[a][vertex] = pm_.base_attribute_value(v, a);
+		}
+	}
+
+	void apply_split(uint32 i)
+	{
+		const VertexSplit& s = pm_.split(i);
+		const uint32 left = map_.embedding(Vertex(vertex_dart_[s.left_]));
+		const uint32 right = map_.embedding(Vertex(vertex_dart_[s.right_]));
+
+		// darts of the vertex going to left_ and right_
+		Dart d, e;
+		const Dart first = vertex_dart_[s.vertex_];
+		Dart it = first;
+		do
+		{
+			const uint32 emb = map_.embedding(Vertex(map_.phi1(it)));
+			if (emb == left)
+				d = it;
+			else if (emb == right)
+				e = it;
+			it = map_.phi2(map_.phi_1(it));
+		} while (it != first);
+		cgogn_message_assert(!d.is_nil() && !e.is_nil(), "ProgressiveMeshPlayer: inconsistent vertex split");
+
+		// the faces of phi2(d) and phi2(e) become quads that are cut to get back the two triangles
+		const Dart d2 = map_.phi2(d);
+		const Dart e2 = map_.phi2(e);
+		map_.split_vertex(d, e);
+		map_.cut_face(d2, map_.phi1(map_.phi1(d2)));
+		map_.cut_face(e2, map_.phi1(map_.phi1(e2)));
+
+		const Vertex kept(d);
+		const Vertex added(e);
+		const VEC3 p = position_[kept];
+		position_[kept] = p + s.vertex_delta_;
+		position_[added] = p + s.new_delta_;
+		for (uint32 a = 0u; a < pm_.nb_attributes(); ++a)
+			attributes_[a][added] = attributes_[a][kept] + pm_.split_attribute_delta(i, a);
+
+		vertex_dart_[s.vertex_] = d;
+		vertex_dart_.push_back(e);
+	}
+
+	const ProgressiveMesh<VEC3>& pm_;
+	CMap2& map_;
+	VertexAttribute& position_;
+	std::vector<VertexAttribute> attributes_;
+	std::vector<Dart> vertex_dart_;
+	uint32 nb_splits_;
+};
+
+} // namespace modeling
+
+} // namespace cgogn
+
+#endif // CGOGN_MODELING_DECIMATION_PROGRESSIVE_MESH_H_
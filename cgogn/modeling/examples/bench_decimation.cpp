@@ -0,0 +1,200 @@
+
+#include <chrono>
+#include <random>
+#include <sstream>
+#include <string>
+
+#include <cgogn/core/utils/logger.h>
+#include <cgogn/core/cmap/cmap2.h>
+
+#include <cgogn/geometry/types/eigen.h>
+
+#include <cgogn/modeling/tiling/triangular_tore.h>
+#include <cgogn/modeling/algos/decimation.h>
+
+using namespace cgogn::numerics;
+
+using Map2 = cgogn::CMap2;
+using Vertex = Map2::Vertex;
+using Vec3 = Eigen::Vector3d;
+
+using Multimap = cgogn::modeling::EdgeQueue_Multimap<Map2, float64>;
+using IndexedHeap = cgogn::modeling::EdgeQueue_IndexedHeap<Map2, float64>;
+using LazyHeap = cgogn::modeling::EdgeQueue_LazyHeap<Map2, float64>;
+
+using TimePoint = std::chrono::time_point<std::chrono::system_clock>;
+
+static float64 elapsed(const TimePoint& start)
+{
+	std::chrono::duration<float64> d = std::chrono::system_clock::now() - start;
+	return d.count();
+}
+
+static void jittered_tore(Map2& map, Map2::VertexAttribute<Vec3>& position, uint32 n)
+{
+	cgogn::modeling::TriangularTore<Map2> tore(map, 2u * n, n);
+	tore.embed_into_tore(position, 10.0f, 4.0f);
+	std::mt19937 gen(3);
+	std::uniform_real_distribution<float64> jitter(-0.2 / float64(n), 0.2 / float64(n));
+	map.foreach_cell([&] (Vertex v) { position[v] += Vec3(jitter(gen), jitter(gen), jitter(gen)); });
+}
+
+/**
+ * \brief collapse half of the vertices of the torus with the given traversor,
+ * the traversor construction (initial queue filling) is timed separately
+ */
+template <typename QUEUE>
+static void bench(const std::string& name, uint32 n, bool qem)
+{
+	using namespace cgogn::modeling;
+
+	Map2 map;
+	auto position = map.add_attribute<Vec3, Vertex>("position");
+	jittered_tore(map, position, n);
+	const uint32 nb = map.nb_cells<Vertex::ORBIT>() / 2u;
+
+	EdgeApproximator_QEM<Map2, Vec3> approx(map, position);
+	float64 init_time = 0.0;
+	float64 collapse_time = 0.0;
+	TimePoint start = std::chrono::system_clock::now();
+	if (qem)
+	{
+		EdgeTraversor_QEM<Map2, Vec3, QUEUE> trav(map, position, approx);
+		init_time = elapsed(start);
+		start = std::chrono::system_clock::now();
+		decimate(map, position, trav, approx, nb);
+		collapse_time = elapsed(start);
+	}
+	else
+	{
+		EdgeTraversor_EdgeLength<Map2, Vec3, QUEUE> trav(map, position);
+		init_time = elapsed(start);
+		start = std::chrono::system_clock::now();
+		decimate(map, position, trav, approx, nb);
+		collapse_time = elapsed(start);
+	}
+
+	cgogn_log_info("bench_decimation") << (qem ? "QEM " : "EdgeLength ") << name << ": init " << init_time << "s, "
+		<< float64(nb) / collapse_time << " collapses/s (" << map.nb_cells<Vertex::ORBIT>() << " vertices left)";
+}
+
+/**
+ * \brief parallel_decimate to the same vertex count with 1 to 32 workers, speedup against the serial QEM decimation
+ */
+static void bench_parallel(uint32 n)
+{
+	using namespace cgogn::modeling;
+
+	float64 serial_time = 0.0;
+	{
+		Map2 map;
+		auto position = map.add_attribute<Vec3, Vertex>("position");
+		jittered_tore(map, position, n);
+		const uint32 nb = map.nb_cells<Vertex::ORBIT>() / 2u;
+		TimePoint start = std::chrono::system_clock::now();
+		EdgeApproximator_QEM<Map2, Vec3> approx(map, position);
+		EdgeTraversor_QEM<Map2, Vec3, IndexedHeap> trav(map, position, approx);
+		decimate(map, position, trav, approx, nb);
+		serial_time = elapsed(start);
+		cgogn_log_info("bench_decimation") << "serial decimate (QEM, indexed heap): " << serial_time << "s";
+	}
+
+	cgogn::ThreadPool* pool = cgogn::thread_pool();
+	for (uint32 nb_workers : { 1u, 2u, 4u, 8u, 16u, 32u })
+	{
+		if (nb_workers > pool->max_nb_workers())
+		{
+			cgogn_log_info("bench_decimation") << "parallel_decimate: " << nb_workers << " workers not available (" << pool->max_nb_workers() << " max)";
+			continue;
+		}
+		Map2 map;
+		auto position = map.add_attribute<Vec3, Vertex>("position");
+		jittered_tore(map, position, n);
+		pool->set_nb_workers(nb_workers);
+		TimePoint start = std::chrono::system_clock::now();
+		parallel_decimate(map, position, map.nb_cells<Vertex::ORBIT>() / 2u);
+		const float64 time = elapsed(start);
+		cgogn_log_info("bench_decimation") << "parallel_decimate, " << nb_workers << " workers: " << time << "s, speedup " << serial_time / time;
+	}
+	pool->set_nb_workers();
+}
+
+/**
+ * \brief record a progressive mesh while decimating to 1% of the vertices,
+ * then rebuild the full mesh: from memory, and from a stream read in batches of splits
+ */
+static void bench_progressive_mesh(uint32 n)
+{
+	using namespace cgogn::modeling;
+
+	Map2 map;
+	auto position = map.add_attribute<Vec3, Vertex>("position");
+	jittered_tore(map, position, n);
+	const uint32 nb = map.nb_cells<Vertex::ORBIT>() - map.nb_cells<Vertex::ORBIT>() / 100u;
+
+	ProgressiveMesh<Vec3> pm;
+	TimePoint start = std::chrono::system_clock::now();
+	{
+		ProgressiveMeshRecorder<Vec3> recorder(map, position);
+		EdgeApproximator_QEM<Map2, Vec3> approx(map, position);
+		EdgeTraversor_QEM<Map2, Vec3, IndexedHeap> trav(map, position, approx);
+		decimate(map, position, trav, approx, nb, recorder);
+		recorder.build(pm);
+	}
+	cgogn_log_info("bench_decimation") << "recorded decimation: " << elapsed(start) << "s, "
+		<< pm.nb_base_vertices() << " base vertices, " << pm.nb_splits() << " splits";
+
+	std::stringstream stream;
+	pm.save(stream);
+	cgogn_log_info("bench_decimation") << "progressive mesh stream: " << float64(stream.str().size()) / float64(pm.nb_splits()) << " bytes per split";
+
+	{
+		Map2 lod;
+		auto lod_position = lod.add_attribute<Vec3, Vertex>("position");
+		start = std::chrono::system_clock::now();
+		ProgressiveMeshPlayer<Vec3> player(pm, lod, lod_position);
+		const float64 base_time = elapsed(start);
+		start = std::chrono::system_clock::now();
+		player.refine(pm.nb_vertices());
+		const float64 time = elapsed(start);
+		cgogn_log_info("bench_decimation") << "reconstruction (in memory): base " << base_time << "s, "
+			<< float64(pm.nb_splits()) / time << " splits/s";
+	}
+	{
+		Map2 lod;
+		auto lod_position = lod.add_attribute<Vec3, Vertex>("position");
+		ProgressiveMesh<Vec3> streamed;
+		start = std::chrono::system_clock::now();
+		streamed.read_base(stream);
+		ProgressiveMeshPlayer<Vec3> player(streamed, lod, lod_position);
+		while (streamed.read_splits(stream, 4096u) > 0u)
+			player.refine(streamed.nb_vertices());
+		const float64 time = elapsed(start);
+		cgogn_log_info("bench_decimation") << "reconstruction (streamed, batches of 4096): "
+			<< float64(streamed.nb_splits()) / time << " splits/s (" << lod.nb_cells<Vertex::ORBIT>() << " vertices)";
+	}
+}
+
+int main(int argc, char** argv)
+{
+	uint32 n = 500u;
+	if (argc < 2)
+		cgogn_log_info("bench_decimation") << "USAGE: " << argv[0] << " [tore_size] (using " << n << ")";
+	else
+		n = std::max(8u, uint32(std::stoi(argv[1])));
+
+	cgogn_log_info("bench_decimation") << 4u * n * n << " triangles";
+
+	for (bool qem : { false, true })
+	{
+		bench<Multimap>("multimap", n, qem);
+		bench<IndexedHeap>("indexed 4-ary heap", n, qem);
+		bench<LazyHeap>("lazy heap", n, qem);
+	}
+
+	bench_parallel(n);
+
+	bench_progressive_mesh(n);
+
+	return 0;
+}
@@ -0,0 +1,171 @@
+#include <array>
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <cgogn/core/utils/logger.h>
+#include <cgogn/core/cmap/cmap2.h>
+#include <cgogn/core/cmap/cmap2_tri.h>
+#include <cgogn/core/cmap/cmap3.h>
+
+#include <cgogn/geometry/types/eigen.h>
+#include <cgogn/geometry/algos/centroid.h>
+
+#include <cgogn/modeling/tiling/triangular_tore.h>
+#include <cgogn/modeling/algos/parallel_subdivision.h>
+#include <cgogn/modeling/algos/dual.h>
+
+using namespace cgogn::numerics;
+
+using Map2 = cgogn::CMap2;
+using Tri = cgogn::CMap2Tri;
+using Map3 = cgogn::CMap3;
+using Vec3 = Eigen::Vector3d;
+
+using TimePoint = std::chrono::time_point<std::chrono::system_clock>;
+
+static float64 elapsed(const TimePoint& start)
+{
+	std::chrono::duration<float64> d = std::chrono::system_clock::now() - start;
+	return d.count();
+}
+
+/**
+ * \brief a n x n x n grid of cubes, each cut into 6 tetrahedra around its diagonal
+ */
+static void tetra_grid(Map3& map, uint32 n)
+{
+	auto id = [&] (uint32 i, uint32 j, uint32 k) { return (k * (n + 1u) + j) * (n + 1u) + i; };
+	const uint32 paths[6][3] = { {0u,1u,2u}, {1u,2u,0u}, {2u,0u,1u}, {0u,2u,1u}, {2u,1u,0u}, {1u,0u,2u} };
+
+	Map3::Builder builder(map);
+	std::vector<uint32> origin;
+	for (uint32 k = 0u; k < n; ++k)
+		for (uint32 j = 0u; j < n; ++j)
+			for (uint32 i = 0u; i < n; ++i)
+				for (uint32 p = 0u; p < 6u; ++p)
+				{
+					uint32 c[3] = { i, j, k };
+					uint32 v[4];
+					v[0] = id(c[0], c[1], c[2]);
+					for (uint32 s = 0u; s < 3u; ++s)
+					{
+						++c[paths[p][s]];
+						v[s + 1u] = id(c[0], c[1], c[2]);
+					}
+					if (p >= 3u)
+						std::swap(v[1], v[2]);
+
+					const cgogn::Dart d = builder.add_pyramid_topo_fp(3u);
+					const cgogn::Dart vertices[4] = { d, map.phi1(d), map.phi_1(d), map.phi_1(map.phi2(map.phi_1(d))) };
+					for (uint32 q = 0u; q < 4u; ++q)
+					{
+						cgogn::Dart dd = vertices[q];
+						do
+						{
+							if (origin.size() <= dd.index)
+								origin.resize(dd.index + 1u);
+							origin[dd.index] = v[q];
+							dd = map.phi1(map.phi2(dd));
+						} while (dd != vertices[q]);
+					}
+				}
+
+	std::map<std::array<uint32, 3>, cgogn::Dart> faces;
+	map.foreach_dart([&] (cgogn::Dart d)
+	{
+		const std::array<uint32, 3> key = {{ origin[map.phi1(d).index], origin[d.index], origin[map.phi_1(d).index] }};
+		auto it = faces.find(key);
+		if (it != faces.end())
+			builder.phi3_sew(d, it->second);
+		else
+			faces[{{ origin[d.index], origin[map.phi1(d).index], origin[map.phi1(map.phi1(d)).index] }}] = d;
+	});
+	builder.close_map();
+
+	auto position = map.add_attribute<Vec3, Map3::Vertex>("position");
+	for (uint32 d = 0u; d < origin.size(); ++d)
+	{
+		const uint32 v = origin[d];
+		position[Map3::Vertex(cgogn::Dart(d))] = Vec3(float64(v % (n + 1u)), float64((v / (n + 1u)) % (n + 1u)), float64(v / ((n + 1u) * (n + 1u))));
+	}
+}
+
+/**
+ * \brief parallel_dual of a volume with the given number of workers
+ */
+static float64 bench_volume(const Map3& map, uint32 nb_workers)
+{
+	const uint32 nb = cgogn::thread_pool()->nb_workers();
+	cgogn::thread_pool()->set_nb_workers(nb_workers);
+	auto position = map.get_attribute<Vec3, Map3::Vertex>("position");
+
+	Map3 dual;
+	Map3::CellMarker<Map3::Vertex::ORBIT> boundary(dual);
+	const TimePoint start = std::chrono::system_clock::now();
+	cgogn::modeling::parallel_dual(map, dual, &boundary, {"position"},
+		[&] (Map3::Volume w) { return cgogn::geometry::centroid(map, w, position); });
+	const float64 time = elapsed(start);
+
+	cgogn::thread_pool()->set_nb_workers(nb);
+	return time;
+}
+
+int main(int argc, char** argv)
+{
+	uint32 n = 500u;
+	uint32 n3 = 40u;
+	if (argc < 2)
+		cgogn_log_info("bench_dual") << "USAGE: " << argv[0] << " [tore_size] [grid_size] (using " << n << " " << n3 << ")";
+	else
+	{
+		n = std::max(4u, uint32(std::stoi(argv[1])));
+		if (argc > 2)
+			n3 = std::max(1u, uint32(std::stoi(argv[2])));
+	}
+
+	const uint32 nb_workers = cgogn::thread_pool()->nb_workers();
+	cgogn_log_info("bench_dual") << nb_workers << " workers";
+
+	{
+		Map2 map;
+		auto position = map.add_attribute<Vec3, Map2::Vertex>("position");
+		cgogn::modeling::TriangularTore<Map2> tore(map, 2u * n, n);
+		tore.embed_into_tore(position, 10.0f, 4.0f);
+		auto centroid = [&] (Map2::Face f) { return cgogn::geometry::centroid(map, f, position); };
+
+		Map2 dual;
+		TimePoint start = std::chrono::system_clock::now();
+		cgogn::modeling::dual(map, dual, nullptr, {"position"}, centroid);
+		const float64 dual_time = elapsed(start);
+
+		Map2 pdual;
+		start = std::chrono::system_clock::now();
+		cgogn::modeling::parallel_dual(map, pdual, nullptr, {"position"}, centroid);
+		const float64 pdual_time = elapsed(start);
+
+		cgogn_log_info("bench_dual") << "CMap2, " << map.nb_cells<Map2::Face::ORBIT>() << " faces: dual " << dual_time
+			<< "s, parallel_dual " << pdual_time << "s, speedup " << dual_time / pdual_time;
+
+		Tri triangles;
+		auto tri_position = triangles.add_attribute<Vec3, Tri::Vertex>("position");
+		cgogn::modeling::parallel_loop(map, position, triangles, tri_position, 1u);
+		Map2 tri_dual;
+		start = std::chrono::system_clock::now();
+		cgogn::modeling::parallel_dual(triangles, tri_dual, nullptr, {"position"},
+			[&] (Tri::Face f) { return cgogn::geometry::centroid(triangles, f, tri_position); });
+		cgogn_log_info("bench_dual") << "CMap2Tri, " << triangles.nb_cells<Tri::Face::ORBIT>() << " faces: parallel_dual " << elapsed(start) << "s";
+	}
+
+	{
+		Map3 map;
+		tetra_grid(map, n3);
+		const float64 serial_time = bench_volume(map, 1u);
+		const float64 parallel_time = bench_volume(map, nb_workers);
+		cgogn_log_info("bench_dual") << "CMap3, " << map.nb_cells<Map3::Volume::ORBIT>() << " tetrahedra: parallel_dual 1 worker "
+			<< serial_time << "s, " << nb_workers << " workers " << parallel_time << "s, speedup " << serial_time / parallel_time;
+	}
+
+	return 0;
+}
@@ -0,0 +1,78 @@
+
+#include <chrono>
+#include <string>
+
+#include <cgogn/core/utils/logger.h>
+#include <cgogn/core/cmap/cmap2.h>
+
+#include <cgogn/geometry/types/eigen.h>
+#include <cgogn/geometry/algos/length.h>
+
+#include <cgogn/modeling/tiling/triangular_tore.h>
+#include <cgogn/modeling/algos/pliant_remeshing.h>
+#include <cgogn/modeling/algos/isotropic_remeshing.h>
+
+using namespace cgogn::numerics;
+
+using Map2 = cgogn::CMap2;
+using Vertex = Map2::Vertex;
+using Face = Map2::Face;
+using Vec3 = Eigen::Vector3d;
+
+using TimePoint = std::chrono::time_point<std::chrono::system_clock>;
+
+static float64 elapsed(const TimePoint& start)
+{
+	std::chrono::duration<float64> d = std::chrono::system_clock::now() - start;
+	return d.count();
+}
+
+static void tore(Map2& map, Map2::VertexAttribute<Vec3>& position, uint32 n)
+{
+	cgogn::modeling::TriangularTore<Map2> tore(map, 2u * n, n);
+	tore.embed_into_tore(position, 10.0f, 4.0f);
+}
+
+int main(int argc, char** argv)
+{
+	uint32 n = 500u;
+	if (argc < 2)
+		cgogn_log_info("bench_remeshing") << "USAGE: " << argv[0] << " [tore_size] (using " << n << ")";
+	else
+		n = std::max(4u, uint32(std::stoi(argv[1])));
+
+	cgogn_log_info("bench_remeshing") << 4u * n * n << " triangles, " << cgogn::thread_pool()->nb_workers() << " workers";
+
+	{
+		Map2 map;
+		auto position = map.add_attribute<Vec3, Vertex>("position");
+		tore(map, position, n);
+		TimePoint start = std::chrono::system_clock::now();
+		cgogn::modeling::pliant_remeshing(map, position);
+		cgogn_log_info("bench_remeshing") << "pliant_remeshing (1 iteration): " << elapsed(start) << "s, "
+			<< map.nb_cells<Face::ORBIT>() << " triangles";
+	}
+
+	// same resolution, coarser and finer
+	for (float64 scale : { 1.0, 2.0, 0.5 })
+	{
+		Map2 map;
+		auto position = map.add_attribute<Vec3, Vertex>("position");
+		tore(map, position, n);
+		const float64 target = scale * cgogn::geometry::mean_edge_length(map, position);
+
+		cgogn::modeling::IsotropicRemeshingStatistics statistics;
+		const uint32 nb_iterations = 5u;
+		cgogn::modeling::isotropic_remeshing(map, position, target, nb_iterations, &statistics);
+
+		cgogn_log_info("bench_remeshing") << "isotropic_remeshing x" << scale << " (" << nb_iterations << " iterations): "
+			<< statistics.total_time() << "s, " << map.nb_cells<Face::ORBIT>() << " triangles";
+		cgogn_log_info("bench_remeshing") << "  split " << statistics.split_time_ << "s (" << statistics.nb_splits_ << ")";
+		cgogn_log_info("bench_remeshing") << "  collapse " << statistics.collapse_time_ << "s (" << statistics.nb_collapses_ << ")";
+		cgogn_log_info("bench_remeshing") << "  flip " << statistics.flip_time_ << "s (" << statistics.nb_flips_ << ")";
+		cgogn_log_info("bench_remeshing") << "  smooth " << statistics.smooth_time_ << "s";
+		cgogn_log_info("bench_remeshing") << "  project " << statistics.project_time_ << "s";
+	}
+
+	return 0;
+}
@@ -0,0 +1,102 @@
+
+#include <chrono>
+#include <string>
+
+#include <cgogn/core/utils/logger.h>
+#include <cgogn/core/cmap/cmap2.h>
+
+#include <cgogn/geometry/types/eigen.h>
+
+#include <cgogn/modeling/tiling/triangular_tore.h>
+#include <cgogn/modeling/algos/catmull_clark.h>
+#include <cgogn/modeling/algos/loop.h>
+#include <cgogn/modeling/algos/parallel_subdivision.h>
+
+using namespace cgogn::numerics;
+
+using Map2 = cgogn::CMap2;
+using Vertex = Map2::Vertex;
+using Vec3 = Eigen::Vector3d;
+
+using TimePoint = std::chrono::time_point<std::chrono::system_clock>;
+
+static float64 elapsed(const TimePoint& start)
+{
+	std::chrono::duration<float64> d = std::chrono::system_clock::now() - start;
+	return d.count();
+}
+
+static void tore(Map2& map, Map2::VertexAttribute<Vec3>& position, uint32 n)
+{
+	cgogn::modeling::TriangularTore<Map2> tore(map, 2u * n, n);
+	tore.embed_into_tore(position, 10.0f, 4.0f);
+}
+
+/**
+ * \brief in place subdivision (catmull_clark / loop) against the parallel subdivision that emits a new map
+ */
+static void bench(uint32 n, uint32 nb_levels, bool cc)
+{
+	using namespace cgogn::modeling;
+
+	float64 in_place_time = 0.0;
+	uint32 nb_faces = 0u;
+	{
+		Map2 map;
+		auto position = map.add_attribute<Vec3, Vertex>("position");
+		tore(map, position, n);
+		TimePoint start = std::chrono::system_clock::now();
+		for (uint32 l = 0u; l < nb_levels; ++l)
+		{
+			if (cc)
+				catmull_clark(map, position);
+			else
+				loop(map, position);
+		}
+		in_place_time = elapsed(start);
+		nb_faces = map.nb_cells<Map2::Face::ORBIT>();
+	}
+
+	float64 parallel_time = 0.0;
+	{
+		Map2 map;
+		auto position = map.add_attribute<Vec3, Vertex>("position");
+		tore(map, position, n);
+		TimePoint start = std::chrono::system_clock::now();
+		if (cc)
+		{
+			cgogn::CMap2Quad quads;
+			auto quad_position = quads.add_attribute<Vec3, cgogn::CMap2Quad::Vertex>("position");
+			parallel_catmull_clark(map, position, quads, quad_position, nb_levels);
+			parallel_time = elapsed(start);
+		}
+		else
+		{
+			cgogn::CMap2Tri triangles;
+			auto tri_position = triangles.add_attribute<Vec3, cgogn::CMap2Tri::Vertex>("position");
+			parallel_loop(map, position, triangles, tri_position, nb_levels);
+			parallel_time = elapsed(start);
+		}
+	}
+
+	cgogn_log_info("bench_subdivision") << (cc ? "Catmull-Clark" : "Loop") << " level " << nb_levels << " (" << nb_faces << " faces): "
+		<< (cc ? "catmull_clark " : "loop ") << in_place_time << "s, "
+		<< (cc ? "parallel_catmull_clark " : "parallel_loop ") << parallel_time << "s, speedup " << in_place_time / parallel_time;
+}
+
+int main(int argc, char** argv)
+{
+	uint32 n = 100u;
+	if (argc < 2)
+		cgogn_log_info("bench_subdivision") << "USAGE: " << argv[0] << " [tore_size] (using " << n << ")";
+	else
+		n = std::max(4u, uint32(std::stoi(argv[1])));
+
+	cgogn_log_info("bench_subdivision") << 4u * n * n << " control triangles, " << cgogn::thread_pool()->nb_workers() << " workers";
+
+	for (bool cc : { true, false })
+		for (uint32 l = 1u; l <= 4u; ++l)
+			bench(n, l, cc);
+
+	return 0;
+}
@@ -0,0 +1,134 @@
+#include <array>
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <cgogn/core/utils/logger.h>
+#include <cgogn/core/cmap/cmap3.h>
+#include <cgogn/core/cmap/cmap3_hexa.h>
+#include <cgogn/core/cmap/cmap3_tetra.h>
+
+#include <cgogn/geometry/types/eigen.h>
+
+#include <cgogn/modeling/tiling/hexa_grid.h>
+#include <cgogn/modeling/algos/tetrahedralization.h>
+
+using namespace cgogn::numerics;
+
+using Map3 = cgogn::CMap3;
+using Hexa = cgogn::CMap3Hexa;
+using Tetra = cgogn::CMap3Tetra;
+using Vec3 = Eigen::Vector3d;
+
+using TimePoint = std::chrono::time_point<std::chrono::system_clock>;
+
+static float64 elapsed(const TimePoint& start)
+{
+	std::chrono::duration<float64> d = std::chrono::system_clock::now() - start;
+	return d.count();
+}
+
+/**
+ * \brief the same tetrahedra built one at a time in a CMap3:
+ * one pyramid per tetrahedron, its faces sewn to the faces already created with the same vertices
+ */
+static uint32 tetrahedralize_one_by_one(const Hexa& hexa, const Hexa::VertexAttribute<Vec3>& position, Map3& map)
+{
+	std::vector<uint32> vertex_index(hexa.attribute_container<Hexa::Vertex::ORBIT>().end());
+	std::vector<Vec3> positions;
+	hexa.foreach_cell([&] (Hexa::Vertex v)
+	{
+		vertex_index[hexa.embedding(v)] = uint32(positions.size());
+		positions.push_back(position[v]);
+	});
+	auto index = [&] (cgogn::Dart d) { return vertex_index[hexa.embedding(Hexa::Vertex(d))]; };
+
+	Map3::Builder builder(map);
+	std::vector<uint32> origin;
+	std::map<std::array<uint32, 3>, cgogn::Dart> faces;
+	std::vector<uint32> tetras;
+	uint32 nb = 0u;
+	hexa.foreach_cell([&] (Hexa::Volume w)
+	{
+		tetras.resize(4u * cgogn::modeling::internal::cone_tetrahedra(hexa, w.dart, index, nullptr));
+		cgogn::modeling::internal::cone_tetrahedra(hexa, w.dart, index, tetras.data());
+		for (uint32 t = 0u, end = uint32(tetras.size()); t < end; t += 4u)
+		{
+			const cgogn::Dart d = builder.add_pyramid_topo_fp(3u);
+			const cgogn::Dart vertices[4] = { d, map.phi1(d), map.phi_1(d), map.phi_1(map.phi2(map.phi_1(d))) };
+			for (uint32 q = 0u; q < 4u; ++q)
+			{
+				cgogn::Dart dd = vertices[q];
+				do
+				{
+					if (origin.size() <= dd.index)
+						origin.resize(dd.index + 1u);
+					origin[dd.index] = tetras[t + q];
+					dd = map.phi1(map.phi2(dd));
+				} while (dd != vertices[q]);
+			}
+			map.foreach_dart_of_orbit(Map3::Volume(d), [&] (cgogn::Dart e)
+			{
+				const std::array<uint32, 3> key = {{ origin[map.phi1(e).index], origin[e.index], origin[map.phi_1(e).index] }};
+				auto it = faces.find(key);
+				if (it != faces.end())
+				{
+					builder.phi3_sew(e, it->second);
+					faces.erase(it);
+				}
+				else
+					faces[{{ origin[e.index], origin[map.phi1(e).index], origin[map.phi1(map.phi1(e)).index] }}] = e;
+			});
+			++nb;
+		}
+	});
+	builder.close_map();
+
+	auto map_position = map.add_attribute<Vec3, Map3::Vertex>("position");
+	for (uint32 d = 0u; d < origin.size(); ++d)
+		map_position[Map3::Vertex(cgogn::Dart(d))] = positions[origin[d]];
+	return nb;
+}
+
+int main(int argc, char** argv)
+{
+	uint32 n = 60u;
+	if (argc < 2)
+		cgogn_log_info("bench_tetrahedralization") << "USAGE: " << argv[0] << " [grid_size] (using " << n << ")";
+	else
+		n = std::max(1u, uint32(std::stoi(argv[1])));
+
+	const uint32 nb_workers = cgogn::thread_pool()->nb_workers();
+	cgogn_log_info("bench_tetrahedralization") << nb_workers << " workers";
+
+	Hexa hexa;
+	auto position = hexa.add_attribute<Vec3, Hexa::Vertex>("position");
+	cgogn::modeling::HexaGrid<Hexa> grid(hexa, n, n, n);
+	grid.embed_into_grid(position, 1.0f, 1.0f, 1.0f);
+	const uint32 nb_hexa = hexa.nb_cells<Hexa::Volume::ORBIT>();
+
+	TimePoint start = std::chrono::system_clock::now();
+	Map3 map;
+	const uint32 nb = tetrahedralize_one_by_one(hexa, position, map);
+	const float64 serial_time = elapsed(start);
+	cgogn_log_info("bench_tetrahedralization") << nb_hexa << " hexahedra, CMap3 built tetrahedron by tetrahedron: "
+		<< nb << " tetrahedra in " << serial_time << "s";
+
+	for (uint32 w : { 1u, nb_workers })
+	{
+		cgogn::thread_pool()->set_nb_workers(w);
+		Tetra tetra;
+		auto tetra_position = tetra.add_attribute<Vec3, Tetra::Vertex>("position");
+		start = std::chrono::system_clock::now();
+		const uint32 nb_tetra = cgogn::modeling::tetrahedralize(hexa, position, tetra, tetra_position);
+		const float64 time = elapsed(start);
+		cgogn_log_info("bench_tetrahedralization") << "tetrahedralize in CMap3Tetra, " << w << " workers: " << nb_tetra
+			<< " tetrahedra in " << time << "s, " << float64(nb_tetra) / time << " tetrahedra/s, speedup " << serial_time / time;
+		if (w == nb_workers)
+			break;
+	}
+	cgogn::thread_pool()->set_nb_workers(nb_workers);
+
+	return 0;
+}
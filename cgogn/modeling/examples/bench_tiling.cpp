@@ -0,0 +1,120 @@
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <cgogn/core/utils/logger.h>
+#include <cgogn/core/cmap/cmap2.h>
+#include <cgogn/core/cmap/cmap2_quad.h>
+#include <cgogn/core/cmap/cmap2_tri.h>
+#include <cgogn/core/cmap/cmap3_hexa.h>
+
+#include <cgogn/geometry/types/eigen.h>
+
+#include <cgogn/modeling/tiling/square_grid.h>
+#include <cgogn/modeling/tiling/triangular_grid.h>
+#include <cgogn/modeling/tiling/hexa_grid.h>
+
+using namespace cgogn::numerics;
+
+using Vec3 = Eigen::Vector3d;
+
+using TimePoint = std::chrono::time_point<std::chrono::system_clock>;
+
+static float64 elapsed(const TimePoint& start)
+{
+	std::chrono::duration<float64> d = std::chrono::system_clock::now() - start;
+	return d.count();
+}
+
+/**
+ * \brief build a n x n grid and embed its vertices
+ */
+template <template <typename> class GRID, typename MAP>
+static void bench_grid(const std::string& name, uint32 n)
+{
+	MAP map;
+	auto position = map.template add_attribute<Vec3, typename MAP::Vertex>("position");
+
+	const TimePoint start = std::chrono::system_clock::now();
+	GRID<MAP> grid(map, n, n);
+	grid.embed_into_grid(position, 1.0f, 1.0f, 0.0f);
+	const float64 time = elapsed(start);
+
+	const uint32 nb_faces = map.template nb_cells<MAP::Face::ORBIT>();
+	cgogn_log_info("bench_tiling") << name << ": " << nb_faces << " faces in " << time << "s, " << float64(nb_faces) / time << " faces/s";
+}
+
+/**
+ * \brief the same grid built from vertex indices, the generic import path of the fixed size face maps
+ */
+template <typename MAP>
+static void bench_indices(const std::string& name, uint32 n, bool triangles)
+{
+	MAP map;
+	auto position = map.template add_attribute<Vec3, typename MAP::Vertex>("position");
+
+	const TimePoint start = std::chrono::system_clock::now();
+	std::vector<uint32> indices;
+	indices.reserve((triangles ? 6u : 4u) * n * n);
+	for (uint32 i = 0u; i < n; ++i)
+	{
+		for (uint32 j = 0u; j < n; ++j)
+		{
+			const uint32 v = i * (n + 1u) + j;
+			if (triangles)
+				indices.insert(indices.end(), { v, v + 1u, v + n + 1u, v + 1u, v + n + 2u, v + n + 1u });
+			else
+				indices.insert(indices.end(), { v, v + 1u, v + n + 2u, v + n + 1u });
+		}
+	}
+	typename MAP::Builder builder(map);
+	const uint32 first = builder.create_faces_from_indices(indices, (n + 1u) * (n + 1u));
+	for (uint32 i = 0u; i <= n; ++i)
+		for (uint32 j = 0u; j <= n; ++j)
+			position[first + i * (n + 1u) + j] = Vec3(float64(j) / n, float64(i) / n, 0.0);
+	const float64 time = elapsed(start);
+
+	const uint32 nb_faces = map.template nb_cells<MAP::Face::ORBIT>();
+	cgogn_log_info("bench_tiling") << name << ": " << nb_faces << " faces in " << time << "s, " << float64(nb_faces) / time << " faces/s";
+}
+
+int main(int argc, char** argv)
+{
+	uint32 n = 2000u;
+	uint32 n3 = 100u;
+	if (argc < 2)
+		cgogn_log_info("bench_tiling") << "USAGE: " << argv[0] << " [grid_size] [hexa_grid_size] (using " << n << " " << n3 << ")";
+	else
+	{
+		n = std::max(1u, uint32(std::stoi(argv[1])));
+		if (argc > 2)
+			n3 = std::max(1u, uint32(std::stoi(argv[2])));
+	}
+
+	cgogn_log_info("bench_tiling") << cgogn::thread_pool()->nb_workers() << " workers";
+
+	bench_grid<cgogn::modeling::SquareGrid, cgogn::CMap2>("SquareGrid<CMap2>", n);
+	bench_grid<cgogn::modeling::SquareGrid, cgogn::CMap2Quad>("SquareGrid<CMap2Quad>", n);
+	bench_indices<cgogn::CMap2Quad>("CMap2Quad from indices", n, false);
+	bench_grid<cgogn::modeling::TriangularGrid, cgogn::CMap2>("TriangularGrid<CMap2>", n);
+	bench_grid<cgogn::modeling::TriangularGrid, cgogn::CMap2Tri>("TriangularGrid<CMap2Tri>", n);
+	bench_indices<cgogn::CMap2Tri>("CMap2Tri from indices", n, true);
+
+	{
+		using Hexa = cgogn::CMap3Hexa;
+		Hexa map;
+		auto position = map.add_attribute<Vec3, Hexa::Vertex>("position");
+
+		const TimePoint start = std::chrono::system_clock::now();
+		cgogn::modeling::HexaGrid<Hexa> grid(map, n3, n3, n3);
+		grid.embed_into_grid(position, 1.0f, 1.0f, 1.0f);
+		const float64 time = elapsed(start);
+
+		const uint32 nb_volumes = map.nb_cells<Hexa::Volume::ORBIT>();
+		cgogn_log_info("bench_tiling") << "HexaGrid<CMap3Hexa>: " << nb_volumes << " hexahedra in " << time << "s, "
+			<< float64(nb_volumes) / time << " hexahedra/s, " << float64(6u * nb_volumes) / time << " faces/s";
+	}
+
+	return 0;
+}
@@ -0,0 +1,188 @@
+
+#include <chrono>
+#include <map>
+#include <string>
+
+#include <cgogn/core/utils/logger.h>
+#include <cgogn/core/cmap/cmap3.h>
+#include <cgogn/core/cmap/cmap3_tetra.h>
+
+#include <cgogn/io/map_import.h>
+
+#include <cgogn/geometry/types/eigen.h>
+#include <cgogn/geometry/functions/predicates.h>
+
+#include <cgogn/modeling/algos/volume_decimation.h>
+
+#define DEFAULT_MESH_PATH CGOGN_STR(CGOGN_TEST_MESHES_PATH)
+
+using namespace cgogn::numerics;
+
+using Map3 = cgogn::CMap3;
+using Tetra = cgogn::CMap3Tetra;
+using Vec3 = Eigen::Vector3d;
+
+using TimePoint = std::chrono::time_point<std::chrono::system_clock>;
+
+static float64 elapsed(const TimePoint& start)
+{
+	std::chrono::duration<float64> d = std::chrono::system_clock::now() - start;
+	return d.count();
+}
+
+struct TetraSoup
+{
+	std::vector<Vec3> positions_;
+	std::vector<uint32> tetras_;
+
+	uint32 nb_tetras() const { return uint32(tetras_.size() / 4u); }
+
+	/**
+	 * \brief the tetrahedra of the imported map, the other volumes are ignored
+	 */
+	void extract(Map3& map, const Map3::VertexAttribute<Vec3>& position)
+	{
+		auto index = map.add_attribute<uint32, Map3::Vertex>("bench_index");
+		map.foreach_cell([&] (Map3::Vertex v)
+		{
+			index[v] = uint32(positions_.size());
+			positions_.push_back(position[v]);
+		});
+		map.foreach_cell([&] (Map3::Volume w)
+		{
+			const cgogn::Dart d = w.dart;
+			if (map.codegree(w) != 4u)
+				return;
+			tetras_.push_back(index[Map3::Vertex(d)]);
+			tetras_.push_back(index[Map3::Vertex(map.phi1(d))]);
+			tetras_.push_back(index[Map3::Vertex(map.phi_1(d))]);
+			tetras_.push_back(index[Map3::Vertex(map.phi_1(map.phi2(map.phi_1(d))))]);
+		});
+		map.remove_attribute(index);
+	}
+
+	/**
+	 * \brief split each tetrahedron into 8 through its edge midpoints, keeping the orientation of the parent
+	 */
+	void subdivide()
+	{
+		std::map<std::pair<uint32, uint32>, uint32> midpoints;
+		auto midpoint = [&] (uint32 a, uint32 b) -> uint32
+		{
+			const std::pair<uint32, uint32> key = a < b ? std::make_pair(a, b) : std::make_pair(b, a);
+			auto it = midpoints.find(key);
+			if (it != midpoints.end())
+				return it->second;
+			const uint32 m = uint32(positions_.size());
+			positions_.push_back(0.5 * (positions_[a] + positions_[b]));
+			midpoints.emplace(key, m);
+			return m;
+		};
+		auto sign = [&] (const uint32* t)
+		{
+			return cgogn::geometry::orient3d(positions_[t[0]], positions_[t[1]], positions_[t[2]], positions_[t[3]]) > 0;
+		};
+
+		std::vector<uint32> result;
+		result.reserve(8u * tetras_.size());
+		for (uint32 i = 0u, end = nb_tetras(); i < end; ++i)
+		{
+			const uint32* t = &tetras_[4u * i];
+			const bool s = sign(t);
+			const uint32 a = t[0], b = t[1], c = t[2], d = t[3];
+			const uint32 ab = midpoint(a, b), ac = midpoint(a, c), ad = midpoint(a, d);
+			const uint32 bc = midpoint(b, c), bd = midpoint(b, d), cd = midpoint(c, d);
+			// 4 corners, then the inner octahedron cut around its diagonal ab-cd
+			const uint32 children[8][4] = {
+				{ a, ab, ac, ad }, { ab, b, bc, bd }, { ac, bc, c, cd }, { ad, bd, cd, d },
+				{ ab, cd, ac, bc }, { ab, cd, bc, bd }, { ab, cd, bd, ad }, { ab, cd, ad, ac }
+			};
+			for (const auto& child : children)
+			{
+				uint32 v[4] = { child[0], child[1], child[2], child[3] };
+				if (sign(v) != s)
+					std::swap(v[1], v[2]);
+				result.insert(result.end(), v, v + 4);
+			}
+		}
+		tetras_.swap(result);
+	}
+
+	void build(Tetra& map, Tetra::VertexAttribute<Vec3>& position) const
+	{
+		Tetra::Builder builder(map);
+		const uint32 first = builder.create_volumes_from_indices(tetras_, uint32(positions_.size()));
+		for (uint32 i = 0u, end = uint32(positions_.size()); i < end; ++i)
+			position[first + i] = positions_[i];
+	}
+};
+
+/**
+ * \brief collapse half of the vertices of the soup with the given boundary constraint
+ */
+static void bench(const TetraSoup& soup, cgogn::modeling::VolumeBoundaryConstraint boundary)
+{
+	Tetra map;
+	auto position = map.add_attribute<Vec3, Tetra::Vertex>("position");
+	TimePoint start = std::chrono::system_clock::now();
+	soup.build(map, position);
+	const float64 build_time = elapsed(start);
+	const uint32 nb_vertices = map.nb_cells<Tetra::Vertex::ORBIT>();
+
+	start = std::chrono::system_clock::now();
+	const uint32 nb = cgogn::modeling::decimate_volume(map, position, nb_vertices / 2u, boundary);
+	const float64 time = elapsed(start);
+
+	cgogn_log_info("bench_volume_decimation") << (boundary == cgogn::modeling::VolumeBoundary_Fixed ? "fixed" : "locked")
+		<< " boundary: build " << build_time << "s, " << nb << " collapses, " << float64(nb) / time << " collapses/s ("
+		<< map.nb_cells<Tetra::Vertex::ORBIT>() << " vertices, " << map.nb_cells<Tetra::Volume::ORBIT>() << " tetrahedra left)";
+}
+
+int main(int argc, char** argv)
+{
+	std::string filename;
+	uint32 nb_levels = 2u;
+	if (argc < 2)
+	{
+		filename = std::string(DEFAULT_MESH_PATH) + std::string("tet/hand.tet");
+		cgogn_log_info("bench_volume_decimation") << "USAGE: " << argv[0] << " [filename] [nb_subdivisions] (using " << filename << " " << nb_levels << ")";
+	}
+	else
+	{
+		filename = std::string(argv[1]);
+		if (argc > 2)
+			nb_levels = std::min(4u, uint32(std::stoi(argv[2])));
+	}
+
+	TetraSoup soup;
+	{
+		Map3 map;
+		cgogn::io::import_volume<Vec3>(map, filename);
+		auto position = map.get_attribute<Vec3, Map3::Vertex>("position");
+		if (!position.is_valid())
+		{
+			cgogn_log_error("bench_volume_decimation") << "Missing attribute position. Aborting.";
+			return 1;
+		}
+
+		// the generic map is decimated as imported
+		const uint32 nb_vertices = map.nb_cells<Map3::Vertex::ORBIT>();
+		soup.extract(map, position);
+		const TimePoint start = std::chrono::system_clock::now();
+		const uint32 nb = cgogn::modeling::decimate_volume(map, position, nb_vertices / 2u);
+		cgogn_log_info("bench_volume_decimation") << "CMap3, " << nb_vertices << " vertices: " << nb << " collapses, "
+			<< float64(nb) / elapsed(start) << " collapses/s";
+	}
+
+	for (uint32 l = 0u; l <= nb_levels; ++l)
+	{
+		cgogn_log_info("bench_volume_decimation") << "CMap3Tetra, subdivision level " << l << ": "
+			<< soup.positions_.size() << " vertices, " << soup.nb_tetras() << " tetrahedra";
+		bench(soup, cgogn::modeling::VolumeBoundary_Fixed);
+		bench(soup, cgogn::modeling::VolumeBoundary_Locked);
+		if (l < nb_levels)
+			soup.subdivide();
+	}
+
+	return 0;
+}
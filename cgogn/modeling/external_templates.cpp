@@ -26,8 +26,11 @@
 #include <cgogn/modeling/algos/catmull_clark.h>
 #include <cgogn/modeling/algos/doo_sabin.h>
 #include <cgogn/modeling/algos/decimation.h>
+#include <cgogn/modeling/algos/volume_decimation.h>
 #include <cgogn/modeling/algos/pliant_remeshing.h>
+#include <cgogn/modeling/algos/isotropic_remeshing.h>
 #include <cgogn/modeling/algos/refinements.h>
+#include <cgogn/modeling/tiling/hexa_grid.h>
 #include <cgogn/modeling/tiling/square_cylinder.h>
 #include <cgogn/modeling/tiling/square_grid.h>
 #include <cgogn/modeling/tiling/square_tore.h>
@@ -55,11 +58,19 @@ template CGOGN_MODELING_API void doo_sabin(CMap2&, CMap2::VertexAttribute<Eigen:
 
 
 
-template CGOGN_MODELING_API void decimate(CMap2&, CMap2::VertexAttribute<Eigen::Vector3f>&, EdgeTraversorType, EdgeApproximatorType, uint32);
-template CGOGN_MODELING_API void decimate(CMap2&, CMap2::VertexAttribute<Eigen::Vector3d>&, EdgeTraversorType, EdgeApproximatorType, uint32);
+template CGOGN_MODELING_API void decimate(CMap2&, CMap2::VertexAttribute<Eigen::Vector3f>&, EdgeTraversorType, EdgeApproximatorType, uint32, ProgressiveMeshRecorder<Eigen::Vector3f>*);
+template CGOGN_MODELING_API void decimate(CMap2&, CMap2::VertexAttribute<Eigen::Vector3d>&, EdgeTraversorType, EdgeApproximatorType, uint32, ProgressiveMeshRecorder<Eigen::Vector3d>*);
+template CGOGN_MODELING_API uint32 parallel_decimate(CMap2&, CMap2::VertexAttribute<Eigen::Vector3f>&, uint32, float32);
+template CGOGN_MODELING_API uint32 parallel_decimate(CMap2&, CMap2::VertexAttribute<Eigen::Vector3d>&, uint32, float64);
+template CGOGN_MODELING_API uint32 decimate_volume(CMap3&, CMap3::VertexAttribute<Eigen::Vector3f>&, uint32, VolumeBoundaryConstraint);
+template CGOGN_MODELING_API uint32 decimate_volume(CMap3&, CMap3::VertexAttribute<Eigen::Vector3d>&, uint32, VolumeBoundaryConstraint);
+template CGOGN_MODELING_API uint32 decimate_volume(CMap3Tetra&, CMap3Tetra::VertexAttribute<Eigen::Vector3f>&, uint32, VolumeBoundaryConstraint);
+template CGOGN_MODELING_API uint32 decimate_volume(CMap3Tetra&, CMap3Tetra::VertexAttribute<Eigen::Vector3d>&, uint32, VolumeBoundaryConstraint);
 
 template CGOGN_MODELING_API void pliant_remeshing(CMap2&, CMap2::VertexAttribute<Eigen::Vector3f>&);
 template CGOGN_MODELING_API void pliant_remeshing(CMap2&, CMap2::VertexAttribute<Eigen::Vector3d>&);
+template CGOGN_MODELING_API void isotropic_remeshing(CMap2&, CMap2::VertexAttribute<Eigen::Vector3f>&, float32, uint32, IsotropicRemeshingStatistics*);
+template CGOGN_MODELING_API void isotropic_remeshing(CMap2&, CMap2::VertexAttribute<Eigen::Vector3d>&, float64, uint32, IsotropicRemeshingStatistics*);
 
 template CGOGN_MODELING_API CMap2::Vertex triangule(CMap2&, CMap2::Face);
 template CGOGN_MODELING_API CMap3::Vertex triangule(CMap3&, CMap3::Face);
@@ -67,6 +78,7 @@ template CGOGN_MODELING_API void triangule(CMap2&, CMap2::VertexAttribute<Eigen:
 template CGOGN_MODELING_API void triangule(CMap2&, CMap2::VertexAttribute<Eigen::Vector3d>&);
 
 
+template class CGOGN_MODELING_API HexaGrid<CMap3Hexa>;
 template class CGOGN_MODELING_API SquareCylinder<CMap2>;
 template class CGOGN_MODELING_API SquareGrid<CMap2>;
 template class CGOGN_MODELING_API SquareTore<CMap2>;
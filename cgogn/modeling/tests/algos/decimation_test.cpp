@@ -0,0 +1,115 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <algorithm>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include <cgogn/core/cmap/cmap2.h>
+#include <cgogn/geometry/types/eigen.h>
+#include <cgogn/modeling/tiling/triangular_grid.h>
+#include <cgogn/modeling/tiling/triangular_tore.h>
+#include <cgogn/modeling/algos/decimation.h>
+
+using namespace cgogn::numerics;
+
+using Vec3 = Eigen::Vector3d;
+using Map2 = cgogn::CMap2;
+using Vertex = Map2::Vertex;
+
+static std::vector<Vec3> sorted_positions(const Map2& map, const Map2::VertexAttribute<Vec3>& position)
+{
+	std::vector<Vec3> result;
+	map.foreach_cell([&] (Vertex v) { result.push_back(position[v]); });
+	std::sort(result.begin(), result.end(), [] (const Vec3& a, const Vec3& b)
+	{
+		return std::lexicographical_compare(a.data(), a.data() + 3, b.data(), b.data() + 3);
+	});
+	return result;
+}
+
+static std::vector<Vec3> decimated_tore(uint32 nb_workers)
+{
+	Map2 map;
+	auto position = map.add_attribute<Vec3, Vertex>("position");
+	cgogn::modeling::TriangularTore<Map2> tore(map, 60u, 30u);
+	tore.embed_into_tore(position, 10.0f, 4.0f);
+	std::mt19937 gen(11);
+	std::uniform_real_distribution<float64> jitter(-0.05, 0.05);
+	map.foreach_cell([&] (Vertex v) { position[v] += Vec3(jitter(gen), jitter(gen), jitter(gen)); });
+
+	const uint32 max_nb_workers = cgogn::thread_pool()->max_nb_workers();
+	cgogn::thread_pool()->set_nb_workers(std::min(nb_workers, max_nb_workers));
+	const uint32 nb_collapses = cgogn::modeling::parallel_decimate(map, position, 600u);
+	cgogn::thread_pool()->set_nb_workers();
+
+	EXPECT_EQ(nb_collapses, 1800u - 600u);
+	EXPECT_EQ(map.nb_cells<Vertex::ORBIT>(), 600u);
+	EXPECT_TRUE(map.check_map_integrity());
+	EXPECT_EQ(map.nb_cells<Map2::Face::ORBIT>(), 2u * 600u); // still a torus
+
+	return sorted_positions(map, position);
+}
+
+TEST(ParallelDecimationTest, target_vertex_count)
+{
+	// the selected edges do not depend on the number of threads
+	const std::vector<Vec3> sequential = decimated_tore(0u);
+	EXPECT_EQ(decimated_tore(1u), sequential);
+	EXPECT_EQ(decimated_tore(4u), sequential);
+}
+
+TEST(ParallelDecimationTest, error_threshold)
+{
+	// flat grid with a bump: the flat parts are decimated, the bump is not touched
+	Map2 map;
+	auto position = map.add_attribute<Vec3, Vertex>("position");
+	cgogn::modeling::TriangularGrid<Map2> grid(map, 30u, 30u);
+	grid.embed_into_grid(position, 30.0f, 30.0f, 0.0f);
+	Vertex bump;
+	float64 best = std::numeric_limits<float64>::max();
+	map.foreach_cell([&] (Vertex v)
+	{
+		const float64 d = (position[v] - Vec3(22.5, 13.0, 0.0)).norm();
+		if (d < best) { best = d; bump = v; }
+	});
+	const Vec3 bump_position = position[bump] + Vec3(0.0, 0.0, 1.0);
+	position[bump] = bump_position;
+
+	const uint32 nbv = map.nb_cells<Vertex::ORBIT>();
+	const uint32 nb_collapses = cgogn::modeling::parallel_decimate(map, position, 0u, 1e-9);
+	EXPECT_GT(nb_collapses, nbv / 2u);
+	EXPECT_EQ(map.nb_cells<Vertex::ORBIT>(), nbv - nb_collapses);
+	EXPECT_TRUE(map.check_map_integrity());
+
+	uint32 nb_bump = 0u;
+	map.foreach_cell([&] (Vertex v)
+	{
+		if ((position[v] - bump_position).norm() < 1e-9)
+			++nb_bump;
+		else
+			EXPECT_NEAR(position[v][2], 0.0, 1e-6);
+	});
+	EXPECT_EQ(nb_bump, 1u);
+}
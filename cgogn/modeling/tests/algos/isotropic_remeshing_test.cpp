@@ -0,0 +1,175 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include <cgogn/core/cmap/cmap2.h>
+#include <cgogn/geometry/types/eigen.h>
+#include <cgogn/geometry/algos/length.h>
+#include <cgogn/geometry/algos/face_bvh.h>
+#include <cgogn/modeling/tiling/triangular_grid.h>
+#include <cgogn/modeling/tiling/triangular_tore.h>
+#include <cgogn/modeling/algos/isotropic_remeshing.h>
+
+using namespace cgogn::numerics;
+
+using Vec3 = Eigen::Vector3d;
+using Map2 = cgogn::CMap2;
+using Vertex = Map2::Vertex;
+using Edge = Map2::Edge;
+using Face = Map2::Face;
+
+class IsotropicRemeshingTest : public ::testing::Test
+{
+protected:
+
+	Map2 map_;
+	Map2::VertexAttribute<Vec3> position_;
+
+	Map2 input_;
+	Map2::VertexAttribute<Vec3> input_position_;
+
+	IsotropicRemeshingTest()
+	{
+		position_ = map_.add_attribute<Vec3, Vertex>("position");
+		input_position_ = input_.add_attribute<Vec3, Vertex>("position");
+	}
+
+	void jittered_tore(Map2& map, Map2::VertexAttribute<Vec3>& position)
+	{
+		cgogn::modeling::TriangularTore<Map2> tore(map, 60u, 20u);
+		tore.embed_into_tore(position, 10.0f, 4.0f);
+		std::mt19937 gen(3);
+		std::uniform_real_distribution<float64> jitter(-0.1, 0.1);
+		map.foreach_cell([&] (Vertex v) { position[v] += Vec3(jitter(gen), jitter(gen), jitter(gen)); });
+	}
+
+	// all the faces are triangles and the edge lengths are close to the target
+	void check_result(float64 target)
+	{
+		EXPECT_TRUE(map_.check_map_integrity());
+		map_.foreach_cell([&] (Face f) { EXPECT_EQ(map_.codegree(f), 3u); });
+
+		uint32 nb_edges = 0u;
+		uint32 nb_out_of_range = 0u;
+		map_.foreach_cell([&] (Edge e)
+		{
+			const float64 l = cgogn::geometry::length(map_, e, position_);
+			EXPECT_LT(l, 2.0 * target);
+			if (l < 0.5 * target || l > 1.5 * target)
+				++nb_out_of_range;
+			++nb_edges;
+		});
+		EXPECT_LT(nb_out_of_range, nb_edges / 20u);
+		EXPECT_NEAR(cgogn::geometry::mean_edge_length(map_, position_), target, 0.1 * target);
+
+		// the vertices are projected onto the input surface
+		cgogn::geometry::FaceBVH<Map2, Vec3> bvh(input_, input_position_);
+		map_.foreach_cell([&] (Vertex v)
+		{
+			cgogn::geometry::FaceBVH<Map2, Vec3>::Projection proj;
+			ASSERT_TRUE(bvh.closest_point(position_[v], proj));
+			EXPECT_LT(proj.distance, 1e-9);
+		});
+	}
+};
+
+TEST_F(IsotropicRemeshingTest, refine)
+{
+	jittered_tore(map_, position_);
+	jittered_tore(input_, input_position_);
+	const uint32 nb_vertices = map_.nb_cells<Vertex::ORBIT>();
+	const float64 target = 0.5 * cgogn::geometry::mean_edge_length(map_, position_);
+
+	cgogn::modeling::IsotropicRemeshingStatistics statistics;
+	cgogn::modeling::isotropic_remeshing(map_, position_, target, 5u, &statistics);
+
+	EXPECT_GT(map_.nb_cells<Vertex::ORBIT>(), 3u * nb_vertices);
+	EXPECT_GT(statistics.nb_splits_, 0u);
+	EXPECT_GT(statistics.nb_flips_, 0u);
+	EXPECT_GT(statistics.total_time(), 0.0);
+	check_result(target);
+}
+
+TEST_F(IsotropicRemeshingTest, coarsen)
+{
+	jittered_tore(map_, position_);
+	jittered_tore(input_, input_position_);
+	const uint32 nb_vertices = map_.nb_cells<Vertex::ORBIT>();
+	const float64 target = 2.0 * cgogn::geometry::mean_edge_length(map_, position_);
+
+	cgogn::modeling::IsotropicRemeshingStatistics statistics;
+	cgogn::modeling::isotropic_remeshing(map_, position_, target, 5u, &statistics);
+
+	EXPECT_LT(map_.nb_cells<Vertex::ORBIT>(), nb_vertices / 3u);
+	EXPECT_GT(statistics.nb_collapses_, 0u);
+	check_result(target);
+}
+
+TEST_F(IsotropicRemeshingTest, boundary)
+{
+	// the boundary of a flat grid is refined but not moved
+	cgogn::modeling::TriangularGrid<Map2> grid(map_, 10u, 10u);
+	grid.embed_into_grid(position_, 1.0f, 1.0f, 0.0f);
+	cgogn::modeling::TriangularGrid<Map2> input_grid(input_, 10u, 10u);
+	input_grid.embed_into_grid(input_position_, 1.0f, 1.0f, 0.0f);
+	const float64 target = 0.5 * cgogn::geometry::mean_edge_length(map_, position_);
+
+	std::vector<std::pair<Vec3, Vec3>> boundary_segments;
+	input_.foreach_cell([&] (Edge e)
+	{
+		if (input_.is_incident_to_boundary(e))
+		{
+			std::pair<Vertex,Vertex> v = input_.vertices(e);
+			boundary_segments.push_back(std::make_pair(input_position_[v.first], input_position_[v.second]));
+		}
+	});
+	EXPECT_EQ(boundary_segments.size(), 40u);
+
+	cgogn::modeling::isotropic_remeshing(map_, position_, target, 3u);
+	EXPECT_TRUE(map_.check_map_integrity());
+	map_.foreach_cell([&] (Face f) { EXPECT_EQ(map_.codegree(f), 3u); });
+
+	uint32 nb_boundary = 0u;
+	map_.foreach_cell([&] (Vertex v)
+	{
+		const Vec3& p = position_[v];
+		EXPECT_NEAR(p[2], 0.0, 1e-12);
+		if (map_.is_incident_to_boundary(v))
+		{
+			++nb_boundary;
+			float64 distance = std::numeric_limits<float64>::max();
+			for (const std::pair<Vec3, Vec3>& s : boundary_segments)
+			{
+				const Vec3 u = s.second - s.first;
+				const float64 t = std::min(1.0, std::max(0.0, (p - s.first).dot(u) / u.squaredNorm()));
+				distance = std::min(distance, (s.first + t * u - p).norm());
+			}
+			EXPECT_LT(distance, 1e-9);
+		}
+	});
+	EXPECT_GE(nb_boundary, 80u);
+}
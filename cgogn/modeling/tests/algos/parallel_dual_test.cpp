@@ -0,0 +1,362 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <algorithm>
+#include <array>
+#include <map>
+
+#include <gtest/gtest.h>
+
+#include <cgogn/core/cmap/cmap2.h>
+#include <cgogn/core/cmap/cmap3_tetra.h>
+#include <cgogn/core/cmap/cmap3_hexa.h>
+#include <cgogn/geometry/types/eigen.h>
+#include <cgogn/geometry/algos/centroid.h>
+#include <cgogn/modeling/tiling/triangular_tore.h>
+#include <cgogn/modeling/tiling/hexa_grid.h>
+#include <cgogn/modeling/algos/parallel_subdivision.h>
+#include <cgogn/modeling/algos/dual.h>
+#include <cgogn/modeling/algos/tetrahedralization.h>
+
+using namespace cgogn::numerics;
+
+using Vec3 = Eigen::Vector3d;
+using Map2 = cgogn::CMap2;
+using Tri = cgogn::CMap2Tri;
+using Map3 = cgogn::CMap3;
+using Tetra = cgogn::CMap3Tetra;
+using Hexa = cgogn::CMap3Hexa;
+
+template <typename MAP>
+static std::vector<Vec3> sorted_positions(const MAP& map, const typename MAP::template VertexAttribute<Vec3>& position)
+{
+	std::vector<Vec3> result;
+	map.foreach_cell([&] (typename MAP::Vertex v) { result.push_back(position[v]); });
+	std::sort(result.begin(), result.end(), [] (const Vec3& a, const Vec3& b)
+	{
+		return std::lexicographical_compare(a.data(), a.data() + 3, b.data(), b.data() + 3);
+	});
+	return result;
+}
+
+/**
+ * \brief number of cells of each dimension, counted by traversal (all the orbits, boundary included)
+ */
+template <typename MAP>
+static std::vector<uint32> nb_orbits(const MAP& map)
+{
+	std::vector<uint32> result(MAP::DIMENSION + 1u, 0u);
+	map.foreach_cell([&] (typename MAP::Vertex) { ++result[0]; });
+	map.foreach_cell([&] (typename MAP::Edge) { ++result[1]; });
+	map.foreach_cell([&] (typename MAP::Face) { ++result[2]; });
+	if (MAP::DIMENSION == 3u)
+	{
+		typename MAP::DartMarker marker(map);
+		map.foreach_dart([&] (cgogn::Dart d)
+		{
+			if (marker.is_marked(d))
+				return;
+			marker.mark_orbit(typename MAP::Volume(d));
+			++result[3];
+		});
+	}
+	return result;
+}
+
+/**
+ * \brief n x n x n cubes, each one cut into 6 tetrahedra around its diagonal, in a CMap3
+ */
+static void tetra_grid(Map3& map, uint32 n)
+{
+	auto id = [&] (uint32 i, uint32 j, uint32 k) { return (k * (n + 1u) + j) * (n + 1u) + i; };
+	const uint32 paths[6][3] = { {0u,1u,2u}, {1u,2u,0u}, {2u,0u,1u}, {0u,2u,1u}, {2u,1u,0u}, {1u,0u,2u} };
+
+	// vertex of origin of each dart of the tetrahedra
+	Map3::Builder builder(map);
+	std::vector<uint32> origin;
+	for (uint32 k = 0u; k < n; ++k)
+		for (uint32 j = 0u; j < n; ++j)
+			for (uint32 i = 0u; i < n; ++i)
+				for (uint32 p = 0u; p < 6u; ++p)
+				{
+					uint32 c[3] = { i, j, k };
+					uint32 v[4];
+					v[0] = id(c[0], c[1], c[2]);
+					for (uint32 s = 0u; s < 3u; ++s)
+					{
+						++c[paths[p][s]];
+						v[s + 1u] = id(c[0], c[1], c[2]);
+					}
+					if (p >= 3u)
+						std::swap(v[1], v[2]); // odd permutations
+
+					const cgogn::Dart d = builder.add_pyramid_topo_fp(3u);
+					const cgogn::Dart vertices[4] = { d, map.phi1(d), map.phi_1(d), map.phi_1(map.phi2(map.phi_1(d))) };
+					for (uint32 q = 0u; q < 4u; ++q)
+					{
+						cgogn::Dart dd = vertices[q];
+						do
+						{
+							if (origin.size() <= dd.index)
+								origin.resize(dd.index + 1u);
+							origin[dd.index] = v[q];
+							dd = map.phi1(map.phi2(dd));
+						} while (dd != vertices[q]);
+					}
+				}
+
+	// the darts of a face are sewn with the darts of the opposite face
+	std::map<std::array<uint32, 3>, cgogn::Dart> faces;
+	map.foreach_dart([&] (cgogn::Dart d)
+	{
+		const std::array<uint32, 3> key = {{ origin[map.phi1(d).index], origin[d.index], origin[map.phi_1(d).index] }};
+		auto it = faces.find(key);
+		if (it != faces.end())
+			builder.phi3_sew(d, it->second);
+		else
+			faces[{{ origin[d.index], origin[map.phi1(d).index], origin[map.phi1(map.phi1(d)).index] }}] = d;
+	});
+	builder.close_map();
+
+	auto position = map.add_attribute<Vec3, Map3::Vertex>("position");
+	for (uint32 d = 0u; d < origin.size(); ++d)
+	{
+		const uint32 v = origin[d];
+		position[Map3::Vertex(cgogn::Dart(d))] = Vec3(float64(v % (n + 1u)), float64((v / (n + 1u)) % (n + 1u)), float64(v / ((n + 1u) * (n + 1u))));
+	}
+}
+
+/**
+ * \brief signed volume of a volume whose faces are fanned from their first vertex
+ */
+template <typename MAP>
+static float64 signed_volume(const MAP& map, const typename MAP::template VertexAttribute<Vec3>& position, typename MAP::Volume w)
+{
+	using Vertex = typename MAP::Vertex;
+	float64 result = 0.0;
+	map.foreach_incident_face(w, [&] (typename MAP::Face f)
+	{
+		const Vec3& p0 = position[Vertex(f.dart)];
+		for (cgogn::Dart d = map.phi1(f.dart); map.phi1(d) != f.dart; d = map.phi1(d))
+			result += p0.dot(position[Vertex(d)].cross(position[Vertex(map.phi1(d))])) / 6.0;
+	});
+	return result;
+}
+
+TEST(ParallelDualTest, surface)
+{
+	Map2 map;
+	auto position = map.add_attribute<Vec3, Map2::Vertex>("position");
+	cgogn::modeling::TriangularTore<Map2> tore(map, 12u, 8u);
+	tore.embed_into_tore(position, 10.0f, 4.0f);
+
+	auto centroid = [&] (Map2::Face f) { return cgogn::geometry::centroid(map, f, position); };
+
+	Map2 dual;
+	cgogn::modeling::dual(map, dual, nullptr, {"position"}, centroid);
+	Map2 parallel_dual;
+	ASSERT_TRUE(cgogn::modeling::parallel_dual(map, parallel_dual, nullptr, {"position"}, centroid));
+	EXPECT_TRUE(parallel_dual.check_map_integrity());
+
+	EXPECT_EQ(parallel_dual.nb_cells<Map2::Vertex::ORBIT>(), map.nb_cells<Map2::Face::ORBIT>());
+	EXPECT_EQ(nb_orbits(parallel_dual), nb_orbits(dual));
+	parallel_dual.foreach_cell([&] (Map2::Face f) { EXPECT_EQ(parallel_dual.codegree(f), 6u); });
+
+	// the same dual vertices, the dual faces are positively oriented as the faces of the existing dual
+	auto dual_position = dual.get_attribute<Vec3, Map2::Vertex>("position");
+	auto parallel_position = parallel_dual.get_attribute<Vec3, Map2::Vertex>("position");
+	const std::vector<Vec3> expected = sorted_positions(dual, dual_position);
+	const std::vector<Vec3> result = sorted_positions(parallel_dual, parallel_position);
+	ASSERT_EQ(result.size(), expected.size());
+	for (std::size_t i = 0u; i < result.size(); ++i)
+		EXPECT_NEAR((result[i] - expected[i]).norm(), 0.0, 1e-12);
+	Vec3 normal = Vec3::Zero();
+	parallel_dual.foreach_cell([&] (Map2::Face f)
+	{
+		const cgogn::Dart d = f.dart;
+		normal += (parallel_position[Map2::Vertex(parallel_dual.phi1(d))] - parallel_position[Map2::Vertex(d)]).cross(
+			parallel_position[Map2::Vertex(parallel_dual.phi_1(d))] - parallel_position[Map2::Vertex(d)]);
+	});
+	Vec3 dual_normal = Vec3::Zero();
+	dual.foreach_cell([&] (Map2::Face f)
+	{
+		const cgogn::Dart d = f.dart;
+		dual_normal += (dual_position[Map2::Vertex(dual.phi1(d))] - dual_position[Map2::Vertex(d)]).cross(
+			dual_position[Map2::Vertex(dual.phi_1(d))] - dual_position[Map2::Vertex(d)]);
+	});
+	EXPECT_NEAR((normal - dual_normal).norm(), 0.0, 1e-9);
+
+	// the faces of the source map (vertices of the dual) are carried over by the dual of the edges
+	auto length = [&] (Map2::Edge e)
+	{
+		return (position[Map2::Vertex(e.dart)] - position[Map2::Vertex(map.phi1(e.dart))]).norm();
+	};
+	ASSERT_TRUE(cgogn::modeling::parallel_dual(map, parallel_dual, nullptr, {"position", "length"}, centroid, length));
+	auto dual_length = parallel_dual.get_attribute<float64, Map2::Edge>("length");
+	float64 total = 0.0;
+	float64 dual_total = 0.0;
+	map.foreach_cell([&] (Map2::Edge e) { total += length(e); });
+	parallel_dual.foreach_cell([&] (Map2::Edge e) { dual_total += dual_length[e]; });
+	EXPECT_NEAR(total, dual_total, 1e-9);
+}
+
+TEST(ParallelDualTest, triangles)
+{
+	Map2 map;
+	auto position = map.add_attribute<Vec3, Map2::Vertex>("position");
+	cgogn::modeling::TriangularTore<Map2> tore(map, 12u, 8u);
+	tore.embed_into_tore(position, 10.0f, 4.0f);
+	Tri triangles;
+	auto tri_position = triangles.add_attribute<Vec3, Tri::Vertex>("position");
+	cgogn::modeling::parallel_loop(map, position, triangles, tri_position, 1u);
+
+	Map2 dual;
+	ASSERT_TRUE(cgogn::modeling::parallel_dual(triangles, dual, nullptr, {"position"},
+		[&] (Tri::Face f) { return cgogn::geometry::centroid(triangles, f, tri_position); }));
+	EXPECT_TRUE(dual.check_map_integrity());
+
+	const std::vector<uint32> counts = nb_orbits(triangles);
+	const std::vector<uint32> dual_counts = nb_orbits(dual);
+	EXPECT_EQ(dual_counts[0], counts[2]);
+	EXPECT_EQ(dual_counts[1], counts[1]);
+	EXPECT_EQ(dual_counts[2], counts[0]);
+	dual.foreach_cell([&] (Map2::Vertex v) { EXPECT_EQ(dual.degree(v), 3u); });
+}
+
+TEST(ParallelDualTest, volume)
+{
+	const uint32 n = 3u;
+	Map3 map;
+	tetra_grid(map, n);
+	auto position = map.get_attribute<Vec3, Map3::Vertex>("position");
+	EXPECT_TRUE(map.check_map_integrity());
+	EXPECT_EQ(map.nb_cells<Map3::Vertex::ORBIT>(), (n + 1u) * (n + 1u) * (n + 1u));
+
+	Map3 dual;
+	Map3::CellMarker<Map3::Vertex::ORBIT> boundary(dual);
+	ASSERT_TRUE(cgogn::modeling::parallel_dual(map, dual, &boundary, {"position"},
+		[&] (Map3::Volume w) { return cgogn::geometry::centroid(map, w, position); }));
+	EXPECT_TRUE(dual.check_map_integrity());
+
+	const std::vector<uint32> counts = nb_orbits(map);
+	const std::vector<uint32> dual_counts = nb_orbits(dual);
+	for (uint32 i = 0u; i < 4u; ++i)
+		EXPECT_EQ(dual_counts[i], counts[3u - i]);
+
+	// the boundary volume is the only marked vertex
+	uint32 nb_boundary = 0u;
+	dual.foreach_cell([&] (Map3::Vertex v)
+	{
+		if (boundary.is_marked(v))
+			++nb_boundary;
+	});
+	EXPECT_EQ(nb_boundary, 1u);
+	EXPECT_EQ(dual.nb_cells<Map3::Vertex::ORBIT>(), 6u * n * n * n + 1u);
+
+	// the dual volumes of the inner vertices are oriented as the tetrahedra
+	auto dual_position = dual.get_attribute<Vec3, Map3::Vertex>("position");
+	float64 sign = 0.0;
+	map.foreach_cell([&] (Map3::Volume w) { sign = signed_volume(map, position, w); });
+	uint32 nb_inner = 0u;
+	float64 inner_volume = 0.0;
+	dual.foreach_cell([&] (Map3::Volume w)
+	{
+		bool inner = true;
+		dual.foreach_incident_vertex(w, [&] (Map3::Vertex v) { inner = inner && !boundary.is_marked(v); });
+		if (!inner)
+			return;
+		++nb_inner;
+		const float64 volume = signed_volume(dual, dual_position, w);
+		EXPECT_GT(volume * sign, 0.0);
+		inner_volume += std::abs(volume);
+	});
+	EXPECT_EQ(nb_inner, (n - 1u) * (n - 1u) * (n - 1u));
+	EXPECT_GT(inner_volume, 0.0);
+
+	// the dual of the dual has the topology of the source map
+	Map3 dual2;
+	ASSERT_TRUE(cgogn::modeling::parallel_dual(dual, dual2, nullptr, {}));
+	EXPECT_TRUE(dual2.check_map_integrity());
+	EXPECT_EQ(nb_orbits(dual2), counts);
+}
+
+TEST(ParallelDualTest, open_map)
+{
+	Map2 map;
+	Map2::Builder(map).add_face_topo_fp(4u);
+	Map2 dual;
+	EXPECT_FALSE(cgogn::modeling::parallel_dual(map, dual, nullptr, {}));
+	EXPECT_EQ(dual.nb_darts(), 0u);
+}
+
+TEST(ParallelDualTest, fixed_size_volumes)
+{
+	// the boundary volumes of a CMap3Tetra give a single dual vertex per hole: same dual as the CMap3
+	const uint32 n = 2u;
+	Map3 map;
+	tetra_grid(map, n);
+	auto position = map.get_attribute<Vec3, Map3::Vertex>("position");
+	Tetra tetra;
+	auto tetra_position = tetra.add_attribute<Vec3, Tetra::Vertex>("position");
+	cgogn::modeling::tetrahedralize(map, position, tetra, tetra_position);
+
+	Map3 dual;
+	ASSERT_TRUE(cgogn::modeling::parallel_dual(map, dual, nullptr, {}));
+	Map3 tetra_dual;
+	Map3::CellMarker<Map3::Vertex::ORBIT> boundary(tetra_dual);
+	ASSERT_TRUE(cgogn::modeling::parallel_dual(tetra, tetra_dual, &boundary, {"position"},
+		[&] (Tetra::Volume w)
+		{
+			// the boundary volumes are not made of vertices of the mesh
+			return tetra.is_boundary(w.dart) ? Vec3(Vec3::Zero()) : cgogn::geometry::centroid(tetra, w, tetra_position);
+		}));
+	EXPECT_TRUE(tetra_dual.check_map_integrity());
+	EXPECT_EQ(nb_orbits(tetra_dual), nb_orbits(dual));
+	EXPECT_EQ(tetra_dual.nb_cells<Map3::Vertex::ORBIT>(), 6u * n * n * n + 1u);
+
+	uint32 nb_boundary = 0u;
+	tetra_dual.foreach_cell([&] (Map3::Vertex v)
+	{
+		if (boundary.is_marked(v))
+			++nb_boundary;
+	});
+	EXPECT_EQ(nb_boundary, 1u);
+
+	// the dual of the dual has the topology of the CMap3
+	Map3 dual2;
+	ASSERT_TRUE(cgogn::modeling::parallel_dual(tetra_dual, dual2, nullptr, {}));
+	EXPECT_TRUE(dual2.check_map_integrity());
+	EXPECT_EQ(nb_orbits(dual2), nb_orbits(map));
+
+	// a x * y * z hexahedral grid: one dual vertex per hexahedron and one for the boundary, one dual volume per vertex
+	const uint32 x = 3u, y = 2u, z = 2u;
+	Hexa hexa;
+	hexa.add_attribute<Vec3, Hexa::Vertex>("position");
+	cgogn::modeling::HexaGrid<Hexa> grid(hexa, x, y, z);
+	Map3 hexa_dual;
+	ASSERT_TRUE(cgogn::modeling::parallel_dual(hexa, hexa_dual, nullptr, {}));
+	EXPECT_TRUE(hexa_dual.check_map_integrity());
+	const std::vector<uint32> counts = nb_orbits(hexa_dual);
+	EXPECT_EQ(counts[0], x * y * z + 1u);
+	EXPECT_EQ(counts[3], (x + 1u) * (y + 1u) * (z + 1u));
+}
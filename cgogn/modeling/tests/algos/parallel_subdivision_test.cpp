@@ -0,0 +1,194 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <algorithm>
+
+#include <gtest/gtest.h>
+
+#include <cgogn/core/cmap/cmap2.h>
+#include <cgogn/geometry/types/eigen.h>
+#include <cgogn/modeling/tiling/triangular_grid.h>
+#include <cgogn/modeling/tiling/triangular_tore.h>
+#include <cgogn/modeling/algos/catmull_clark.h>
+#include <cgogn/modeling/algos/loop.h>
+#include <cgogn/modeling/algos/parallel_subdivision.h>
+
+using namespace cgogn::numerics;
+
+using Vec3 = Eigen::Vector3d;
+using Map2 = cgogn::CMap2;
+using Quad = cgogn::CMap2Quad;
+using Tri = cgogn::CMap2Tri;
+
+template <typename MAP>
+static std::vector<Vec3> sorted_positions(const MAP& map, const typename MAP::template VertexAttribute<Vec3>& position)
+{
+	std::vector<Vec3> result;
+	map.foreach_cell([&] (typename MAP::Vertex v) { result.push_back(position[v]); });
+	std::sort(result.begin(), result.end(), [] (const Vec3& a, const Vec3& b)
+	{
+		return std::lexicographical_compare(a.data(), a.data() + 3, b.data(), b.data() + 3);
+	});
+	return result;
+}
+
+static void tore(Map2& map, Map2::VertexAttribute<Vec3>& position)
+{
+	cgogn::modeling::TriangularTore<Map2> tore(map, 12u, 8u);
+	tore.embed_into_tore(position, 10.0f, 4.0f);
+}
+
+TEST(ParallelSubdivisionTest, catmull_clark)
+{
+	Map2 map;
+	auto position = map.add_attribute<Vec3, Map2::Vertex>("position");
+	tore(map, position);
+
+	Quad quads;
+	auto quad_position = quads.add_attribute<Vec3, Quad::Vertex>("position");
+	cgogn::modeling::parallel_catmull_clark(map, position, quads, quad_position, 2u);
+	EXPECT_TRUE(quads.check_map_integrity());
+
+	cgogn::modeling::catmull_clark(map, position);
+	cgogn::modeling::catmull_clark(map, position);
+
+	EXPECT_EQ(quads.nb_cells<Quad::Vertex::ORBIT>(), map.nb_cells<Map2::Vertex::ORBIT>());
+	EXPECT_EQ(quads.nb_cells<Quad::Edge::ORBIT>(), map.nb_cells<Map2::Edge::ORBIT>());
+	EXPECT_EQ(quads.nb_cells<Quad::Face::ORBIT>(), map.nb_cells<Map2::Face::ORBIT>());
+
+	const std::vector<Vec3> expected = sorted_positions(map, position);
+	const std::vector<Vec3> result = sorted_positions(quads, quad_position);
+	ASSERT_EQ(result.size(), expected.size());
+	for (std::size_t i = 0u; i < result.size(); ++i)
+		EXPECT_NEAR((result[i] - expected[i]).norm(), 0.0, 1e-9);
+}
+
+TEST(ParallelSubdivisionTest, loop)
+{
+	Map2 map;
+	auto position = map.add_attribute<Vec3, Map2::Vertex>("position");
+	tore(map, position);
+
+	Tri triangles;
+	auto tri_position = triangles.add_attribute<Vec3, Tri::Vertex>("position");
+	cgogn::modeling::parallel_loop(map, position, triangles, tri_position, 3u);
+	EXPECT_TRUE(triangles.check_map_integrity());
+
+	for (uint32 l = 0u; l < 3u; ++l)
+		cgogn::modeling::loop(map, position);
+
+	EXPECT_EQ(triangles.nb_cells<Tri::Vertex::ORBIT>(), map.nb_cells<Map2::Vertex::ORBIT>());
+	EXPECT_EQ(triangles.nb_cells<Tri::Face::ORBIT>(), map.nb_cells<Map2::Face::ORBIT>());
+
+	const std::vector<Vec3> expected = sorted_positions(map, position);
+	const std::vector<Vec3> result = sorted_positions(triangles, tri_position);
+	ASSERT_EQ(result.size(), expected.size());
+	for (std::size_t i = 0u; i < result.size(); ++i)
+		EXPECT_NEAR((result[i] - expected[i]).norm(), 0.0, 1e-9);
+}
+
+TEST(ParallelSubdivisionTest, boundary)
+{
+	// a flat grid stays flat and inside the bounding box of the control points,
+	// the vertices of its straight bottom boundary stay on it
+	Map2 map;
+	auto position = map.add_attribute<Vec3, Map2::Vertex>("position");
+	cgogn::modeling::TriangularGrid<Map2> grid(map, 6u, 5u);
+	grid.embed_into_grid(position, 1.0f, 1.0f, 0.0f);
+	const uint32 nb_v = map.nb_cells<Map2::Vertex::ORBIT>();
+	const uint32 nb_e = map.nb_cells<Map2::Edge::ORBIT>();
+	const uint32 nb_f = map.nb_cells<Map2::Face::ORBIT>();
+	Vec3 min = Vec3::Constant(1e10);
+	Vec3 max = Vec3::Constant(-1e10);
+	map.foreach_cell([&] (Map2::Vertex v)
+	{
+		min = min.cwiseMin(position[v]);
+		max = max.cwiseMax(position[v]);
+	});
+	EXPECT_EQ(min[1], 0.0);
+
+	Quad quads;
+	auto quad_position = quads.add_attribute<Vec3, Quad::Vertex>("position");
+	cgogn::modeling::parallel_catmull_clark(map, position, quads, quad_position);
+	EXPECT_EQ(quads.nb_cells<Quad::Vertex::ORBIT>(), nb_v + nb_e + nb_f);
+	EXPECT_EQ(quads.nb_cells<Quad::Face::ORBIT>(), 3u * nb_f);
+
+	// the vertices of the bottom boundary (but the corners) do not move: 3/4 p + 1/8 (a + b) on a straight line
+	// (up to the float precision of embed_into_grid)
+	const std::vector<Vec3> quad_positions = sorted_positions(quads, quad_position);
+	float64 bottom_min = max[0];
+	float64 bottom_max = min[0];
+	map.foreach_cell([&] (Map2::Vertex v)
+	{
+		if (position[v][1] == min[1])
+		{
+			bottom_min = std::min(bottom_min, position[v][0]);
+			bottom_max = std::max(bottom_max, position[v][0]);
+		}
+	});
+	uint32 nb_fixed = 0u;
+	map.foreach_cell([&] (Map2::Vertex v)
+	{
+		const Vec3& p = position[v];
+		if (p[1] != min[1] || p[0] == bottom_min || p[0] == bottom_max)
+			return;
+		++nb_fixed;
+		EXPECT_TRUE(std::any_of(quad_positions.begin(), quad_positions.end(), [&] (const Vec3& q) { return (q - p).norm() < 1e-6; }));
+	});
+	EXPECT_GT(nb_fixed, 0u);
+	// these vertices and the midpoints of the bottom edges stay on the bottom boundary, the corners move up
+	uint32 nb_bottom = 0u;
+	quads.foreach_cell([&] (Quad::Vertex v)
+	{
+		if (quad_position[v][1] == min[1])
+			++nb_bottom;
+	});
+	EXPECT_EQ(nb_bottom, 2u * nb_fixed + 1u);
+
+	Tri triangles;
+	auto tri_position = triangles.add_attribute<Vec3, Tri::Vertex>("position");
+	cgogn::modeling::parallel_loop(map, position, triangles, tri_position, 2u);
+	EXPECT_EQ(triangles.nb_cells<Tri::Face::ORBIT>(), 16u * nb_f);
+
+	auto check = [&] (const Vec3& p)
+	{
+		EXPECT_EQ(p[2], 0.0);
+		for (uint32 c = 0u; c < 2u; ++c)
+		{
+			EXPECT_GE(p[c], min[c] - 1e-12);
+			EXPECT_LE(p[c], max[c] + 1e-12);
+		}
+	};
+	quads.foreach_cell([&] (Quad::Vertex v) { check(quad_position[v]); });
+	triangles.foreach_cell([&] (Tri::Vertex v) { check(tri_position[v]); });
+
+	uint32 nb_boundary = 0u;
+	triangles.foreach_cell([&] (Tri::Vertex v)
+	{
+		if (tri_position[v][1] == 0.0)
+			++nb_boundary;
+	});
+	// 25 vertices on the bottom boundary after 2 levels, but the corners are smoothed:
+	// 2 corners at level 1, then these corners, their 2 neighbors and the 2 midpoints next to them at level 2
+	EXPECT_EQ(nb_boundary, 25u - 6u);
+}
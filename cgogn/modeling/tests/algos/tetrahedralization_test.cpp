@@ -0,0 +1,142 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <cgogn/core/cmap/cmap3.h>
+#include <cgogn/core/cmap/cmap3_hexa.h>
+#include <cgogn/core/cmap/cmap3_tetra.h>
+#include <cgogn/geometry/types/eigen.h>
+#include <cgogn/modeling/tiling/hexa_grid.h>
+#include <cgogn/modeling/algos/tetrahedralization.h>
+
+using namespace cgogn::numerics;
+
+using Vec3 = Eigen::Vector3d;
+using Map3 = cgogn::CMap3;
+using Hexa = cgogn::CMap3Hexa;
+using Tetra = cgogn::CMap3Tetra;
+
+/**
+ * \brief signed volume of a volume whose faces are fanned from their first vertex
+ */
+template <typename MAP>
+static float64 signed_volume(const MAP& map, const typename MAP::template VertexAttribute<Vec3>& position, typename MAP::Volume w)
+{
+	using Vertex = typename MAP::Vertex;
+	float64 result = 0.0;
+	map.foreach_incident_face(w, [&] (typename MAP::Face f)
+	{
+		const Vec3& p0 = position[Vertex(f.dart)];
+		for (cgogn::Dart d = map.phi1(f.dart); map.phi1(d) != f.dart; d = map.phi1(d))
+			result += p0.dot(position[Vertex(d)].cross(position[Vertex(map.phi1(d))])) / 6.0;
+	});
+	return result;
+}
+
+/**
+ * \brief the tetrahedra have the orientation of the source volumes and fill the same volume,
+ * \return the number of inner faces of dst (sewn to another tetrahedron)
+ */
+static uint32 check_tetrahedra(const Tetra& dst, const Tetra::VertexAttribute<Vec3>& position, float64 volume)
+{
+	float64 sum = 0.0;
+	uint32 nb_inner = 0u;
+	dst.foreach_cell([&] (Tetra::Volume w)
+	{
+		const float64 v = signed_volume(dst, position, w);
+		EXPECT_GT(v * volume, 0.0);
+		sum += v;
+		const cgogn::Dart d = w.dart;
+		for (cgogn::Dart f : { d, dst.phi2(d), dst.phi2(dst.phi1(d)), dst.phi2(dst.phi_1(d)) })
+			if (!dst.is_boundary(dst.phi3(f)))
+				++nb_inner;
+	});
+	EXPECT_NEAR(sum, volume, 1e-9);
+	return nb_inner / 2u;
+}
+
+TEST(TetrahedralizationTest, hexa_grid)
+{
+	const uint32 n = 3u;
+	Hexa map;
+	auto position = map.add_attribute<Vec3, Hexa::Vertex>("position");
+	cgogn::modeling::HexaGrid<Hexa> grid(map, n, n, n);
+	grid.embed_into_grid(position, 1.0f, 1.0f, 1.0f);
+
+	float64 volume = 0.0;
+	map.foreach_cell([&] (Hexa::Volume w) { volume += signed_volume(map, position, w); });
+	EXPECT_NEAR(std::abs(volume), 1.0, 1e-9);
+
+	Tetra tetra;
+	auto tetra_position = tetra.add_attribute<Vec3, Tetra::Vertex>("position");
+	EXPECT_EQ(cgogn::modeling::tetrahedralize(map, position, tetra, tetra_position), 6u * n * n * n);
+	EXPECT_EQ(tetra.nb_cells<Tetra::Vertex::ORBIT>(), (n + 1u) * (n + 1u) * (n + 1u));
+	EXPECT_EQ(tetra.nb_cells<Tetra::Volume::ORBIT>(), 6u * n * n * n);
+
+	// conforming: every inner face of the grid is split in 2 sewn triangles, 6 inner triangles per cube
+	const uint32 nb_inner = check_tetrahedra(tetra, tetra_position, volume);
+	EXPECT_EQ(nb_inner, 6u * n * n * n + 2u * 3u * n * n * (n - 1u));
+}
+
+TEST(TetrahedralizationTest, polyhedra)
+{
+	// a prism on a triangle and a pyramid on a square, apart
+	Map3 map;
+	Map3::Builder builder(map);
+	const cgogn::Dart prism = builder.add_prism_topo_fp(3u);
+	const cgogn::Dart pyramid = builder.add_pyramid_topo_fp(4u);
+	builder.close_map();
+	auto position = map.add_attribute<Vec3, Map3::Vertex>("position");
+
+	const Vec3 base[3] = { Vec3(0.0, 0.0, 0.0), Vec3(1.0, 0.0, 0.0), Vec3(0.0, 1.0, 0.0) };
+	cgogn::Dart d = prism;
+	for (uint32 i = 0u; i < 3u; ++i)
+	{
+		position[Map3::Vertex(d)] = base[i];
+		position[Map3::Vertex(map.phi1(map.phi1(map.phi2(d))))] = base[i] + Vec3(0.0, 0.0, 2.0);
+		d = map.phi1(d);
+	}
+	const Vec3 square[4] = { Vec3(5.0, 0.0, 0.0), Vec3(6.0, 0.0, 0.0), Vec3(6.0, 1.0, 0.0), Vec3(5.0, 1.0, 0.0) };
+	d = pyramid;
+	for (uint32 i = 0u; i < 4u; ++i)
+	{
+		position[Map3::Vertex(d)] = square[i];
+		d = map.phi1(d);
+	}
+	position[Map3::Vertex(map.phi_1(map.phi2(pyramid)))] = Vec3(5.5, 0.5, 3.0);
+
+	const float64 prism_volume = signed_volume(map, position, Map3::Volume(prism));
+	const float64 pyramid_volume = signed_volume(map, position, Map3::Volume(pyramid));
+	EXPECT_NEAR(std::abs(prism_volume), 1.0, 1e-9);
+	EXPECT_NEAR(std::abs(pyramid_volume), 1.0, 1e-9);
+	EXPECT_GT(prism_volume * pyramid_volume, 0.0);
+
+	Tetra tetra;
+	auto tetra_position = tetra.add_attribute<Vec3, Tetra::Vertex>("position");
+	EXPECT_EQ(cgogn::modeling::tetrahedralize(map, position, tetra, tetra_position), 3u + 2u);
+	EXPECT_EQ(tetra.nb_cells<Tetra::Vertex::ORBIT>(), 6u + 5u);
+
+	// 2 inner triangles in the prism, 1 in the pyramid
+	EXPECT_EQ(check_tetrahedra(tetra, tetra_position, prism_volume + pyramid_volume), 3u);
+}
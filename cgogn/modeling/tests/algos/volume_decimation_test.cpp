@@ -0,0 +1,168 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include <cgogn/core/cmap/cmap3_tetra.h>
+#include <cgogn/geometry/types/eigen.h>
+#include <cgogn/modeling/algos/volume_decimation.h>
+
+using namespace cgogn::numerics;
+
+using Vec3 = Eigen::Vector3d;
+using Map3 = cgogn::CMap3Tetra;
+using Vertex = Map3::Vertex;
+using Edge = Map3::Edge;
+using Face = Map3::Face;
+using Volume = Map3::Volume;
+
+/**
+ * \brief n x n x n cubes, each one cut into 6 tetrahedra around its diagonal, interior vertices are jittered
+ */
+static void tetra_grid(Map3& map, Map3::VertexAttribute<Vec3>& position, uint32 n)
+{
+	auto id = [&] (uint32 i, uint32 j, uint32 k) { return (k * (n + 1u) + j) * (n + 1u) + i; };
+	const uint32 paths[6][3] = { {0u,1u,2u}, {1u,2u,0u}, {2u,0u,1u}, {0u,2u,1u}, {2u,1u,0u}, {1u,0u,2u} };
+	std::vector<uint32> tetras;
+	for (uint32 k = 0u; k < n; ++k)
+		for (uint32 j = 0u; j < n; ++j)
+			for (uint32 i = 0u; i < n; ++i)
+				for (uint32 p = 0u; p < 6u; ++p)
+				{
+					uint32 c[3] = { i, j, k };
+					uint32 v[4];
+					v[0] = id(c[0], c[1], c[2]);
+					for (uint32 s = 0u; s < 3u; ++s)
+					{
+						++c[paths[p][s]];
+						v[s + 1u] = id(c[0], c[1], c[2]);
+					}
+					if (p >= 3u)
+						std::swap(v[1], v[2]); // odd permutations
+					tetras.insert(tetras.end(), v, v + 4);
+				}
+
+	Map3::Builder builder(map);
+	const uint32 first = builder.create_volumes_from_indices(tetras, (n + 1u) * (n + 1u) * (n + 1u));
+
+	std::mt19937 gen(3);
+	std::uniform_real_distribution<float64> jitter(-0.2, 0.2);
+	for (uint32 k = 0u; k <= n; ++k)
+		for (uint32 j = 0u; j <= n; ++j)
+			for (uint32 i = 0u; i <= n; ++i)
+			{
+				Vec3 p = Vec3(float64(i), float64(j), float64(k));
+				if (i > 0u && j > 0u && k > 0u && i < n && j < n && k < n)
+					p += Vec3(jitter(gen), jitter(gen), jitter(gen));
+				position[first + id(i, j, k)] = p;
+			}
+}
+
+static int32 orientation(const Map3& map, const Map3::VertexAttribute<Vec3>& position, Volume w)
+{
+	const cgogn::Dart d = w.dart;
+	const float64 o = cgogn::geometry::orient3d(position[Vertex(d)], position[Vertex(map.phi1(d))], position[Vertex(map.phi_1(d))], position[Vertex(map.phi_1(map.phi2(map.phi_1(d))))]);
+	return o > 0.0 ? 1 : (o < 0.0 ? -1 : 0);
+}
+
+static int32 euler_characteristic(const Map3& map)
+{
+	return int32(map.nb_cells<Vertex::ORBIT>()) - int32(map.nb_cells<Edge::ORBIT>()) + int32(map.nb_cells<Face::ORBIT>()) - int32(map.nb_cells<Volume::ORBIT>());
+}
+
+TEST(VolumeDecimationTest, fixed_boundary)
+{
+	Map3 map;
+	auto position = map.add_attribute<Vec3, Vertex>("position");
+	tetra_grid(map, position, 5u);
+	EXPECT_EQ(map.nb_cells<Vertex::ORBIT>(), 216u);
+	EXPECT_EQ(euler_characteristic(map), 1);
+
+	int32 sign = 0;
+	map.foreach_cell([&] (Volume w) { sign += orientation(map, position, w); });
+	ASSERT_EQ(std::abs(sign), int32(map.nb_cells<Volume::ORBIT>()));
+	sign = sign > 0 ? 1 : -1;
+
+	std::vector<Vec3> boundary;
+	map.foreach_cell([&] (Vertex v)
+	{
+		if (map.is_incident_to_boundary(v))
+			boundary.push_back(position[v]);
+	});
+
+	const uint32 nb = cgogn::modeling::decimate_volume(map, position, 1000u);
+
+	// the 64 interior vertices can all be collapsed onto the boundary
+	EXPECT_GT(nb, 0u);
+	EXPECT_LE(nb, 64u);
+	EXPECT_EQ(map.nb_cells<Vertex::ORBIT>(), 216u - nb);
+	EXPECT_EQ(euler_characteristic(map), 1);
+	map.foreach_cell([&] (Volume w) { EXPECT_EQ(orientation(map, position, w), sign); });
+
+	// the boundary is unchanged
+	std::vector<Vec3> result;
+	map.foreach_cell([&] (Vertex v)
+	{
+		if (map.is_incident_to_boundary(v))
+			result.push_back(position[v]);
+	});
+	ASSERT_EQ(result.size(), boundary.size());
+	auto less = [] (const Vec3& a, const Vec3& b) { return std::lexicographical_compare(a.data(), a.data() + 3, b.data(), b.data() + 3); };
+	std::sort(boundary.begin(), boundary.end(), less);
+	std::sort(result.begin(), result.end(), less);
+	EXPECT_TRUE(boundary == result);
+}
+
+TEST(VolumeDecimationTest, locked_boundary)
+{
+	Map3 map;
+	auto position = map.add_attribute<Vec3, Vertex>("position");
+	tetra_grid(map, position, 5u);
+
+	const uint32 nb = cgogn::modeling::decimate_volume(map, position, 1000u, cgogn::modeling::VolumeBoundary_Locked);
+
+	// the interior vertices can only be collapsed together: at least one of them remains
+	EXPECT_GT(nb, 0u);
+	EXPECT_LE(nb, 63u);
+	EXPECT_EQ(map.nb_cells<Vertex::ORBIT>(), 216u - nb);
+	EXPECT_EQ(euler_characteristic(map), 1);
+	uint32 nb_interior = 0u;
+	map.foreach_cell([&] (Vertex v)
+	{
+		if (!map.is_incident_to_boundary(v))
+			++nb_interior;
+	});
+	EXPECT_EQ(nb_interior, 64u - nb);
+	int32 sign = 0;
+	map.foreach_cell([&] (Volume w) { sign += orientation(map, position, w); });
+	EXPECT_EQ(std::abs(sign), int32(map.nb_cells<Volume::ORBIT>()));
+
+	// a limited number of collapses
+	Map3 map2;
+	auto position2 = map2.add_attribute<Vec3, Vertex>("position");
+	tetra_grid(map2, position2, 5u);
+	EXPECT_EQ(cgogn::modeling::decimate_volume(map2, position2, 10u), 10u);
+	EXPECT_EQ(map2.nb_cells<Vertex::ORBIT>(), 206u);
+}
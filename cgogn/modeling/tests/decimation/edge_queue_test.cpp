@@ -0,0 +1,191 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <algorithm>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include <cgogn/core/cmap/cmap2.h>
+#include <cgogn/geometry/types/eigen.h>
+#include <cgogn/modeling/tiling/triangular_tore.h>
+#include <cgogn/modeling/algos/decimation.h>
+
+using namespace cgogn::numerics;
+
+using Vec3 = Eigen::Vector3d;
+using Map2 = cgogn::CMap2;
+using Vertex = Map2::Vertex;
+using Edge = Map2::Edge;
+
+/**
+ * \brief torus with jittered vertices (no two edges have the same cost)
+ */
+static void jittered_tore(Map2& map, Map2::VertexAttribute<Vec3>& position, uint32 n, uint32 m)
+{
+	cgogn::modeling::TriangularTore<Map2> tore(map, n, m);
+	tore.embed_into_tore(position, 10.0f, 4.0f);
+	std::mt19937 gen(11);
+	std::uniform_real_distribution<float64> jitter(-0.05, 0.05);
+	map.foreach_cell([&] (Vertex v) { position[v] += Vec3(jitter(gen), jitter(gen), jitter(gen)); });
+}
+
+/**
+ * \brief random updates and removals, the top of the queue is checked against a brute force minimum
+ */
+template <typename QUEUE>
+static void check_queue(Map2& map)
+{
+	std::vector<Edge> edges;
+	map.foreach_cell([&] (Edge e) { edges.push_back(e); });
+	auto cost = map.add_attribute<float64, Edge>("cost");
+	auto in = map.add_attribute<bool, Edge>("in");
+	in.set_all_values(false);
+
+	QUEUE queue(map, "test");
+	std::mt19937 gen(5);
+	std::uniform_int_distribution<uint32> pick(0u, uint32(edges.size()) - 1u);
+	std::uniform_real_distribution<float64> value(0.0, 1.0);
+	for (uint32 i = 0u; i < 20000u; ++i)
+	{
+		const Edge e = edges[pick(gen)];
+		if (i % 3u == 2u)
+		{
+			queue.remove(e);
+			in[e] = false;
+		}
+		else
+		{
+			cost[e] = value(gen);
+			queue.update(e, cost[e]);
+			in[e] = true;
+		}
+
+		uint32 nb_in = 0u;
+		float64 min = 2.0;
+		for (Edge f : edges)
+		{
+			EXPECT_EQ(queue.contains(f), in[f]);
+			if (in[f])
+			{
+				++nb_in;
+				min = std::min(min, cost[f]);
+			}
+		}
+		ASSERT_EQ(queue.size(), nb_in);
+		ASSERT_EQ(queue.empty(), nb_in == 0u);
+		if (nb_in > 0u)
+		{
+			EXPECT_EQ(cost[queue.top()], min);
+		}
+	}
+
+	// draining the queue gives nondecreasing costs
+	float64 last = -1.0;
+	while (!queue.empty())
+	{
+		const Edge e = queue.top();
+		EXPECT_GE(cost[e], last);
+		last = cost[e];
+		queue.remove(e);
+	}
+	map.remove_attribute(cost);
+	map.remove_attribute(in);
+}
+
+TEST(EdgeQueueTest, indexed_heap)
+{
+	Map2 map;
+	auto position = map.add_attribute<Vec3, Vertex>("position");
+	jittered_tore(map, position, 8u, 6u);
+	check_queue<cgogn::modeling::EdgeQueue_IndexedHeap<Map2, float64>>(map);
+}
+
+TEST(EdgeQueueTest, lazy_heap)
+{
+	Map2 map;
+	auto position = map.add_attribute<Vec3, Vertex>("position");
+	jittered_tore(map, position, 8u, 6u);
+	check_queue<cgogn::modeling::EdgeQueue_LazyHeap<Map2, float64>>(map);
+}
+
+/**
+ * \brief the heap traversors collapse the same edges as the multimap traversors
+ */
+template <template <typename, typename> class QUEUE>
+static void check_decimation()
+{
+	using namespace cgogn::modeling;
+	using Queue = QUEUE<Map2, float64>;
+
+	auto decimated_positions = [] (bool qem, bool heap) -> std::vector<Vec3>
+	{
+		Map2 map;
+		auto position = map.add_attribute<Vec3, Vertex>("position");
+		jittered_tore(map, position, 40u, 20u);
+		EdgeApproximator_QEM<Map2, Vec3> approx(map, position);
+		if (qem && heap)
+		{
+			EdgeTraversor_QEM<Map2, Vec3, Queue> trav(map, position, approx);
+			decimate(map, position, trav, approx, 500u);
+		}
+		else if (qem)
+		{
+			EdgeTraversor_QEM<Map2, Vec3> trav(map, position, approx);
+			decimate(map, position, trav, approx, 500u);
+		}
+		else if (heap)
+		{
+			EdgeTraversor_EdgeLength<Map2, Vec3, Queue> trav(map, position);
+			decimate(map, position, trav, approx, 500u);
+		}
+		else
+		{
+			EdgeTraversor_EdgeLength<Map2, Vec3> trav(map, position);
+			decimate(map, position, trav, approx, 500u);
+		}
+		EXPECT_TRUE(map.check_map_integrity());
+		EXPECT_EQ(map.nb_cells<Vertex::ORBIT>(), 800u - 500u);
+
+		std::vector<Vec3> result;
+		map.foreach_cell([&] (Vertex v) { result.push_back(position[v]); });
+		std::sort(result.begin(), result.end(), [] (const Vec3& a, const Vec3& b)
+		{
+			return std::lexicographical_compare(a.data(), a.data() + 3, b.data(), b.data() + 3);
+		});
+		return result;
+	};
+
+	EXPECT_EQ(decimated_positions(true, true), decimated_positions(true, false));
+	EXPECT_EQ(decimated_positions(false, true), decimated_positions(false, false));
+}
+
+TEST(EdgeQueueTest, indexed_heap_decimation)
+{
+	check_decimation<cgogn::modeling::EdgeQueue_IndexedHeap>();
+}
+
+TEST(EdgeQueueTest, lazy_heap_decimation)
+{
+	check_decimation<cgogn::modeling::EdgeQueue_LazyHeap>();
+}
@@ -0,0 +1,207 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <algorithm>
+#include <random>
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+#include <cgogn/core/cmap/cmap2.h>
+#include <cgogn/geometry/types/eigen.h>
+#include <cgogn/modeling/tiling/triangular_tore.h>
+#include <cgogn/modeling/algos/decimation.h>
+
+using namespace cgogn::numerics;
+
+using Vec3 = Eigen::Vector3d;
+using Map2 = cgogn::CMap2;
+using Vertex = Map2::Vertex;
+using Face = Map2::Face;
+using ProgressiveMesh = cgogn::modeling::ProgressiveMesh<Vec3>;
+
+/**
+ * \brief positions and colors of the vertices, sorted by position
+ */
+static std::vector<std::pair<Vec3, Vec3>> sorted_vertices(const Map2& map, const Map2::VertexAttribute<Vec3>& position, const Map2::VertexAttribute<Vec3>& color)
+{
+	std::vector<std::pair<Vec3, Vec3>> result;
+	map.foreach_cell([&] (Vertex v) { result.push_back(std::make_pair(position[v], color[v])); });
+	std::sort(result.begin(), result.end(), [] (const std::pair<Vec3, Vec3>& a, const std::pair<Vec3, Vec3>& b)
+	{
+		return std::lexicographical_compare(a.first.data(), a.first.data() + 3, b.first.data(), b.first.data() + 3);
+	});
+	return result;
+}
+
+TEST(ProgressiveMeshTest, record_stream_and_refine)
+{
+	Map2 map;
+	auto position = map.add_attribute<Vec3, Vertex>("position");
+	auto color = map.add_attribute<Vec3, Vertex>("color");
+	cgogn::modeling::TriangularTore<Map2> tore(map, 30u, 20u);
+	tore.embed_into_tore(position, 10.0f, 4.0f);
+	std::mt19937 gen(5);
+	std::uniform_real_distribution<float64> jitter(-0.05, 0.05);
+	map.foreach_cell([&] (Vertex v)
+	{
+		position[v] += Vec3(jitter(gen), jitter(gen), jitter(gen));
+		color[v] = Vec3(0.5 + 0.05 * position[v][0], 0.5 - 0.05 * position[v][1], 0.25 * position[v][2]);
+	});
+	const std::vector<std::pair<Vec3, Vec3>> original = sorted_vertices(map, position, color);
+
+	cgogn::modeling::ProgressiveMeshRecorder<Vec3> recorder(map, position);
+	recorder.add_attribute(color);
+	cgogn::modeling::decimate(map, position, cgogn::modeling::EdgeTraversor_QEM_Heap_T, cgogn::modeling::EdgeApproximator_QEM_T, 450u, &recorder);
+	EXPECT_EQ(recorder.nb_collapses(), 450u);
+	EXPECT_EQ(map.nb_cells<Vertex::ORBIT>(), 150u);
+
+	ProgressiveMesh pm;
+	recorder.build(pm);
+	EXPECT_EQ(pm.nb_base_vertices(), 150u);
+	EXPECT_EQ(pm.nb_base_triangles(), 300u);
+	EXPECT_EQ(pm.nb_splits(), 450u);
+	for (uint32 i = 0u; i < pm.nb_splits(); ++i)
+	{
+		// a split only refers to existing vertices
+		EXPECT_LT(pm.split(i).vertex_, pm.nb_base_vertices() + i);
+		EXPECT_LT(pm.split(i).left_, pm.nb_base_vertices() + i);
+		EXPECT_LT(pm.split(i).right_, pm.nb_base_vertices() + i);
+	}
+
+	std::stringstream stream;
+	pm.save(stream);
+
+	// the base mesh first, then the splits in batches
+	ProgressiveMesh streamed;
+	ASSERT_TRUE(streamed.read_base(stream));
+	EXPECT_EQ(streamed.nb_splits_in_stream(), 450u);
+	EXPECT_EQ(streamed.nb_splits(), 0u);
+	ASSERT_EQ(streamed.nb_attributes(), 1u);
+	EXPECT_EQ(streamed.attribute_name(0u), "color");
+
+	Map2 lod;
+	auto lod_position = lod.add_attribute<Vec3, Vertex>("position");
+	cgogn::modeling::ProgressiveMeshPlayer<Vec3> player(streamed, lod, lod_position);
+	auto lod_color = lod.get_attribute<Vec3, Vertex>("color");
+	ASSERT_TRUE(lod_color.is_valid());
+	EXPECT_EQ(lod.nb_cells<Vertex::ORBIT>(), 150u);
+	EXPECT_EQ(lod.nb_cells<Face::ORBIT>(), 300u);
+	EXPECT_TRUE(lod.check_map_integrity());
+	EXPECT_EQ(sorted_vertices(lod, lod_position, lod_color).size(), 150u);
+
+	// splits are only applied once they are read
+	EXPECT_EQ(player.refine(1000u), 0u);
+	EXPECT_EQ(streamed.read_splits(stream, 100u), 100u);
+	EXPECT_EQ(player.refine(200u), 50u);
+	EXPECT_EQ(player.refine(1000u), 50u);
+	EXPECT_EQ(lod.nb_cells<Vertex::ORBIT>(), 250u);
+	EXPECT_EQ(lod.nb_cells<Face::ORBIT>(), 500u);
+	EXPECT_TRUE(lod.check_map_integrity());
+
+	while (streamed.read_splits(stream, 128u) > 0u)
+		player.refine(streamed.nb_vertices());
+	EXPECT_EQ(player.nb_vertices(), 600u);
+	EXPECT_EQ(player.nb_applied_splits(), 450u);
+	EXPECT_EQ(lod.nb_cells<Vertex::ORBIT>(), 600u);
+	EXPECT_EQ(lod.nb_cells<Map2::Edge::ORBIT>(), 1800u);
+	EXPECT_EQ(lod.nb_cells<Face::ORBIT>(), 1200u);
+	EXPECT_TRUE(lod.check_map_integrity());
+
+	// the original mesh is recovered
+	const std::vector<std::pair<Vec3, Vec3>> refined = sorted_vertices(lod, lod_position, lod_color);
+	ASSERT_EQ(refined.size(), original.size());
+	for (std::size_t i = 0u; i < refined.size(); ++i)
+	{
+		EXPECT_NEAR((refined[i].first - original[i].first).norm(), 0.0, 1e-9);
+		EXPECT_NEAR((refined[i].second - original[i].second).norm(), 0.0, 1e-9);
+	}
+}
+
+/**
+ * \brief overwrite the little endian uint32 at the given offset of a stream
+ */
+static void write_uint32(std::string& data, std::size_t offset, uint32 x)
+{
+	for (uint32 b = 0u; b < 4u; ++b)
+		data[offset + b] = char((x >> (8u * b)) & 0xffu);
+}
+
+TEST(ProgressiveMeshTest, invalid_stream)
+{
+	std::stringstream stream("not a progressive mesh");
+	ProgressiveMesh pm;
+	EXPECT_FALSE(pm.read_base(stream));
+
+	Map2 map;
+	auto position = map.add_attribute<Vec3, Vertex>("position");
+	cgogn::modeling::TriangularTore<Map2> tore(map, 10u, 8u);
+	tore.embed_into_tore(position, 10.0f, 4.0f);
+	cgogn::modeling::ProgressiveMeshRecorder<Vec3> recorder(map, position);
+	cgogn::modeling::decimate(map, position, cgogn::modeling::EdgeTraversor_QEM_Heap_T, cgogn::modeling::EdgeApproximator_QEM_T, 20u, &recorder);
+	recorder.build(pm);
+	std::stringstream out;
+	pm.save(out);
+	const std::string data = out.str();
+
+	// header (magic, version, scalar size, no attribute, sizes), positions, triangles, then splits
+	const std::size_t triangles = 28u + 3u * sizeof(float64) * pm.nb_base_vertices();
+	const std::size_t splits = triangles + 12u * pm.nb_base_triangles();
+	const std::size_t split_size = 12u + 6u * sizeof(float64);
+
+	{
+		std::string corrupted = data;
+		write_uint32(corrupted, triangles + 4u, pm.nb_base_vertices());
+		std::stringstream in(corrupted);
+		ProgressiveMesh streamed;
+		EXPECT_FALSE(streamed.read_base(in));
+		EXPECT_EQ(streamed.nb_base_triangles(), 0u);
+	}
+	{
+		// the first split cannot refer to a vertex added by a split
+		std::string corrupted = data;
+		write_uint32(corrupted, splits + 4u, pm.nb_base_vertices());
+		std::stringstream in(corrupted);
+		ProgressiveMesh streamed;
+		ASSERT_TRUE(streamed.read_base(in));
+		EXPECT_EQ(streamed.read_splits(in, 10u), 0u);
+		EXPECT_EQ(streamed.nb_splits(), 0u);
+	}
+	{
+		// the second split can refer to the vertex added by the first one, not further
+		std::string corrupted = data;
+		write_uint32(corrupted, splits + split_size, pm.nb_base_vertices() + 1u);
+		std::stringstream in(corrupted);
+		ProgressiveMesh streamed;
+		ASSERT_TRUE(streamed.read_base(in));
+		EXPECT_EQ(streamed.read_splits(in, 1u), 1u);
+		EXPECT_EQ(streamed.read_splits(in, 1u), 0u);
+		EXPECT_EQ(streamed.nb_splits(), 1u);
+	}
+	{
+		std::stringstream in(data);
+		ProgressiveMesh streamed;
+		EXPECT_TRUE(streamed.load(in));
+		EXPECT_EQ(streamed.nb_splits(), 20u);
+	}
+}
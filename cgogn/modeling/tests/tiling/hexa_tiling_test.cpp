@@ -0,0 +1,123 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <cgogn/core/cmap/cmap3_hexa.h>
+#include <cgogn/geometry/types/eigen.h>
+#include <cgogn/modeling/tiling/hexa_grid.h>
+
+namespace cgogn
+{
+
+using Hexa = CMap3Hexa;
+
+TEST(HexaTilingTest, HexaGrid)
+{
+	Hexa map;
+	const uint32 x = 5u, y = 4u, z = 3u;
+	cgogn::modeling::HexaGrid<Hexa> g(map, x, y, z);
+
+	EXPECT_EQ(map.nb_cells<Hexa::Vertex::ORBIT>(), (x+1)*(y+1)*(z+1));
+	EXPECT_EQ(map.nb_cells<Hexa::Edge::ORBIT>(), x*(y+1)*(z+1) + (x+1)*y*(z+1) + (x+1)*(y+1)*z);
+	EXPECT_EQ(map.nb_cells<Hexa::Face::ORBIT>(), x*y*(z+1) + x*(y+1)*z + (x+1)*y*z);
+	EXPECT_EQ(map.nb_cells<Hexa::Volume::ORBIT>(), x*y*z);
+	EXPECT_EQ(g.volume_table_.size(), x*y*z);
+
+	uint32 nb_boundary_faces = 0u;
+	map.foreach_dart([&] (Dart d)
+	{
+		if (map.is_boundary(d))
+			return;
+		EXPECT_NE(map.phi3(d), d);
+		EXPECT_EQ(map.phi3(map.phi3(d)), d);
+		if (map.is_boundary(map.phi3(d)))
+			++nb_boundary_faces;
+	});
+	EXPECT_EQ(nb_boundary_faces, 4u * 2u * (x*y + y*z + x*z));
+	EXPECT_TRUE(map.check_map_integrity());
+}
+
+TEST(HexaTilingTest, HexaGridOtherHoles)
+{
+	// an open hexahedron of the map is not closed with the grid
+	Hexa map;
+	Hexa::Builder mbuild(map);
+	const Dart open = mbuild.add_volumes_topo_fp(1u);
+	const uint32 x = 3u, y = 2u, z = 2u;
+	cgogn::modeling::HexaGrid<Hexa> g(map, x, y, z);
+
+	// the only open darts (out of the boundary) are the ones of the hexahedron
+	uint32 nb_open = 0u;
+	map.foreach_dart([&] (Dart d)
+	{
+		if (!map.is_boundary(d) && map.phi3(d) == d)
+			++nb_open;
+	});
+	map.foreach_dart_of_orbit(Hexa::Volume(open), [&] (Dart d) { EXPECT_EQ(map.phi3(d), d); });
+	EXPECT_EQ(nb_open, 24u);
+	EXPECT_EQ(map.nb_cells<Hexa::Volume::ORBIT>(), x*y*z + 1u);
+	mbuild.close_boundary(open);
+	EXPECT_TRUE(map.check_map_integrity());
+}
+
+TEST(HexaTilingTest, embed_into_grid)
+{
+	Hexa map;
+	auto position = map.add_attribute<Eigen::Vector3d, Hexa::Vertex>("position");
+	const uint32 x = 4u, y = 6u, z = 5u;
+	cgogn::modeling::HexaGrid<Hexa> g(map, x, y, z);
+	g.embed_into_grid(position, float32(x), float32(y), float32(z));
+
+	EXPECT_EQ(map.nb_cells<Hexa::Vertex::ORBIT>(), (x+1)*(y+1)*(z+1));
+	for (uint32 v = 0u; v < g.vertex_table_.size(); ++v)
+		EXPECT_EQ(map.embedding(g.vertex_table_[v]), v);
+
+	// all the edges of the cubes are unit edges aligned with the axes,
+	// and the darts of a vertex are embedded on the same line
+	map.foreach_dart([&] (Dart d)
+	{
+		if (map.is_boundary(d))
+			return;
+		const Eigen::Vector3d e = position[Hexa::Vertex(map.phi1(d))] - position[Hexa::Vertex(d)];
+		EXPECT_NEAR(e.norm(), 1.0, 1e-5);
+		EXPECT_NEAR(e.cwiseAbs().maxCoeff(), 1.0, 1e-5);
+		EXPECT_EQ(map.embedding(Hexa::Vertex(map.phi2(map.phi_1(d)))), map.embedding(Hexa::Vertex(d)));
+		EXPECT_EQ(map.embedding(Hexa::Vertex(map.phi1(map.phi3(d)))), map.embedding(Hexa::Vertex(d)));
+	});
+
+	// the volumes are positively oriented (VolumeImport order)
+	for (Hexa::Volume w : g.volume_table_)
+	{
+		const Dart d = w.dart;
+		const Eigen::Vector3d p0 = position[Hexa::Vertex(d)];
+		const Eigen::Vector3d p1 = position[Hexa::Vertex(map.phi1(d))];
+		const Eigen::Vector3d p2 = position[Hexa::Vertex(map.phi1(map.phi1(d)))];
+		const Eigen::Vector3d p4 = position[Hexa::Vertex(map.phi2(map.phi1(map.phi1(map.phi2(map.phi_1(d))))))];
+		EXPECT_LT((p1 - p0).cross(p2 - p0).dot(p4 - p0), 0.0);
+	}
+
+	EXPECT_TRUE(map.check_map_integrity());
+}
+
+} // namespace cgogn
@@ -26,6 +26,8 @@
 #include <gtest/gtest.h>
 
 #include <cgogn/core/cmap/cmap2.h>
+#include <cgogn/core/cmap/cmap2_quad.h>
+#include <cgogn/geometry/types/eigen.h>
 #include <cgogn/geometry/types/geometry_traits.h>
 #include <cgogn/modeling/tiling/square_tore.h>
 
@@ -84,6 +86,43 @@ TEST_F(SquareTilingTest, SquareGrid)
 	EXPECT_TRUE(cmap_.check_map_integrity());
 }
 
+TEST_F(SquareTilingTest, SquareGridQuad)
+{
+	using Quad = CMap2Quad;
+	Quad quads;
+	auto position = quads.add_attribute<Eigen::Vector3d, Quad::Vertex>("position");
+	cgogn::modeling::SquareGrid<Quad> g(quads, x_, y_);
+	g.embed_into_grid(position, float32(x_), float32(y_), 0.0f);
+
+	EXPECT_EQ(quads.nb_cells<Quad::Vertex::ORBIT>(), (x_+1)*(y_+1));
+	EXPECT_EQ(quads.nb_cells<Quad::Face::ORBIT>(), x_*y_);
+
+	// all the squares have unit edges
+	quads.foreach_cell([&] (Quad::Face f)
+	{
+		quads.foreach_dart_of_orbit(f, [&] (Dart d)
+		{
+			EXPECT_NEAR((position[Quad::Vertex(quads.phi1(d))] - position[Quad::Vertex(d)]).norm(), 1.0, 1e-5);
+		});
+	});
+
+	EXPECT_TRUE(quads.check_map_integrity());
+}
+
+TEST_F(SquareTilingTest, SquareGridOtherHoles)
+{
+	// an open face of the map is not closed with the grid
+	CMap2 map;
+	CMap2::Builder mbuild(map);
+	const Dart open = mbuild.add_face_topo_fp(5u);
+	cgogn::modeling::SquareGrid<CMap2> g(map, x_, y_);
+
+	map.foreach_dart_of_orbit(Face(open), [&] (Dart d) { EXPECT_EQ(map.phi2(d), d); });
+	EXPECT_EQ(map.nb_cells<Face::ORBIT>(), x_*y_ + 1u);
+	EXPECT_EQ(mbuild.close_map(), 1u);
+	EXPECT_TRUE(map.check_map_integrity());
+}
+
 TEST_F(SquareTilingTest, SquareCylinder)
 {
 	cgogn::modeling::SquareCylinder<CMap2> g(cmap_, x_, y_);
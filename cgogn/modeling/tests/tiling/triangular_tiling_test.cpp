@@ -26,6 +26,8 @@
 #include <gtest/gtest.h>
 
 #include <cgogn/core/cmap/cmap2.h>
+#include <cgogn/core/cmap/cmap2_tri.h>
+#include <cgogn/geometry/types/eigen.h>
 #include <cgogn/geometry/types/geometry_traits.h>
 #include <cgogn/modeling/tiling/triangular_tore.h>
 
@@ -84,6 +86,44 @@ TEST_F(TriangularTilingTest, TriangularGrid)
 	EXPECT_TRUE(cmap_.check_map_integrity());
 }
 
+TEST_F(TriangularTilingTest, TriangularGridTri)
+{
+	using Tri = CMap2Tri;
+	Tri triangles;
+	auto position = triangles.add_attribute<Eigen::Vector3d, Tri::Vertex>("position");
+	cgogn::modeling::TriangularGrid<Tri> g(triangles, x_, y_);
+	g.embed_into_grid(position, float32(x_), float32(y_), 0.0f);
+
+	EXPECT_EQ(triangles.nb_cells<Tri::Vertex::ORBIT>(), (x_+1)*(y_+1));
+	EXPECT_EQ(triangles.nb_cells<Tri::Face::ORBIT>(), 2u*x_*y_);
+
+	// all the triangles are equilateral with unit edges
+	triangles.foreach_cell([&] (Tri::Face f)
+	{
+		triangles.foreach_dart_of_orbit(f, [&] (Dart d)
+		{
+			EXPECT_NEAR((position[Tri::Vertex(triangles.phi1(d))] - position[Tri::Vertex(d)]).norm(), 1.0, 1e-4);
+		});
+	});
+
+	EXPECT_TRUE(triangles.check_map_integrity());
+}
+
+TEST_F(TriangularTilingTest, TriangularGridOtherHoles)
+{
+	// an open triangle of the map is not closed with the grid
+	using Tri = CMap2Tri;
+	Tri triangles;
+	Tri::Builder mbuild(triangles);
+	const Dart open = mbuild.add_faces_topo_fp(1u, 3u);
+	cgogn::modeling::TriangularGrid<Tri> g(triangles, x_, y_);
+
+	triangles.foreach_dart_of_orbit(Tri::Face(open), [&] (Dart d) { EXPECT_EQ(triangles.phi2(d), d); });
+	EXPECT_EQ(triangles.nb_cells<Tri::Face::ORBIT>(), 2u*x_*y_ + 1u);
+	EXPECT_EQ(mbuild.close_map(), 1u);
+	EXPECT_TRUE(triangles.check_map_integrity());
+}
+
 TEST_F(TriangularTilingTest, TriangularCylinder)
 {
 	cgogn::modeling::TriangularCylinder<CMap2> g(cmap_, x_, y_);
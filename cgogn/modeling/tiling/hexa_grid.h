@@ -0,0 +1,290 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef CGOGN_MODELING_TILING_HEXA_GRID_H_
+#define CGOGN_MODELING_TILING_HEXA_GRID_H_
+
+#include <array>
+
+#include <cgogn/core/cmap/cmap3_hexa.h>
+#include <cgogn/core/cmap/cmap3_builder.h>
+#include <cgogn/modeling/tiling/tiling.h>
+#include <cgogn/geometry/types/geometry_traits.h>
+
+namespace cgogn
+{
+
+namespace modeling
+{
+
+/*! \brief The class of regular 3D grids of hexahedra (CMap3Hexa)
+ * The darts, phi3 and the vertex embedding are computed from the (i,j,k) indices of the cubes and written in parallel.
+ */
+template <typename MAP>
+class HexaGrid : public Tiling<MAP>
+{
+	static_assert(MAP::PRIM_SIZE == 24u, "HexaGrid works only with CMap3Hexa");
+
+	using CDart = typename MAP::CDart;
+	using Vertex = typename MAP::Vertex;
+	using Edge = typename MAP::Edge;
+	using Face = typename MAP::Face;
+	using Volume = typename MAP::Volume;
+
+public:
+
+	CGOGN_NOT_COPYABLE_NOR_MOVABLE(HexaGrid);
+
+	//@{
+	//! Create a 3D grid
+	/*! @param[in] x nb of cubes in x
+	 *  @param[in] y nb of cubes in y
+	 *  @param[in] z nb of cubes in z
+	 */
+	HexaGrid(MAP& map, uint32 x, uint32 y, uint32 z) :
+		Tiling<MAP>(map, x, y, z)
+	{
+		using MapBuilder = typename MAP::Builder;
+		MapBuilder mbuild(this->map_);
+
+		const uint32 nb_x = x+1;
+		const uint32 nb_xy = (x+1)*(y+1);
+		const uint32 nb_vertices = (x+1)*(y+1)*(z+1);
+		const uint32 nb_volumes = x*y*z;
+
+		// cube c = (k*y+j)*x+i is made of the darts first + 24*c + [0,24[
+		const Dart d = mbuild.add_volumes_topo_fp(nb_volumes);
+		const uint32 first = d.index;
+
+		// corner (in x,y,z) of the origin of each dart of a cube and phi3 towards the adjacent cubes
+		// (identical for all cubes), the corners of the vertices are in the VolumeImport order
+		static const uint32 corners[8][3] = {
+			{ 0u, 0u, 0u }, { 0u, 1u, 0u }, { 1u, 1u, 0u }, { 1u, 0u, 0u },
+			{ 0u, 0u, 1u }, { 0u, 1u, 1u }, { 1u, 1u, 1u }, { 1u, 0u, 1u }
+		};
+		const std::array<Dart, 8> vertices_of_hexa = {{
+			d,
+			this->map_.phi1(d),
+			this->map_.phi1(this->map_.phi1(d)),
+			this->map_.phi_1(d),
+			this->map_.phi2(this->map_.phi1(this->map_.phi1(this->map_.phi2(this->map_.phi_1(d))))),
+			this->map_.phi2(this->map_.phi1(this->map_.phi1(this->map_.phi2(d)))),
+			this->map_.phi2(this->map_.phi1(this->map_.phi1(this->map_.phi2(this->map_.phi1(d))))),
+			this->map_.phi2(this->map_.phi1(this->map_.phi1(this->map_.phi2(this->map_.phi1(this->map_.phi1(d))))))
+		}};
+		std::array<uint32, 24> local_vertex;
+		for (uint32 v = 0u; v < 8u; ++v)
+		{
+			Dart dd = vertices_of_hexa[v];
+			do
+			{
+				local_vertex[dd.index - first] = v;
+				dd = this->map_.phi1(this->map_.phi2(dd));
+			} while (dd != vertices_of_hexa[v]);
+		}
+
+		// the face of dart l is on the side side[l] (0 or 1) of the cube along axis[l],
+		// it is sewn with dart local_phi3[l] of the adjacent cube on this side
+		std::array<uint32, 24> axis;
+		std::array<uint32, 24> side;
+		std::array<uint32, 24> local_phi3;
+		const auto corner = [&] (uint32 l) -> const uint32* { return corners[local_vertex[l]]; };
+		const auto phi1 = [&] (uint32 l) -> uint32 { return this->map_.phi1(Dart(first + l)).index - first; };
+		for (uint32 l = 0u; l < 24u; ++l)
+		{
+			for (uint32 a = 0u; a < 3u; ++a)
+			{
+				if (corner(phi1(l))[a] == corner(l)[a] && corner(phi1(phi1(l)))[a] == corner(l)[a])
+				{
+					axis[l] = a;
+					side[l] = corner(l)[a];
+				}
+			}
+			// in the adjacent cube, the corners are shifted by -1 (side 1) or +1 (side 0) along the axis
+			const auto shifted = [&] (uint32 m, uint32 a) -> uint32
+			{
+				if (a != axis[l])
+					return corner(m)[a];
+				return side[l] == 1u ? corner(m)[a] - 1u : corner(m)[a] + 1u;
+			};
+			for (uint32 m = 0u; m < 24u; ++m)
+			{
+				bool match = true;
+				for (uint32 a = 0u; a < 3u; ++a)
+					match = match && corner(m)[a] == shifted(phi1(l), a) && corner(phi1(m))[a] == shifted(l, a);
+				if (match)
+					local_phi3[l] = m;
+			}
+		}
+
+		const auto cube = [&] (uint32 i, uint32 j, uint32 k) { return (k*y+j)*x+i; };
+
+		auto& phi3 = mbuild.ca_phi3();
+		parallel_foreach_index(0u, nb_volumes, [&] (uint32 c)
+		{
+			const uint32 ijk[3] = { c % x, (c / x) % y, c / (x*y) };
+			const uint32 n[3] = { x, y, z };
+			for (uint32 l = 0u; l < 24u; ++l)
+			{
+				uint32 adj[3] = { ijk[0], ijk[1], ijk[2] };
+				const uint32 a = axis[l];
+				const bool inside = side[l] == 1u ? adj[a] + 1u < n[a] : adj[a] > 0u;
+				if (inside)
+				{
+					adj[a] = side[l] == 1u ? adj[a] + 1u : adj[a] - 1u;
+					phi3[first + 24u*c + l] = Dart(first + 24u*cube(adj[0], adj[1], adj[2]) + local_phi3[l]);
+				}
+				else
+					phi3[first + 24u*c + l] = Dart(first + 24u*c + l);
+			}
+		});
+
+		this->vertex_table_.resize(nb_vertices);
+		volume_table_.resize(nb_volumes);
+		parallel_foreach_index(0u, nb_volumes, [&] (uint32 c)
+		{
+			volume_table_[c] = Volume(Dart(first + 24u*c));
+		});
+		parallel_foreach_index(0u, nb_vertices, [&] (uint32 v)
+		{
+			const uint32 ijk[3] = { v % nb_x, (v / nb_x) % (y+1), v / nb_xy };
+			const uint32 n[3] = { x, y, z };
+			uint32 c[3];
+			uint32 local[3];
+			for (uint32 a = 0u; a < 3u; ++a)
+			{
+				c[a] = ijk[a] < n[a] ? ijk[a] : n[a] - 1u;
+				local[a] = ijk[a] - c[a];
+			}
+			uint32 lv = 0u;
+			while (corners[lv][0] != local[0] || corners[lv][1] != local[1] || corners[lv][2] != local[2])
+				++lv;
+			this->vertex_table_[v] = Vertex(Dart(vertices_of_hexa[lv].index + 24u*cube(c[0], c[1], c[2])));
+		});
+
+		this->dart_ = d;
+
+		// the vertices are embedded from the indices of the cubes (vertex v of the table is embedded on line first + v),
+		// the other cells one by one
+		if (this->map_.template is_embedded<Vertex>())
+		{
+			mbuild.template new_embeddings<Vertex::ORBIT>(
+				d, 24u*nb_volumes, nb_vertices,
+				[&] (uint32 e) -> uint32
+				{
+					const uint32 c = e / 24u;
+					const uint32* o = corner(e % 24u);
+					return (c / (x*y) + o[2]) * nb_xy + ((c / x) % y + o[1]) * nb_x + c % x + o[0];
+				},
+				[&] (uint32 v) -> uint32
+				{
+					// 3 darts in each incident cube
+					const uint32 ijk[3] = { v % nb_x, (v / nb_x) % (y+1), v / nb_xy };
+					const uint32 n[3] = { x, y, z };
+					uint32 nb = 3u;
+					for (uint32 a = 0u; a < 3u; ++a)
+						nb *= (ijk[a] > 0u ? 1u : 0u) + (ijk[a] < n[a] ? 1u : 0u);
+					return nb;
+				}
+			);
+		}
+
+		embed_cells<CDart>(mbuild, first, 24u*nb_volumes);
+		embed_cells<Edge>(mbuild, first, 24u*nb_volumes);
+		embed_cells<Face>(mbuild, first, 24u*nb_volumes);
+		embed_cells<Volume>(mbuild, first, 24u*nb_volumes);
+
+		// close the boundary of the grid (and not the other holes of the map) and copy the embeddings of the incident cells on it
+		mbuild.close_boundary(this->dart_);
+	}
+	//@}
+
+	/**
+	 * @brief Table of volumes, cube (i,j,k) is volume (k*ny+j)*nx+i
+	 */
+	std::vector<Volume> volume_table_;
+
+	/*! @name Embedding Operators
+	 *************************************************************************/
+
+	//@{
+	//! Embed a topological grid into a geometrical grid
+	/*! @param[in] attribute Attribute used to store vertices positions
+	 *  @param[in] x size in X
+	 *  @param[in] y size in Y
+	 *  @param[in] z size in Z
+	 *  the grid is centered on 0
+	 */
+	template <typename VERTEX_ATTR>
+	void embed_into_grid(VERTEX_ATTR& attribute,
+						 float32 x,
+						 float32 y,
+						 float32 z)
+	{
+		static_assert(is_orbit_of<VERTEX_ATTR, MAP::Vertex::ORBIT>::value,"position must be a vertex attribute");
+
+		using T = InsideTypeOf<VERTEX_ATTR>;
+		const float32 dx = x / float32(this->nx_);
+		const float32 dy = y / float32(this->ny_);
+		const float32 dz = z / float32(this->nz_);
+
+		parallel_foreach_index(0u, this->nz_ + 1u, [&] (uint32 k)
+		{
+			for(uint32 j = 0; j <= this->ny_; ++j)
+			{
+				for(uint32 i = 0; i <= this->nx_; ++i)
+				{
+					attribute[this->vertex_table_[(k*(this->ny_+1)+j)*(this->nx_+1)+i]] =
+							T(-x/2.0f+dx*float32(i),
+							  -y/2.0f+dy*float32(j),
+							  -z/2.0f+dz*float32(k));
+				}
+			}
+		});
+	}
+	//@}
+
+private:
+
+	template <typename CellType, typename MapBuilder>
+	void embed_cells(MapBuilder& mbuild, uint32 first, uint32 nb_darts)
+	{
+		if (!this->map_.template is_embedded<CellType>())
+			return;
+		for (uint32 i = first; i < first + nb_darts; ++i)
+		{
+			if (this->map_.embedding(CellType(Dart(i))) == INVALID_INDEX)
+				mbuild.new_orbit_embedding(CellType(Dart(i)));
+		}
+	}
+};
+
+#if defined(CGOGN_USE_EXTERNAL_TEMPLATES) && (!defined(CGOGN_MODELING_EXTERNAL_TEMPLATES_CPP_))
+extern template class CGOGN_MODELING_API HexaGrid<CMap3Hexa>;
+#endif // defined(CGOGN_USE_EXTERNAL_TEMPLATES) && (!defined(CGOGN_MODELING_EXTERNAL_TEMPLATES_CPP_))
+
+} //namespace modeling
+
+} //namespace cgogn
+
+#endif // CGOGN_MODELING_TILING_HEXA_GRID_H_
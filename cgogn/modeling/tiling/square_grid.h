@@ -66,55 +66,37 @@ public:
 			const uint32 nb_vertices = (x+1)*(y+1);
 			const uint32 nb_faces = x*y;
 
-			g->vertex_table_.reserve(nb_vertices);
-			g->face_table_.reserve(nb_faces);
+			// the darts, phi2 and the tables are computed from the (i,j) indices of the squares:
+			// the darts of square (i,j) are 4*(i*x+j) + [0,4[ starting from the vertices (i,j), (i,j+1), (i+1,j+1) and (i+1,j)
+			const uint32 first = mbuild.add_faces_topo_fp(nb_faces, 4u).index;
+			const auto dart = [&] (uint32 i, uint32 j, uint32 k) { return Dart(first + 4u*(i*x+j) + k); };
 
-			//creation of quads and storing vertices
-			for(uint32 i = 0 ; i < y ; ++i)
+			auto& phi2 = mbuild.ca_phi2();
+			parallel_foreach_index(0u, nb_faces, [&] (uint32 f)
 			{
-				for(uint32 j = 1 ; j <= x ; ++j)
-				{
-					Dart d = mbuild.add_face_topo_fp(4);
-					g->vertex_table_.push_back(Vertex(d));
-					g->face_table_.push_back(Face(d));
-
-					if (j == x)
-						g->vertex_table_.push_back(Vertex(g->map_.phi1(d)));
-				}
-			}
-
-			// store last row of vertices
-			const uint32 idx = (x+1)*(y-1);
-			for (uint32 i = 0; i < x; ++i)
-				g->vertex_table_.push_back(Vertex(g->map_.phi_1(g->vertex_table_[idx+i].dart)));
-
-			g->vertex_table_.push_back(Vertex(g->map_.phi1(g->vertex_table_[idx+x].dart)));
+				const uint32 i = f / x;
+				const uint32 j = f % x;
+				phi2[dart(i,j,0u).index] = i > 0u ? dart(i-1u,j,2u) : dart(i,j,0u); // sew with preceeding row
+				phi2[dart(i,j,1u).index] = j < x-1u ? dart(i,j+1u,3u) : dart(i,j,1u); // sew with next column
+				phi2[dart(i,j,2u).index] = i < y-1u ? dart(i+1u,j,0u) : dart(i,j,2u); // sew with next row
+				phi2[dart(i,j,3u).index] = j > 0u ? dart(i,j-1u,1u) : dart(i,j,3u); // sew with preceeding column
+			});
 
-			//sewing pairs of quads
-			const uint32 nb_x = (x+1);
-			for (uint32 i = 0; i < y; ++i)
+			g->vertex_table_.resize(nb_vertices);
+			g->face_table_.resize(nb_faces);
+			parallel_foreach_index(0u, nb_faces, [&] (uint32 f)
 			{
-				for (uint32 j = 0; j < x; ++j)
-				{
-					if (i > 0) // sew with preceeding row
-					{
-						const int32 pos = i*nb_x+j;
-						Dart d = g->vertex_table_[pos].dart;
-						Dart e = g->vertex_table_[pos-nb_x].dart;
-						e = g->map_.phi1(g->map_.phi1(e));
-						mbuild.phi2_sew(d, e);
-					}
-					if (j > 0) // sew with preceeding column
-					{
-						const int32 pos = i*nb_x+j;
-						Dart d = g->vertex_table_[pos].dart;
-						d = g->map_.phi_1(d);
-						Dart e = g->vertex_table_[pos-1].dart;
-						e = g->map_.phi1(e);
-						mbuild.phi2_sew(d, e);
-					}
-				}
-			}
+				g->face_table_[f] = Face(Dart(first + 4u*f));
+			});
+			parallel_foreach_index(0u, nb_vertices, [&] (uint32 v)
+			{
+				const uint32 i = v / (x+1);
+				const uint32 j = v % (x+1);
+				if (i < y)
+					g->vertex_table_[v] = Vertex(j < x ? dart(i,j,0u) : dart(i,x-1u,1u));
+				else // last row of vertices
+					g->vertex_table_[v] = Vertex(j < x ? dart(y-1u,j,3u) : dart(y-1u,x-1u,2u));
+			});
 		}
 		//@}
 	};
@@ -134,13 +116,26 @@ public:
 		using MapBuilder = typename MAP::Builder;
 		MapBuilder mbuild(this->map_);
 
-		//close the hole
-		Dart f = mbuild.close_hole_topo(this->dart_);
-
-		//and embed the vertices
+		//embed the vertices from the indices of the squares (vertex v of the table is embedded on line first + v)
 		if(this->map_.template is_embedded<Vertex>())
-			for(Vertex v : this->vertex_table_)
-				mbuild.new_orbit_embedding(v);
+		{
+			const uint32 nb_x = x+1;
+			mbuild.template new_embeddings<Vertex::ORBIT>(
+				this->dart_, 4u*x*y, nb_x*(y+1),
+				[&] (uint32 d) -> uint32
+				{
+					const uint32 f = d / 4u;
+					const uint32 k = d % 4u;
+					return (f/x + (k >= 2u ? 1u : 0u)) * nb_x + f%x + ((k == 1u || k == 2u) ? 1u : 0u);
+				},
+				[&] (uint32 v) -> uint32
+				{
+					const uint32 i = v / nb_x;
+					const uint32 j = v % nb_x;
+					return ((i > 0u ? 1u : 0u) + (i < y ? 1u : 0u)) * ((j > 0u ? 1u : 0u) + (j < x ? 1u : 0u));
+				}
+			);
+		}
 
 		if(this->map_.template is_embedded<Edge>())
 			this->map_.foreach_incident_edge(Volume(this->dart_), [&](Edge e)
@@ -151,9 +146,6 @@ public:
 		if(this->map_.template is_embedded<Volume>())
 			mbuild.new_orbit_embedding(Volume(this->dart_));
 
-		//mark it as boundary
-		mbuild.boundary_mark(Face(f));
-
 		/*
 		if(this->map_.template is_embedded<CDart>())
 			this->map_.foreach_dart_of_orbit(Volume(this->dart_), [&](CDart d)
@@ -167,6 +159,9 @@ public:
 			{
 				mbuild.new_orbit_embedding(f);
 			});
+
+		//close the hole, mark it as boundary and copy the embeddings of the incident cells on it
+		mbuild.close_boundary(this->dart_);
 	}
 
 	/*! @name Embedding Operators
@@ -191,7 +186,7 @@ public:
 		const float32 dx = x / float32(this->nx_);
 		const float32 dy = y / float32(this->ny_);
 
-		for(uint32 i = 0; i <= this->ny_; ++i)
+		parallel_foreach_index(0u, this->ny_ + 1u, [&] (uint32 i)
 		{
 			for(uint32 j = 0; j <= this->nx_; ++j)
 			{
@@ -200,7 +195,7 @@ public:
 						  -y/2.0+dy*float32(i),
 						  z);
 			}
-		}
+		});
 	}
 	//! Embed a topological grid into a twister open ribbon
 	/*! @details with turns=PI it is a Moebius strip, needs only to be closed (if model allows it)
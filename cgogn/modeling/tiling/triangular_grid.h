@@ -57,6 +57,7 @@ public:
 		GridTopo(Tiling<INNERMAP>* g, uint32 x, uint32 y)
 		{
 			using Vertex = typename INNERMAP::Vertex;
+			using Edge = typename INNERMAP::Edge;
 			using Face = typename INNERMAP::Face;
 
 			using MapBuilder = typename INNERMAP::Builder;
@@ -65,61 +66,43 @@ public:
 			const uint32 nb_vertices = (x+1)*(y+1);
 			const uint32 nb_faces = 2*x*y;
 
-			g->vertex_table_.reserve(nb_vertices);
-			g->face_table_.reserve(nb_faces);
+			// the darts, phi2 and the tables are computed from the (i,j) indices of the squares:
+			// the darts of square (i,j) are 6*(i*x+j) + [0,6[, the first triangle starting from the vertices (i,j), (i,j+1), (i+1,j)
+			// and the second one from the vertices (i,j+1), (i+1,j+1), (i+1,j)
+			const uint32 first = mbuild.add_faces_topo_fp(nb_faces, 3u).index;
+			const auto dart = [&] (uint32 i, uint32 j, uint32 k) { return Dart(first + 6u*(i*x+j) + k); };
 
-			//creation of triangles and storing vertices
-			for(uint32 i = 0 ; i < y ; ++i)
+			auto& phi2 = mbuild.ca_phi2();
+			parallel_foreach_index(0u, x*y, [&] (uint32 f)
 			{
-				for(uint32 j = 1 ; j <= x ; ++j)
-				{
-					Dart d = mbuild.add_face_topo_fp(3);
-					Dart d2 = mbuild.add_face_topo_fp(3);
-					mbuild.phi2_sew(g->map_.phi1(d), g->map_.phi_1(d2));
-
-					g->vertex_table_.push_back(Vertex(d));
-					g->edge_table_.push_back(Edge(d));
-
-					g->face_table_.push_back(Face(d));
-					g->face_table_.push_back(Face(d2));
-
-					if (j == x)
-						g->vertex_table_.push_back(Vertex(d2));
-				}
-			}
-
-			// store last row of vertices
-			const uint32 idx = (x+1)*(y-1);
-			for (uint32 i = 0; i < x; ++i)
-				g->vertex_table_.push_back(Vertex(g->map_.phi_1(g->vertex_table_[idx+i].dart)));
-
-			g->vertex_table_.push_back(Vertex(g->map_.phi1(g->vertex_table_[idx+x].dart)));
+				const uint32 i = f / x;
+				const uint32 j = f % x;
+				phi2[dart(i,j,0u).index] = i > 0u ? dart(i-1u,j,4u) : dart(i,j,0u); // sew with preceeding row
+				phi2[dart(i,j,1u).index] = dart(i,j,5u); // sew the two triangles
+				phi2[dart(i,j,2u).index] = j > 0u ? dart(i,j-1u,3u) : dart(i,j,2u); // sew with preceeding column
+				phi2[dart(i,j,3u).index] = j < x-1u ? dart(i,j+1u,2u) : dart(i,j,3u); // sew with next column
+				phi2[dart(i,j,4u).index] = i < y-1u ? dart(i+1u,j,0u) : dart(i,j,4u); // sew with next row
+				phi2[dart(i,j,5u).index] = dart(i,j,1u);
+			});
 
-			//sewing pairs of triangles
-			const uint32 nb_x = (x+1);
-			for (uint32 i = 0; i < y; ++i)
+			g->vertex_table_.resize(nb_vertices);
+			g->edge_table_.resize(x*y);
+			g->face_table_.resize(nb_faces);
+			parallel_foreach_index(0u, x*y, [&] (uint32 f)
 			{
-				for (uint32 j = 0; j < x; ++j)
-				{
-					if (i > 0) // sew with preceeding row
-					{
-						const int32 pos = i*nb_x+j;
-						Dart d = g->vertex_table_[pos].dart;
-						Dart e = g->vertex_table_[pos-nb_x].dart;
-						e = g->map_.phi_1(g->map_.phi2(g->map_.phi1(e)));
-						mbuild.phi2_sew(d, e);
-					}
-					if (j > 0) // sew with preceeding column
-					{
-						const int32 pos = i*nb_x+j;
-						Dart d = g->vertex_table_[pos].dart;
-						d = g->map_.phi_1(d);
-						Dart e = g->vertex_table_[pos-1].dart;
-						e = g->map_.phi1(g->map_.phi2(g->map_.phi1(e)));
-						mbuild.phi2_sew(d, e);
-					}
-				}
-			}
+				g->edge_table_[f] = Edge(Dart(first + 6u*f));
+				g->face_table_[2u*f] = Face(Dart(first + 6u*f));
+				g->face_table_[2u*f+1u] = Face(Dart(first + 6u*f + 3u));
+			});
+			parallel_foreach_index(0u, nb_vertices, [&] (uint32 v)
+			{
+				const uint32 i = v / (x+1);
+				const uint32 j = v % (x+1);
+				if (i < y)
+					g->vertex_table_[v] = Vertex(j < x ? dart(i,j,0u) : dart(i,x-1u,3u));
+				else // last row of vertices
+					g->vertex_table_[v] = Vertex(j < x ? dart(y-1u,j,2u) : dart(y-1u,x-1u,4u));
+			});
 		}
 		//@}
 	};
@@ -138,25 +121,44 @@ public:
 		using MapBuilder = typename MAP::Builder;
 		MapBuilder mbuild(this->map_);
 
-		// close the hole
-		Dart f = mbuild.close_hole_topo(this->dart_);
-		mbuild.boundary_mark(Face(f));
-
 		// embed the cells
 
 		if (this->map_.template is_embedded<CDart>())
 		{
 			this->map_.foreach_dart_of_orbit(Volume(this->dart_), [&] (Dart d)
 			{
-				if (!this->map_.is_boundary(d))
-					mbuild.new_orbit_embedding(CDart(d));
+				mbuild.new_orbit_embedding(CDart(d));
 			});
 		}
 
+		// the vertices are embedded from the indices of the squares (vertex v of the table is embedded on line first + v)
 		if (this->map_.template is_embedded<Vertex>())
 		{
-			for (Vertex v : this->vertex_table_)
-				mbuild.new_orbit_embedding(v);
+			// local vertex of the darts of a square: (i,j), (i,j+1), (i+1,j), (i,j+1), (i+1,j+1), (i+1,j)
+			static const uint32 di[6] = { 0u, 0u, 1u, 0u, 1u, 1u };
+			static const uint32 dj[6] = { 0u, 1u, 0u, 1u, 1u, 0u };
+			const uint32 nb_x = x+1;
+			mbuild.template new_embeddings<Vertex::ORBIT>(
+				this->dart_, 6u*x*y, nb_x*(y+1),
+				[&] (uint32 d) -> uint32
+				{
+					const uint32 f = d / 6u;
+					const uint32 k = d % 6u;
+					return (f/x + di[k]) * nb_x + f%x + dj[k];
+				},
+				[&] (uint32 v) -> uint32
+				{
+					// 1 dart in square (i,j), 2 in (i,j-1), 2 in (i-1,j) and 1 in (i-1,j-1)
+					const uint32 i = v / nb_x;
+					const uint32 j = v % nb_x;
+					uint32 nb = 0u;
+					if (i < y && j < x) nb += 1u;
+					if (i < y && j > 0u) nb += 2u;
+					if (i > 0u && j < x) nb += 2u;
+					if (i > 0u && j > 0u) nb += 1u;
+					return nb;
+				}
+			);
 		}
 
 		if (this->map_.template is_embedded<Edge>())
@@ -177,6 +179,9 @@ public:
 
 		if (this->map_.template is_embedded<Volume>())
 			mbuild.new_orbit_embedding(Volume(this->dart_));
+
+		// close the hole, mark it as boundary and copy the embeddings of the incident cells on it
+		mbuild.close_boundary(this->dart_);
 	}
 
 	/*! @name Embedding Operators
@@ -201,7 +206,7 @@ public:
 		const float32 dx = x / float32(this->nx_);
 		const float32 dy = y / float32(this->ny_);
 
-		for(uint32 i = 0; i <= this->ny_; ++i)
+		parallel_foreach_index(0u, this->ny_ + 1u, [&] (uint32 i)
 		{
 			for(uint32 j = 0; j <= this->nx_; ++j)
 			{
@@ -210,7 +215,7 @@ public:
 						  dy*float32(i)*std::sqrt(3.0f) / 2.0f,
 						  z);
 			}
-		}
+		});
 	}
 
 	//! Embed a topological grid into a twister open ribbon
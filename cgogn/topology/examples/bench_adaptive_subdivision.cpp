@@ -0,0 +1,165 @@
+#include <chrono>
+#include <cmath>
+#include <string>
+
+#include <cgogn/core/utils/logger.h>
+#include <cgogn/core/cmap/cmap2.h>
+
+#include <cgogn/geometry/types/eigen.h>
+#include <cgogn/geometry/algos/normal.h>
+
+#include <cgogn/modeling/tiling/triangular_tore.h>
+
+#include <cgogn/topology/types/adaptive_tri_quad_cmap2.h>
+
+using namespace cgogn::numerics;
+
+using Map2 = cgogn::CMap2;
+using Vertex = Map2::Vertex;
+using Face = Map2::Face;
+using Vec3 = Eigen::Vector3d;
+using AdaptiveMap = cgogn::AdaptiveTriQuadCMap2;
+
+using TimePoint = std::chrono::time_point<std::chrono::system_clock>;
+
+static float64 elapsed(const TimePoint& start)
+{
+	std::chrono::duration<float64> d = std::chrono::system_clock::now() - start;
+	return d.count();
+}
+
+/**
+ * \brief closest point on a tore whose tube radius varies around the tore
+ */
+static Vec3 project(const Vec3& p)
+{
+	const float64 theta = std::atan2(p[1], p[0]);
+	const Vec3 center(10.0 * std::cos(theta), 10.0 * std::sin(theta), 0.0);
+	const float64 radius = 4.0 + 3.0 * std::sin(5.0 * theta);
+	return center + radius * (p - center).normalized();
+}
+
+struct AdaptiveTore
+{
+	Map2 map_;
+	Map2::VertexAttribute<Vec3> position_;
+	Map2::FaceAttribute<Vec3> normal_;
+	AdaptiveMap* adaptive_;
+
+	AdaptiveTore(uint32 n)
+	{
+		position_ = map_.add_attribute<Vec3, Vertex>("position");
+		normal_ = map_.add_attribute<Vec3, Face>("normal");
+		cgogn::modeling::TriangularTore<Map2> tore(map_, 2u * n, n);
+		tore.embed_into_tore(position_, 10.0f, 4.0f);
+		map_.parallel_foreach_cell([&] (Vertex v) { position_[v] = project(position_[v]); });
+		adaptive_ = new AdaptiveMap(map_);
+		adaptive_->init();
+	}
+
+	~AdaptiveTore()
+	{
+		delete adaptive_;
+	}
+
+	/**
+	 * \brief the faces whose normal deviates from the normal of a neighbour by more (refine) or less (!refine) than the threshold
+	 */
+	std::vector<Face> select(float64 threshold, uint32 max_level, bool refine)
+	{
+		map_.parallel_foreach_cell([&] (Face f) { normal_[f] = cgogn::geometry::normal(map_, f, position_); });
+		std::vector<Face> faces;
+		map_.foreach_cell([&] (Face f)
+		{
+			const uint8 level = adaptive_->face_level(f);
+			if ((refine && level >= max_level) || (!refine && level == 0u))
+				return;
+			float64 deviation = 0.0;
+			map_.foreach_adjacent_face_through_edge(f, [&] (Face af)
+			{
+				deviation = std::max(deviation, 1.0 - normal_[f].dot(normal_[af]));
+			});
+			if (refine == (deviation > threshold))
+				faces.push_back(f);
+		});
+		return faces;
+	}
+
+	void cut_edge(Vertex v)
+	{
+		position_[v] = project(0.5 * (position_[Vertex(map_.phi_1(v.dart))] + position_[Vertex(map_.phi1(v.dart))]));
+	}
+};
+
+int main(int argc, char** argv)
+{
+	uint32 n = 100u;
+	uint32 nb_steps = 4u;
+	if (argc < 2)
+		cgogn_log_info("bench_adaptive_subdivision") << "USAGE: " << argv[0] << " [tore_size] [nb_steps] (using " << n << " " << nb_steps << ")";
+	else
+	{
+		n = std::max(4u, uint32(std::stoi(argv[1])));
+		if (argc > 2)
+			nb_steps = std::min(6u, uint32(std::stoi(argv[2])));
+	}
+
+	cgogn_log_info("bench_adaptive_subdivision") << 4u * n * n << " initial triangles, " << cgogn::thread_pool()->nb_workers() << " workers";
+
+	// the same refinement is done face by face and by batches
+	AdaptiveTore single(n);
+	AdaptiveTore batch(n);
+	const float64 threshold = 1e-3;
+
+	for (uint32 s = 0u; s < nb_steps; ++s)
+	{
+		const std::vector<Face> single_faces = single.select(threshold, nb_steps, true);
+		const std::vector<Face> batch_faces = batch.select(threshold, nb_steps, true);
+
+		TimePoint start = std::chrono::system_clock::now();
+		std::vector<uint8> levels;
+		levels.reserve(single_faces.size());
+		for (Face f : single_faces)
+			levels.push_back(single.adaptive_->face_level(f));
+		for (uint32 i = 0u, end = uint32(single_faces.size()); i < end; ++i)
+		{
+			// skip the faces already subdivided to preserve the level of a finer neighbour
+			if (single.adaptive_->face_level(single_faces[i]) != levels[i])
+				continue;
+			single.adaptive_->subdivide_face(single_faces[i], [&] (Vertex v) { single.cut_edge(v); }, [] (Face) {}, [] (Face) {});
+		}
+		const float64 single_time = elapsed(start);
+
+		start = std::chrono::system_clock::now();
+		batch.adaptive_->subdivide_faces(
+			batch_faces,
+			[&] (const std::vector<Vertex>& vertices)
+			{
+				cgogn::parallel_foreach_index(0u, uint32(vertices.size()), [&] (uint32 i) { batch.cut_edge(vertices[i]); });
+			},
+			[] (const std::vector<Face>&) {},
+			[] (const std::vector<Face>&) {}
+		);
+		const float64 batch_time = elapsed(start);
+
+		cgogn_log_info("bench_adaptive_subdivision") << "refinement step " << s << " (" << batch_faces.size() << " selected faces, "
+			<< batch.map_.nb_cells<Face::ORBIT>() << " faces): subdivide_face " << single_time << "s, subdivide_faces " << batch_time
+			<< "s, speedup " << single_time / batch_time;
+		if (single.map_.nb_cells<Face::ORBIT>() != batch.map_.nb_cells<Face::ORBIT>())
+			cgogn_log_warning("bench_adaptive_subdivision") << "different results: " << single.map_.nb_cells<Face::ORBIT>() << " faces";
+	}
+
+	for (uint32 s = 0u; s < nb_steps; ++s)
+	{
+		// coarsen the flattest parts with a larger threshold
+		const std::vector<Face> faces = batch.select(threshold * 4.0, nb_steps, false);
+		const TimePoint start = std::chrono::system_clock::now();
+		const uint32 nb_merged = batch.adaptive_->simplify_faces(faces, [] (const std::vector<Face>&) {}, [] (const std::vector<Face>&) {}, [] (const std::vector<Map2::Edge>&) {});
+		cgogn_log_info("bench_adaptive_subdivision") << "simplification step " << s << " (" << faces.size() << " selected faces): simplify_faces "
+			<< elapsed(start) << "s, " << nb_merged << " merged groups, " << batch.map_.nb_cells<Face::ORBIT>() << " faces";
+		if (nb_merged == 0u)
+			break;
+	}
+
+	return 0;
+}
@@ -0,0 +1,335 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <algorithm>
+#include <array>
+#include <memory>
+
+#include <gtest/gtest.h>
+
+#include <cgogn/core/cmap/cmap2.h>
+#include <cgogn/geometry/types/eigen.h>
+#include <cgogn/geometry/algos/centroid.h>
+#include <cgogn/modeling/tiling/square_grid.h>
+#include <cgogn/modeling/tiling/triangular_tore.h>
+#include <cgogn/topology/types/adaptive_tri_quad_cmap2.h>
+
+using namespace cgogn::numerics;
+
+using Vec3 = Eigen::Vector3d;
+using Map2 = cgogn::CMap2;
+using Vertex = Map2::Vertex;
+using Edge = Map2::Edge;
+using Face = Map2::Face;
+using AdaptiveMap = cgogn::AdaptiveTriQuadCMap2;
+
+/**
+ * \brief a triangulated tore or a quad grid with its adaptive subdivision
+ * (the adaptive map is created once the surface is built: the tilings do not embed the darts)
+ */
+struct AdaptiveSurface
+{
+	Map2 map_;
+	Map2::VertexAttribute<Vec3> position_;
+	std::unique_ptr<AdaptiveMap> adaptive_ptr_;
+	AdaptiveMap& adaptive_;
+
+	AdaptiveSurface(bool triangles) :
+		position_(map_.add_attribute<Vec3, Vertex>("position")),
+		adaptive_ptr_(build(triangles)),
+		adaptive_(*adaptive_ptr_)
+	{
+		adaptive_.init();
+	}
+
+	AdaptiveMap* build(bool triangles)
+	{
+		if (triangles)
+		{
+			cgogn::modeling::TriangularTore<Map2> tore(map_, 12u, 8u);
+			tore.embed_into_tore(position_, 10.0f, 4.0f);
+		}
+		else
+		{
+			cgogn::modeling::SquareGrid<Map2> grid(map_, 6u, 5u);
+			grid.embed_into_grid(position_, 1.0f, 1.0f, 0.0f);
+		}
+		return new AdaptiveMap(map_);
+	}
+
+	Vec3 centroid(Face f) const
+	{
+		return cgogn::geometry::centroid(map_, f, position_);
+	}
+
+	void cut_edge(Vertex v)
+	{
+		position_[v] = 0.5 * (position_[Vertex(map_.phi_1(v.dart))] + position_[Vertex(map_.phi1(v.dart))]);
+	}
+
+	/**
+	 * \brief position of the central vertex inserted in a split quad (f is one of its children, the grid is planar)
+	 */
+	void split_face(Face f)
+	{
+		if (adaptive_.is_triangle_face(f))
+			return;
+		const cgogn::Dart od = adaptive_.oldest_dart(f);
+		position_[Vertex(map_.phi<11>(od))] =
+			position_[Vertex(map_.phi1(od))] + position_[Vertex(map_.phi_1(od))] - position_[Vertex(od)];
+	}
+
+	template <typename PREDICATE>
+	std::vector<Face> select(const PREDICATE& pred)
+	{
+		std::vector<Face> faces;
+		map_.foreach_cell([&] (Face f)
+		{
+			if (pred(f))
+				faces.push_back(f);
+		});
+		return faces;
+	}
+
+	/**
+	 * \brief subdivide the faces one at a time, skipping the faces already subdivided as a coarser neighbour of a previous one
+	 * \return the number of calls to the cut_edge, pre_split and post_split callbacks
+	 */
+	std::array<uint32, 3> subdivide_one_by_one(const std::vector<Face>& faces)
+	{
+		std::array<uint32, 3> nb = {{ 0u, 0u, 0u }};
+		std::vector<uint8> levels;
+		for (Face f : faces)
+			levels.push_back(adaptive_.face_level(f));
+		for (uint32 i = 0u; i < uint32(faces.size()); ++i)
+		{
+			if (adaptive_.face_level(faces[i]) != levels[i])
+				continue;
+			adaptive_.subdivide_face(faces[i],
+				[&] (Vertex v) { cut_edge(v); ++nb[0]; },
+				[&] (Face) { ++nb[1]; },
+				[&] (Face f) { split_face(f); ++nb[2]; }
+			);
+		}
+		return nb;
+	}
+
+	/**
+	 * \brief subdivide the faces by batches
+	 * \return the sizes of the vectors given to the cut_edges, pre_split and post_split callbacks
+	 */
+	std::array<uint32, 3> subdivide_batch(const std::vector<Face>& faces, uint32& nb_subdivided)
+	{
+		std::array<uint32, 3> nb = {{ 0u, 0u, 0u }};
+		nb_subdivided = adaptive_.subdivide_faces(faces,
+			[&] (const std::vector<Vertex>& vertices)
+			{
+				for (Vertex v : vertices)
+					cut_edge(v);
+				nb[0] += uint32(vertices.size());
+			},
+			[&] (const std::vector<Face>& fs) { nb[1] += uint32(fs.size()); },
+			[&] (const std::vector<Face>& fs)
+			{
+				nb[2] += uint32(fs.size());
+				// the split faces are one of their children
+				for (Face f : fs)
+				{
+					EXPECT_GE(adaptive_.face_level(f), 1u);
+					split_face(f);
+				}
+			}
+		);
+		return nb;
+	}
+
+	/**
+	 * \brief the centroid and level of each face, sorted
+	 */
+	std::vector<std::pair<Vec3, uint32>> faces()
+	{
+		std::vector<std::pair<Vec3, uint32>> result;
+		map_.foreach_cell([&] (Face f) { result.push_back(std::make_pair(centroid(f), uint32(adaptive_.face_level(f)))); });
+		std::sort(result.begin(), result.end(), [] (const std::pair<Vec3, uint32>& a, const std::pair<Vec3, uint32>& b)
+		{
+			return std::lexicographical_compare(a.first.data(), a.first.data() + 3, b.first.data(), b.first.data() + 3);
+		});
+		return result;
+	}
+};
+
+static void expect_same_faces(AdaptiveSurface& a, AdaptiveSurface& b)
+{
+	EXPECT_EQ(a.map_.nb_cells<Vertex::ORBIT>(), b.map_.nb_cells<Vertex::ORBIT>());
+	EXPECT_EQ(a.map_.nb_cells<Edge::ORBIT>(), b.map_.nb_cells<Edge::ORBIT>());
+	const std::vector<std::pair<Vec3, uint32>> fa = a.faces();
+	const std::vector<std::pair<Vec3, uint32>> fb = b.faces();
+	ASSERT_EQ(fa.size(), fb.size());
+	for (std::size_t i = 0u; i < fa.size(); ++i)
+	{
+		EXPECT_NEAR((fa[i].first - fb[i].first).norm(), 0.0, 1e-9);
+		EXPECT_EQ(fa[i].second, fb[i].second);
+	}
+}
+
+static void check_subdivide_faces(bool triangles)
+{
+	AdaptiveSurface single(triangles);
+	AdaptiveSurface batch(triangles);
+
+	// two refinement steps, the second one forces the refinement of coarser neighbours
+	const auto step1 = [] (AdaptiveSurface& s) { return s.select([&] (Face f) { return s.centroid(f)[0] > 0.15; }); };
+	const auto step2 = [] (AdaptiveSurface& s)
+	{
+		return s.select([&] (Face f) { return s.adaptive_.face_level(f) == 1u && s.centroid(f)[1] > 0.15; });
+	};
+
+	for (uint32 step = 0u; step < 2u; ++step)
+	{
+		const std::vector<Face> single_faces = step == 0u ? step1(single) : step2(single);
+		const std::vector<Face> batch_faces = step == 0u ? step1(batch) : step2(batch);
+		ASSERT_EQ(single_faces.size(), batch_faces.size());
+		ASSERT_FALSE(batch_faces.empty());
+
+		const uint32 nb_vertices = batch.map_.nb_cells<Vertex::ORBIT>();
+		const std::array<uint32, 3> nb_single = single.subdivide_one_by_one(single_faces);
+		uint32 nb_subdivided = 0u;
+		const std::array<uint32, 3> nb_batch = batch.subdivide_batch(batch_faces, nb_subdivided);
+
+		EXPECT_TRUE(single.map_.check_map_integrity());
+		EXPECT_TRUE(batch.map_.check_map_integrity());
+		expect_same_faces(single, batch);
+
+		// each cut edge and each split face is given once to the callbacks
+		EXPECT_EQ(nb_batch[0], nb_single[0]);
+		EXPECT_EQ(nb_batch[0] + (triangles ? 0u : nb_subdivided), batch.map_.nb_cells<Vertex::ORBIT>() - nb_vertices);
+		EXPECT_EQ(nb_batch[1], nb_subdivided);
+		EXPECT_EQ(nb_batch[2], nb_subdivided);
+		EXPECT_EQ(nb_single[1], nb_subdivided);
+		EXPECT_EQ(nb_single[2], nb_subdivided);
+		if (step == 1u)
+		{
+			EXPECT_GT(nb_subdivided, uint32(batch_faces.size())); // coarser neighbours
+		}
+	}
+}
+
+TEST(AdaptiveTriQuadCMap2Test, subdivide_faces_triangles)
+{
+	check_subdivide_faces(true);
+}
+
+TEST(AdaptiveTriQuadCMap2Test, subdivide_faces_quads)
+{
+	check_subdivide_faces(false);
+}
+
+static void check_simplify_faces(bool triangles)
+{
+	AdaptiveSurface single(triangles);
+	AdaptiveSurface batch(triangles);
+	const auto all = [] (Face) { return true; };
+	uint32 nb_subdivided = 0u;
+	single.subdivide_batch(single.select(all), nb_subdivided);
+	batch.subdivide_batch(batch.select(all), nb_subdivided);
+
+	// the groups of 4 faces with a face in the selected region are merged
+	const auto region = [] (AdaptiveSurface& s, Face f) { return s.adaptive_.face_level(f) == 1u && s.centroid(f)[0] > 0.15; };
+
+	std::array<uint32, 3> nb_single = {{ 0u, 0u, 0u }};
+	uint32 nb_single_merged = 0u;
+	for (;;)
+	{
+		Face g;
+		single.map_.foreach_cell([&] (Face f) -> bool
+		{
+			if (!region(single, f) || !single.adaptive_.is_simplifiable(f))
+				return true;
+			g = f;
+			return false;
+		});
+		if (g.dart.is_nil())
+			break;
+		single.adaptive_.simplify_face(g, [&] (Face) { ++nb_single[0]; }, [&] (Face) { ++nb_single[1]; }, [&] (Edge) { ++nb_single[2]; });
+		++nb_single_merged;
+	}
+
+	const uint32 nb_vertices = batch.map_.nb_cells<Vertex::ORBIT>();
+	std::array<uint32, 3> nb_batch = {{ 0u, 0u, 0u }};
+	const uint32 nb_merged = batch.adaptive_.simplify_faces(batch.select([&] (Face f) { return region(batch, f); }),
+		[&] (const std::vector<Face>& fs) { nb_batch[0] += uint32(fs.size()); },
+		[&] (const std::vector<Face>& fs)
+		{
+			nb_batch[1] += uint32(fs.size());
+			for (Face f : fs)
+				EXPECT_EQ(batch.adaptive_.face_level(f), 0u);
+		},
+		[&] (const std::vector<Edge>& es) { nb_batch[2] += uint32(es.size()); }
+	);
+
+	EXPECT_GT(nb_merged, 0u);
+	EXPECT_EQ(nb_merged, nb_single_merged);
+	EXPECT_TRUE(single.map_.check_map_integrity());
+	EXPECT_TRUE(batch.map_.check_map_integrity());
+	expect_same_faces(single, batch);
+
+	EXPECT_EQ(nb_batch[0], nb_merged);
+	EXPECT_EQ(nb_batch[1], nb_merged);
+	EXPECT_EQ(nb_batch[2], nb_single[2]);
+	EXPECT_EQ(nb_single[0], nb_merged);
+	EXPECT_EQ(nb_single[1], nb_merged);
+	// the vertices inserted in the merged edges (and in the center of the quads) are removed
+	EXPECT_EQ(nb_vertices - batch.map_.nb_cells<Vertex::ORBIT>(), nb_batch[2] + (triangles ? 0u : nb_merged));
+}
+
+TEST(AdaptiveTriQuadCMap2Test, simplify_faces_triangles)
+{
+	check_simplify_faces(true);
+}
+
+TEST(AdaptiveTriQuadCMap2Test, simplify_faces_quads)
+{
+	check_simplify_faces(false);
+}
+
+TEST(AdaptiveTriQuadCMap2Test, simplify_all)
+{
+	// two uniform levels are removed by two calls (the merged faces are not in the given faces)
+	AdaptiveSurface s(true);
+	const uint32 nb_vertices = s.map_.nb_cells<Vertex::ORBIT>();
+	const uint32 nb_faces = s.map_.nb_cells<Face::ORBIT>();
+	const auto all = [] (Face) { return true; };
+	const auto nothing = [] (const std::vector<Face>&) {};
+	uint32 nb = 0u;
+	s.subdivide_batch(s.select(all), nb);
+	s.subdivide_batch(s.select(all), nb);
+	EXPECT_EQ(s.map_.nb_cells<Face::ORBIT>(), 16u * nb_faces);
+
+	EXPECT_EQ(s.adaptive_.simplify_faces(s.select(all), nothing, nothing, [] (const std::vector<Edge>&) {}), 4u * nb_faces);
+	EXPECT_EQ(s.map_.nb_cells<Face::ORBIT>(), 4u * nb_faces);
+	EXPECT_EQ(s.adaptive_.simplify_faces(s.select(all), nothing, nothing, [] (const std::vector<Edge>&) {}), nb_faces);
+	EXPECT_EQ(s.map_.nb_cells<Face::ORBIT>(), nb_faces);
+	EXPECT_EQ(s.map_.nb_cells<Vertex::ORBIT>(), nb_vertices);
+	s.map_.foreach_cell([&] (Face f) { EXPECT_EQ(s.adaptive_.face_level(f), 0u); });
+	EXPECT_TRUE(s.map_.check_map_integrity());
+}
@@ -22,6 +22,8 @@
 *******************************************************************************/
 
 #include <cgogn/topology/types/adaptive_tri_quad_cmap2.h>
+#include <cgogn/core/basic/cell_marker.h>
+#include <cgogn/core/utils/thread.h>
 
 namespace cgogn
 {
@@ -112,6 +114,379 @@ bool AdaptiveTriQuadCMap2::is_simplifiable(Face f)
 	return false; // should never reach
 }
 
+std::vector<std::vector<AdaptiveTriQuadCMap2::Face>> AdaptiveTriQuadCMap2::subdivision_levels(const std::vector<Face>& faces)
+{
+	CellMarkerStore<CMap2, Face::ORBIT> selected(map_);
+	std::vector<Face> selection;
+	std::vector<Face> front;
+	for (Face f : faces)
+	{
+		if (!selected.is_marked(f))
+		{
+			selected.mark(f);
+			front.push_back(f);
+		}
+	}
+
+	// enforce neighbours level difference is not greater than 1 :
+	// the coarser neighbours of the selected faces are selected, until no more face is added
+	std::vector<std::vector<Face>> thread_faces(thread_pool()->nb_workers() + 1u);
+	while (!front.empty())
+	{
+		selection.insert(selection.end(), front.begin(), front.end());
+		parallel_foreach_index(0u, uint32(front.size()), [&] (uint32 i)
+		{
+			const uint8 fl = face_level(front[i]);
+			std::vector<Face>& coarser = thread_faces[current_thread_index()];
+			map_.foreach_adjacent_face_through_edge(front[i], [&] (Face af)
+			{
+				if (face_level(af) < fl && !selected.is_marked(af))
+					coarser.push_back(af);
+			});
+		});
+		front.clear();
+		for (std::vector<Face>& coarser : thread_faces)
+		{
+			for (Face af : coarser)
+			{
+				if (!selected.is_marked(af))
+				{
+					selected.mark(af);
+					front.push_back(af);
+				}
+			}
+			coarser.clear();
+		}
+	}
+
+	std::vector<uint8> levels(selection.size());
+	parallel_foreach_index(0u, uint32(selection.size()), [&] (uint32 i)
+	{
+		selection[i].dart = oldest_dart(selection[i]);
+		levels[i] = face_level(selection[i]);
+	});
+
+	std::vector<std::vector<Face>> result;
+	for (uint32 i = 0u, end = uint32(selection.size()); i < end; ++i)
+	{
+		if (levels[i] >= result.size())
+			result.resize(levels[i] + 1u);
+		result[levels[i]].push_back(selection[i]);
+	}
+	return result;
+}
+
+std::vector<AdaptiveTriQuadCMap2::Vertex> AdaptiveTriQuadCMap2::cut_edges_of_faces(const std::vector<Face>& faces, uint8 fl)
+{
+	CellMarkerStore<CMap2, Face::ORBIT> in_level(map_);
+	for (Face f : faces)
+		in_level.mark(f);
+
+	std::vector<std::vector<Edge>> thread_edges(thread_pool()->nb_workers() + 1u);
+	parallel_foreach_index(0u, uint32(faces.size()), [&] (uint32 i)
+	{
+		std::vector<Edge>& edges = thread_edges[current_thread_index()];
+		const Dart first = faces[i].dart;
+		Dart it = first;
+		do
+		{
+			Dart next = map_.phi1(it);
+			if (dart_level_[next] > fl)
+				next = map_.phi1(next);
+			else
+			{
+				// an edge shared by two faces of the level is cut by the face of its smallest dart
+				const Dart it2 = map_.phi2(it);
+				if (map_.is_boundary(it2) || !in_level.is_marked(Face(it2)) || it.index < it2.index)
+					edges.push_back(Edge(it));
+			}
+			it = next;
+		} while (it != first);
+	});
+
+	std::vector<Edge> edges;
+	for (std::vector<Edge>& te : thread_edges)
+		edges.insert(edges.end(), te.begin(), te.end());
+
+	std::vector<Vertex> vertices = map_.cut_edges(edges);
+
+	parallel_foreach_index(0u, uint32(edges.size()), [&] (uint32 i)
+	{
+		const Dart it = edges[i].dart;
+		dart_level_[map_.phi1(it)] = fl + 1;
+		if (!map_.is_incident_to_boundary(edges[i]))
+			dart_level_[map_.phi2(it)] = fl + 1;
+	});
+
+	return vertices;
+}
+
+void AdaptiveTriQuadCMap2::split_faces(const std::vector<Face>& faces, uint8 fl)
+{
+	std::vector<uint32> tris;
+	std::vector<uint32> quads;
+	for (uint32 i = 0u, end = uint32(faces.size()); i < end; ++i)
+	{
+		if (tri_face_[faces[i]])
+			tris.push_back(i);
+		else
+			quads.push_back(i);
+	}
+
+	auto set_edge_level = [&] (Edge e)
+	{
+		dart_level_[e.dart] = fl + 1;
+		dart_level_[map_.phi2(e.dart)] = fl + 1;
+	};
+
+	// each face is cut by one edge at a time : the cuts of the different faces are done together
+	std::vector<std::pair<Dart, Dart>> cuts;
+	std::vector<Edge> edges;
+
+	// cut triangles into 4 triangles
+	const uint32 nb_tris = uint32(tris.size());
+	std::vector<Dart> it(nb_tris);
+	std::vector<Dart> it2(nb_tris);
+	std::vector<uint32> fid(nb_tris);
+	cuts.resize(nb_tris);
+	parallel_foreach_index(0u, nb_tris, [&] (uint32 i)
+	{
+		const Face f = faces[tris[i]];
+		fid[i] = face_subd_id_[f];
+		it[i] = map_.phi1(f.dart);
+		it2[i] = map_.phi<11>(it[i]);
+		cuts[i] = std::make_pair(it[i], it2[i]);
+	});
+	edges = map_.cut_faces(cuts);
+	parallel_foreach_index(0u, nb_tris, [&] (uint32 i)
+	{
+		set_edge_level(edges[i]);
+		face_subd_id_[Face(it[i])] = 4*fid[i] + 1;
+		tri_face_[Face(it[i])] = true;
+		it[i] = map_.phi<11>(it2[i]);
+		cuts[i] = std::make_pair(it[i], it2[i]);
+	});
+	edges = map_.cut_faces(cuts);
+	parallel_foreach_index(0u, nb_tris, [&] (uint32 i)
+	{
+		set_edge_level(edges[i]);
+		face_subd_id_[Face(it2[i])] = 4*fid[i] + 2;
+		tri_face_[Face(it2[i])] = true;
+		it2[i] = map_.phi<11>(it[i]);
+		cuts[i] = std::make_pair(it[i], it2[i]);
+	});
+	edges = map_.cut_faces(cuts);
+	parallel_foreach_index(0u, nb_tris, [&] (uint32 i)
+	{
+		set_edge_level(edges[i]);
+		face_subd_id_[Face(it[i])] = 4*fid[i] + 3;
+		tri_face_[Face(it[i])] = true;
+		face_subd_id_[Face(it2[i])] = 4*fid[i] + 4;
+		tri_face_[Face(it2[i])] = true;
+	});
+
+	// cut other faces into quads
+	const uint32 nb_quads = uint32(quads.size());
+	it.resize(nb_quads);
+	it2.resize(nb_quads);
+	fid.resize(nb_quads);
+	cuts.resize(nb_quads);
+	parallel_foreach_index(0u, nb_quads, [&] (uint32 i)
+	{
+		const Face f = faces[quads[i]];
+		fid[i] = face_subd_id_[f];
+		it[i] = map_.phi1(f.dart);
+		it2[i] = map_.phi<11>(it[i]);
+		cuts[i] = std::make_pair(it[i], it2[i]);
+	});
+	edges = map_.cut_faces(cuts);
+	parallel_foreach_index(0u, nb_quads, [&] (uint32 i)
+	{
+		set_edge_level(edges[i]);
+		tri_face_[Face(it2[i])] = false;
+	});
+	const std::vector<Vertex> centers = map_.cut_edges(edges);
+	parallel_foreach_index(0u, nb_quads, [&] (uint32 i)
+	{
+		const Dart e = edges[i].dart;
+		dart_level_[map_.phi1(e)] = fl + 1;
+		dart_level_[map_.phi2(e)] = fl + 1;
+		it[i] = map_.phi2(e);
+		it2[i] = map_.phi<11>(it2[i]);
+	});
+	std::vector<uint32> active(nb_quads);
+	for (uint32 i = 0u; i < nb_quads; ++i)
+		active[i] = i;
+	while (!active.empty())
+	{
+		cuts.resize(active.size());
+		parallel_foreach_index(0u, uint32(active.size()), [&] (uint32 i)
+		{
+			cuts[i] = std::make_pair(it[active[i]], it2[active[i]]);
+		});
+		edges = map_.cut_faces(cuts);
+		parallel_foreach_index(0u, uint32(active.size()), [&] (uint32 i)
+		{
+			const uint32 q = active[i];
+			set_edge_level(edges[i]);
+			tri_face_[Face(it2[q])] = false;
+			it[q] = map_.phi2(map_.phi_1(it[q]));
+			it2[q] = map_.phi<11>(it2[q]);
+		});
+		active.erase(
+			std::remove_if(active.begin(), active.end(), [&] (uint32 q) { return map_.phi1(it2[q]) == it[q]; }),
+			active.end()
+		);
+	}
+	parallel_foreach_index(0u, nb_quads, [&] (uint32 i)
+	{
+		uint32 cmpt = 0;
+		map_.foreach_incident_face(centers[i], [&] (Face af)
+		{
+			cmpt++;
+			face_subd_id_[af] = 4*fid[i] + cmpt;
+		});
+	});
+}
+
+std::vector<std::vector<AdaptiveTriQuadCMap2::Face>> AdaptiveTriQuadCMap2::simplification_levels(const std::vector<Face>& faces)
+{
+	std::vector<Face> oldest(faces.size());
+	std::vector<uint8> levels(faces.size());
+	parallel_foreach_index(0u, uint32(faces.size()), [&] (uint32 i)
+	{
+		oldest[i] = Face(oldest_dart(faces[i]));
+		levels[i] = face_level(faces[i]);
+	});
+
+	std::vector<std::vector<Face>> result;
+	for (uint32 i = 0u, end = uint32(faces.size()); i < end; ++i)
+	{
+		if (levels[i] >= result.size())
+			result.resize(levels[i] + 1u);
+		result[levels[i]].push_back(oldest[i]);
+	}
+	return result;
+}
+
+std::vector<AdaptiveTriQuadCMap2::Face> AdaptiveTriQuadCMap2::simplifiable_groups(const std::vector<Face>& faces)
+{
+	// a simplifiable group is made of faces without inserted vertex :
+	// its neighbours are not finer and merging it keeps the level difference not greater than 1
+	std::vector<uint8> simplifiable(faces.size());
+	parallel_foreach_index(0u, uint32(faces.size()), [&] (uint32 i)
+	{
+		simplifiable[i] = is_simplifiable(faces[i]);
+	});
+
+	CellMarkerStore<CMap2, Face::ORBIT> grouped(map_);
+	std::vector<Face> groups;
+	for (uint32 i = 0u, end = uint32(faces.size()); i < end; ++i)
+	{
+		if (simplifiable[i] && !grouped.is_marked(faces[i]))
+		{
+			foreach_group_face(faces[i], [&] (Face gf) { grouped.mark(gf); });
+			groups.push_back(faces[i]);
+		}
+	}
+	return groups;
+}
+
+std::vector<AdaptiveTriQuadCMap2::Face> AdaptiveTriQuadCMap2::merge_groups(const std::vector<Face>& faces)
+{
+	std::vector<Face> result;
+	result.reserve(faces.size());
+
+	for (Face f : faces)
+	{
+		const uint32 fid = face_subd_id_[f];
+		Face resF;
+
+		if (tri_face_[f])
+		{
+			Dart it = f.dart;
+			switch (face_type(f))
+			{
+				case TRI_CORNER: {
+					Dart od = oldest_dart(f);
+					it = map_.phi<12>(od); // put 'it' in the central face
+					resF.dart = od;
+					break;
+				}
+				case TRI_CENTRAL: {
+					resF.dart = map_.phi_1(map_.phi2(f.dart));
+					break;
+				}
+				default:
+					break;
+			}
+
+			Dart next = map_.phi1(it);
+			map_.merge_incident_faces(Edge(map_.phi2(it)));
+			it = next;
+			next = map_.phi1(it);
+			map_.merge_incident_faces(Edge(it));
+			it = next;
+			map_.merge_incident_faces(Edge(it));
+
+			tri_face_[resF] = true;
+		}
+		else
+		{
+			Dart od = oldest_dart(f);
+			resF.dart = od;
+			map_.merge_incident_faces(Vertex(map_.phi<11>(od))); // central vertex
+
+			tri_face_[resF] = false;
+		}
+
+		// the level of the merged faces is needed to simplify their edges
+		face_subd_id_[resF] = uint32((fid-1) / 4);
+		result.push_back(resF);
+	}
+
+	return result;
+}
+
+std::vector<AdaptiveTriQuadCMap2::Edge> AdaptiveTriQuadCMap2::merge_edges_of_faces(const std::vector<Face>& faces, uint8 fl)
+{
+	CellMarkerStore<CMap2, Face::ORBIT> merged(map_);
+	for (Face f : faces)
+		merged.mark(f);
+
+	// the darts of the inserted vertices that can be removed,
+	// an edge shared by two merged faces is simplified by the face of its smallest inserted dart
+	std::vector<std::vector<Dart>> thread_darts(thread_pool()->nb_workers() + 1u);
+	parallel_foreach_index(0u, uint32(faces.size()), [&] (uint32 i)
+	{
+		std::vector<Dart>& darts = thread_darts[current_thread_index()];
+		const Dart first = faces[i].dart;
+		Dart it = first;
+		do
+		{
+			const Dart v = map_.phi1(it);
+			const Dart it2 = map_.phi2(it);
+			if (map_.is_boundary(it2))
+				darts.push_back(v);
+			else if (face_level(Face(it2)) == fl-1 && (!merged.is_marked(Face(it2)) || v.index < it2.index))
+				darts.push_back(v);
+			it = map_.phi<11>(it);
+		} while (it != first);
+	});
+
+	std::vector<Edge> edges;
+	for (std::vector<Dart>& darts : thread_darts)
+	{
+		for (Dart v : darts)
+		{
+			const Dart it = map_.phi_1(v);
+			map_.merge_incident_edges(Vertex(v));
+			edges.push_back(Edge(it));
+		}
+	}
+	return edges;
+}
+
 uint8 AdaptiveTriQuadCMap2::dart_level(Dart d)
 {
 	return dart_level_[d];
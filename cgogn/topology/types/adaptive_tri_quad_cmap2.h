@@ -24,6 +24,8 @@
 #ifndef CGOGN_TOPOLOGY_ADAPTIVE_TRI_QUAD_CMAP2_H_
 #define CGOGN_TOPOLOGY_ADAPTIVE_TRI_QUAD_CMAP2_H_
 
+#include <vector>
+
 #include <cgogn/topology/dll.h>
 #include <cgogn/core/cmap/cmap2.h>
 
@@ -166,6 +168,55 @@ public:
 		post_split_face_func(f);
 	}
 
+	/**
+	 * \brief Subdivide a set of faces
+	 * \param faces : the faces to subdivide
+	 * \param cut_edges_func : called with the vertices inserted in the edges
+	 * \param pre_split_faces_func : called with the faces about to be split (their edges being cut)
+	 * \param post_split_faces_func : called with the split faces
+	 * \return the number of subdivided faces
+	 * The result is the same as calling subdivide_face for each face in order, skipping the faces
+	 * that have already been subdivided as a coarser neighbour of a previous face (a given face is subdivided once).
+	 * The level constraints are first resolved for the whole set : the coarser neighbours that have to be subdivided are added.
+	 * The faces are then subdivided level by level : the edges of all the faces of a level are cut at once,
+	 * then the faces are split by batches of independent cuts (see CMap2::cut_edges and CMap2::cut_faces).
+	 * Each callback is called once per level.
+	 */
+	template <typename CUT_EDGES_FUNC, typename PRE_SPLIT_FACES_FUNC, typename POST_SPLIT_FACES_FUNC>
+	uint32 subdivide_faces(
+		const std::vector<Face>& faces,
+		const CUT_EDGES_FUNC& cut_edges_func,
+		const PRE_SPLIT_FACES_FUNC& pre_split_faces_func,
+		const POST_SPLIT_FACES_FUNC& post_split_faces_func
+	)
+	{
+		static_assert(is_func_parameter_same<CUT_EDGES_FUNC, const std::vector<Vertex>&>::value, "Wrong cut_edges function parameter type");
+		static_assert(is_func_parameter_same<PRE_SPLIT_FACES_FUNC, const std::vector<Face>&>::value, "Wrong pre_split_faces function parameter type");
+		static_assert(is_func_parameter_same<POST_SPLIT_FACES_FUNC, const std::vector<Face>&>::value, "Wrong post_split_faces function parameter type");
+
+		const std::vector<std::vector<Face>> levels = subdivision_levels(faces);
+
+		uint32 nb_subdivided = 0u;
+		for (uint32 l = 0u; l < uint32(levels.size()); ++l)
+		{
+			const std::vector<Face>& level_faces = levels[l];
+			if (level_faces.empty())
+				continue;
+
+			const std::vector<Vertex> vertices = cut_edges_of_faces(level_faces, uint8(l));
+			if (!vertices.empty())
+				cut_edges_func(vertices);
+
+			pre_split_faces_func(level_faces);
+			split_faces(level_faces, uint8(l));
+			post_split_faces_func(level_faces);
+
+			nb_subdivided += uint32(level_faces.size());
+		}
+
+		return nb_subdivided;
+	}
+
 	bool is_simplifiable(Face f);
 
 	template <typename PRE_MERGE_FACES_FUNC, typename POST_MERGE_FACES_FUNC, typename MERGE_EDGES_FUNC>
@@ -248,6 +299,55 @@ public:
 		return resF;
 	}
 
+	/**
+	 * \brief Simplify a set of faces
+	 * \param faces : the faces whose group of 4 triangles or quads is merged
+	 * \param pre_merge_faces_func : called with one face of each group about to be merged
+	 * \param post_merge_faces_func : called with the merged faces
+	 * \param merge_edges_func : called with the edges whose inserted vertex has been removed
+	 * \return the number of merged groups
+	 * The result is the same as calling simplify_face, level by level from the finest one, once for each group
+	 * that contains a given face and is simplifiable when its level is reached. The faces resulting from a merge
+	 * are not in the given faces: they are simplified further only if another face of their group is given.
+	 * Merging the finer groups first can make coarser groups simplifiable. The groups of a level are selected in parallel,
+	 * each group is merged once even if several of its faces are given.
+	 * Each callback is called once per level.
+	 */
+	template <typename PRE_MERGE_FACES_FUNC, typename POST_MERGE_FACES_FUNC, typename MERGE_EDGES_FUNC>
+	uint32 simplify_faces(
+		const std::vector<Face>& faces,
+		const PRE_MERGE_FACES_FUNC& pre_merge_faces_func,
+		const POST_MERGE_FACES_FUNC& post_merge_faces_func,
+		const MERGE_EDGES_FUNC& merge_edges_func
+	)
+	{
+		static_assert(is_func_parameter_same<PRE_MERGE_FACES_FUNC, const std::vector<Face>&>::value, "Wrong pre_merge_faces function parameter type");
+		static_assert(is_func_parameter_same<POST_MERGE_FACES_FUNC, const std::vector<Face>&>::value, "Wrong post_merge_faces function parameter type");
+		static_assert(is_func_parameter_same<MERGE_EDGES_FUNC, const std::vector<Edge>&>::value, "Wrong merge_edges function parameter type");
+
+		const std::vector<std::vector<Face>> levels = simplification_levels(faces);
+
+		uint32 nb_merged = 0u;
+		for (uint32 l = uint32(levels.size()); l > 1u; --l)
+		{
+			const std::vector<Face> groups = simplifiable_groups(levels[l - 1u]);
+			if (groups.empty())
+				continue;
+
+			pre_merge_faces_func(groups);
+			const std::vector<Face> merged = merge_groups(groups);
+			post_merge_faces_func(merged);
+
+			const std::vector<Edge> edges = merge_edges_of_faces(merged, uint8(l - 1u));
+			if (!edges.empty())
+				merge_edges_func(edges);
+
+			nb_merged += uint32(groups.size());
+		}
+
+		return nb_merged;
+	}
+
 	uint8 dart_level(Dart d);
 	uint8 face_level(Face f);
 	FaceType face_type(Face f);
@@ -256,6 +356,61 @@ public:
 
 protected:
 
+	/**
+	 * \brief the given faces and the coarser neighbours that have to be subdivided before them, sorted by level
+	 * (the faces are represented by their oldest dart)
+	 */
+	std::vector<std::vector<Face>> subdivision_levels(const std::vector<Face>& faces);
+
+	/**
+	 * \brief cut the edges of the given faces of level fl that are not already cut
+	 */
+	std::vector<Vertex> cut_edges_of_faces(const std::vector<Face>& faces, uint8 fl);
+
+	/**
+	 * \brief split the given faces of level fl whose edges are cut
+	 */
+	void split_faces(const std::vector<Face>& faces, uint8 fl);
+
+	/**
+	 * \brief the given faces sorted by level (the faces are represented by their oldest dart)
+	 */
+	std::vector<std::vector<Face>> simplification_levels(const std::vector<Face>& faces);
+
+	/**
+	 * \brief one face of each simplifiable group of the given faces
+	 */
+	std::vector<Face> simplifiable_groups(const std::vector<Face>& faces);
+
+	/**
+	 * \brief merge the groups of the given faces, return the merged faces
+	 */
+	std::vector<Face> merge_groups(const std::vector<Face>& faces);
+
+	/**
+	 * \brief remove the vertices inserted in the edges of the given merged faces when possible
+	 * \param fl : the level of the faces before their merge
+	 */
+	std::vector<Edge> merge_edges_of_faces(const std::vector<Face>& faces, uint8 fl);
+
+	/**
+	 * \brief call func on each face of the group of 4 triangles or quads of the simplifiable face f
+	 */
+	template <typename FUNC>
+	void foreach_group_face(Face f, const FUNC& func)
+	{
+		if (tri_face_[f])
+		{
+			Dart it = f.dart;
+			if (face_type(f) == TRI_CORNER)
+				it = map_.phi<12>(oldest_dart(f)); // central face
+			func(Face(it));
+			map_.foreach_dart_of_orbit(Face(it), [&] (Dart d) { func(Face(map_.phi2(d))); });
+		}
+		else
+			map_.foreach_incident_face(Vertex(map_.phi<12>(oldest_dart(f))), func);
+	}
+
 	CMap2& map_;
 
 	CMap2::CDartAttribute<uint8> dart_level_; // dart insertion level